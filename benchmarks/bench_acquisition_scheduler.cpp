@@ -0,0 +1,89 @@
+/**
+ * @file bench_acquisition_scheduler.cpp
+ * @brief Scheduler dispatch benchmarks against the in-process Inverter SIM
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "bench_common.hpp"
+#include "acquisition_scheduler.hpp"
+#include "config_manager.hpp"
+#include "inverter_sim_server.hpp"
+#include <memory>
+#include <vector>
+
+using namespace ecoWatt;
+using ecoWatt::bench::AllocationScope;
+using ecoWatt::bench::reportThroughput;
+
+namespace {
+
+constexpr const char* kSimBaseUrl = "http://127.0.0.1:18091";
+
+struct SchedulerFixture {
+    SchedulerFixture() {
+        simulator = std::make_shared<InverterSimulator>();
+        server = std::make_unique<InverterSimServer>(simulator, kSimBaseUrl);
+        server->start();
+
+        ModbusConfig modbus_config = config.getModbusConfig();
+        modbus_config.slave_address = 17;
+        modbus_config.max_retries = 1;
+        config.updateModbusConfig(modbus_config);
+
+        ApiConfig api_config = config.getApiConfig();
+        api_config.base_url = kSimBaseUrl;
+        config.updateApiConfig(api_config);
+
+        auto adapter = std::make_shared<ProtocolAdapter>(config);
+        scheduler = std::make_unique<AcquisitionScheduler>(adapter, config);
+        scheduler->configureRegisters(config.getRegisterConfigs());
+    }
+
+    ConfigManager config;
+    std::shared_ptr<InverterSimulator> simulator;
+    std::unique_ptr<InverterSimServer> server;
+    std::unique_ptr<AcquisitionScheduler> scheduler;
+};
+
+} // namespace
+
+static void BM_Scheduler_ReadMultipleRegisters(benchmark::State& state) {
+    SchedulerFixture fixture;
+
+    std::vector<RegisterAddress> addresses;
+    for (RegisterAddress address = 0; address < state.range(0); ++address) {
+        addresses.push_back(address);
+    }
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fixture.scheduler->readMultipleRegisters(addresses));
+    }
+    allocs.report(state);
+    reportThroughput(state, state.range(0));
+}
+BENCHMARK(BM_Scheduler_ReadMultipleRegisters)->Arg(1)->Arg(10)->UseRealTime();
+
+static void BM_Scheduler_PollCycle(benchmark::State& state) {
+    SchedulerFixture fixture;
+
+    // Callbacks mimic the device wiring (storage, display, ...)
+    uint64_t delivered = 0;
+    for (int i = 0; i < state.range(0); ++i) {
+        fixture.scheduler->addSampleCallback([&delivered](const AcquisitionSample& sample) {
+            delivered += sample.raw_value;
+        });
+    }
+
+    size_t registers = fixture.config.getRegisterConfigs().size();
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        fixture.scheduler->pollOnce();
+    }
+    allocs.report(state);
+    benchmark::DoNotOptimize(delivered);
+    reportThroughput(state, static_cast<int64_t>(registers));
+}
+BENCHMARK(BM_Scheduler_PollCycle)->Arg(1)->Arg(4)->UseRealTime();
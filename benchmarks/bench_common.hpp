@@ -0,0 +1,52 @@
+/**
+ * @file bench_common.hpp
+ * @brief Shared helpers for the EcoWatt benchmark suite
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdint>
+
+namespace ecoWatt {
+namespace bench {
+
+/**
+ * @brief Process-wide count of operator new calls (replaced in bench_alloc.cpp)
+ *
+ * C libraries that call malloc directly (SQLite) are not included.
+ */
+uint64_t allocationCount();
+
+/**
+ * @brief Reports heap allocations per iteration as the "allocs_per_op" counter
+ *
+ * Construct just before the timing loop and call report() after it. The
+ * counter is process-wide, so background threads (e.g. an in-process HTTP
+ * server) are included in the figure.
+ */
+class AllocationScope {
+public:
+    AllocationScope() : start_(allocationCount()) {}
+
+    void report(benchmark::State& state) const {
+        state.counters["allocs_per_op"] = benchmark::Counter(
+            static_cast<double>(allocationCount() - start_), benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    uint64_t start_;
+};
+
+/**
+ * @brief Sets items_per_second from the iteration count times @p items_per_iteration
+ */
+inline void reportThroughput(benchmark::State& state, int64_t items_per_iteration = 1) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * items_per_iteration);
+}
+
+} // namespace bench
+} // namespace ecoWatt
@@ -0,0 +1,182 @@
+/**
+ * @file bench_compare.cpp
+ * @brief Regression gate for ecoWatt_bench JSON results
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ *
+ * Usage: bench_compare [options] <baseline.json> <candidate.json>
+ * Exit codes: 0 = no regression, 1 = regression, 2 = usage or input error.
+ */
+
+#include "bench_stats.hpp"
+#include <cstdio>
+#include <iostream>
+#include <regex>
+#include <string>
+
+using namespace ecoWatt::bench;
+
+namespace {
+
+constexpr int kExitRegression = 1;
+constexpr int kExitError = 2;
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options] <baseline.json> <candidate.json>\n"
+              << "  --time-threshold <f>        Max relative slowdown of median time (default 0.05)\n"
+              << "  --throughput-threshold <f>  Max relative drop of median items/s (default 0.05)\n"
+              << "  --allocs-threshold <n>      Max increase of median allocs/op (default 0.5)\n"
+              << "  --alpha <p>                 Mann-Whitney U significance level (default 0.05)\n"
+              << "  --min-repetitions <n>       Skip the U test below this (default 5)\n"
+              << "  --filter <regex>            Only compare matching benchmark names\n"
+              << "  --help                      Show this message\n";
+}
+
+std::string formatTime(double ns) {
+    char buffer[32];
+    if (ns >= 1e9) {
+        std::snprintf(buffer, sizeof(buffer), "%.3f s", ns / 1e9);
+    } else if (ns >= 1e6) {
+        std::snprintf(buffer, sizeof(buffer), "%.3f ms", ns / 1e6);
+    } else if (ns >= 1e3) {
+        std::snprintf(buffer, sizeof(buffer), "%.3f us", ns / 1e3);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.1f ns", ns);
+    }
+    return buffer;
+}
+
+std::string formatValue(const MetricComparison& metric, double value) {
+    if (metric.metric == "real_time" || metric.metric == "cpu_time") {
+        return formatTime(value);
+    }
+
+    char buffer[32];
+    if (metric.metric == "items_per_second") {
+        std::snprintf(buffer, sizeof(buffer), "%.4g/s", value);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.2f", value);
+    }
+    return buffer;
+}
+
+std::string formatChange(const MetricComparison& metric) {
+    char buffer[32];
+    if (metric.metric == "allocs_per_op") {
+        std::snprintf(buffer, sizeof(buffer), "%+.2f", metric.change);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%+.1f%%", metric.change * 100.0);
+    }
+    return buffer;
+}
+
+void printReport(const CompareReport& report) {
+    for (const auto& benchmark : report.benchmarks) {
+        std::printf("%s  [%zu vs %zu repetitions]\n", benchmark.name.c_str(),
+                    benchmark.baseline_repetitions, benchmark.candidate_repetitions);
+        std::printf("  %-18s p50 %s / p90 %s / p99 %s  ->  p50 %s / p90 %s / p99 %s\n", "latency",
+                    formatTime(benchmark.baseline_latency.p50).c_str(),
+                    formatTime(benchmark.baseline_latency.p90).c_str(),
+                    formatTime(benchmark.baseline_latency.p99).c_str(),
+                    formatTime(benchmark.candidate_latency.p50).c_str(),
+                    formatTime(benchmark.candidate_latency.p90).c_str(),
+                    formatTime(benchmark.candidate_latency.p99).c_str());
+
+        for (const auto& metric : benchmark.metrics) {
+            std::string p_value = metric.utest ? std::to_string(metric.p_value).substr(0, 6) : "-";
+            std::printf("  %-18s %14s -> %-14s %9s  p=%-8s %s\n", metric.metric.c_str(),
+                        formatValue(metric, metric.baseline).c_str(),
+                        formatValue(metric, metric.candidate).c_str(),
+                        formatChange(metric).c_str(), p_value.c_str(), toString(metric.verdict));
+        }
+    }
+
+    for (const auto& name : report.only_in_baseline) {
+        std::printf("%s  [removed]\n", name.c_str());
+    }
+    for (const auto& name : report.only_in_candidate) {
+        std::printf("%s  [new]\n", name.c_str());
+    }
+}
+
+BenchmarkRun filterRun(const BenchmarkRun& run, const std::regex& filter) {
+    BenchmarkRun filtered;
+    for (const auto& [name, samples] : run) {
+        if (std::regex_search(name, filter)) {
+            filtered.emplace(name, samples);
+        }
+    }
+    return filtered;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    CompareThresholds thresholds;
+    std::string filter;
+    std::vector<std::string> files;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool has_value = i + 1 < argc;
+
+            if (arg == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (arg == "--time-threshold" && has_value) {
+                thresholds.time = std::stod(argv[++i]);
+            } else if (arg == "--throughput-threshold" && has_value) {
+                thresholds.throughput = std::stod(argv[++i]);
+            } else if (arg == "--allocs-threshold" && has_value) {
+                thresholds.allocs = std::stod(argv[++i]);
+            } else if (arg == "--alpha" && has_value) {
+                thresholds.alpha = std::stod(argv[++i]);
+            } else if (arg == "--min-repetitions" && has_value) {
+                thresholds.min_repetitions = static_cast<size_t>(std::stoul(argv[++i]));
+            } else if (arg == "--filter" && has_value) {
+                filter = argv[++i];
+            } else if (!arg.empty() && arg[0] == '-') {
+                std::cerr << "Unknown or incomplete option: " << arg << "\n";
+                printUsage(argv[0]);
+                return kExitError;
+            } else {
+                files.push_back(arg);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid option value: " << e.what() << "\n";
+        return kExitError;
+    }
+
+    if (files.size() != 2) {
+        printUsage(argv[0]);
+        return kExitError;
+    }
+
+    try {
+        BenchmarkRun baseline = loadBenchmarkFile(files[0]);
+        BenchmarkRun candidate = loadBenchmarkFile(files[1]);
+
+        if (!filter.empty()) {
+            std::regex pattern(filter);
+            baseline = filterRun(baseline, pattern);
+            candidate = filterRun(candidate, pattern);
+        }
+
+        CompareReport report = compareRuns(baseline, candidate, thresholds);
+        printReport(report);
+
+        if (report.regressed()) {
+            std::printf("\nRESULT: regression detected\n");
+            return kExitRegression;
+        }
+
+        std::printf("\nRESULT: no regression (%zu benchmarks compared)\n", report.benchmarks.size());
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "bench_compare: " << e.what() << "\n";
+        return kExitError;
+    }
+}
@@ -0,0 +1,212 @@
+/**
+ * @file bench_data_storage.cpp
+ * @brief Benchmarks for memory and SQLite sample storage
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "bench_common.hpp"
+#include "data_storage.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace ecoWatt;
+using ecoWatt::bench::AllocationScope;
+using ecoWatt::bench::reportThroughput;
+
+namespace {
+
+constexpr RegisterAddress kRegisterCount = 10;
+
+AcquisitionSample makeSample(RegisterAddress address, TimePoint timestamp) {
+    return AcquisitionSample(timestamp, address, "Register " + std::to_string(address),
+                             static_cast<RegisterValue>(address * 100), address * 10.0, "V");
+}
+
+std::vector<AcquisitionSample> makeBatch(size_t size, TimePoint start) {
+    std::vector<AcquisitionSample> batch;
+    batch.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        batch.push_back(makeSample(static_cast<RegisterAddress>(i % kRegisterCount),
+                                   start + std::chrono::milliseconds(i)));
+    }
+    return batch;
+}
+
+/**
+ * @brief Fresh database file per benchmark run, removed afterwards
+ */
+class TempDatabase {
+public:
+    explicit TempDatabase(const std::string& name) : path_("bench_" + name + ".db") {
+        std::remove(path_.c_str());
+    }
+    ~TempDatabase() { std::remove(path_.c_str()); }
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+};
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// MemoryDataStorage
+// ----------------------------------------------------------------------------
+
+static void BM_MemoryStorage_StoreSample(benchmark::State& state) {
+    MemoryDataStorage storage(1000);
+    AcquisitionSample sample = makeSample(0, std::chrono::system_clock::now());
+    RegisterAddress address = 0;
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        sample.register_address = address;
+        storage.storeSample(sample);
+        address = static_cast<RegisterAddress>((address + 1) % kRegisterCount);
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_MemoryStorage_StoreSample);
+
+// Same with the rings mirrored into the memory-mapped snapshot file
+static void BM_MemoryStorage_StoreSample_Snapshot(benchmark::State& state) {
+    const std::string path = "bench_memory.snap";
+    std::remove(path.c_str());
+    {
+        MemoryDataStorage storage(1000, path);
+        AcquisitionSample sample = makeSample(0, std::chrono::system_clock::now());
+        RegisterAddress address = 0;
+
+        AllocationScope allocs;
+        for (auto _ : state) {
+            sample.register_address = address;
+            storage.storeSample(sample);
+            address = static_cast<RegisterAddress>((address + 1) % kRegisterCount);
+        }
+        allocs.report(state);
+        reportThroughput(state);
+    }
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_MemoryStorage_StoreSample_Snapshot);
+
+// Warm start: open a full snapshot (1000 samples x 10 registers) and rebuild the rings
+static void BM_MemoryStorage_WarmStart(benchmark::State& state) {
+    const std::string path = "bench_memory.snap";
+    std::remove(path.c_str());
+    {
+        MemoryDataStorage storage(1000, path);
+        storage.storeSamples(makeBatch(1000 * kRegisterCount, std::chrono::system_clock::now()));
+    }
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        MemoryDataStorage storage(1000, path);
+        benchmark::DoNotOptimize(storage.getAllLatestSamples());
+    }
+    allocs.report(state);
+    reportThroughput(state, 1000 * kRegisterCount);
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_MemoryStorage_WarmStart)->Unit(benchmark::kMillisecond);
+
+static void BM_MemoryStorage_GetSamples(benchmark::State& state) {
+    MemoryDataStorage storage(1000);
+    storage.storeSamples(makeBatch(1000 * kRegisterCount, std::chrono::system_clock::now()));
+    size_t count = static_cast<size_t>(state.range(0));
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(storage.getSamples(3, count));
+    }
+    allocs.report(state);
+    reportThroughput(state, state.range(0));
+}
+BENCHMARK(BM_MemoryStorage_GetSamples)->Arg(1)->Arg(100)->Arg(1000);
+
+static void BM_MemoryStorage_GetSamplesByTimeRange(benchmark::State& state) {
+    MemoryDataStorage storage(1000);
+    TimePoint start = std::chrono::system_clock::now();
+    storage.storeSamples(makeBatch(1000 * kRegisterCount, start));
+
+    TimePoint range_start = start + std::chrono::milliseconds(2500);
+    TimePoint range_end = start + std::chrono::milliseconds(7500);
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(storage.getSamplesByTimeRange(3, range_start, range_end));
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_MemoryStorage_GetSamplesByTimeRange);
+
+static void BM_MemoryStorage_GetAllLatestSamples(benchmark::State& state) {
+    MemoryDataStorage storage(1000);
+    storage.storeSamples(makeBatch(100 * kRegisterCount, std::chrono::system_clock::now()));
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(storage.getAllLatestSamples());
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_MemoryStorage_GetAllLatestSamples);
+
+// ----------------------------------------------------------------------------
+// SQLiteDataStorage
+// ----------------------------------------------------------------------------
+
+static void BM_SQLiteStorage_StoreSample(benchmark::State& state) {
+    TempDatabase db("single");
+    SQLiteDataStorage storage(db.path());
+    AcquisitionSample sample = makeSample(0, std::chrono::system_clock::now());
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        sample.timestamp += std::chrono::milliseconds(1);
+        storage.storeSample(sample);
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_SQLiteStorage_StoreSample)->UseRealTime();
+
+static void BM_SQLiteStorage_StoreBatch(benchmark::State& state) {
+    TempDatabase db("batch");
+    SQLiteDataStorage storage(db.path());
+    TimePoint start = std::chrono::system_clock::now();
+    size_t batch_size = static_cast<size_t>(state.range(0));
+    std::vector<AcquisitionSample> batch = makeBatch(batch_size, start);
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        storage.storeSamples(batch);
+    }
+    allocs.report(state);
+    reportThroughput(state, state.range(0));
+}
+BENCHMARK(BM_SQLiteStorage_StoreBatch)->Arg(10)->Arg(100)->UseRealTime();
+
+static void BM_SQLiteStorage_RangeQuery(benchmark::State& state) {
+    TempDatabase db("range");
+    SQLiteDataStorage storage(db.path());
+    TimePoint start = std::chrono::system_clock::now();
+    storage.storeSamples(makeBatch(10000, start));
+
+    // Roughly state.range(0) samples of register 3 fall in the window
+    TimePoint range_start = start + std::chrono::milliseconds(1000);
+    TimePoint range_end = range_start + std::chrono::milliseconds(state.range(0) * kRegisterCount);
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(storage.getSamplesByTimeRange(3, range_start, range_end));
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_SQLiteStorage_RangeQuery)->Arg(10)->Arg(500)->UseRealTime();
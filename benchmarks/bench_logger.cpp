@@ -0,0 +1,79 @@
+/**
+ * @file bench_logger.cpp
+ * @brief Benchmarks for per-request logging cost: disabled calls and sync vs async sinks
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "bench_common.hpp"
+#include "logger.hpp"
+#include "modbus_frame.hpp"
+#include <spdlog/sinks/basic_file_sink.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace ecoWatt;
+using ecoWatt::bench::AllocationScope;
+using ecoWatt::bench::reportThroughput;
+
+namespace {
+
+const std::vector<uint8_t> kFrame = {0x11, 0x03, 0x00, 0x00, 0x00, 0x0A, 0xC6, 0x9D};
+
+} // namespace
+
+// A disabled LOG_DEBUG with a computed argument (bench_main sets the level to WARN)
+static void BM_Log_DisabledDebug(benchmark::State& state) {
+    AllocationScope allocs;
+    for (auto _ : state) {
+        LOG_DEBUG("Sending frame {}", ModbusFrame::bytesToHex(kFrame));
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_Log_DisabledDebug);
+
+// The same call as the macros used to expand it: arguments built, then filtered
+static void BM_Log_DisabledDebug_Unguarded(benchmark::State& state) {
+    AllocationScope allocs;
+    for (auto _ : state) {
+        Logger::get()->debug("Sending frame {}", ModbusFrame::bytesToHex(kFrame));
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_Log_DisabledDebug_Unguarded);
+
+// Caller-side cost of an enabled message to a file sink; Arg(0) sync, Arg(1) async.
+// Messages come in poll-cycle sized bursts; the async queue drains between
+// bursts outside the timed region, as it does between real poll cycles.
+static void BM_Log_EnabledFileSink(benchmark::State& state) {
+    constexpr int kBurst = 64;
+    auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("ecoWatt_bench_sink.log", true);
+    std::shared_ptr<spdlog::details::thread_pool> pool;  // Async loggers only hold a weak reference
+    std::shared_ptr<spdlog::logger> logger;
+    if (state.range(0) != 0) {
+        pool = std::make_shared<spdlog::details::thread_pool>(8192, 1);
+        logger = std::make_shared<spdlog::async_logger>("bench_async", sink, pool,
+                                                        spdlog::async_overflow_policy::block);
+    } else {
+        logger = std::make_shared<spdlog::logger>("bench_sync", sink);
+    }
+    logger->set_pattern("[%Y-%m-%d %H:%M:%S] [%l] %v");
+
+    for (auto _ : state) {
+        for (int i = 0; i < kBurst; ++i) {
+            logger->info("Successfully read {} registers in {}us", 10, 1234);
+        }
+
+        state.PauseTiming();
+        while (pool && pool->queue_size() > 0) {
+            std::this_thread::yield();
+        }
+        state.ResumeTiming();
+    }
+    logger->flush();
+    reportThroughput(state, kBurst);
+}
+BENCHMARK(BM_Log_EnabledFileSink)->Arg(0)->Arg(1)->UseRealTime();
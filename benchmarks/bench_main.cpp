@@ -0,0 +1,30 @@
+/**
+ * @file bench_main.cpp
+ * @brief Entry point for the EcoWatt benchmark suite
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "bench_common.hpp"
+#include "logger.hpp"
+
+int main(int argc, char** argv) {
+    // Keep logging out of the measurements; sinks and levels are benchmarked separately
+    ecoWatt::LoggingConfig logging_config;
+    logging_config.console_level = ecoWatt::LogLevel::ERROR;
+    logging_config.file_level = ecoWatt::LogLevel::WARN;
+    logging_config.log_file = "ecoWatt_bench.log";
+    ecoWatt::Logger::initialize(logging_config);
+    ecoWatt::Logger::setLevel(ecoWatt::LogLevel::WARN);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    ecoWatt::Logger::shutdown();
+    return 0;
+}
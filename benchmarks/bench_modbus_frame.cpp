@@ -0,0 +1,148 @@
+/**
+ * @file bench_modbus_frame.cpp
+ * @brief Benchmarks for Modbus frame building, parsing, CRC and hex conversion
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "bench_common.hpp"
+#include "modbus_frame.hpp"
+#include "frame_envelope.hpp"
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+using namespace ecoWatt;
+using ecoWatt::bench::AllocationScope;
+using ecoWatt::bench::reportThroughput;
+
+namespace {
+
+// Read response for N registers (slave 0x11), built once per benchmark
+std::string makeReadResponse(uint16_t num_registers) {
+    std::vector<uint8_t> frame = {0x11, 0x03, static_cast<uint8_t>(num_registers * 2)};
+    for (uint16_t i = 0; i < num_registers; ++i) {
+        frame.push_back(static_cast<uint8_t>(i >> 8));
+        frame.push_back(static_cast<uint8_t>(i & 0xFF));
+    }
+    uint16_t crc = ModbusFrame::calculateCRC(frame);
+    frame.push_back(crc & 0xFF);
+    frame.push_back((crc >> 8) & 0xFF);
+    return ModbusFrame::bytesToHex(frame);
+}
+
+} // namespace
+
+static void BM_ModbusFrame_CreateReadFrame(benchmark::State& state) {
+    AllocationScope allocs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ModbusFrame::createReadFrame(0x11, 0, 10));
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_ModbusFrame_CreateReadFrame);
+
+static void BM_ModbusFrame_CreateWriteFrame(benchmark::State& state) {
+    AllocationScope allocs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ModbusFrame::createWriteFrame(0x11, 8, 50));
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_ModbusFrame_CreateWriteFrame);
+
+static void BM_ModbusFrame_ParseReadResponse(benchmark::State& state) {
+    std::string response = makeReadResponse(static_cast<uint16_t>(state.range(0)));
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ModbusFrame::parseResponse(response));
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_ModbusFrame_ParseReadResponse)->Arg(1)->Arg(10)->Arg(125);
+
+static void BM_ModbusFrame_CalculateCRC(benchmark::State& state) {
+    std::vector<uint8_t> data(static_cast<size_t>(state.range(0)));
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 31);
+    }
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ModbusFrame::calculateCRC(data));
+    }
+    allocs.report(state);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ModbusFrame_CalculateCRC)->Arg(6)->Arg(255);
+
+static void BM_ModbusFrame_HexToBytes(benchmark::State& state) {
+    std::string hex = makeReadResponse(static_cast<uint16_t>(state.range(0)));
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ModbusFrame::hexToBytes(hex));
+    }
+    allocs.report(state);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * hex.size()));
+}
+BENCHMARK(BM_ModbusFrame_HexToBytes)->Arg(10)->Arg(125);
+
+static void BM_ModbusFrame_BytesToHex(benchmark::State& state) {
+    std::vector<uint8_t> bytes = ModbusFrame::hexToBytes(makeReadResponse(static_cast<uint16_t>(state.range(0))));
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ModbusFrame::bytesToHex(bytes));
+    }
+    allocs.report(state);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+}
+BENCHMARK(BM_ModbusFrame_BytesToHex)->Arg(10)->Arg(125);
+
+// ----------------------------------------------------------------------------
+// JSON envelope: nlohmann DOM (previous request path) vs FrameEnvelope codec
+// ----------------------------------------------------------------------------
+
+static void BM_Envelope_Dom_RoundTrip(benchmark::State& state) {
+    std::string frame = ModbusFrame::createReadFrame(0x11, 0, 10);
+    std::string body = "{\"frame\":\"" + makeReadResponse(10) + "\"}";
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        nlohmann::json payload;
+        payload["frame"] = frame;
+        std::string request = payload.dump();
+        benchmark::DoNotOptimize(request);
+
+        nlohmann::json response = nlohmann::json::parse(body);
+        std::string response_frame = response["frame"];
+        benchmark::DoNotOptimize(response_frame);
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_Envelope_Dom_RoundTrip);
+
+static void BM_Envelope_Codec_RoundTrip(benchmark::State& state) {
+    std::string frame = ModbusFrame::createReadFrame(0x11, 0, 10);
+    const std::string original_body = "{\"frame\":\"" + makeReadResponse(10) + "\"}";
+    std::string request;
+    std::string body;
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        FrameEnvelope::encodeRequest(frame, request);
+        benchmark::DoNotOptimize(request);
+
+        body.assign(original_body);
+        benchmark::DoNotOptimize(FrameEnvelope::extractFrame(body));
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_Envelope_Codec_RoundTrip);
@@ -0,0 +1,118 @@
+/**
+ * @file bench_protocol_adapter.cpp
+ * @brief ProtocolAdapter round trips against the in-process Inverter SIM
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "bench_common.hpp"
+#include "protocol_adapter.hpp"
+#include "config_manager.hpp"
+#include "inverter_sim_server.hpp"
+#include "modbus_tcp_sim_server.hpp"
+#include "modbus_tcp_transport.hpp"
+#include <memory>
+
+using namespace ecoWatt;
+using ecoWatt::bench::AllocationScope;
+using ecoWatt::bench::reportThroughput;
+
+namespace {
+
+constexpr const char* kSimBaseUrl = "http://127.0.0.1:18090";
+
+/**
+ * @brief Zero-latency, fault-free simulator shared by all adapter benchmarks
+ */
+InverterSimServer& localSim() {
+    static std::shared_ptr<InverterSimulator> simulator = std::make_shared<InverterSimulator>();
+    static std::unique_ptr<InverterSimServer> server = [] {
+        auto s = std::make_unique<InverterSimServer>(simulator, kSimBaseUrl);
+        s->start();
+        return s;
+    }();
+    return *server;
+}
+
+std::unique_ptr<ProtocolAdapter> makeAdapter() {
+    localSim();
+
+    ConfigManager config;
+
+    ModbusConfig modbus_config = config.getModbusConfig();
+    modbus_config.slave_address = 17;
+    modbus_config.max_retries = 1;
+    config.updateModbusConfig(modbus_config);
+
+    ApiConfig api_config = config.getApiConfig();
+    api_config.base_url = kSimBaseUrl;
+    config.updateApiConfig(api_config);
+
+    return std::make_unique<ProtocolAdapter>(config);
+}
+
+/**
+ * @brief Same simulator behind a native Modbus TCP front end (ephemeral port)
+ */
+ModbusTcpSimServer& localTcpSim() {
+    static std::unique_ptr<ModbusTcpSimServer> server = [] {
+        auto s = std::make_unique<ModbusTcpSimServer>(std::make_shared<InverterSimulator>());
+        s->start();
+        return s;
+    }();
+    return *server;
+}
+
+std::unique_ptr<ProtocolAdapter> makeTcpAdapter() {
+    ConfigManager config;
+
+    ModbusConfig modbus_config = config.getModbusConfig();
+    modbus_config.slave_address = 17;
+    modbus_config.max_retries = 1;
+    config.updateModbusConfig(modbus_config);
+
+    return std::make_unique<ProtocolAdapter>(config, std::make_unique<ModbusTcpTransport>(
+        "127.0.0.1", localTcpSim().port(), modbus_config.timeout));
+}
+
+} // namespace
+
+static void BM_ProtocolAdapter_ReadRegisters(benchmark::State& state) {
+    auto adapter = makeAdapter();
+    uint16_t count = static_cast<uint16_t>(state.range(0));
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(adapter->readRegisters(0, count));
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_ProtocolAdapter_ReadRegisters)->Arg(1)->Arg(10)->UseRealTime();
+
+static void BM_ProtocolAdapter_ReadRegisters_ModbusTcp(benchmark::State& state) {
+    auto adapter = makeTcpAdapter();
+    uint16_t count = static_cast<uint16_t>(state.range(0));
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(adapter->readRegisters(0, count));
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_ProtocolAdapter_ReadRegisters_ModbusTcp)->Arg(1)->Arg(10)->UseRealTime();
+
+static void BM_ProtocolAdapter_WriteRegister(benchmark::State& state) {
+    auto adapter = makeAdapter();
+    RegisterValue value = 0;
+
+    AllocationScope allocs;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(adapter->writeRegister(8, value));
+        value = static_cast<RegisterValue>((value + 1) % 101);
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_ProtocolAdapter_WriteRegister)->UseRealTime();
@@ -0,0 +1,95 @@
+/**
+ * @file bench_shm_latest_table.cpp
+ * @brief Benchmarks for the shared-memory latest-value table: publish and snapshot reads
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "bench_common.hpp"
+#include "shm_latest_publisher.hpp"
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace ecoWatt;
+using ecoWatt::bench::AllocationScope;
+using ecoWatt::bench::reportThroughput;
+
+namespace {
+
+SharedMemoryConfig benchConfig() {
+    SharedMemoryConfig config;
+    config.enabled = true;
+    config.name = "/ecowatt_bench_" + std::to_string(::getpid());
+    return config;
+}
+
+std::map<RegisterAddress, RegisterConfig> benchRegisters() {
+    std::map<RegisterAddress, RegisterConfig> registers;
+    for (RegisterAddress address = 0; address < 10; ++address) {
+        RegisterConfig config;
+        config.address = address;
+        config.name = "Register " + std::to_string(address);
+        config.unit = "V";
+        registers.emplace(address, config);
+    }
+    return registers;
+}
+
+} // namespace
+
+// Acquisition-side cost of one sample callback
+static void BM_Shm_Publish(benchmark::State& state) {
+    ShmLatestPublisher publisher(benchConfig(), benchRegisters());
+    AcquisitionSample sample(std::chrono::system_clock::now(), 3, "Register 3", 2301, 230.1, "V");
+    AllocationScope allocs;
+    for (auto _ : state) {
+        ++sample.raw_value;
+        publisher.publish(sample);
+    }
+    allocs.report(state);
+    reportThroughput(state);
+}
+BENCHMARK(BM_Shm_Publish);
+
+// Reader snapshot of one slot; Arg(1) with the publisher rewriting that slot continuously
+static void BM_Shm_Read(benchmark::State& state) {
+    auto config = benchConfig();
+    ShmLatestPublisher publisher(config, benchRegisters());
+    AcquisitionSample sample(std::chrono::system_clock::now(), 3, "Register 3", 2301, 230.1, "V");
+    publisher.publish(sample);
+    ShmLatestReader reader(config.name);
+    const int slot = reader.findSlot(3);
+
+    std::atomic<bool> stop{false};
+    std::thread writer;
+    if (state.range(0) != 0) {
+        writer = std::thread([&]() {
+            AcquisitionSample update = sample;
+            while (!stop.load(std::memory_order_relaxed)) {
+                ++update.raw_value;
+                publisher.publish(update);
+            }
+        });
+    }
+
+    ShmReading reading;
+    uint64_t retries = 0;
+    AllocationScope allocs;
+    for (auto _ : state) {
+        while (!reader.tryRead(slot, reading)) {
+            ++retries;
+        }
+        benchmark::DoNotOptimize(reading);
+    }
+    allocs.report(state);
+    stop = true;
+    if (writer.joinable()) {
+        writer.join();
+    }
+    state.counters["retries"] = benchmark::Counter(static_cast<double>(retries), benchmark::Counter::kAvgIterations);
+    reportThroughput(state);
+}
+BENCHMARK(BM_Shm_Read)->Arg(0)->Arg(1);
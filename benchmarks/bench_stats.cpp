@@ -0,0 +1,321 @@
+/**
+ * @file bench_stats.cpp
+ * @brief Implementation of benchmark result loading and comparison
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "bench_stats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+namespace ecoWatt {
+namespace bench {
+
+namespace {
+
+double toNanoseconds(double value, const std::string& unit) {
+    if (unit == "ns") return value;
+    if (unit == "us") return value * 1e3;
+    if (unit == "ms") return value * 1e6;
+    if (unit == "s") return value * 1e9;
+    throw ConfigException("Unknown benchmark time unit: " + unit);
+}
+
+/**
+ * @brief Replace the bare NaN/Infinity literals Google Benchmark writes for
+ *        degenerate aggregates (e.g. the cv of a constant counter) with null
+ */
+std::string sanitizeNonFinite(const std::string& text) {
+    static const char* const kLiterals[] = {"-Infinity", "Infinity", "-NaN", "NaN",
+                                            "-nan", "nan", "-inf", "inf"};
+    std::string out;
+    out.reserve(text.size());
+
+    bool in_string = false;
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (in_string) {
+            out.push_back(c);
+            if (c == '\\' && i + 1 < text.size()) {
+                out.push_back(text[++i]);
+            } else if (c == '"') {
+                in_string = false;
+            }
+            continue;
+        }
+
+        if (c == '"') {
+            in_string = true;
+            out.push_back(c);
+            continue;
+        }
+
+        bool replaced = false;
+        for (const char* literal : kLiterals) {
+            size_t length = std::char_traits<char>::length(literal);
+            if (text.compare(i, length, literal) == 0) {
+                out.append("null");
+                i += length - 1;
+                replaced = true;
+                break;
+            }
+        }
+        if (!replaced) {
+            out.push_back(c);
+        }
+    }
+
+    return out;
+}
+
+double median(const std::vector<double>& values) {
+    return percentile(values, 50.0);
+}
+
+LatencySummary summarize(const std::vector<double>& values) {
+    LatencySummary summary;
+    summary.p50 = percentile(values, 50.0);
+    summary.p90 = percentile(values, 90.0);
+    summary.p99 = percentile(values, 99.0);
+    return summary;
+}
+
+/**
+ * @brief Compare one metric
+ * @param higher_is_better True for throughput
+ * @param relative True to express change as a fraction of the baseline
+ */
+MetricComparison compareMetric(const std::string& metric,
+                               const std::vector<double>& baseline,
+                               const std::vector<double>& candidate,
+                               double threshold, bool higher_is_better, bool relative,
+                               const CompareThresholds& thresholds) {
+    MetricComparison result;
+    result.metric = metric;
+    result.baseline = median(baseline);
+    result.candidate = median(candidate);
+
+    double delta = result.candidate - result.baseline;
+    if (relative) {
+        result.change = (result.baseline != 0.0) ? delta / std::fabs(result.baseline) : 0.0;
+    } else {
+        result.change = delta;
+    }
+
+    bool significant = true;
+    if (relative && baseline.size() >= thresholds.min_repetitions &&
+        candidate.size() >= thresholds.min_repetitions) {
+        MannWhitneyResult test = mannWhitneyU(baseline, candidate);
+        result.utest = test.valid;
+        result.p_value = test.p_value;
+        significant = !test.valid || test.p_value < thresholds.alpha;
+    }
+
+    double worse = higher_is_better ? -result.change : result.change;
+    if (significant && worse > threshold) {
+        result.verdict = Verdict::REGRESSED;
+    } else if (significant && -worse > threshold) {
+        result.verdict = Verdict::IMPROVED;
+    }
+
+    return result;
+}
+
+} // namespace
+
+BenchmarkRun parseBenchmarkJson(const nlohmann::json& json) {
+    if (!json.is_object() || !json.contains("benchmarks") || !json["benchmarks"].is_array()) {
+        throw ConfigException("Not a Google Benchmark JSON document (missing 'benchmarks')");
+    }
+
+    BenchmarkRun run;
+
+    try {
+        for (const auto& entry : json["benchmarks"]) {
+            if (entry.value("run_type", "iteration") != "iteration") {
+                continue; // mean/median/stddev are recomputed from the repetitions
+            }
+            if (entry.contains("error_occurred") && entry["error_occurred"].get<bool>()) {
+                continue;
+            }
+
+            std::string name = entry.value("run_name", entry.value("name", ""));
+            if (name.empty()) {
+                continue;
+            }
+
+            std::string unit = entry.value("time_unit", "ns");
+            auto& samples = run[name];
+            samples.name = name;
+            samples.real_time_ns.push_back(toNanoseconds(entry.at("real_time").get<double>(), unit));
+            samples.cpu_time_ns.push_back(toNanoseconds(entry.at("cpu_time").get<double>(), unit));
+
+            if (entry.contains("items_per_second") && entry["items_per_second"].is_number()) {
+                samples.items_per_second.push_back(entry["items_per_second"].get<double>());
+            }
+            if (entry.contains("allocs_per_op") && entry["allocs_per_op"].is_number()) {
+                samples.allocs_per_op.push_back(entry["allocs_per_op"].get<double>());
+            }
+        }
+    } catch (const nlohmann::json::exception& e) {
+        throw ConfigException("Invalid benchmark entry: " + std::string(e.what()));
+    }
+
+    return run;
+}
+
+BenchmarkRun loadBenchmarkFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw ConfigException("Cannot open benchmark results: " + path);
+    }
+
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    try {
+        return parseBenchmarkJson(nlohmann::json::parse(sanitizeNonFinite(text)));
+    } catch (const nlohmann::json::parse_error& e) {
+        throw ConfigException("Failed to parse " + path + ": " + e.what());
+    }
+}
+
+MannWhitneyResult mannWhitneyU(const std::vector<double>& a, const std::vector<double>& b) {
+    MannWhitneyResult result;
+    if (a.empty() || b.empty()) {
+        return result;
+    }
+
+    const double n1 = static_cast<double>(a.size());
+    const double n2 = static_cast<double>(b.size());
+    const double n = n1 + n2;
+
+    // Rank the pooled samples, averaging ranks over ties
+    std::vector<std::pair<double, bool>> pooled; // value, from a
+    pooled.reserve(a.size() + b.size());
+    for (double v : a) pooled.emplace_back(v, true);
+    for (double v : b) pooled.emplace_back(v, false);
+    std::sort(pooled.begin(), pooled.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    double rank_sum_a = 0.0;
+    double tie_term = 0.0;
+    size_t i = 0;
+    while (i < pooled.size()) {
+        size_t j = i;
+        while (j + 1 < pooled.size() && pooled[j + 1].first == pooled[i].first) {
+            ++j;
+        }
+
+        double average_rank = (static_cast<double>(i + 1) + static_cast<double>(j + 1)) / 2.0;
+        for (size_t k = i; k <= j; ++k) {
+            if (pooled[k].second) {
+                rank_sum_a += average_rank;
+            }
+        }
+
+        double t = static_cast<double>(j - i + 1);
+        tie_term += t * t * t - t;
+        i = j + 1;
+    }
+
+    result.u = rank_sum_a - n1 * (n1 + 1.0) / 2.0;
+    result.valid = true;
+
+    double mean_u = n1 * n2 / 2.0;
+    double variance = n1 * n2 / 12.0 * ((n + 1.0) - tie_term / (n * (n - 1.0)));
+    if (variance <= 0.0) {
+        result.p_value = 1.0; // All values identical
+        return result;
+    }
+
+    double diff = std::fabs(result.u - mean_u);
+    double z = std::max(0.0, diff - 0.5) / std::sqrt(variance);
+    result.p_value = std::min(1.0, std::erfc(z / std::sqrt(2.0)));
+    return result;
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+
+    std::sort(values.begin(), values.end());
+    double position = std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(values.size() - 1);
+    size_t lower = static_cast<size_t>(std::floor(position));
+    size_t upper = std::min(lower + 1, values.size() - 1);
+    double fraction = position - static_cast<double>(lower);
+    return values[lower] + (values[upper] - values[lower]) * fraction;
+}
+
+const char* toString(Verdict verdict) {
+    switch (verdict) {
+        case Verdict::SAME: return "same";
+        case Verdict::IMPROVED: return "improved";
+        case Verdict::REGRESSED: return "REGRESSED";
+        default: return "unknown";
+    }
+}
+
+bool BenchmarkComparison::regressed() const {
+    return std::any_of(metrics.begin(), metrics.end(),
+                       [](const MetricComparison& m) { return m.verdict == Verdict::REGRESSED; });
+}
+
+bool CompareReport::regressed() const {
+    return std::any_of(benchmarks.begin(), benchmarks.end(),
+                       [](const BenchmarkComparison& b) { return b.regressed(); });
+}
+
+CompareReport compareRuns(const BenchmarkRun& baseline, const BenchmarkRun& candidate,
+                          const CompareThresholds& thresholds) {
+    CompareReport report;
+
+    for (const auto& [name, base] : baseline) {
+        auto it = candidate.find(name);
+        if (it == candidate.end()) {
+            report.only_in_baseline.push_back(name);
+            continue;
+        }
+        const BenchmarkSamples& cand = it->second;
+
+        BenchmarkComparison comparison;
+        comparison.name = name;
+        comparison.baseline_repetitions = base.real_time_ns.size();
+        comparison.candidate_repetitions = cand.real_time_ns.size();
+        comparison.baseline_latency = summarize(base.real_time_ns);
+        comparison.candidate_latency = summarize(cand.real_time_ns);
+
+        comparison.metrics.push_back(compareMetric("real_time", base.real_time_ns, cand.real_time_ns,
+                                                   thresholds.time, false, true, thresholds));
+        comparison.metrics.push_back(compareMetric("cpu_time", base.cpu_time_ns, cand.cpu_time_ns,
+                                                   thresholds.time, false, true, thresholds));
+
+        if (!base.items_per_second.empty() && !cand.items_per_second.empty()) {
+            comparison.metrics.push_back(compareMetric("items_per_second", base.items_per_second,
+                                                       cand.items_per_second, thresholds.throughput,
+                                                       true, true, thresholds));
+        }
+
+        if (!base.allocs_per_op.empty() && !cand.allocs_per_op.empty()) {
+            comparison.metrics.push_back(compareMetric("allocs_per_op", base.allocs_per_op,
+                                                       cand.allocs_per_op, thresholds.allocs,
+                                                       false, false, thresholds));
+        }
+
+        report.benchmarks.push_back(std::move(comparison));
+    }
+
+    for (const auto& [name, cand] : candidate) {
+        if (baseline.find(name) == baseline.end()) {
+            report.only_in_candidate.push_back(name);
+        }
+    }
+
+    return report;
+}
+
+} // namespace bench
+} // namespace ecoWatt
@@ -0,0 +1,131 @@
+/**
+ * @file bench_stats.hpp
+ * @brief Loading and statistical comparison of Google Benchmark JSON results
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "exceptions.hpp"
+#include <nlohmann/json.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ecoWatt {
+namespace bench {
+
+/**
+ * @brief Per-repetition measurements of one benchmark
+ */
+struct BenchmarkSamples {
+    std::string name;
+    std::vector<double> real_time_ns;
+    std::vector<double> cpu_time_ns;
+    std::vector<double> items_per_second; // Empty if the benchmark does not report it
+    std::vector<double> allocs_per_op;    // Empty if the benchmark does not report it
+};
+
+using BenchmarkRun = std::map<std::string, BenchmarkSamples>;
+
+/**
+ * @brief Collect iteration entries (aggregates are ignored) grouped by run name
+ * @throws ConfigException if the document is not Google Benchmark JSON
+ */
+BenchmarkRun parseBenchmarkJson(const nlohmann::json& json);
+
+/**
+ * @brief Read and parse a Google Benchmark JSON file
+ * @throws ConfigException if the file cannot be read or parsed
+ */
+BenchmarkRun loadBenchmarkFile(const std::string& path);
+
+/**
+ * @brief Two-sided Mann-Whitney U test (normal approximation, tie and continuity corrected)
+ */
+struct MannWhitneyResult {
+    double u = 0.0;        // U statistic of the first sample
+    double p_value = 1.0;
+    bool valid = false;    // False when either sample is empty
+};
+
+MannWhitneyResult mannWhitneyU(const std::vector<double>& a, const std::vector<double>& b);
+
+/**
+ * @brief Percentile with linear interpolation between closest ranks
+ * @param values Samples (any order)
+ * @param p Percentile in [0, 100]
+ */
+double percentile(std::vector<double> values, double p);
+
+/**
+ * @brief Regression gate configuration
+ *
+ * Time and throughput thresholds are relative changes of the median
+ * (0.05 = 5 %); the allocation threshold is absolute (allocs/op).
+ */
+struct CompareThresholds {
+    double time = 0.05;
+    double throughput = 0.05;
+    double allocs = 0.5;
+    double alpha = 0.05;          // Significance level for the U test
+    size_t min_repetitions = 5;   // Below this the U test is skipped
+};
+
+enum class Verdict {
+    SAME,
+    IMPROVED,
+    REGRESSED
+};
+
+const char* toString(Verdict verdict);
+
+struct MetricComparison {
+    std::string metric;
+    double baseline = 0.0;     // Median
+    double candidate = 0.0;    // Median
+    double change = 0.0;       // Relative for time/throughput, absolute for allocs
+    double p_value = 1.0;
+    bool utest = false;        // Whether p_value comes from a U test
+    Verdict verdict = Verdict::SAME;
+};
+
+struct LatencySummary {
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+};
+
+struct BenchmarkComparison {
+    std::string name;
+    size_t baseline_repetitions = 0;
+    size_t candidate_repetitions = 0;
+    LatencySummary baseline_latency;   // real time per iteration, ns
+    LatencySummary candidate_latency;
+    std::vector<MetricComparison> metrics;
+
+    bool regressed() const;
+};
+
+struct CompareReport {
+    std::vector<BenchmarkComparison> benchmarks; // Present in both runs
+    std::vector<std::string> only_in_baseline;
+    std::vector<std::string> only_in_candidate;
+
+    bool regressed() const;
+};
+
+/**
+ * @brief Compare two runs benchmark by benchmark
+ *
+ * A metric regresses when its median moves past the threshold in the bad
+ * direction and, if both sides have at least min_repetitions samples, the
+ * U test rejects equality at alpha. Allocation counts are deterministic and
+ * are judged on the median alone.
+ */
+CompareReport compareRuns(const BenchmarkRun& baseline, const BenchmarkRun& candidate,
+                          const CompareThresholds& thresholds);
+
+} // namespace bench
+} // namespace ecoWatt
@@ -0,0 +1,84 @@
+/**
+ * @file shm_reader_example.cpp
+ * @brief Example co-located reader of the shared-memory latest-value table
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ *
+ * Depends only on shm_latest_table.hpp; copy that header into another
+ * project to read the table the same way.
+ */
+
+#include "shm_latest_table.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --name <shm>         Segment name (default /ecowatt_latest)\n"
+              << "  --interval-ms <ms>   Print period (default 1000)\n"
+              << "  --count <n>          Stop after n prints (default: run forever)\n"
+              << "  --help               Show this message\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string name = "/ecowatt_latest";
+    long interval_ms = 1000;
+    long count = -1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--name" && i + 1 < argc) {
+            name = argv[++i];
+        } else if (arg == "--interval-ms" && i + 1 < argc) {
+            interval_ms = std::atol(argv[++i]);
+        } else if (arg == "--count" && i + 1 < argc) {
+            count = std::atol(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::unique_ptr<ecoWatt::ShmLatestReader> table;
+    for (long printed = 0; count < 0 || printed < count; ++printed) {
+        // (Re)open when the publisher is not there yet or has restarted
+        if (!table || !table->valid()) {
+            table.reset();
+            try {
+                table = std::make_unique<ecoWatt::ShmLatestReader>(name);
+            } catch (const std::exception& e) {
+                std::cerr << "Waiting for " << name << ": " << e.what() << "\n";
+                std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+                continue;
+            }
+            std::cout << name << ": " << table->slotCount() << " registers, publisher pid "
+                      << table->publisherPid() << "\n";
+        }
+
+        for (size_t slot = 0; slot < table->slotCount(); ++slot) {
+            ecoWatt::ShmReading reading;
+            if (!table->read(slot, reading)) {
+                continue;  // Publisher kept rewriting this slot; next round
+            }
+            if (reading.sequence == 0) {
+                std::printf("%5u %-20s %12s\n", table->address(slot), table->name(slot), "-");
+                continue;
+            }
+            const auto now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            std::printf("%5u %-20s %12.3f %-6s age %.1f s\n", reading.address, table->name(slot),
+                        reading.value, table->unit(slot), (now_ns - reading.timestamp_ns) / 1e9);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    }
+    return 0;
+}
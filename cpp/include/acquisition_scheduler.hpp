@@ -11,6 +11,9 @@
 #include "exceptions.hpp"
 #include "protocol_adapter.hpp"
 #include "config_manager.hpp"
+#include "latest_value_cache.hpp"
+#include "derived_metrics.hpp"
+#include "alarm_engine.hpp"
 #include <vector>
 #include <memory>
 #include <thread>
@@ -58,6 +61,15 @@ public:
      */
     bool isPolling() const { return polling_active_.load(); }
 
+    /**
+     * @brief Run one poll cycle synchronously on the calling thread
+     *
+     * Reads all configured registers, stores the samples and notifies
+     * callbacks exactly as the polling thread does. Derived metrics are
+     * then computed from the latest values and published the same way.
+     */
+    void pollOnce();
+
     /**
      * @brief Set polling interval
      * @param interval Polling interval
@@ -88,22 +100,75 @@ public:
      */
     void addErrorCallback(ErrorCallback callback);
 
+    /**
+     * @brief Add alarm callback (ignored when no alarm rules are configured)
+     * @param callback Function to call when an alarm is raised or cleared
+     */
+    void addAlarmCallback(AlarmEngine::Callback callback);
+
     /**
      * @brief Read single register manually
      * @param address Register address
+     * @param lane Transaction lane
      * @return Acquisition sample or nullptr if failed
      */
-    UniquePtr<AcquisitionSample> readSingleRegister(RegisterAddress address);
+    UniquePtr<AcquisitionSample> readSingleRegister(RegisterAddress address,
+                                                    TransactionLane lane = TransactionLane::INTERACTIVE);
 
     /**
      * @brief Read multiple registers manually
+     *
+     * One frame per register; a batching transport sends them in one round trip.
+     *
      * @param addresses List of register addresses
+     * @param lane Transaction lane
      * @return Vector of successful samples
      */
-    std::vector<AcquisitionSample> readMultipleRegisters(const std::vector<RegisterAddress>& addresses);
+    std::vector<AcquisitionSample> readMultipleRegisters(const std::vector<RegisterAddress>& addresses,
+                                                         TransactionLane lane = TransactionLane::INTERACTIVE);
 
     /**
-     * @brief Perform write operation
+     * @brief Read registers with as few block requests as possible
+     *
+     * A single request covers the whole span when every address in it is a
+     * configured register (at most 125); otherwise one request is issued per
+     * run of consecutive addresses. Failed blocks are logged and skipped.
+     */
+    std::vector<AcquisitionSample> readRegisterBlock(const std::vector<RegisterAddress>& addresses,
+                                                     TransactionLane lane = TransactionLane::INTERACTIVE);
+
+    /**
+     * @brief Latest samples, served from the cache when fresh
+     *
+     * Registers that are missing or older than their max-age are fetched
+     * live through readRegisterBlock() and cached. Fresh samples come first
+     * in request order, followed by the live ones. Derived metrics are only
+     * produced by poll cycles and are never read live.
+     */
+    std::vector<AcquisitionSample> getLatestSamples(const std::vector<RegisterAddress>& addresses);
+
+    /**
+     * @brief Default max-age for cached values without a per-register setting
+     */
+    void setCacheMaxAge(Duration max_age);
+
+    /**
+     * @brief Latest-value cache hit/miss counters
+     */
+    LatestValueCache::Statistics getCacheStatistics() const { return latest_cache_.getStatistics(); }
+
+    /**
+     * @brief Derived metrics engine (nullptr when none are configured)
+     */
+    DerivedMetricsEngine* getDerivedMetrics() const { return derived_metrics_.get(); }
+
+    /**
+     * @brief Alarm rule engine (nullptr when no rules are configured)
+     */
+    AlarmEngine* getAlarmEngine() const { return alarm_engine_.get(); }
+
+    /**
+     * @brief Perform write operation on the control lane
      * @param register_address Register address to write
      * @param value Value to write
      * @return True if successful
@@ -129,7 +194,12 @@ public:
     /**
      * @brief Get acquisition statistics
      */
-    const AcquisitionStatistics& getStatistics() const { return statistics_; }
+    AcquisitionStatistics getStatistics() const;
+
+    /**
+     * @brief Duration of poll cycles (read, store, derive) so far
+     */
+    HistogramSnapshot getCycleLatency() const { return cycle_latency_.snapshot(); }
 
     /**
      * @brief Reset statistics
@@ -153,15 +223,30 @@ private:
     void performPollCycle();
 
     /**
-     * @brief Store sample in internal buffer and notify callbacks
+     * @brief Store sample in internal buffer, run its alarm rules and notify callbacks
      */
-    void storeSample(const AcquisitionSample& sample);
+    void storeSample(const AcquisitionSample& sample,
+                     uint64_t read_epoch = LatestValueCache::kCurrentEpoch);
 
     /**
      * @brief Notify error callbacks
      */
     void notifyError(const std::string& error_message);
 
+    using RegisterConfigs = std::map<RegisterAddress, RegisterConfig>;
+
+    /**
+     * @brief Register configuration as of now; configureRegisters() replaces
+     *        the map rather than changing it, so the snapshot stays valid
+     */
+    std::shared_ptr<const RegisterConfigs> registerConfigs() const;
+
+    /**
+     * @brief Build a scaled sample from a raw register value
+     */
+    static AcquisitionSample makeSample(const RegisterConfigs& configs, RegisterAddress address,
+                                        RegisterValue value, TimePoint timestamp);
+
     /**
      * @brief Group consecutive register addresses for efficient reading
      */
@@ -170,7 +255,7 @@ private:
 
     // Dependencies
     SharedPtr<ProtocolAdapter> protocol_adapter_;
-    std::map<RegisterAddress, RegisterConfig> register_configs_;
+    std::shared_ptr<const RegisterConfigs> register_configs_;  // Guarded by buffer_mutex_
 
     // Configuration
     AcquisitionConfig config_;
@@ -181,6 +266,15 @@ private:
     std::atomic<bool> stop_requested_{false};
     UniquePtr<std::thread> polling_thread_;
 
+    // Latest value per register (fed by poll cycles and live reads)
+    LatestValueCache latest_cache_;
+
+    // Virtual registers computed after each poll cycle
+    UniquePtr<DerivedMetricsEngine> derived_metrics_;
+
+    // Alarm rules run on every stored sample, physical or derived
+    UniquePtr<AlarmEngine> alarm_engine_;
+
     // Sample storage (internal buffer)
     std::deque<AcquisitionSample> sample_buffer_;
     mutable std::mutex buffer_mutex_;
@@ -193,6 +287,7 @@ private:
 
     // Statistics
     AcquisitionStatistics statistics_;
+    LatencyHistogram cycle_latency_;
     mutable std::mutex stats_mutex_;
 };
 
@@ -0,0 +1,123 @@
+/**
+ * @file alarm_engine.hpp
+ * @brief In-process threshold/alarm rules evaluated per sample
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace ecoWatt {
+
+enum class AlarmTransition {
+    RAISED,
+    CLEARED
+};
+
+/**
+ * @brief Alarm state change; strings view into the engine's rule table
+ */
+struct AlarmEvent {
+    AlarmTransition transition;
+    std::string_view rule;
+    RegisterAddress address;
+    AlarmSeverity severity;
+    double value;       // Sample value, or rate per second for rate rules
+    double threshold;
+    TimePoint timestamp;
+};
+
+/**
+ * @brief Alarm rules compiled into a per-register dispatch table
+ *
+ * Rules are grouped by register at construction into one flat array with
+ * a CSR-style offset table indexed by address, and every rule has a
+ * preallocated state slot. evaluate() therefore costs O(rules for that
+ * register) and does not allocate.
+ *
+ * - ABOVE/BELOW compare the scaled value, RATE_ABOVE/RATE_BELOW its
+ *   change per second since the register's previous sample.
+ * - A rule raises once its condition has held for @c duration (sample
+ *   time) and clears once the value is back past threshold by
+ *   @c hysteresis.
+ *
+ * Callbacks run on the evaluating thread with the engine locked and must
+ * not call back into the engine.
+ */
+class AlarmEngine {
+public:
+    using Callback = std::function<void(const AlarmEvent&)>;
+
+    struct ActiveAlarm {
+        std::string rule;
+        RegisterAddress address;
+        AlarmSeverity severity;
+        TimePoint since;
+    };
+
+    struct Statistics {
+        uint64_t evaluated_samples = 0;
+        uint64_t raised = 0;
+        uint64_t cleared = 0;
+    };
+
+    /**
+     * @throws ConfigException for negative hysteresis or duration
+     */
+    explicit AlarmEngine(const std::vector<AlarmRuleConfig>& rules);
+
+    /**
+     * @brief Register a callback for alarm events (before evaluation starts)
+     */
+    void addCallback(Callback callback);
+
+    /**
+     * @brief Run the rules of the sample's register
+     */
+    void evaluate(const AcquisitionSample& sample);
+
+    std::vector<ActiveAlarm> getActiveAlarms() const;
+    Statistics getStatistics() const;
+    size_t ruleCount() const { return rules_.size(); }
+
+private:
+    struct Rule {
+        AlarmRuleConfig config;
+        double clear_threshold;
+
+        // State slot
+        bool active = false;
+        bool pending = false;
+        TimePoint pending_since;
+        TimePoint active_since;
+    };
+
+    struct RateState {
+        bool has_previous = false;
+        double previous = 0.0;
+        TimePoint previous_time;
+    };
+
+    void emit(const Rule& rule, AlarmTransition transition, double value, TimePoint timestamp);
+
+    std::vector<Rule> rules_;                // Grouped by register
+    std::vector<uint32_t> offsets_;          // rules_[offsets_[a]..offsets_[a + 1]) belong to register a
+    std::vector<int32_t> rate_slot_;         // Per register, -1 without rate rules
+    std::vector<RateState> rate_states_;
+    std::vector<Callback> callbacks_;
+
+    mutable std::mutex mutex_;
+
+    std::atomic<uint64_t> evaluated_samples_{0};
+    std::atomic<uint64_t> raised_{0};
+    std::atomic<uint64_t> cleared_{0};
+};
+
+} // namespace ecoWatt
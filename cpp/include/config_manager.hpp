@@ -53,6 +53,36 @@ public:
      */
     const LoggingConfig& getLoggingConfig() const { return logging_config_; }
 
+    /**
+     * @brief Get tracing configuration
+     */
+    const TracingConfig& getTracingConfig() const { return tracing_config_; }
+
+    /**
+     * @brief Get metrics endpoint configuration
+     */
+    const MetricsConfig& getMetricsConfig() const { return metrics_config_; }
+
+    /**
+     * @brief Get REST query API configuration
+     */
+    const QueryApiConfig& getQueryApiConfig() const { return query_api_config_; }
+
+    /**
+     * @brief Get live sample stream configuration
+     */
+    const StreamConfig& getStreamConfig() const { return stream_config_; }
+
+    /**
+     * @brief Get shared-memory latest-value table configuration
+     */
+    const SharedMemoryConfig& getSharedMemoryConfig() const { return shared_memory_config_; }
+
+    /**
+     * @brief Get store-and-forward uplink configuration
+     */
+    const UplinkConfig& getUplinkConfig() const { return uplink_config_; }
+
     /**
      * @brief Get register configurations
      */
@@ -67,6 +97,20 @@ public:
      */
     const RegisterConfig& getRegisterConfig(RegisterAddress address) const;
 
+    /**
+     * @brief Get derived metric (virtual register) configurations, by address
+     */
+    const std::vector<DerivedMetricConfig>& getDerivedMetricConfigs() const {
+        return derived_metric_configs_;
+    }
+
+    /**
+     * @brief Get alarm rule configurations
+     */
+    const std::vector<AlarmRuleConfig>& getAlarmRuleConfigs() const {
+        return alarm_rule_configs_;
+    }
+
     /**
      * @brief Check if register exists
      * @param address Register address
@@ -89,9 +133,17 @@ public:
     /**
      * @brief Update configuration at runtime
      */
+    void updateModbusConfig(const ModbusConfig& config);
+    void updateApiConfig(const ApiConfig& config);
     void updateAcquisitionConfig(const AcquisitionConfig& config);
     void updateStorageConfig(const StorageConfig& config);
     void updateLoggingConfig(const LoggingConfig& config);
+    void updateTracingConfig(const TracingConfig& config);
+    void updateMetricsConfig(const MetricsConfig& config);
+    void updateQueryApiConfig(const QueryApiConfig& config);
+    void updateStreamConfig(const StreamConfig& config);
+    void updateSharedMemoryConfig(const SharedMemoryConfig& config);
+    void updateUplinkConfig(const UplinkConfig& config);
 
     /**
      * @brief Add or update register configuration
@@ -103,6 +155,16 @@ public:
      */
     void removeRegisterConfig(RegisterAddress address);
 
+    /**
+     * @brief Replace derived metric configurations
+     */
+    void setDerivedMetricConfigs(const std::vector<DerivedMetricConfig>& configs);
+
+    /**
+     * @brief Replace alarm rule configurations
+     */
+    void setAlarmRuleConfigs(const std::vector<AlarmRuleConfig>& configs);
+
     /**
      * @brief Validate configuration consistency
      * @throws ConfigException if configuration is invalid
@@ -122,6 +184,8 @@ private:
     void loadEnvironmentVariables(const std::string& env_file);
     void loadJsonConfiguration(const std::string& config_file);
     void parseRegisterConfigs(const nlohmann::json& json);
+    void parseDerivedMetricConfigs(const nlohmann::json& json);
+    void parseAlarmRuleConfigs(const nlohmann::json& json);
     
     // Configuration sections
     ModbusConfig modbus_config_;
@@ -129,9 +193,17 @@ private:
     StorageConfig storage_config_;
     ApiConfig api_config_;
     LoggingConfig logging_config_;
+    TracingConfig tracing_config_;
+    MetricsConfig metrics_config_;
+    QueryApiConfig query_api_config_;
+    StreamConfig stream_config_;
+    SharedMemoryConfig shared_memory_config_;
+    UplinkConfig uplink_config_;
     
     // Register configurations
     std::map<RegisterAddress, RegisterConfig> register_configs_;
+    std::vector<DerivedMetricConfig> derived_metric_configs_;
+    std::vector<AlarmRuleConfig> alarm_rule_configs_;
     
     // Application information
     std::string app_name_;
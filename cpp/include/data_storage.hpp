@@ -10,15 +10,40 @@
 #include "types.hpp"
 #include "exceptions.hpp"
 #include "config_manager.hpp"
+#include "sample_filter.hpp"
+#include "memory_snapshot.hpp"
 #include <vector>
 #include <memory>
 #include <mutex>
 #include <map>
 #include <deque>
+#include <optional>
+#include <atomic>
+#include <thread>
 #include <sqlite3.h>
 
 namespace ecoWatt {
 
+/**
+ * @brief One time bucket of a downsampled history query (raw register units)
+ */
+struct HistoryBucket {
+    TimePoint start;
+    double mean = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    uint64_t count = 0;  // Stored rows; 0 when only carried or interpolated values cover it
+};
+
+/**
+ * @brief How a history query fills the time between persisted rows
+ */
+enum class HistoryFill {
+    NONE,    // Unfiltered: plain average of the rows in each bucket
+    HOLD,    // Deadband/heartbeat: each row's value holds until the next row
+    LINEAR   // Swinging door: linear between consecutive rows
+};
+
 /**
  * @brief Memory-based data storage for fast access
  */
@@ -27,8 +52,13 @@ public:
     /**
      * @brief Constructor
      * @param max_samples_per_register Maximum samples to keep per register
+     * @param snapshot_path Mirror the rings into this file and start from its
+     *        contents (see MemorySnapshotFile); empty keeps them in memory only
+     * @param snapshot_max_registers Registers the snapshot file has room for
      */
-    explicit MemoryDataStorage(size_t max_samples_per_register = 1000);
+    explicit MemoryDataStorage(size_t max_samples_per_register = 1000,
+                               const std::string& snapshot_path = "",
+                               uint32_t snapshot_max_registers = 64);
 
     /**
      * @brief Store single sample
@@ -76,10 +106,16 @@ public:
      */
     StorageStatistics getStatistics() const;
 
+    /**
+     * @brief Snapshot file statistics (nullopt without a snapshot)
+     */
+    std::optional<MemorySnapshotFile::Statistics> getSnapshotStatistics() const;
+
 private:
     mutable std::mutex mutex_;
     size_t max_samples_per_register_;
     std::map<RegisterAddress, std::deque<AcquisitionSample>> samples_by_register_;
+    UniquePtr<MemorySnapshotFile> snapshot_;
 };
 
 /**
@@ -116,11 +152,53 @@ public:
 
     /**
      * @brief Get samples within time range
+     *
+     * Rows are what HybridDataStorage persisted after SampleFilter, see
+     * HybridDataStorage::getHistoricalSamples for how to reconstruct them.
      */
     std::vector<AcquisitionSample> getSamplesByTimeRange(RegisterAddress register_address,
                                                         const TimePoint& start_time,
                                                         const TimePoint& end_time) const;
 
+    /**
+     * @brief Rows in [start_time, end_time] averaged per @p resolution bucket, oldest first
+     *
+     * With HistoryFill::HOLD or LINEAR the series is reconstructed from the
+     * last row before start_time onwards and the mean is weighted by time,
+     * so buckets without rows are still covered. HOLD carries each row until
+     * the next one and the newest for at most @p max_hold (0: until
+     * end_time); LINEAR ends at the newest row, whose segment the filter
+     * has not closed yet.
+     *
+     * Runs on a separate read-only connection; with the database in WAL mode
+     * it neither waits for nor delays storeSample().
+     */
+    std::vector<HistoryBucket> getAggregatedSamples(RegisterAddress register_address,
+                                                    const TimePoint& start_time,
+                                                    const TimePoint& end_time,
+                                                    Duration resolution,
+                                                    HistoryFill fill = HistoryFill::NONE,
+                                                    Duration max_hold = Duration(0)) const;
+
+    /**
+     * @brief Up to @p limit rows with id greater than @p after_id, in id order
+     *
+     * Ids grow with insertion, so a consumer that remembers the last id it
+     * processed sees every row exactly once. Runs on the read-only connection.
+     */
+    std::vector<StoredSample> getSamplesAfter(uint64_t after_id, size_t limit) const;
+
+    /**
+     * @brief Id of the newest row (0 when empty)
+     */
+    uint64_t getLastSampleId() const;
+
+    /**
+     * @brief Persistent named position of a getSamplesAfter consumer (0 if unset)
+     */
+    uint64_t loadCursor(const std::string& name) const;
+    void saveCursor(const std::string& name, uint64_t id);
+
     /**
      * @brief Store register configurations
      */
@@ -153,6 +231,11 @@ private:
     std::string db_path_;
     sqlite3* db_;
     mutable std::mutex mutex_;
+
+    // Read-only connection for queries that must not hold up writers
+    // (nullptr for in-memory databases, which then share db_)
+    sqlite3* read_db_ = nullptr;
+    mutable std::mutex read_mutex_;
 };
 
 /**
@@ -172,7 +255,8 @@ public:
     ~HybridDataStorage();
 
     /**
-     * @brief Store single sample in both memory and persistent storage
+     * @brief Store single sample in memory and, if it passes the register's
+     *        deadband/compression filter, in persistent storage
      */
     void storeSample(const AcquisitionSample& sample);
 
@@ -189,11 +273,41 @@ public:
 
     /**
      * @brief Get historical samples from persistent storage
+     *
+     * Registers with storage filtering only have the rows that passed it:
+     * - Deadband: hold each row's value until the next row; every dropped
+     *   sample was within the band of it.
+     * - Swinging door: interpolate linearly between consecutive rows; every
+     *   dropped sample was within the band of that line. The newest segment
+     *   is only closed by the next stored row or flushFilters().
+     * - Heartbeat: consecutive rows are at most max_interval plus one poll
+     *   period apart while acquisition runs.
+     * The memory ring (getRecentSamples) is not filtered.
      */
     std::vector<AcquisitionSample> getHistoricalSamples(RegisterAddress register_address,
                                                        const TimePoint& start_time,
                                                        const TimePoint& end_time) const;
 
+    /**
+     * @brief Persisted rows downsampled to @p resolution buckets (see
+     *        SQLiteDataStorage::getAggregatedSamples)
+     */
+    std::vector<HistoryBucket> getAggregatedSamples(RegisterAddress register_address,
+                                                    const TimePoint& start_time,
+                                                    const TimePoint& end_time,
+                                                    Duration resolution,
+                                                    HistoryFill fill = HistoryFill::NONE,
+                                                    Duration max_hold = Duration(0)) const;
+
+    /**
+     * @brief Persisted rows after a cursor, newest id and named cursors (see
+     *        SQLiteDataStorage::getSamplesAfter)
+     */
+    std::vector<StoredSample> getSamplesAfter(uint64_t after_id, size_t limit) const;
+    uint64_t getLastSampleId() const;
+    uint64_t loadCursor(const std::string& name) const;
+    void saveCursor(const std::string& name, uint64_t id);
+
     /**
      * @brief Get latest sample from memory
      */
@@ -209,6 +323,18 @@ public:
      */
     void storeRegisterConfigs(const std::map<RegisterAddress, RegisterConfig>& configs);
 
+    /**
+     * @brief Apply per-register deadband, compression and heartbeat settings
+     */
+    void configureFilters(const std::map<RegisterAddress, RegisterConfig>& configs);
+
+    /**
+     * @brief Persist samples held back by swinging-door compression
+     *
+     * Called by the destructor; call earlier to close the newest segments.
+     */
+    void flushFilters();
+
     /**
      * @brief Export data to file
      */
@@ -231,11 +357,21 @@ public:
     struct CombinedStatistics {
         StorageStatistics memory_stats;
         StorageStatistics persistent_stats;
+        SampleFilter::Statistics filter_stats;
         uint64_t total_storage_bytes;
     };
     
     CombinedStatistics getCombinedStatistics() const;
 
+    /**
+     * @brief Memory-tier and filter statistics only (no SQLite queries)
+     */
+    StorageStatistics getMemoryStatistics() const { return memory_storage_->getStatistics(); }
+    SampleFilter::Statistics getFilterStatistics() const { return sample_filter_.getStatistics(); }
+    std::optional<MemorySnapshotFile::Statistics> getSnapshotStatistics() const {
+        return memory_storage_->getSnapshotStatistics();
+    }
+
     /**
      * @brief Start background cleanup task
      */
@@ -252,6 +388,7 @@ private:
     StorageConfig config_;
     UniquePtr<MemoryDataStorage> memory_storage_;
     UniquePtr<SQLiteDataStorage> sqlite_storage_;
+    SampleFilter sample_filter_;
     
     // Background cleanup
     std::atomic<bool> cleanup_active_{false};
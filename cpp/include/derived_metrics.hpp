@@ -0,0 +1,116 @@
+/**
+ * @file derived_metrics.hpp
+ * @brief Derived metrics evaluated incrementally at ingest
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace ecoWatt {
+
+/**
+ * @brief Computes virtual registers from the latest register values
+ *
+ * Expressions use register names or r<address> (physical or derived),
+ * numbers, + - * /, parentheses and abs(), sqrt(), min(a, b), max(a, b),
+ * all on scaled values. They are compiled once into postfix code.
+ *
+ * evaluate() is called with each poll cycle's samples. Metrics are computed
+ * in dependency order over that cycle's values only; a metric with an input
+ * missing from the cycle (a failed read, or a metric skipped itself), or
+ * whose result is not finite, is skipped for that cycle. Integrating
+ * metrics accumulate their expression with the trapezoidal rule between
+ * the cycles they are computed in, in value-hours times scale.
+ *
+ * A derived sample's raw_value is llround(value * gain) as a signed 64-bit
+ * SampleRawValue, so energy counters do not wrap at a register's 16 bits
+ * and net flows such as export power keep their sign. Values beyond the
+ * type's range saturate; those samples are counted and logged.
+ */
+class DerivedMetricsEngine {
+public:
+    /**
+     * @brief Compile the metric expressions
+     * @throws ConfigException on syntax errors, unknown references, cycles,
+     *         addresses that clash with physical registers or a gain that
+     *         is not positive
+     */
+    DerivedMetricsEngine(const std::vector<DerivedMetricConfig>& metrics,
+                         const std::map<RegisterAddress, RegisterConfig>& registers);
+
+    /**
+     * @brief Fold in one cycle's samples and compute the derived metrics
+     * @return One sample per computed metric, timestamped with the newest input
+     */
+    std::vector<AcquisitionSample> evaluate(const std::vector<AcquisitionSample>& samples);
+
+    /**
+     * @brief Whether @p address is a derived (virtual) register
+     */
+    bool isDerived(RegisterAddress address) const;
+
+    /**
+     * @brief Current value of an integrating metric
+     */
+    std::optional<double> getIntegral(RegisterAddress address) const;
+
+    /**
+     * @brief Continue an integrating metric from a previously published total
+     */
+    void restoreIntegral(RegisterAddress address, double total);
+
+    /**
+     * @brief Samples whose raw_value saturated at the SampleRawValue limits, over all metrics
+     */
+    uint64_t getClampedCount() const;
+
+    const std::vector<DerivedMetricConfig>& getMetrics() const { return metrics_; }
+
+private:
+    enum class Op : uint8_t { CONST, LOAD, ADD, SUB, MUL, DIV, NEG, ABS, SQRT, MIN, MAX };
+
+    struct Instruction {
+        Op op;
+        double value = 0.0;  // CONST
+        size_t slot = 0;     // LOAD
+    };
+
+    struct Metric {
+        DerivedMetricConfig config;
+        std::vector<Instruction> code;
+        std::vector<size_t> inputs;  // Slots read by code
+        size_t slot = 0;
+
+        // Integration state
+        bool has_previous = false;
+        double previous = 0.0;
+        TimePoint previous_time;
+        double total = 0.0;
+
+        uint64_t clamped = 0;  // Samples whose raw_value saturated
+    };
+
+    class Compiler;
+
+    double run(const std::vector<Instruction>& code);
+    size_t slotFor(RegisterAddress address);
+    void orderMetrics();
+
+    std::vector<DerivedMetricConfig> metrics_;
+    std::vector<Metric> compiled_;             // In evaluation order
+    std::map<RegisterAddress, size_t> slots_;  // Address -> index into values_
+    std::vector<double> values_;
+    std::vector<char> present_;
+    std::vector<double> stack_;
+
+    mutable std::mutex mutex_;
+};
+
+} // namespace ecoWatt
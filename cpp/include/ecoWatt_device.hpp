@@ -13,6 +13,12 @@
 #include "protocol_adapter.hpp"
 #include "acquisition_scheduler.hpp"
 #include "data_storage.hpp"
+#include "setpoint_writer.hpp"
+#include "metrics_exporter.hpp"
+#include "query_api_server.hpp"
+#include "sample_stream.hpp"
+#include "shm_latest_publisher.hpp"
+#include "uplink.hpp"
 #include <memory>
 #include <string>
 #include <map>
@@ -27,6 +33,7 @@ struct SystemStatus {
     AcquisitionStatistics acquisition_stats;
     StorageStatistics storage_stats;
     AcquisitionConfig acquisition_config;
+    SetpointWriter::Statistics setpoint_stats;
     TimePoint status_timestamp;
 };
 
@@ -37,7 +44,7 @@ struct ReadingData {
     double scaled_value;
     std::string unit;
     TimePoint timestamp;
-    RegisterValue raw_value;
+    SampleRawValue raw_value;
 };
 
 /**
@@ -78,15 +85,24 @@ public:
 
     /**
      * @brief Get current readings from all monitored registers
+     *
+     * Served from the latest-value cache; only registers older than their
+     * max-age are read live, in a single block request where possible.
      */
     std::map<std::string, ReadingData> getCurrentReadings() const;
 
     /**
      * @brief Set export power percentage
+     *
+     * Goes through the setpoint writer: rapid successive calls coalesce to
+     * the latest value, writes are spaced by setpoint_min_interval and a
+     * value equal to the last confirmed one is not sent again.
+     *
      * @param percentage Export power percentage (0-100)
-     * @return True if successful
+     * @param wait_for_write Block until the write is applied, skipped or superseded
+     * @return True unless the value is invalid or the write failed
      */
-    bool setExportPower(uint8_t percentage);
+    bool setExportPower(uint8_t percentage, bool wait_for_write = true);
 
     /**
      * @brief Get historical data for a register
@@ -149,6 +165,13 @@ public:
      */
     const std::map<RegisterAddress, RegisterConfig>& getAllRegisterConfigs() const;
 
+    /**
+     * @brief Write the recorded trace spans as Chrome trace-event JSON
+     * @param path Output file (empty = tracing.output from the configuration)
+     * @return False when the file cannot be written
+     */
+    bool dumpTrace(const std::string& path = "") const;
+
 private:
     /**
      * @brief Initialize all components
@@ -160,6 +183,27 @@ private:
      */
     void setupCallbacks();
 
+    /**
+     * @brief Register the acquisition, communication, queue and storage
+     *        collectors with the metrics endpoint
+     */
+    void registerMetricCollectors();
+
+    /**
+     * @brief Physical and derived registers, as served to local consumers
+     */
+    std::map<RegisterAddress, RegisterConfig> publishedRegisterConfigs() const;
+
+    /**
+     * @brief Create the REST query API with register metadata and a statistics provider
+     */
+    void createQueryApi();
+
+    /**
+     * @brief Status counters served by /api/v1/statistics
+     */
+    nlohmann::json statisticsJson() const;
+
     /**
      * @brief Sample callback for data storage
      */
@@ -170,6 +214,11 @@ private:
      */
     void onAcquisitionError(const std::string& error_message);
 
+    /**
+     * @brief Alarm callback for logging
+     */
+    void onAlarm(const AlarmEvent& event);
+
     /**
      * @brief Convert acquisition sample to reading data
      */
@@ -182,6 +231,12 @@ private:
     SharedPtr<ProtocolAdapter> protocol_adapter_;
     SharedPtr<AcquisitionScheduler> acquisition_scheduler_;
     SharedPtr<HybridDataStorage> data_storage_;
+    UniquePtr<SetpointWriter> setpoint_writer_;
+    UniquePtr<MetricsExporter> metrics_exporter_;
+    UniquePtr<QueryApiServer> query_api_;
+    UniquePtr<SampleStreamServer> stream_server_;
+    UniquePtr<ShmLatestPublisher> shm_publisher_;
+    UniquePtr<UplinkForwarder> uplink_;
     
     // State
     std::atomic<bool> is_running_{false};
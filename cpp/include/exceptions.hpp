@@ -45,6 +45,15 @@ public:
         : EcoWattException("HTTP Error (" + std::to_string(response_code) + "): " + message) {}
 };
 
+/**
+ * @brief Exception for transport (socket/serial link) errors
+ */
+class TransportException : public EcoWattException {
+public:
+    explicit TransportException(const std::string& message)
+        : EcoWattException("Transport Error: " + message) {}
+};
+
 /**
  * @brief Exception for configuration errors
  */
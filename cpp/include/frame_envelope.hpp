@@ -0,0 +1,84 @@
+/**
+ * @file frame_envelope.hpp
+ * @brief JSON envelope codec for Modbus frames on the HTTP API
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "exceptions.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ecoWatt {
+
+/**
+ * @brief Encodes and decodes the {"frame":"<hex>"} envelope used by the Inverter SIM API
+ *
+ * Requests are written from a fixed template and responses are decoded by a
+ * single-pass scanner that returns a view into the response body. The
+ * nlohmann::json DOM is only used when the body has an unexpected shape
+ * (escaped strings, non-string frame, malformed JSON).
+ *
+ * Gateways that support it also accept a batch envelope,
+ * {"frames":["<hex>", ...]}, answered by {"frames":[...]} with one entry per
+ * request frame in the same order; an empty entry means that frame got no
+ * response.
+ */
+class FrameEnvelope {
+public:
+    /**
+     * @brief Build request body for a hex frame
+     * @param frame_hex Modbus frame as hex string
+     * @param out Output buffer (cleared, capacity reused)
+     */
+    static void encodeRequest(std::string_view frame_hex, std::string& out);
+
+    /**
+     * @brief Build request body for a hex frame
+     */
+    static std::string encodeRequest(std::string_view frame_hex);
+
+    /**
+     * @brief Extract the "frame" field from a response body
+     *
+     * Uses the fast scanner and falls back to a full JSON parse. When the
+     * fallback runs, the extracted value is stored back into @p body so the
+     * returned view always points into @p body.
+     *
+     * @param body Response body (may be replaced by the fallback)
+     * @return View of the frame hex string
+     * @throws HttpException if the body is not JSON or has no non-empty frame
+     */
+    static std::string_view extractFrame(std::string& body);
+
+    /**
+     * @brief Single-pass scanner for the "frame" field
+     * @param body Response body
+     * @param frame Set to a view into @p body on success
+     * @return False if the body shape needs the full JSON parser
+     */
+    static bool scanFrame(std::string_view body, std::string_view& frame);
+
+    /**
+     * @brief Build batch request body for several hex frames
+     * @param frames_hex Modbus frames as hex strings
+     * @param out Output buffer (cleared, capacity reused)
+     */
+    static void encodeBatchRequest(const std::vector<std::string>& frames_hex, std::string& out);
+
+    /**
+     * @brief Extract the "frames" array from a batch response body
+     * @return One hex string per entry (empty for unanswered frames)
+     * @throws HttpException if the body is not JSON or has no "frames" array
+     *         of strings
+     */
+    static std::vector<std::string> extractFrames(const std::string& body);
+
+private:
+    static bool needsEscaping(std::string_view value);
+};
+
+} // namespace ecoWatt
@@ -14,6 +14,7 @@
 #include <cpprest/http_client.h>
 #include <cpprest/filestream.h>
 #include <mutex>
+#include <vector>
 
 namespace ecoWatt {
 
@@ -57,6 +58,20 @@ public:
                      const std::string& data,
                      const std::map<std::string, std::string>& headers = {});
 
+    /**
+     * @brief Perform POST request with a binary body
+     * @param endpoint API endpoint
+     * @param body Request body bytes
+     * @param content_type Content-Type of @p body
+     * @param headers Additional headers (e.g. Content-Encoding)
+     * @return HTTP response
+     * @throws HttpException on error
+     */
+    HttpResponse postBytes(const std::string& endpoint,
+                          const std::vector<uint8_t>& body,
+                          const std::string& content_type,
+                          const std::map<std::string, std::string>& headers = {});
+
     /**
      * @brief Perform GET request
      * @param endpoint API endpoint
@@ -0,0 +1,49 @@
+/**
+ * @file http_transport.hpp
+ * @brief Inverter SIM HTTP transport (hex frames in a JSON envelope)
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "transport.hpp"
+#include "http_client.hpp"
+
+namespace ecoWatt {
+
+/**
+ * @brief POSTs {"frame":"<hex>"} to the read or write endpoint
+ *
+ * With ApiConfig::enable_batch the gateway is probed once at construction
+ * with an empty {"frames":[]} batch; if it answers with a frames array,
+ * transactBatch() sends up to batch_max_frames frames per POST to the batch
+ * endpoint.
+ */
+class HttpTransport : public Transport {
+public:
+    HttpTransport(const ApiConfig& api_config, Duration timeout);
+
+    std::vector<uint8_t> transact(const std::vector<uint8_t>& request,
+                                  TransportOperation operation) override;
+
+    std::vector<std::vector<uint8_t>> transactBatch(const std::vector<std::vector<uint8_t>>& requests,
+                                                    TransportOperation operation) override;
+
+    bool supportsBatch() const override { return batch_supported_; }
+    size_t maxBatchSize() const override { return api_config_.batch_max_frames; }
+
+    std::string describe() const override { return api_config_.base_url; }
+
+private:
+    /**
+     * @brief Ask the gateway whether it serves the batch endpoint
+     */
+    bool probeBatchSupport();
+
+    ApiConfig api_config_;
+    UniquePtr<HttpClient> http_client_;
+    bool batch_supported_ = false;
+};
+
+} // namespace ecoWatt
@@ -0,0 +1,83 @@
+/**
+ * @file inverter_sim_server.hpp
+ * @brief HTTP front end for the local Inverter SIM
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "inverter_simulator.hpp"
+#include "types.hpp"
+#include <cpprest/http_listener.h>
+#include <memory>
+#include <string>
+
+namespace ecoWatt {
+
+/**
+ * @brief Serves /api/inverter/read and /api/inverter/write with the same
+ *        {"frame":"<hex>"} envelope as the remote Inverter SIM
+ *
+ * Intended for tests and benchmarks, which start it in-process and point
+ * ApiConfig::base_url at baseUrl(). Each request is delayed by a sample
+ * from the simulator's latency profile. Dropped or invalid frames are held
+ * for SimFaultProfile::drop_hold and answered with an empty frame, the way
+ * the remote SIM reports an unresponsive slave.
+ *
+ * ApiConfig::batch_endpoint (when non-empty) accepts {"frames":[...]} and
+ * answers every frame in one response after a single latency sample, with
+ * an empty entry for each dropped or invalid frame.
+ */
+class InverterSimServer {
+public:
+    /**
+     * @brief Constructor
+     * @param simulator Register model shared with the caller
+     * @param base_url Listen address, e.g. "http://127.0.0.1:18080"
+     * @param api_key Expected Authorization header (empty disables the check)
+     * @param api_config Endpoint paths to serve
+     */
+    InverterSimServer(std::shared_ptr<InverterSimulator> simulator,
+                      const std::string& base_url = "http://127.0.0.1:18080",
+                      const std::string& api_key = "",
+                      const ApiConfig& api_config = ApiConfig{});
+
+    ~InverterSimServer();
+
+    // Non-copyable
+    InverterSimServer(const InverterSimServer&) = delete;
+    InverterSimServer& operator=(const InverterSimServer&) = delete;
+
+    /**
+     * @brief Open the listener
+     * @throws HttpException if the address cannot be bound
+     */
+    void start();
+
+    /**
+     * @brief Close the listener (idempotent)
+     */
+    void stop();
+
+    bool isRunning() const { return running_; }
+    const std::string& baseUrl() const { return base_url_; }
+    InverterSimulator& simulator() { return *simulator_; }
+
+private:
+    void handlePost(web::http::http_request request);
+    void replyFrame(const web::http::http_request& request, const std::string& frame_hex);
+    void handleBatch(const web::http::http_request& request, const std::string& body);
+
+    std::shared_ptr<InverterSimulator> simulator_;
+    std::string base_url_;
+    std::string api_key_;
+    std::string read_endpoint_;
+    std::string write_endpoint_;
+    std::string batch_endpoint_;
+
+    std::unique_ptr<web::http::experimental::listener::http_listener> listener_;
+    bool running_ = false;
+};
+
+} // namespace ecoWatt
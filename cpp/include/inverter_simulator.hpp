@@ -0,0 +1,195 @@
+/**
+ * @file inverter_simulator.hpp
+ * @brief Local Inverter SIM stand-in: register model and Modbus frame processing
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include "exceptions.hpp"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace ecoWatt {
+
+/**
+ * @brief How a simulated register value evolves over time
+ */
+enum class RegisterDynamics {
+    CONSTANT,     // Always returns base (or the last written value)
+    SINE,         // base + amplitude * sin(2*pi*t / period)
+    RANDOM_WALK,  // Moves up to +/- step per read, clamped to [min, max]
+    RAMP          // base + step * t (seconds), wrapping within [min, max]
+};
+
+/**
+ * @brief Model for one simulated holding register
+ */
+struct SimRegisterModel {
+    RegisterValue base = 0;
+    RegisterDynamics dynamics = RegisterDynamics::CONSTANT;
+    double amplitude = 0.0;
+    double period_s = 60.0;
+    double step = 1.0;
+    RegisterValue min_value = 0;
+    RegisterValue max_value = 0xFFFF;
+    bool writable = false;
+};
+
+/**
+ * @brief Distribution used to delay responses
+ */
+enum class LatencyDistribution {
+    NONE,
+    FIXED,
+    UNIFORM,
+    NORMAL,
+    LOG_NORMAL
+};
+
+struct SimLatencyProfile {
+    LatencyDistribution distribution = LatencyDistribution::NONE;
+    std::chrono::microseconds mean{0};
+    std::chrono::microseconds stddev{0};
+    std::chrono::microseconds min{0};
+    std::chrono::microseconds max{std::chrono::seconds(10)};
+};
+
+/**
+ * @brief Fault injection rates (probabilities in [0, 1])
+ */
+struct SimFaultProfile {
+    double exception_rate = 0.0;   // Reply with a Modbus exception frame
+    uint8_t exception_code = 0x04; // Slave Device Failure
+    double crc_error_rate = 0.0;   // Reply with a corrupted CRC
+    double drop_rate = 0.0;        // Do not reply at all
+    Duration drop_hold = Duration(0); // How long a front end holds a dropped request
+};
+
+/**
+ * @brief Complete simulator configuration
+ */
+struct InverterSimConfig {
+    SlaveAddress slave_address = 17;
+    uint32_t seed = 0x5EED;
+    std::map<RegisterAddress, SimRegisterModel> registers;
+    SimLatencyProfile latency;
+    SimFaultProfile faults;
+
+    /**
+     * @brief EcoWatt register map (0-9) with plausible dynamics
+     */
+    static InverterSimConfig defaults();
+
+    /**
+     * @brief Build configuration from JSON, starting from defaults()
+     * @throws ConfigException on invalid values
+     */
+    static InverterSimConfig fromJson(const nlohmann::json& json);
+};
+
+/**
+ * @brief Transport-independent Inverter SIM: turns Modbus RTU request frames
+ *        into response frames using the configured register model and faults
+ *
+ * Thread-safe; front ends (HTTP, TCP, serial) call processFrame concurrently.
+ */
+class InverterSimulator {
+public:
+    /**
+     * @brief Counters for what the simulator did
+     */
+    struct Statistics {
+        uint64_t requests = 0;
+        uint64_t replies = 0;
+        uint64_t invalid_frames = 0;
+        uint64_t exceptions_injected = 0;
+        uint64_t crc_errors_injected = 0;
+        uint64_t drops = 0;
+    };
+
+    explicit InverterSimulator(InverterSimConfig config = InverterSimConfig::defaults());
+
+    /**
+     * @brief Process one request frame (RTU bytes including CRC)
+     * @return Response frame, or std::nullopt when the request is dropped
+     *         or invalid (wrong slave, bad CRC, truncated)
+     */
+    std::optional<std::vector<uint8_t>> processFrame(const std::vector<uint8_t>& request);
+
+    /**
+     * @brief Draw a response delay from the latency profile
+     */
+    std::chrono::microseconds sampleLatency();
+
+    /**
+     * @brief Direct register access (bypasses fault injection)
+     */
+    RegisterValue readRegister(RegisterAddress address);
+    void setRegister(RegisterAddress address, RegisterValue value);
+
+    /**
+     * @brief Runtime reconfiguration
+     */
+    void setLatencyProfile(const SimLatencyProfile& profile);
+    void setFaultProfile(const SimFaultProfile& profile);
+    SimFaultProfile getFaultProfile() const;
+
+    SlaveAddress slaveAddress() const { return slave_address_; }
+
+    Statistics getStatistics() const;
+    void resetStatistics();
+
+private:
+    std::vector<uint8_t> handleRead(SlaveAddress slave, const std::vector<uint8_t>& request);
+    std::vector<uint8_t> handleWriteSingle(SlaveAddress slave, const std::vector<uint8_t>& request);
+    std::vector<uint8_t> handleWriteMultiple(SlaveAddress slave, const std::vector<uint8_t>& request);
+    std::vector<uint8_t> handleReadWriteMultiple(SlaveAddress slave, const std::vector<uint8_t>& request);
+
+    /**
+     * @brief Append @p count big-endian register values to @p out
+     * @return 0 on success, otherwise the Modbus exception code
+     */
+    uint8_t appendRegisters(std::vector<uint8_t>& out, RegisterAddress start, uint16_t count);
+
+    /**
+     * @brief Validate and apply all writes, or none of them
+     * @param values Big-endian register values
+     * @return 0 on success, otherwise the Modbus exception code
+     */
+    uint8_t applyWrites(RegisterAddress start, uint16_t count, const uint8_t* values);
+
+    RegisterValue currentValue(RegisterAddress address, SimRegisterModel& model);
+    bool chance(double probability);
+
+    static std::vector<uint8_t> exceptionFrame(SlaveAddress slave, FunctionCode function,
+                                               uint8_t exception_code);
+    static void appendCRC(std::vector<uint8_t>& frame);
+
+    SlaveAddress slave_address_;
+    std::map<RegisterAddress, SimRegisterModel> registers_;
+    std::map<RegisterAddress, double> walk_state_;
+    SimLatencyProfile latency_;
+    SimFaultProfile faults_;
+
+    std::chrono::steady_clock::time_point start_time_;
+    std::mt19937 rng_;
+    mutable std::mutex mutex_;
+
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> replies_{0};
+    std::atomic<uint64_t> invalid_frames_{0};
+    std::atomic<uint64_t> exceptions_injected_{0};
+    std::atomic<uint64_t> crc_errors_injected_{0};
+    std::atomic<uint64_t> drops_{0};
+};
+
+} // namespace ecoWatt
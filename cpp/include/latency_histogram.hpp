@@ -0,0 +1,122 @@
+/**
+ * @file latency_histogram.hpp
+ * @brief Lock-free latency histogram and EWMA gauge
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace ecoWatt {
+
+/**
+ * @brief Point-in-time copy of a LatencyHistogram
+ */
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    uint64_t sum_us = 0;
+    uint64_t min_us = 0;
+    uint64_t max_us = 0;
+    std::vector<uint64_t> buckets; // Per-bucket counts in LatencyHistogram layout
+
+    /**
+     * @brief Arithmetic mean in microseconds (0 when empty)
+     */
+    double mean_us() const {
+        return count > 0 ? static_cast<double>(sum_us) / count : 0.0;
+    }
+
+    /**
+     * @brief Estimate a percentile from the bucket counts
+     * @param percentile Percentile in the range [0, 100]
+     * @return Latency in microseconds (0 when empty)
+     */
+    uint64_t percentile(double percentile) const;
+};
+
+/**
+ * @brief Lock-free log-linear latency histogram with microsecond resolution
+ *
+ * Values below 32us get one bucket each; every power-of-two range above that
+ * is split into 32 linear sub-buckets, bounding the relative error to ~3%.
+ * Recording is a handful of relaxed atomic increments, so it is safe to call
+ * from any thread while another thread takes snapshots.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 5;
+    static constexpr uint64_t kSubBucketCount = 1u << kSubBucketBits;
+    static constexpr unsigned kMaxExponent = 36; // ~19 hours; larger values clamp
+    static constexpr size_t kBucketCount =
+        kSubBucketCount + (kMaxExponent - kSubBucketBits) * kSubBucketCount;
+
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Record one latency value
+     */
+    void record(uint64_t value_us);
+
+    void record(std::chrono::microseconds value) {
+        record(value.count() > 0 ? static_cast<uint64_t>(value.count()) : 0);
+    }
+
+    /**
+     * @brief Copy the current counts
+     */
+    HistogramSnapshot snapshot() const;
+
+    /**
+     * @brief Zero all counts
+     */
+    void reset();
+
+    /**
+     * @brief Bucket layout helpers
+     */
+    static size_t bucketIndex(uint64_t value_us);
+    static uint64_t bucketLowerBound(size_t index);
+    static uint64_t bucketUpperBound(size_t index); // exclusive
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_;
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_us_{0};
+    std::atomic<uint64_t> min_us_;
+    std::atomic<uint64_t> max_us_{0};
+};
+
+/**
+ * @brief Lock-free exponentially weighted moving average
+ */
+class EwmaGauge {
+public:
+    /**
+     * @param alpha Weight of the newest sample (0 < alpha <= 1)
+     */
+    explicit EwmaGauge(double alpha = 0.2);
+
+    void update(double sample);
+
+    /**
+     * @brief Current average (0 before the first sample)
+     */
+    double value() const;
+
+    void reset();
+
+private:
+    double alpha_;
+    std::atomic<uint64_t> bits_; // IEEE-754 bit pattern; NaN until first sample
+};
+
+} // namespace ecoWatt
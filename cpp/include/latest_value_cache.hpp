@@ -0,0 +1,120 @@
+/**
+ * @file latest_value_cache.hpp
+ * @brief Latest-value cache with per-register max-age
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace ecoWatt {
+
+/**
+ * @brief Most recent sample per register, fed by the acquisition path
+ *
+ * Freshness is measured on the steady clock from the moment a sample was
+ * cached, so wall-clock adjustments never make a value look fresh or stale.
+ *
+ * Every invalidation bumps an epoch. Readers capture epoch() before they
+ * start a read and pass it back with the result; a sample from a read that
+ * started before its register was invalidated is dropped, so a poll that
+ * was in flight across a write cannot re-cache the pre-write value.
+ */
+class LatestValueCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Epoch for samples that did not come from a device read
+    static constexpr uint64_t kCurrentEpoch = std::numeric_limits<uint64_t>::max();
+
+    /**
+     * @brief Result of a cache lookup
+     */
+    struct Lookup {
+        std::vector<AcquisitionSample> fresh;   // In request order
+        std::vector<RegisterAddress> stale;     // Missing or older than their max-age
+    };
+
+    struct Statistics {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t updates = 0;
+        uint64_t rejected = 0;  // Reads that started before an invalidation
+
+        double hit_rate() const {
+            uint64_t total = hits + misses;
+            return total > 0 ? static_cast<double>(hits) / total : 0.0;
+        }
+    };
+
+    /**
+     * @brief Constructor
+     * @param default_max_age Max-age for registers without an explicit one
+     */
+    explicit LatestValueCache(Duration default_max_age = Duration(20000));
+
+    /**
+     * @brief Store a sample if it is not older than the cached one
+     * @param read_epoch epoch() captured before the read that produced it
+     */
+    void update(const AcquisitionSample& sample, uint64_t read_epoch = kCurrentEpoch);
+    void update(const std::vector<AcquisitionSample>& samples, uint64_t read_epoch = kCurrentEpoch);
+
+    /**
+     * @brief Current invalidation epoch, captured before starting a read
+     */
+    uint64_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Split @p addresses into fresh cached samples and stale addresses
+     */
+    Lookup lookup(const std::vector<RegisterAddress>& addresses) const;
+    Lookup lookup(const std::vector<RegisterAddress>& addresses, Clock::time_point now) const;
+
+    /**
+     * @brief Max-age configuration (Duration(0) reverts a register to the default)
+     */
+    void setDefaultMaxAge(Duration max_age);
+    void setMaxAge(RegisterAddress address, Duration max_age);
+    void configure(const std::map<RegisterAddress, RegisterConfig>& register_configs);
+    Duration getMaxAge(RegisterAddress address) const;
+
+    /**
+     * @brief Drop one register or everything
+     */
+    void invalidate(RegisterAddress address);
+    void clear();
+
+    Statistics getStatistics() const;
+
+private:
+    struct Entry {
+        AcquisitionSample sample;
+        Clock::time_point cached_at;
+    };
+
+    void updateLocked(const AcquisitionSample& sample, Clock::time_point now, uint64_t read_epoch);
+
+    mutable std::mutex mutex_;
+    std::map<RegisterAddress, Entry> entries_;
+    std::map<RegisterAddress, Duration> max_ages_;
+    Duration default_max_age_;
+    std::map<RegisterAddress, uint64_t> invalidated_at_;
+    uint64_t cleared_at_ = 0;
+    std::atomic<uint64_t> epoch_{0};
+
+    mutable std::atomic<uint64_t> hits_{0};
+    mutable std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> updates_{0};
+    std::atomic<uint64_t> rejected_{0};
+};
+
+} // namespace ecoWatt
@@ -0,0 +1,97 @@
+/**
+ * @file log_limiter.hpp
+ * @brief Per-call-site rate limiting and duplicate folding for warnings and errors
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include <spdlog/spdlog.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace ecoWatt {
+
+/**
+ * @brief Suppression state of one LOG_WARN/LOG_ERROR/LOG_CRITICAL call site
+ *
+ * Keeps the number of lines (and flushes, since warnings flush) a failing
+ * gateway can produce bounded:
+ *
+ * - A message identical to the site's last emitted one is folded into a
+ *   repeat count instead of being written.
+ * - Distinct messages pass through a token bucket (burst, then
+ *   @c suppress_per_minute); the excess is counted and dropped.
+ * - Folded and dropped counts are written as summary lines when the site
+ *   next logs after @c suppress_summary_interval, before the next message
+ *   written after a run of repeats, and at Logger::shutdown().
+ *
+ * A site therefore writes at most twice its token budget (burst +
+ * per_minute per minute) plus two summary lines per interval.
+ */
+class LogSite {
+public:
+    struct Statistics {
+        uint64_t folded = 0;      // Duplicate messages not written
+        uint64_t suppressed = 0;  // Messages dropped by the rate limit
+    };
+
+    LogSite(const char* file, int line);
+    ~LogSite();
+
+    LogSite(const LogSite&) = delete;
+    LogSite& operator=(const LogSite&) = delete;
+
+    template <typename... Args>
+    void log(spdlog::logger& logger, spdlog::level::level_enum level,
+             spdlog::format_string_t<Args...> format, Args&&... args) {
+        submit(logger, level, fmt::format(format, std::forward<Args>(args)...));
+    }
+
+    template <typename T>
+    void log(spdlog::logger& logger, spdlog::level::level_enum level, const T& message) {
+        submit(logger, level, fmt::format("{}", message));
+    }
+
+    void submit(spdlog::logger& logger, spdlog::level::level_enum level, std::string message);
+
+    /**
+     * @brief Apply the suppression settings of a logging configuration
+     */
+    static void configure(const LoggingConfig& config);
+
+    /**
+     * @brief Write pending summaries of every site (called by Logger::shutdown)
+     */
+    static void flushAll(spdlog::logger& logger);
+
+    /**
+     * @brief Process-wide folded/suppressed totals
+     */
+    static Statistics getStatistics();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void writeSummary(spdlog::logger& logger, Clock::time_point now);
+
+    std::string site_;  // "file.cpp:123"
+
+    std::mutex mutex_;
+    bool started_ = false;
+    double tokens_ = 0.0;
+    Clock::time_point last_refill_;
+    Clock::time_point window_start_;
+    std::string last_message_;
+    bool has_last_ = false;
+    spdlog::level::level_enum level_ = spdlog::level::warn;
+    uint64_t repeated_ = 0;
+    uint64_t suppressed_ = 0;
+};
+
+} // namespace ecoWatt
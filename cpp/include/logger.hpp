@@ -13,11 +13,16 @@
 #endif
 
 #include "types.hpp"
+#include "log_limiter.hpp"
 #include <spdlog/spdlog.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace ecoWatt {
 
@@ -29,6 +34,11 @@ public:
     /**
      * @brief Initialize the logging system
      * @param config Logging configuration
+     *
+     * Replaces the default logger that is created when something logs
+     * before initialization (e.g. while loading the configuration). With
+     * config.async, messages are formatted and written by spdlog's thread
+     * pool; callers only enqueue them.
      */
     static void initialize(const LoggingConfig& config);
 
@@ -37,6 +47,18 @@ public:
      */
     static std::shared_ptr<spdlog::logger> get(const std::string& name = "ecoWatt");
 
+    /**
+     * @brief Default logger without refcounting (used by the LOG_* macros)
+     *
+     * One acquire load. Replaced loggers are never freed, so a caller
+     * logging while initialize() replaces the defaulted logger can finish
+     * with the old one.
+     */
+    static spdlog::logger& instance() {
+        spdlog::logger* logger = current_.load(std::memory_order_acquire);
+        return logger ? *logger : *get();
+    }
+
     /**
      * @brief Set log level for all loggers
      */
@@ -53,18 +75,77 @@ public:
     static void shutdown();
 
 private:
-    static std::shared_ptr<spdlog::logger> logger_;
-    static bool initialized_;
+    static std::atomic<spdlog::logger*> current_;  // Null until initialized and after shutdown()
+    static std::vector<std::shared_ptr<spdlog::logger>> loggers_;  // Every logger installed, newest last
+    static bool defaulted_;  // Created implicitly, replaced by initialize()
+    static std::mutex init_mutex_;  // Guards loggers_, defaulted_ and (re)initialization
     
+    static void initializeLocked(const LoggingConfig& config, bool defaulted);
     static spdlog::level::level_enum convertLogLevel(LogLevel level);
 };
 
+// Lowest level compiled in (SPDLOG_LEVEL_TRACE .. SPDLOG_LEVEL_OFF); calls
+// below it expand to nothing, arguments included. Release builds set it to
+// SPDLOG_LEVEL_INFO from CMake.
+#ifndef ECOWATT_LOG_ACTIVE_LEVEL
+#define ECOWATT_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
+// Arguments are only evaluated when the logger's runtime level admits the call
+#define ECOWATT_LOG(level, ...) \
+    do { \
+        spdlog::logger& ecowatt_logger_ = ecoWatt::Logger::instance(); \
+        if (ecowatt_logger_.should_log(level)) { \
+            ecowatt_logger_.log(level, __VA_ARGS__); \
+        } \
+    } while (false)
+
+// Warnings and errors additionally go through a per-call-site LogSite, so a
+// failing gateway cannot flood (and, with flush_on(warn), flush) the log
+#define ECOWATT_LOG_LIMITED(level, ...) \
+    do { \
+        spdlog::logger& ecowatt_logger_ = ecoWatt::Logger::instance(); \
+        if (ecowatt_logger_.should_log(level)) { \
+            static ecoWatt::LogSite ecowatt_site_(__FILE__, __LINE__); \
+            ecowatt_site_.log(ecowatt_logger_, level, __VA_ARGS__); \
+        } \
+    } while (false)
+
 // Convenience macros for logging
-#define LOG_TRACE(...) ecoWatt::Logger::get()->trace(__VA_ARGS__)
-#define LOG_DEBUG(...) ecoWatt::Logger::get()->debug(__VA_ARGS__)
-#define LOG_INFO(...) ecoWatt::Logger::get()->info(__VA_ARGS__)
-#define LOG_WARN(...) ecoWatt::Logger::get()->warn(__VA_ARGS__)
-#define LOG_ERROR(...) ecoWatt::Logger::get()->error(__VA_ARGS__)
-#define LOG_CRITICAL(...) ecoWatt::Logger::get()->critical(__VA_ARGS__)
+#if ECOWATT_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define LOG_TRACE(...) ECOWATT_LOG(spdlog::level::trace, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) (void)0
+#endif
+
+#if ECOWATT_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) ECOWATT_LOG(spdlog::level::debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) (void)0
+#endif
+
+#if ECOWATT_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define LOG_INFO(...) ECOWATT_LOG(spdlog::level::info, __VA_ARGS__)
+#else
+#define LOG_INFO(...) (void)0
+#endif
+
+#if ECOWATT_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define LOG_WARN(...) ECOWATT_LOG_LIMITED(spdlog::level::warn, __VA_ARGS__)
+#else
+#define LOG_WARN(...) (void)0
+#endif
+
+#if ECOWATT_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
+#define LOG_ERROR(...) ECOWATT_LOG_LIMITED(spdlog::level::err, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) (void)0
+#endif
+
+#if ECOWATT_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_CRITICAL
+#define LOG_CRITICAL(...) ECOWATT_LOG_LIMITED(spdlog::level::critical, __VA_ARGS__)
+#else
+#define LOG_CRITICAL(...) (void)0
+#endif
 
 } // namespace ecoWatt
@@ -0,0 +1,167 @@
+/**
+ * @file memory_snapshot.hpp
+ * @brief Memory-mapped snapshot of the in-memory sample rings for warm restarts
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ecoWatt {
+
+constexpr char kSnapshotMagic[8] = {'E', 'W', 'M', 'E', 'M', 'S', 'N', 'P'};
+constexpr uint32_t kSnapshotVersion = 3;
+
+/**
+ * @brief File header; geometry fields must match the file size
+ */
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t register_entry_size;
+    uint32_t record_size;
+    uint32_t max_registers;
+    uint32_t samples_per_register;
+    int64_t created_ns;
+    uint8_t reserved[20];
+    uint32_t checksum;              // FNV-1a of the bytes above
+};
+
+/**
+ * @brief One register's identity; entry i owns ring i
+ */
+struct SnapshotRegister {
+    uint16_t address;
+    uint16_t in_use;
+    uint32_t checksum;              // FNV-1a of the entry with this field zero
+    char name[40];
+    char unit[16];
+};
+
+/**
+ * @brief One sample in a register's ring
+ */
+struct SnapshotRecord {
+    uint64_t sequence;              // File-wide write order; 0 = empty
+    int64_t timestamp_ns;
+    double scaled_value;
+    int64_t raw_value;
+    uint32_t checksum;              // FNV-1a of the fields above, seeded with the ring index
+    uint32_t reserved;
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "SnapshotHeader layout changed; bump kSnapshotVersion");
+static_assert(sizeof(SnapshotRegister) == 64, "SnapshotRegister layout changed; bump kSnapshotVersion");
+static_assert(sizeof(SnapshotRecord) == 40, "SnapshotRecord layout changed; bump kSnapshotVersion");
+
+/**
+ * @brief Mirrors MemoryDataStorage's per-register rings into a MAP_SHARED file
+ *
+ * Layout: header, max_registers register entries, then max_registers rings
+ * of samples_per_register records (native byte order). append() writes
+ * one record into the page cache (under 100 ns, no system call); the kernel
+ * writes dirty pages back in the background and the destructor msyncs.
+ * After a crash, a power cut or a torn write, each record and register
+ * entry is validated by its own checksum and invalid ones are dropped, so
+ * at most the samples being written at that moment are lost.
+ *
+ * On open, the valid records are returned by takeRestored() in write
+ * order. A file with another version or a corrupt header is replaced by
+ * an empty one. A file with a different geometry (retention or register
+ * limit changed) is rebuilt keeping the newest samples that fit.
+ *
+ * Not thread-safe: MemoryDataStorage calls it under its own mutex.
+ */
+class MemorySnapshotFile {
+public:
+    using RegisterSamples = std::map<RegisterAddress, std::deque<AcquisitionSample>>;
+
+    struct Statistics {
+        uint64_t restored = 0;            // Samples loaded at open
+        uint64_t discarded = 0;           // Records and entries failing their checksum at open
+        uint64_t written = 0;             // Records appended since open
+        uint64_t register_overflow = 0;   // Samples of registers beyond max_registers
+        std::string reset_reason;         // Why the previous file was not reused as is
+    };
+
+    /**
+     * @throws StorageException if the file cannot be created or mapped
+     * @throws ValidationException on a zero limit
+     */
+    MemorySnapshotFile(const std::string& path, uint32_t max_registers, uint32_t samples_per_register);
+    ~MemorySnapshotFile();
+
+    MemorySnapshotFile(const MemorySnapshotFile&) = delete;
+    MemorySnapshotFile& operator=(const MemorySnapshotFile&) = delete;
+
+    /**
+     * @brief Samples found at open, oldest first per register (moved out; later calls return nothing)
+     */
+    RegisterSamples takeRestored();
+
+    /**
+     * @brief Write @p sample over the oldest record of its register's ring
+     */
+    void append(const AcquisitionSample& sample);
+
+    /**
+     * @brief Empty one register's ring, or all rings and register entries
+     */
+    void clear(RegisterAddress address);
+    void clearAll();
+
+    /**
+     * @brief Start (or with @p wait, finish) writing dirty pages to disk
+     */
+    void flush(bool wait = false);
+
+    Statistics getStatistics() const { return stats_; }
+    const std::string& path() const { return path_; }
+
+    static size_t fileSize(uint32_t max_registers, uint32_t samples_per_register);
+
+private:
+    void map(size_t size);
+    void unmap();
+    void create();
+    bool restore(std::string& reason);
+    void adopt(RegisterSamples samples);
+    int32_t slotFor(const AcquisitionSample& sample);
+    void writeEntry(uint32_t slot, RegisterAddress address, const std::string& name, const std::string& unit);
+
+    SnapshotHeader* header() const { return static_cast<SnapshotHeader*>(base_); }
+    SnapshotRegister* entries() const;
+    SnapshotRecord* ring(uint32_t slot) const;
+
+    std::string path_;
+    uint32_t max_registers_;
+    uint32_t samples_per_register_;
+    int fd_ = -1;
+    void* base_ = nullptr;
+    size_t size_ = 0;
+
+    struct Slot {
+        bool used = false;
+        uint32_t next = 0;                // Ring index of the next write
+        std::string name;
+        std::string unit;
+    };
+    std::unordered_map<RegisterAddress, uint32_t> slot_by_address_;
+    std::vector<Slot> slots_;
+    uint64_t next_sequence_ = 1;
+
+    RegisterSamples restored_;
+    Statistics stats_;
+};
+
+} // namespace ecoWatt
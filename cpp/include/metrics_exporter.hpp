@@ -0,0 +1,145 @@
+/**
+ * @file metrics_exporter.hpp
+ * @brief OpenMetrics text exposition served from a prerendered buffer
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include "latency_histogram.hpp"
+#include <cpprest/http_listener.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace ecoWatt {
+
+/**
+ * @brief Appends metric families in OpenMetrics text format to a buffer
+ *
+ * Samples of one family must follow its family() line. @p labels is the
+ * inner part of a label set without braces, e.g. @c lane="control".
+ */
+class MetricsWriter {
+public:
+    explicit MetricsWriter(std::string& out) : out_(out) {}
+
+    /**
+     * @brief Start a family: "# TYPE" and "# HELP" lines
+     * @param type "counter", "gauge" or "histogram"
+     */
+    void family(std::string_view name, std::string_view type, std::string_view help);
+
+    /**
+     * @brief Counter sample (name_total)
+     */
+    void counter(std::string_view name, uint64_t value, std::string_view labels = {});
+
+    void gauge(std::string_view name, double value, std::string_view labels = {});
+
+    /**
+     * @brief Histogram samples in seconds: cumulative name_bucket{le=...},
+     *        name_count and name_sum
+     *
+     * LatencyHistogram buckets are attributed to the first bound at or above
+     * their largest value, so a bound may undercount by the histogram's ~3%
+     * resolution; +Inf and _count are exact.
+     */
+    void histogram(std::string_view name, const HistogramSnapshot& snapshot, std::string_view labels = {});
+
+    /**
+     * @brief Default bucket bounds in seconds (1 ms .. 10 s)
+     */
+    static const std::vector<double>& defaultBounds();
+
+private:
+    void sampleLine(std::string_view name, std::string_view suffix, std::string_view labels,
+                    std::string_view extra_label);
+
+    std::string& out_;
+};
+
+/**
+ * @brief Embedded /metrics endpoint for Prometheus/OpenMetrics scrapers
+ *
+ * Collectors registered with addCollector() read component statistics into
+ * a MetricsWriter. refresh() runs every collector on the exporter's own
+ * thread (every @c refresh_interval), keeps each collector's section and
+ * only reassembles and republishes the body when a section changed.
+ * Scrapes reply with the published buffer as is: they never run collectors
+ * or take the locks of the components being measured, so a scrape costs
+ * one shared_ptr copy and the socket write.
+ */
+class MetricsExporter {
+public:
+    using Collector = std::function<void(MetricsWriter&)>;
+
+    static constexpr const char* kContentType = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+    explicit MetricsExporter(const MetricsConfig& config);
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    /**
+     * @brief Register a collector (before start())
+     */
+    void addCollector(Collector collector);
+
+    /**
+     * @brief Run all collectors and publish the body if any section changed
+     * @return True when a new body was published
+     */
+    bool refresh();
+
+    /**
+     * @brief Body served to the next scrape (ends with "# EOF")
+     */
+    std::shared_ptr<const std::string> body() const;
+
+    /**
+     * @brief Refresh once, then open the listener and start the refresh thread
+     * @throws HttpException if the address cannot be bound
+     */
+    void start();
+
+    /**
+     * @brief Close the listener and stop refreshing (idempotent)
+     */
+    void stop();
+
+    bool isRunning() const { return running_; }
+    uint64_t scrapeCount() const { return scrapes_.load(std::memory_order_relaxed); }
+
+private:
+    void refreshLoop();
+    void handleGet(web::http::http_request request);
+
+    MetricsConfig config_;
+
+    std::vector<Collector> collectors_;
+    std::vector<std::string> sections_;  // Last output per collector
+    std::string scratch_;
+    std::mutex refresh_mutex_;
+
+    std::shared_ptr<const std::string> body_;  // Accessed with std::atomic_load/store
+
+    std::unique_ptr<web::http::experimental::listener::http_listener> listener_;
+    std::thread refresh_thread_;
+    std::mutex thread_mutex_;
+    std::condition_variable thread_cv_;
+    bool stop_requested_ = false;
+    bool running_ = false;
+    std::atomic<uint64_t> scrapes_{0};
+};
+
+} // namespace ecoWatt
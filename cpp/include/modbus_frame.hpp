@@ -11,6 +11,7 @@
 #include "exceptions.hpp"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <cstdint>
 
 namespace ecoWatt {
@@ -42,13 +43,71 @@ public:
                                       RegisterAddress register_address,
                                       RegisterValue value);
 
+    /**
+     * @brief Create write multiple registers frame (FC16)
+     * @param slave_address Slave device address
+     * @param start_address First register to write
+     * @param values Values for consecutive registers (1-123)
+     * @return Hex string representation of frame
+     */
+    static std::string createWriteMultipleFrame(SlaveAddress slave_address,
+                                              RegisterAddress start_address,
+                                              const std::vector<RegisterValue>& values);
+
+    /**
+     * @brief Create read/write multiple registers frame (FC23)
+     *
+     * The device performs the write before the read, so the response already
+     * reflects the written values.
+     *
+     * @param slave_address Slave device address
+     * @param read_start First register to read
+     * @param read_count Number of registers to read (1-125)
+     * @param write_start First register to write
+     * @param values Values for consecutive registers (1-121)
+     * @return Hex string representation of frame
+     */
+    static std::string createReadWriteMultipleFrame(SlaveAddress slave_address,
+                                                  RegisterAddress read_start,
+                                                  uint16_t read_count,
+                                                  RegisterAddress write_start,
+                                                  const std::vector<RegisterValue>& values);
+
     /**
      * @brief Parse response frame
      * @param frame_hex Hex string representation of response frame
      * @return Parsed Modbus response
      * @throws ModbusException if frame is invalid
      */
-    static ModbusResponse parseResponse(const std::string& frame_hex);
+    static ModbusResponse parseResponse(std::string_view frame_hex);
+
+    /**
+     * @brief Parse response frame from raw bytes (binary transports)
+     * @param frame_bytes Response frame including CRC
+     * @return Parsed Modbus response
+     * @throws ModbusException if frame is invalid
+     */
+    static ModbusResponse parseResponse(const std::vector<uint8_t>& frame_bytes);
+
+    /**
+     * @brief Binary request frames (including CRC) for transports that do
+     *        not use the hex envelope; the create*Frame() variants above
+     *        return the same frames hex-encoded
+     */
+    static std::vector<uint8_t> createReadFrameBytes(SlaveAddress slave_address,
+                                                   RegisterAddress start_address,
+                                                   uint16_t num_registers);
+    static std::vector<uint8_t> createWriteFrameBytes(SlaveAddress slave_address,
+                                                    RegisterAddress register_address,
+                                                    RegisterValue value);
+    static std::vector<uint8_t> createWriteMultipleFrameBytes(SlaveAddress slave_address,
+                                                            RegisterAddress start_address,
+                                                            const std::vector<RegisterValue>& values);
+    static std::vector<uint8_t> createReadWriteMultipleFrameBytes(SlaveAddress slave_address,
+                                                                RegisterAddress read_start,
+                                                                uint16_t read_count,
+                                                                RegisterAddress write_start,
+                                                                const std::vector<RegisterValue>& values);
 
     /**
      * @brief Calculate Modbus RTU CRC
@@ -63,7 +122,7 @@ public:
      * @return Vector of bytes
      * @throws ValidationException if hex string is invalid
      */
-    static std::vector<uint8_t> hexToBytes(const std::string& hex_string);
+    static std::vector<uint8_t> hexToBytes(std::string_view hex_string);
 
     /**
      * @brief Convert bytes to hex string
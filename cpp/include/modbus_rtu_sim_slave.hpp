@@ -0,0 +1,79 @@
+/**
+ * @file modbus_rtu_sim_slave.hpp
+ * @brief Modbus RTU slave emulator for the local Inverter SIM on a pseudo-terminal
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "inverter_simulator.hpp"
+#include "modbus_rtu_transport.hpp"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace ecoWatt {
+
+/**
+ * @brief Answers RTU requests written to a pty slave device
+ *
+ * Opens a pseudo-terminal pair and serves the simulator on the master side
+ * with the same frame-end rules as a real RTU slave, so ModbusRtuTransport
+ * can be exercised without RS-485 hardware by pointing it at devicePath().
+ * Replies are sent no sooner than t3.5 after the request; dropped or
+ * invalid requests are not answered.
+ */
+class ModbusRtuSimSlave {
+public:
+    /**
+     * @brief Constructor
+     * @param simulator Register model shared with the caller
+     * @param baud_rate Line speed used for the silent intervals
+     */
+    explicit ModbusRtuSimSlave(std::shared_ptr<InverterSimulator> simulator,
+                               uint32_t baud_rate = 115200);
+
+    ~ModbusRtuSimSlave();
+
+    // Non-copyable
+    ModbusRtuSimSlave(const ModbusRtuSimSlave&) = delete;
+    ModbusRtuSimSlave& operator=(const ModbusRtuSimSlave&) = delete;
+
+    /**
+     * @brief Create the pty pair and start answering
+     * @throws TransportException if no pseudo-terminal is available
+     */
+    void start();
+
+    /**
+     * @brief Stop answering and close the pty pair (idempotent)
+     */
+    void stop();
+
+    bool isRunning() const { return running_; }
+
+    /**
+     * @brief Device for the transport to open (e.g. /dev/pts/3)
+     */
+    const std::string& devicePath() const { return device_path_; }
+
+    InverterSimulator& simulator() { return *simulator_; }
+
+private:
+    void serve();
+
+    std::shared_ptr<InverterSimulator> simulator_;
+    uint32_t baud_rate_;
+    RtuTiming timing_;
+
+    int master_fd_ = -1;
+    int slave_fd_ = -1; // Held open so the master never sees a hangup
+    std::string device_path_;
+
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+} // namespace ecoWatt
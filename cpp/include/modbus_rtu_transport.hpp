@@ -0,0 +1,114 @@
+/**
+ * @file modbus_rtu_transport.hpp
+ * @brief Modbus RTU transport over a serial line (termios)
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "transport.hpp"
+#include <chrono>
+#include <mutex>
+
+namespace ecoWatt {
+
+/**
+ * @brief Modbus RTU silent intervals for one baud rate
+ */
+struct RtuTiming {
+    std::chrono::microseconds character{0};   // One 11-bit character on the wire
+    std::chrono::microseconds inter_char{0};  // t1.5
+    std::chrono::microseconds inter_frame{0}; // t3.5: silence that ends a frame
+};
+
+/**
+ * @brief Talks to an RS-485 inverter with binary RTU frames
+ *
+ * The line is half-duplex, so one transaction is on the bus at a time. Before
+ * each request the transport waits until the bus has been silent for t3.5
+ * since the last frame, and a response ends either when its length (known
+ * from the function code) is complete or when the line stays silent for t3.5.
+ * Waits use ppoll() deadlines derived from the baud rate rather than fixed
+ * sleeps, so at 115200 baud a register read costs little more than its
+ * bytes on the wire.
+ */
+class ModbusRtuTransport : public Transport {
+public:
+    /**
+     * @brief Constructor (opens the device lazily on the first request)
+     * @param device Serial device, e.g. "/dev/ttyUSB0" or a pty slave
+     * @param baud_rate Line speed (1200-230400)
+     * @param parity Line parity; NONE implies two stop bits
+     * @param timeout Time allowed for the first response byte
+     * @throws ConfigException for an unsupported baud rate
+     */
+    ModbusRtuTransport(std::string device, uint32_t baud_rate,
+                       SerialParity parity = SerialParity::EVEN,
+                       Duration timeout = Duration(1000));
+
+    ~ModbusRtuTransport() override;
+
+    // Non-copyable
+    ModbusRtuTransport(const ModbusRtuTransport&) = delete;
+    ModbusRtuTransport& operator=(const ModbusRtuTransport&) = delete;
+
+    /**
+     * @throws TransportException if the device cannot be opened or fails
+     * @throws TimeoutException if the slave does not answer
+     */
+    std::vector<uint8_t> transact(const std::vector<uint8_t>& request,
+                                  TransportOperation operation) override;
+
+    std::string describe() const override;
+
+    const RtuTiming& timing() const { return timing_; }
+
+    /**
+     * @brief Silent intervals for @p baud_rate (fixed 750/1750us above 19200 baud)
+     */
+    static RtuTiming timingForBaud(uint32_t baud_rate);
+
+    /**
+     * @brief Length a frame will have once complete, from its first bytes
+     * @return Total length including CRC, or 0 while it cannot be known yet
+     */
+    static size_t expectedResponseLength(const std::vector<uint8_t>& partial);
+    static size_t expectedRequestLength(const std::vector<uint8_t>& partial);
+
+    /**
+     * @brief Receive one RTU frame from @p fd
+     *
+     * Waits up to @p first_byte_timeout for the frame to start, then reads
+     * until @p expected_length reports it complete or the line is silent for
+     * the inter-frame interval.
+     *
+     * @return The frame, or an empty vector if nothing arrived
+     * @throws TransportException on a read error or end of file
+     */
+    static std::vector<uint8_t> receiveFrame(int fd, const RtuTiming& timing,
+                                             std::chrono::microseconds first_byte_timeout,
+                                             size_t (*expected_length)(const std::vector<uint8_t>&));
+
+    /**
+     * @brief Put @p fd in raw 8-bit mode at @p baud_rate
+     * @throws TransportException if the line cannot be configured
+     */
+    static void configureLine(int fd, uint32_t baud_rate, SerialParity parity);
+
+private:
+    void open();
+    void close();
+
+    std::string device_;
+    uint32_t baud_rate_;
+    SerialParity parity_;
+    Duration timeout_;
+    RtuTiming timing_;
+
+    std::mutex mutex_; // One transaction on the bus at a time
+    int fd_ = -1;
+    std::chrono::steady_clock::time_point last_activity_{};
+};
+
+} // namespace ecoWatt
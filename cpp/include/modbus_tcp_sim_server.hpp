@@ -0,0 +1,92 @@
+/**
+ * @file modbus_tcp_sim_server.hpp
+ * @brief Modbus TCP front end for the local Inverter SIM
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "inverter_simulator.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ecoWatt {
+
+/**
+ * @brief Serves the simulator as a Modbus TCP slave
+ *
+ * Stand-in for an inverter with a native Modbus TCP interface. Requests on
+ * a connection are processed concurrently, each delayed by a sample from the
+ * latency profile, and answered as soon as they complete, so pipelined
+ * clients see responses out of order the way a real gateway may return them.
+ * Dropped or invalid frames are not answered at all.
+ */
+class ModbusTcpSimServer {
+public:
+    /**
+     * @brief Constructor
+     * @param simulator Register model shared with the caller
+     * @param port Listen port; 0 picks a free port (see port())
+     * @param host Listen address
+     */
+    explicit ModbusTcpSimServer(std::shared_ptr<InverterSimulator> simulator,
+                                uint16_t port = 0,
+                                const std::string& host = "127.0.0.1");
+
+    ~ModbusTcpSimServer();
+
+    // Non-copyable
+    ModbusTcpSimServer(const ModbusTcpSimServer&) = delete;
+    ModbusTcpSimServer& operator=(const ModbusTcpSimServer&) = delete;
+
+    /**
+     * @brief Bind and start accepting connections
+     * @throws TransportException if the address cannot be bound
+     */
+    void start();
+
+    /**
+     * @brief Close the listener and all connections (idempotent)
+     */
+    void stop();
+
+    bool isRunning() const { return running_; }
+    uint16_t port() const { return port_; }
+    InverterSimulator& simulator() { return *simulator_; }
+
+private:
+    struct Session {
+        explicit Session(int socket_fd) : fd(socket_fd) {}
+        ~Session();
+
+        const int fd;
+        std::mutex write_mutex;
+        std::mutex mutex;
+        std::condition_variable idle;
+        size_t active_requests = 0;
+    };
+
+    void acceptLoop();
+    void serve(std::shared_ptr<Session> session);
+    void respond(const std::shared_ptr<Session>& session, uint16_t transaction_id,
+                 std::vector<uint8_t> request);
+
+    std::shared_ptr<InverterSimulator> simulator_;
+    std::string host_;
+    uint16_t port_;
+
+    int listen_fd_ = -1;
+    std::atomic<bool> running_{false};
+    std::thread accept_thread_;
+
+    std::mutex sessions_mutex_;
+    std::vector<std::pair<std::shared_ptr<Session>, std::thread>> sessions_;
+};
+
+} // namespace ecoWatt
@@ -0,0 +1,110 @@
+/**
+ * @file modbus_tcp_transport.hpp
+ * @brief Native Modbus TCP transport (MBAP framing, pipelined requests)
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "transport.hpp"
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace ecoWatt {
+
+/**
+ * @brief Speaks Modbus TCP to the inverter over one persistent connection
+ *
+ * RTU frames from ModbusFrame are re-framed as MBAP ADUs (the CRC is dropped
+ * on send and recomputed on receive, so parsing is unchanged). Requests are
+ * matched to responses by transaction identifier, which lets up to
+ * maxInFlight() requests share the connection without waiting for each
+ * other. A background reader thread demultiplexes responses; when the
+ * connection breaks, every outstanding request fails with TransportException
+ * and the next request reconnects.
+ */
+class ModbusTcpTransport : public Transport {
+public:
+    static constexpr size_t kMbapHeaderSize = 7;
+
+    /**
+     * @brief Constructor (connects lazily on the first request)
+     * @param host Inverter host name or address
+     * @param port Modbus TCP port (normally 502)
+     * @param timeout Connect and response timeout
+     * @param max_in_flight Outstanding requests allowed on the connection
+     */
+    ModbusTcpTransport(std::string host, uint16_t port, Duration timeout,
+                       size_t max_in_flight = 4);
+
+    ~ModbusTcpTransport() override;
+
+    // Non-copyable
+    ModbusTcpTransport(const ModbusTcpTransport&) = delete;
+    ModbusTcpTransport& operator=(const ModbusTcpTransport&) = delete;
+
+    /**
+     * @throws TransportException if the connection fails or breaks
+     * @throws TimeoutException if no response arrives in time
+     */
+    std::vector<uint8_t> transact(const std::vector<uint8_t>& request,
+                                  TransportOperation operation) override;
+
+    size_t maxInFlight() const override { return max_in_flight_; }
+    std::string describe() const override;
+
+    bool isConnected() const;
+
+    /**
+     * @brief Connections opened so far (the first one included)
+     */
+    uint64_t getConnectCount() const { return connects_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Wrap an RTU frame (address, PDU, CRC) in an MBAP header
+     */
+    static std::vector<uint8_t> encodeAdu(uint16_t transaction_id, const std::vector<uint8_t>& rtu_frame);
+
+    /**
+     * @brief Rebuild an RTU frame (with CRC) from a unit identifier and PDU
+     */
+    static std::vector<uint8_t> toRtuFrame(uint8_t unit_id, const uint8_t* pdu, size_t pdu_length);
+
+private:
+    /**
+     * @brief Owns the socket; closed when the last user lets go
+     */
+    struct Connection {
+        explicit Connection(int socket_fd) : fd(socket_fd) {}
+        ~Connection();
+        void shutdown();
+
+        const int fd;
+    };
+
+    std::shared_ptr<Connection> connection();
+    std::shared_ptr<Connection> connect();
+    void readerLoop(std::shared_ptr<Connection> connection);
+
+    std::string host_;
+    uint16_t port_;
+    Duration timeout_;
+    size_t max_in_flight_;
+
+    std::mutex connect_mutex_;  // Serializes (re)connects and reader thread handover
+    std::thread reader_;
+
+    mutable std::mutex mutex_;  // Guards connection_, pending_ and the ID counter
+    std::shared_ptr<Connection> connection_;
+    uint16_t next_transaction_id_ = 1;
+    std::unordered_map<uint16_t, std::promise<std::vector<uint8_t>>> pending_;
+
+    std::mutex send_mutex_;     // Keeps ADUs from interleaving on the socket
+    std::atomic<uint64_t> connects_{0};
+};
+
+} // namespace ecoWatt
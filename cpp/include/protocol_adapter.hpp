@@ -9,16 +9,25 @@
 
 #include "types.hpp"
 #include "exceptions.hpp"
-#include "http_client.hpp"
+#include "transport.hpp"
 #include "modbus_frame.hpp"
 #include "config_manager.hpp"
+#include "latency_histogram.hpp"
+#include "read_coalescer.hpp"
+#include "transaction_queue.hpp"
 #include <vector>
 #include <memory>
+#include <array>
+#include <atomic>
+#include <optional>
 
 namespace ecoWatt {
 
 /**
- * @brief Protocol adapter for Modbus RTU communication over HTTP API
+ * @brief Protocol adapter for Modbus RTU communication
+ *
+ * Frames are carried by a pluggable Transport (Inverter SIM HTTP API,
+ * native Modbus TCP or RTU serial), selected by ModbusConfig::transport.
  */
 class ProtocolAdapter {
 public:
@@ -28,6 +37,13 @@ public:
      */
     explicit ProtocolAdapter(const ConfigManager& config);
 
+    /**
+     * @brief Constructor with an explicit transport
+     * @param config Configuration manager instance
+     * @param transport Link to the inverter (must not be null)
+     */
+    ProtocolAdapter(const ConfigManager& config, UniquePtr<Transport> transport);
+
     /**
      * @brief Destructor
      */
@@ -35,22 +51,88 @@ public:
 
     /**
      * @brief Read holding registers from inverter
+     *
+     * Concurrent calls whose range is covered by a read already in flight
+     * share that transaction instead of sending their own request.
+     *
      * @param start_address Starting register address
      * @param num_registers Number of registers to read
+     * @param lane Transaction lane (polling should use BACKGROUND)
      * @return Vector of register values
      * @throws ModbusException on communication or protocol error
      */
     std::vector<RegisterValue> readRegisters(RegisterAddress start_address, 
-                                           uint16_t num_registers);
+                                           uint16_t num_registers,
+                                           TransactionLane lane = TransactionLane::INTERACTIVE);
+
+    /**
+     * @brief Result of one block in readRegisterBlocks()
+     */
+    struct BlockRead {
+        RegisterAddress start_address = 0;
+        uint16_t num_registers = 0;
+        std::vector<RegisterValue> values; // Empty on failure
+        std::string error;                 // Why this block failed
+        
+        bool ok() const { return error.empty(); }
+    };
+
+    /**
+     * @brief Read several register blocks, each succeeding or failing on its own
+     *
+     * When the transport supports batching, the blocks go out as one round
+     * trip (split at Transport::maxBatchSize()); otherwise each block is a
+     * readRegisters() call. Either way blocks are coalesced with concurrent
+     * reads, so a block covered by one already in flight is not re-sent. Exception responses and missing responses are
+     * reported per block.
+     *
+     * @param blocks (start address, register count) pairs
+     * @param lane Transaction lane
+     * @return One result per block, in request order
+     */
+    std::vector<BlockRead> readRegisterBlocks(const std::vector<std::pair<RegisterAddress, uint16_t>>& blocks,
+                                              TransactionLane lane = TransactionLane::INTERACTIVE);
 
     /**
      * @brief Write single register to inverter
      * @param register_address Register address to write
      * @param value Value to write
+     * @param lane Transaction lane; writes preempt queued reads by default
      * @return True if successful
      * @throws ModbusException on communication or protocol error
      */
-    bool writeRegister(RegisterAddress register_address, RegisterValue value);
+    bool writeRegister(RegisterAddress register_address, RegisterValue value,
+                       TransactionLane lane = TransactionLane::CONTROL);
+
+    /**
+     * @brief Write consecutive registers in one transaction (FC16)
+     * @param start_address First register to write
+     * @param values Values for consecutive registers (1-123)
+     * @param lane Transaction lane
+     * @return True if successful
+     * @throws ModbusException on communication or protocol error
+     */
+    bool writeRegisters(RegisterAddress start_address, const std::vector<RegisterValue>& values,
+                        TransactionLane lane = TransactionLane::CONTROL);
+
+    /**
+     * @brief Write registers and read registers back in one transaction (FC23)
+     *
+     * The write is applied before the read, so reading the written range
+     * returns the new values.
+     *
+     * @param read_start First register to read
+     * @param read_count Number of registers to read (1-125)
+     * @param write_start First register to write
+     * @param values Values for consecutive registers (1-121)
+     * @param lane Transaction lane
+     * @return Values of the registers read
+     * @throws ModbusException on communication or protocol error
+     */
+    std::vector<RegisterValue> readWriteRegisters(RegisterAddress read_start, uint16_t read_count,
+                                                  RegisterAddress write_start,
+                                                  const std::vector<RegisterValue>& values,
+                                                  TransactionLane lane = TransactionLane::CONTROL);
 
     /**
      * @brief Test communication with inverter
@@ -59,14 +141,34 @@ public:
     bool testCommunication();
 
     /**
-     * @brief Get communication statistics
+     * @brief Operation types tracked by the latency histograms
+     */
+    enum class OperationType : size_t {
+        READ = 0,
+        WRITE = 1,
+        RETRY = 2  // Individual failed attempts that were retried
+    };
+
+    static constexpr size_t kOperationTypeCount = 3;
+
+    /**
+     * @brief Snapshot of communication statistics
      */
     struct CommunicationStats {
         uint64_t total_requests = 0;
         uint64_t successful_requests = 0;
         uint64_t failed_requests = 0;
         uint64_t retry_attempts = 0;
-        Duration average_response_time = Duration(0);
+        uint64_t coalesced_reads = 0;       // Reads served by another caller's in-flight request
+        uint64_t coalesced_registers = 0;
+        uint64_t batch_round_trips = 0;     // Batched POSTs (each carries several frames)
+        uint64_t batched_frames = 0;
+        Duration average_response_time = Duration(0);      // True mean over all operations
+        std::chrono::microseconds ewma_response_time{0};   // Recent-biased average
+        HistogramSnapshot read_latency;
+        HistogramSnapshot write_latency;
+        HistogramSnapshot retry_latency;
+        std::array<TransactionQueue::LaneStatistics, TransactionQueue::kLaneCount> lanes;
         
         double success_rate() const {
             return total_requests > 0 ? 
@@ -76,8 +178,10 @@ public:
 
     /**
      * @brief Get communication statistics
+     *
+     * Safe to call from any thread while requests are in flight.
      */
-    const CommunicationStats& getStatistics() const { return stats_; }
+    CommunicationStats getStatistics() const;
 
     /**
      * @brief Reset statistics
@@ -86,13 +190,50 @@ public:
 
 private:
     /**
-     * @brief Send HTTP request with retry logic
-     * @param endpoint API endpoint
-     * @param frame Modbus frame as hex string
-     * @return Response frame as hex string
+     * @brief Perform one FC03 transaction (the single-flight leader path)
+     */
+    std::vector<RegisterValue> performRead(RegisterAddress start_address, uint16_t num_registers,
+                                           TransactionLane lane);
+
+    /**
+     * @brief Send one batch of FC03 frames, fill in the listed results and resolve their claims
+     */
+    void performBatchRead(std::vector<BlockRead>& results,
+                          std::vector<std::optional<ReadCoalescer::Claim>>& claims,
+                          const std::vector<size_t>& indices, TransactionLane lane);
+
+    /**
+     * @brief Check an FC03/FC23 response frame and extract its register values
+     * @throws ModbusException on exception responses or a count mismatch
+     */
+    std::vector<RegisterValue> decodeReadResponse(const std::vector<uint8_t>& response_frame,
+                                                  uint16_t num_registers);
+
+    /**
+     * @brief Run @p attempt (one wire transaction) under a lane slot, retrying
+     *        link-level failures with the configured delay
      * @throws ModbusException on failure after all retries
      */
-    std::string sendRequest(const std::string& endpoint, const std::string& frame);
+    template <typename Attempt>
+    auto withRetries(TransactionLane lane, Attempt&& attempt) -> decltype(attempt());
+
+    /**
+     * @brief Send request over the transport with retry logic
+     * @param frame Modbus request frame including CRC
+     * @param operation Read or write, for transports that route them differently
+     * @param lane Lane each attempt is queued on (retry delays hold no slot)
+     * @return Response frame including CRC (empty if the slave did not answer)
+     * @throws ModbusException on failure after all retries
+     */
+    std::vector<uint8_t> sendRequest(const std::vector<uint8_t>& frame, TransportOperation operation,
+                                     TransactionLane lane);
+
+    /**
+     * @brief sendRequest() for a write of @p num_registers registers at @p start_address;
+     *        afterwards (even on failure) reads in flight over that range are not joined
+     */
+    std::vector<uint8_t> sendWrite(const std::vector<uint8_t>& frame, RegisterAddress start_address,
+                                   uint16_t num_registers, TransactionLane lane);
 
     /**
      * @brief Parse register values from response data
@@ -102,22 +243,38 @@ private:
     std::vector<RegisterValue> parseRegisterValues(const std::vector<uint8_t>& data);
 
     /**
-     * @brief Update statistics
+     * @brief Record the outcome of a read/write operation
+     */
+    void updateStats(OperationType operation, bool success, std::chrono::microseconds response_time);
+
+    /**
+     * @brief Record a failed attempt that is about to be retried
      */
-    void updateStats(bool success, Duration response_time, bool was_retry = false);
+    void recordRetry(std::chrono::microseconds attempt_time);
 
     // Configuration
     ModbusConfig modbus_config_;
-    ApiConfig api_config_;
     
-    // HTTP client
-    UniquePtr<HttpClient> http_client_;
+    // Link to the inverter
+    UniquePtr<Transport> transport_;
+    
+    // Single-flight layer for concurrent identical reads
+    ReadCoalescer read_coalescer_;
     
-    // Statistics
-    CommunicationStats stats_;
+    // Prioritized admission of wire transactions
+    TransactionQueue transaction_queue_;
     
-    // Timing for statistics
-    std::chrono::high_resolution_clock::time_point request_start_time_;
+    // Statistics (lock-free; updated from any calling thread)
+    std::atomic<uint64_t> total_requests_{0};
+    std::atomic<uint64_t> successful_requests_{0};
+    std::atomic<uint64_t> failed_requests_{0};
+    std::atomic<uint64_t> retry_attempts_{0};
+    std::atomic<uint64_t> batch_round_trips_{0};
+    std::atomic<uint64_t> batched_frames_{0};
+    std::array<LatencyHistogram, kOperationTypeCount> latency_;
+    EwmaGauge ewma_response_us_;
 };
 
+using CommunicationStats = ProtocolAdapter::CommunicationStats;
+
 } // namespace ecoWatt
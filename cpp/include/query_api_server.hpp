@@ -0,0 +1,172 @@
+/**
+ * @file query_api_server.hpp
+ * @brief Read-only REST API for latest readings, history and statistics
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include "data_storage.hpp"
+#include <cpprest/http_listener.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ecoWatt {
+
+/**
+ * @brief Embedded read-only HTTP API for HMIs and local tools
+ *
+ * Endpoints (GET, JSON):
+ * - /api/v1/latest: latest sample of every register
+ * - /api/v1/latest/{address}: latest sample of one register
+ * - /api/v1/history?register=&from=&to=&resolution=: persisted rows
+ *   averaged per bucket (times in ms since the epoch; defaults to the last
+ *   hour, resolution coarsened to at most @c max_history_points buckets).
+ *   Registers with deadband, heartbeat or swinging-door storage filtering
+ *   only have sparse rows; for them the series is rebuilt as
+ *   HybridDataStorage::getHistoricalSamples describes (held or
+ *   interpolated, seeded by the row before @c from) and averaged over time
+ * - /api/v1/statistics: the device's status counters
+ *
+ * Latest values come from the server's own copy, fed by onSample() from
+ * the scheduler's sample callback, and history from the storage's
+ * read-only SQLite connection: requests never reach the inverter and never
+ * wait on the acquisition or storage write paths.
+ *
+ * Every register carries a version that increases with each sample and
+ * the server a generation that increases with any sample. Latest-value
+ * responses carry them in an ETag; a matching If-None-Match is answered
+ * 304 without serializing anything. The /latest body is serialized once
+ * per generation and shared by every request until the next sample.
+ *
+ * Requests are handled by @c threads workers; when @c queue_limit
+ * requests are already waiting, new ones are answered 503.
+ */
+class QueryApiServer {
+public:
+    using StatisticsProvider = std::function<nlohmann::json()>;
+
+    struct Response {
+        uint16_t status = 200;
+        std::shared_ptr<const std::string> body;  // JSON; null for 304
+        std::string etag;                         // Empty when not cacheable
+    };
+
+    struct Statistics {
+        uint64_t requests = 0;
+        uint64_t not_modified = 0;        // Answered 304 from If-None-Match
+        uint64_t latest_cache_hits = 0;   // /latest bodies served without serializing
+        uint64_t rejected = 0;            // Answered 503, worker queue full
+    };
+
+    /**
+     * @param config Listener and worker settings
+     * @param storage History source (may be null: /history answers 503)
+     * @param register_configs Names, units and gains for history scaling
+     */
+    QueryApiServer(const QueryApiConfig& config,
+                   SharedPtr<HybridDataStorage> storage,
+                   const std::map<RegisterAddress, RegisterConfig>& register_configs);
+    ~QueryApiServer();
+
+    QueryApiServer(const QueryApiServer&) = delete;
+    QueryApiServer& operator=(const QueryApiServer&) = delete;
+
+    /**
+     * @brief Record a new latest sample (called on the acquisition thread; O(log n) under a short lock)
+     */
+    void onSample(const AcquisitionSample& sample);
+
+    /**
+     * @brief Source of the /api/v1/statistics body (before start())
+     */
+    void setStatisticsProvider(StatisticsProvider provider);
+
+    /**
+     * @brief Serve one GET request (what the workers call; usable without a listener)
+     * @param path Request path, e.g. "/api/v1/latest/0"
+     * @param query Decoded query parameters
+     * @param if_none_match If-None-Match header value (empty if absent)
+     */
+    Response handle(const std::string& path,
+                    const std::map<std::string, std::string>& query,
+                    const std::string& if_none_match = "");
+
+    /**
+     * @brief Start the workers and open the listener
+     * @throws HttpException if the address cannot be bound
+     */
+    void start();
+
+    /**
+     * @brief Close the listener and join the workers (idempotent)
+     */
+    void stop();
+
+    bool isRunning() const { return running_; }
+    Statistics getStatistics() const;
+
+private:
+    struct Latest {
+        AcquisitionSample sample;
+        uint64_t version = 0;
+    };
+
+    Response latestAll(const std::string& if_none_match);
+    Response latestOne(const std::string& address_text, const std::string& if_none_match);
+    Response history(const std::map<std::string, std::string>& query);
+    Response statistics();
+
+    std::string makeEtag(const std::string& tag) const;
+    static bool etagMatches(const std::string& if_none_match, const std::string& etag);
+    static Response jsonResponse(uint16_t status, const nlohmann::json& body, std::string etag = "");
+    static Response errorResponse(uint16_t status, const std::string& message);
+
+    void enqueue(web::http::http_request request);
+    void workerLoop();
+    void serve(web::http::http_request& request);
+
+    QueryApiConfig config_;
+    SharedPtr<HybridDataStorage> storage_;
+    std::map<RegisterAddress, RegisterConfig> register_configs_;
+    StatisticsProvider statistics_provider_;
+    std::string epoch_;  // Distinguishes ETags of earlier processes
+
+    // Latest sample per register, written by onSample()
+    std::map<RegisterAddress, Latest> latest_;
+    std::atomic<uint64_t> generation_{0};
+    mutable std::mutex latest_mutex_;
+
+    // Serialized /latest body and the generation it reflects
+    std::shared_ptr<const std::string> latest_body_;
+    uint64_t latest_body_generation_ = 0;
+    std::mutex latest_body_mutex_;
+
+    // Worker pool
+    std::deque<web::http::http_request> pending_;
+    std::vector<std::thread> workers_;
+    std::mutex pending_mutex_;
+    std::condition_variable pending_cv_;
+    bool stop_requested_ = false;
+
+    std::unique_ptr<web::http::experimental::listener::http_listener> listener_;
+    bool running_ = false;
+
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> not_modified_{0};
+    std::atomic<uint64_t> latest_cache_hits_{0};
+    std::atomic<uint64_t> rejected_{0};
+};
+
+} // namespace ecoWatt
@@ -0,0 +1,159 @@
+/**
+ * @file read_coalescer.hpp
+ * @brief Single-flight coalescing of concurrent register reads
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include "transaction_queue.hpp"
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ecoWatt {
+
+/**
+ * @brief Lets concurrent reads of the same registers share one transaction
+ *
+ * The first caller for a range becomes the leader and performs the read.
+ * Callers whose (slave, start, count) range is covered by a read already in
+ * flight wait for it and receive their slice of its result, or its exception.
+ * Ranges that only partially overlap an in-flight read are issued on their
+ * own. A caller joins only flights queued on its own lane or a higher one,
+ * so a control or interactive read never waits behind background polling.
+ * Nothing is cached once the leader returns.
+ *
+ * A write retires the flights overlapping the registers it wrote, so a read
+ * that starts after the write completed never joins a read issued before it
+ * (callers already waiting on such a flight still receive its result).
+ *
+ * Callers that put several reads into one transaction (batched FC03 frames)
+ * use claim() to register each read before sending, then complete or fail
+ * the claims they lead and wait() on the others.
+ */
+class ReadCoalescer {
+    struct Flight;
+
+public:
+    using Reader = std::function<std::vector<RegisterValue>(RegisterAddress, uint16_t)>;
+
+    struct Statistics {
+        uint64_t leader_reads = 0;          // Reads actually performed
+        uint64_t coalesced_reads = 0;       // Duplicate reads suppressed
+        uint64_t coalesced_registers = 0;   // Registers served from another caller's read
+
+        double suppression_ratio() const {
+            uint64_t total = leader_reads + coalesced_reads;
+            return total > 0 ? static_cast<double>(coalesced_reads) / total : 0.0;
+        }
+    };
+
+    /**
+     * @brief One caller's registration for a read: either its leader or a waiter
+     *
+     * A leading claim must be completed or failed once its read returns; one
+     * dropped unresolved is unregistered and its waiters get std::future_error.
+     */
+    class Claim {
+    public:
+        Claim(Claim&& other) noexcept;
+        Claim& operator=(Claim&&) = delete;
+        ~Claim();
+
+        bool leading() const { return leading_; }
+
+        /**
+         * @brief Publish the leader's values to its waiters
+         */
+        void complete(const std::vector<RegisterValue>& values);
+
+        /**
+         * @brief Publish the leader's failure to its waiters
+         */
+        void fail(std::exception_ptr error);
+
+        /**
+         * @brief Waiter side: this claim's slice of the covering flight's result
+         * @throws Whatever the leader failed with
+         */
+        std::vector<RegisterValue> wait() const;
+
+    private:
+        friend class ReadCoalescer;
+        Claim(ReadCoalescer* owner, std::shared_ptr<Flight> flight, bool leading,
+              RegisterAddress start_address, uint16_t num_registers);
+
+        ReadCoalescer* owner_;             // Null once moved from or resolved
+        std::shared_ptr<Flight> flight_;
+        bool leading_;
+        RegisterAddress start_;
+        uint16_t count_;
+        std::promise<std::vector<RegisterValue>> promise_;  // Leader only
+    };
+
+    /**
+     * @brief Join a covering in-flight read of this or a higher lane, or lead a new one
+     */
+    Claim claim(SlaveAddress slave, RegisterAddress start_address, uint16_t num_registers,
+                TransactionLane lane);
+
+    /**
+     * @brief Read through @p reader unless a covering read is already in flight
+     * @param lane Lane @p reader queues on; only flights of this or a higher lane are joined
+     * @throws Whatever @p reader (or the shared leader read) throws
+     */
+    std::vector<RegisterValue> read(SlaveAddress slave, RegisterAddress start_address,
+                                    uint16_t num_registers, TransactionLane lane, const Reader& reader);
+
+    /**
+     * @brief Stop later reads from joining in-flight reads overlapping a written range
+     */
+    void retire(SlaveAddress slave, RegisterAddress start_address, uint16_t num_registers);
+
+    /**
+     * @brief Number of leader reads currently in flight
+     */
+    size_t inFlight() const;
+
+    Statistics getStatistics() const;
+    void resetStatistics();
+
+private:
+    struct Flight {
+        SlaveAddress slave;
+        RegisterAddress start;
+        uint16_t count;
+        TransactionLane lane;
+        std::shared_future<std::vector<RegisterValue>> result;
+
+        bool covers(SlaveAddress s, RegisterAddress a, uint16_t n) const {
+            return slave == s && a >= start &&
+                   static_cast<uint32_t>(a) + n <= static_cast<uint32_t>(start) + count;
+        }
+
+        bool overlaps(SlaveAddress s, RegisterAddress a, uint16_t n) const {
+            return slave == s && static_cast<uint32_t>(a) < static_cast<uint32_t>(start) + count &&
+                   static_cast<uint32_t>(start) < static_cast<uint32_t>(a) + n;
+        }
+    };
+
+    /**
+     * @brief Unregister a flight before publishing so late arrivals start a fresh read
+     */
+    void land(const std::shared_ptr<Flight>& flight);
+
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<Flight>> flights_;
+
+    std::atomic<uint64_t> leader_reads_{0};
+    std::atomic<uint64_t> coalesced_reads_{0};
+    std::atomic<uint64_t> coalesced_registers_{0};
+};
+
+} // namespace ecoWatt
@@ -0,0 +1,110 @@
+/**
+ * @file sample_filter.hpp
+ * @brief Report-by-exception filtering of samples before persistence
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace ecoWatt {
+
+/**
+ * @brief Per-register deadband, swinging-door compression and heartbeat
+ *
+ * Works on scaled values. The band for a register is
+ * max(deadband, deadband_percent% of the last stored value).
+ *
+ * - Deadband (CompressionMode::NONE): a sample is stored when it differs
+ *   from the last stored one by more than the band. Holding the last
+ *   stored value reproduces every dropped sample within the band.
+ * - Swinging door: a sample is held back while one straight line from the
+ *   last stored point can pass within the band of every sample since. When
+ *   that stops being possible the held sample is stored. Linear
+ *   interpolation between consecutive stored samples reproduces every
+ *   dropped sample within the band.
+ * - Heartbeat: a sample is stored whenever max_interval has passed since
+ *   the last stored one, so gaps stay bounded for slowly varying registers.
+ *
+ * Registers without any of these settings pass through unchanged, as do
+ * samples that are not newer than the previous one for their register.
+ */
+class SampleFilter {
+public:
+    struct Statistics {
+        uint64_t received = 0;
+        uint64_t stored = 0;
+
+        /**
+         * @brief Received samples per stored sample (1.0 = no reduction)
+         */
+        double reduction() const {
+            return stored > 0 ? static_cast<double>(received) / stored : 1.0;
+        }
+    };
+
+    /**
+     * @brief Replace the filter settings from the register configuration
+     *
+     * State for registers whose settings are unchanged is kept.
+     */
+    void configure(const std::map<RegisterAddress, RegisterConfig>& register_configs);
+
+    /**
+     * @brief Offer an acquired sample
+     * @return Samples to persist, oldest first (none, one, or a held
+     *         swinging-door sample followed by this one)
+     */
+    std::vector<AcquisitionSample> offer(const AcquisitionSample& sample);
+
+    /**
+     * @brief Store the samples still held by swinging-door compression
+     *
+     * Call before shutdown so the last segment of each register is closed.
+     */
+    std::vector<AcquisitionSample> flush();
+
+    Statistics getStatistics() const;
+    void resetStatistics();
+
+private:
+    struct Settings {
+        double deadband = 0.0;
+        double deadband_percent = 0.0;
+        CompressionMode compression = CompressionMode::NONE;
+        Duration max_interval = Duration(0);
+
+        bool operator==(const Settings& other) const {
+            return deadband == other.deadband && deadband_percent == other.deadband_percent &&
+                   compression == other.compression && max_interval == other.max_interval;
+        }
+    };
+
+    struct Channel {
+        Settings settings;
+        std::optional<AcquisitionSample> stored;  // Last persisted sample
+        std::optional<AcquisitionSample> held;    // Swinging door: latest sample not yet persisted
+        double slope_min = 0.0;                   // Feasible corridor slopes, per second
+        double slope_max = 0.0;
+    };
+
+    static double band(const Settings& settings, double reference);
+    static void archive(Channel& channel, const AcquisitionSample& sample);
+    static void swingingDoor(Channel& channel, const AcquisitionSample& sample,
+                             std::vector<AcquisitionSample>& out);
+
+    mutable std::mutex mutex_;
+    std::map<RegisterAddress, Channel> channels_;
+
+    std::atomic<uint64_t> received_{0};
+    std::atomic<uint64_t> stored_{0};
+};
+
+} // namespace ecoWatt
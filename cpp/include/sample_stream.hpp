@@ -0,0 +1,222 @@
+/**
+ * @file sample_stream.hpp
+ * @brief Live sample fan-out to Server-Sent Events clients
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include "latency_histogram.hpp"
+#include <cpprest/http_listener.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ecoWatt {
+
+/**
+ * @brief Serializes each sample once and fans it out to every subscriber
+ *
+ * publish() only queues the sample, so the acquisition thread pays for a
+ * copy. pump(), called from a single dispatcher thread, turns queued
+ * samples into immutable SSE events ("id", "event: sample", JSON "data")
+ * held in a ring of @c client_queue events, then hands each subscriber the
+ * shared events between its cursor and the head. Per subscriber that is a
+ * write of an already serialized buffer, never a serialization.
+ *
+ * A subscriber's Writer may refuse an event (its connection is not
+ * draining); the event stays in the ring. A subscriber that falls more
+ * than @c client_queue events behind loses the oldest ones (counted as
+ * drops), and once it has lost @c client_queue events without catching up
+ * to the head in between it is closed. A client that falls behind now and
+ * then but always catches up stays connected.
+ * Samples pushed out of the queue before the dispatcher serialized them
+ * count as drops too.
+ */
+class SampleBroadcaster {
+public:
+    /**
+     * @brief Writes one event to a client; false = not now (backpressure)
+     */
+    using Writer = std::function<bool(const std::string& event)>;
+    using Closer = std::function<void()>;
+
+    struct Statistics {
+        size_t subscribers = 0;
+        uint64_t published = 0;
+        uint64_t delivered = 0;      // Events written, summed over subscribers
+        uint64_t dropped = 0;        // Events skipped for slow subscribers or a stalled dispatcher
+        uint64_t evicted = 0;        // Subscribers closed for falling behind
+        HistogramSnapshot delivery_lag; // publish() to write into the client's buffer
+    };
+
+    struct SubscriberStatistics {
+        uint64_t id = 0;
+        uint64_t delivered = 0;
+        uint64_t dropped = 0;
+        uint64_t backlog = 0;          // Events published but not yet written
+        std::chrono::microseconds last_lag{0};
+    };
+
+    /**
+     * @param client_queue Events a subscriber may lag behind before losing the oldest
+     */
+    explicit SampleBroadcaster(size_t client_queue = 1024);
+    ~SampleBroadcaster();
+
+    SampleBroadcaster(const SampleBroadcaster&) = delete;
+    SampleBroadcaster& operator=(const SampleBroadcaster&) = delete;
+
+    /**
+     * @brief Queue a sample for fan-out (any thread)
+     */
+    void publish(const AcquisitionSample& sample);
+
+    /**
+     * @brief Add a subscriber (any thread); it receives events from the next pump()
+     * @param last_event_id Resume after this event if it is still in the ring
+     * @return Subscriber id
+     */
+    uint64_t subscribe(Writer writer, Closer closer, std::optional<uint64_t> last_event_id = std::nullopt);
+
+    /**
+     * @brief Close and remove a subscriber (any thread)
+     */
+    void unsubscribe(uint64_t id);
+
+    /**
+     * @brief Serialize queued samples and deliver to subscribers (dispatcher thread only)
+     * @return True when some subscriber still has undelivered events
+     */
+    bool pump();
+
+    /**
+     * @brief Send an SSE comment to subscribers with nothing pending (dispatcher thread only)
+     */
+    void heartbeat();
+
+    /**
+     * @brief Close every subscriber
+     */
+    void closeAll();
+
+    /**
+     * @brief Wake-up hook called after publish() and subscribe()
+     */
+    void setNotifier(std::function<void()> notifier) { notifier_ = std::move(notifier); }
+
+    Statistics getStatistics() const;
+    std::vector<SubscriberStatistics> getSubscriberStatistics() const;
+
+    /**
+     * @brief SSE event for one sample ("id: N\nevent: sample\ndata: {...}\n\n")
+     */
+    static std::string formatEvent(uint64_t id, const AcquisitionSample& sample);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Event {
+        uint64_t id = 0;
+        Clock::time_point published;
+        std::shared_ptr<const std::string> text;
+    };
+
+    struct Subscriber {
+        uint64_t id = 0;
+        Writer writer;
+        Closer closer;
+        uint64_t cursor = 0;           // Next event id to write
+        uint64_t delivered = 0;
+        uint64_t dropped = 0;
+        uint64_t episode_dropped = 0;  // Drops since the cursor last reached the head
+        int64_t last_lag_us = 0;
+    };
+
+    const size_t client_queue_;
+    std::function<void()> notifier_;
+
+    // Samples waiting for the dispatcher
+    std::deque<std::pair<AcquisitionSample, Clock::time_point>> inbox_;
+    std::mutex inbox_mutex_;
+
+    // Ring of serialized events; written by the dispatcher only
+    std::vector<Event> ring_;
+    std::atomic<uint64_t> head_{1};  // Id of the next event
+
+    std::vector<std::shared_ptr<Subscriber>> subscribers_;
+    mutable std::mutex subscribers_mutex_;  // Membership and per-subscriber counters
+    uint64_t next_subscriber_id_ = 1;
+
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> delivered_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> evicted_{0};
+    LatencyHistogram delivery_lag_;
+};
+
+/**
+ * @brief SSE endpoint (GET @c path) streaming every acquired sample
+ *
+ * Each client gets a chunked text/event-stream response backed by a
+ * cpprest producer/consumer buffer. A buffer still holding more than
+ * @c max_buffered_kb unread bytes counts as not draining, so its events
+ * back up in the broadcaster's ring until the client catches up or is
+ * evicted. A comment line every @c heartbeat_interval keeps idle
+ * connections open through proxies. Browsers reconnecting with
+ * Last-Event-ID resume where they left off when the gap is still queued.
+ */
+class SampleStreamServer {
+public:
+    explicit SampleStreamServer(const StreamConfig& config);
+    ~SampleStreamServer();
+
+    SampleStreamServer(const SampleStreamServer&) = delete;
+    SampleStreamServer& operator=(const SampleStreamServer&) = delete;
+
+    /**
+     * @brief Queue a sample for all clients (sample callback)
+     */
+    void publish(const AcquisitionSample& sample) { broadcaster_.publish(sample); }
+
+    /**
+     * @brief Open the listener and start the dispatcher thread
+     * @throws HttpException if the address cannot be bound
+     */
+    void start();
+
+    /**
+     * @brief Close all streams and the listener (idempotent)
+     */
+    void stop();
+
+    bool isRunning() const { return running_; }
+    const SampleBroadcaster& broadcaster() const { return broadcaster_; }
+
+private:
+    void handleGet(web::http::http_request request);
+    void dispatchLoop();
+
+    StreamConfig config_;
+    SampleBroadcaster broadcaster_;
+
+    std::unique_ptr<web::http::experimental::listener::http_listener> listener_;
+    std::thread dispatcher_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    bool wake_ = false;
+    bool stop_requested_ = false;
+    bool running_ = false;
+};
+
+} // namespace ecoWatt
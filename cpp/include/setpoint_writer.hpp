@@ -0,0 +1,146 @@
+/**
+ * @file setpoint_writer.hpp
+ * @brief Coalescing, rate-limited writer for setpoint registers
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace ecoWatt {
+
+/**
+ * @brief Outcome of a submitted setpoint
+ */
+enum class SetpointResult {
+    APPLIED,    // Written and confirmed by the inverter
+    COALESCED,  // Superseded by a later value before it was written
+    SKIPPED,    // Equal to the last confirmed value; nothing sent
+    FAILED      // The write was attempted and failed
+};
+
+/**
+ * @brief Applies setpoint writes on a worker thread
+ *
+ * At most one write per register is pending: a new value replaces the
+ * pending one (last writer wins) and the replaced submission completes as
+ * COALESCED. Writes to a register are spaced by at least the minimum
+ * interval, and values equal to the last confirmed one are not sent. A
+ * failed write, or a polled read-back that disagrees with the confirmed
+ * value (inverter reset, out-of-band write), forgets the confirmed value so
+ * the next submission is sent.
+ */
+class SetpointWriter {
+public:
+    using Writer = std::function<bool(RegisterAddress, RegisterValue)>;
+    using Clock = std::chrono::steady_clock;
+
+    struct Statistics {
+        uint64_t submitted = 0;
+        uint64_t applied = 0;
+        uint64_t coalesced = 0;
+        uint64_t skipped = 0;
+        uint64_t failed = 0;
+        uint64_t invalidated = 0;  // Confirmed values contradicted by a read-back
+    };
+
+    /**
+     * @brief Constructor
+     * @param writer Performs one confirmed write (e.g. write-and-verify)
+     * @param min_interval Minimum spacing between writes to the same register
+     */
+    SetpointWriter(Writer writer, Duration min_interval);
+
+    /**
+     * @brief Destructor; flushes pending writes
+     */
+    ~SetpointWriter();
+
+    SetpointWriter(const SetpointWriter&) = delete;
+    SetpointWriter& operator=(const SetpointWriter&) = delete;
+
+    /**
+     * @brief Queue a setpoint without waiting for it
+     */
+    std::shared_future<SetpointResult> submit(RegisterAddress address, RegisterValue value);
+
+    /**
+     * @brief Queue a setpoint and wait for its outcome
+     */
+    SetpointResult write(RegisterAddress address, RegisterValue value) {
+        return submit(address, value).get();
+    }
+
+    void setMinInterval(Duration min_interval);
+    Duration getMinInterval() const;
+
+    /**
+     * @brief Last value confirmed by the inverter for @p address, if known
+     */
+    std::optional<RegisterValue> getConfirmedValue(RegisterAddress address) const;
+
+    /**
+     * @brief Forget the confirmed value (e.g. after an out-of-band change)
+     */
+    void invalidate(RegisterAddress address);
+
+    /**
+     * @brief Compare a polled value of @p address with the confirmed one
+     *
+     * A differing value invalidates the confirmation. Reads taken before
+     * the confirming write finished, or while a write is in flight, are
+     * ignored; registers never written are not tracked.
+     */
+    void observe(RegisterAddress address, RegisterValue value, TimePoint read_time);
+
+    Statistics getStatistics() const;
+
+    static const char* toString(SetpointResult result);
+
+private:
+    struct Pending {
+        RegisterValue value;
+        std::shared_ptr<std::promise<SetpointResult>> promise;
+        std::shared_future<SetpointResult> future;
+    };
+
+    struct RegisterState {
+        std::optional<RegisterValue> confirmed;
+        TimePoint confirmed_at;  // When the confirming write returned
+        std::optional<Clock::time_point> last_write;
+        std::optional<Pending> pending;
+        bool in_flight = false;
+    };
+
+    void workerLoop();
+    void complete(Pending& pending, SetpointResult result);
+
+    Writer writer_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::map<RegisterAddress, RegisterState> registers_;
+    Duration min_interval_;
+    bool stopping_ = false;
+    std::thread worker_;
+
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> applied_{0};
+    std::atomic<uint64_t> coalesced_{0};
+    std::atomic<uint64_t> skipped_{0};
+    std::atomic<uint64_t> failed_{0};
+    std::atomic<uint64_t> invalidated_{0};
+};
+
+} // namespace ecoWatt
@@ -0,0 +1,74 @@
+/**
+ * @file shm_latest_publisher.hpp
+ * @brief Publishes latest samples into the shared-memory latest-value table
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include "shm_latest_table.hpp"
+#include <atomic>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace ecoWatt {
+
+/**
+ * @brief Writer side of the table described in shm_latest_table.hpp
+ *
+ * The constructor creates (or replaces) the segment with one slot per
+ * register, in address order, and publishes the header last. publish()
+ * is a seqlock write into the register's slot and takes no locks; the
+ * slot is claimed with a compare-and-swap on its sequence, so concurrent
+ * callbacks for the same register stay consistent.
+ */
+class ShmLatestPublisher {
+public:
+    struct Statistics {
+        uint64_t published = 0;
+        uint64_t unknown_register = 0;   // Samples without a slot
+    };
+
+    /**
+     * @param config Segment name and lifetime
+     * @param registers Registers that get a slot
+     * @throws StorageException if the segment cannot be created
+     */
+    ShmLatestPublisher(const SharedMemoryConfig& config, const std::map<RegisterAddress, RegisterConfig>& registers);
+
+    /**
+     * @brief Marks the table invalid for readers and, if configured and the
+     *        name still refers to this table, unlinks it
+     */
+    ~ShmLatestPublisher();
+
+    ShmLatestPublisher(const ShmLatestPublisher&) = delete;
+    ShmLatestPublisher& operator=(const ShmLatestPublisher&) = delete;
+
+    /**
+     * @brief Write a sample into its register's slot (sample callback)
+     */
+    void publish(const AcquisitionSample& sample);
+
+    const std::string& name() const { return config_.name; }
+    size_t slotCount() const { return slot_count_; }
+    Statistics getStatistics() const;
+
+private:
+    SharedMemoryConfig config_;
+    void* base_ = nullptr;
+    size_t size_ = 0;
+    size_t slot_count_ = 0;
+    ShmTableHeader* header_ = nullptr;
+    ShmSlot* slots_ = nullptr;
+    dev_t device_ = 0;                 // Identify our segment so a successor's is never unlinked
+    ino_t inode_ = 0;
+    std::unordered_map<RegisterAddress, ShmSlot*> slot_by_address_;  // Fixed after construction
+
+    std::atomic<uint64_t> unknown_register_{0};
+};
+
+} // namespace ecoWatt
@@ -0,0 +1,237 @@
+/**
+ * @file shm_latest_table.hpp
+ * @brief Shared-memory latest-value table layout and header-only reader
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ *
+ * Self-contained (standard library and POSIX only) so that co-located
+ * processes can include it without the rest of the device code.
+ *
+ * Layout of the segment (all little-endian, native alignment):
+ *
+ *   offset 0    ShmTableHeader (64 bytes)
+ *   offset 64   ShmSlot[slot_count] (64 bytes each, one cache line)
+ *
+ * Slot metadata (address, name, unit) is written once before the header's
+ * magic is published. The value fields are guarded by a per-slot sequence
+ * counter (seqlock): the publisher makes it odd, stores the fields and
+ * makes it even again. A reader copies the fields between two loads of the
+ * counter and keeps the copy only when both loads are equal and even, so a
+ * read never blocks the publisher and never returns a torn sample.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ecoWatt {
+
+constexpr uint32_t kShmTableMagic = 0x544C5745;  // "EWLT"
+constexpr uint32_t kShmTableVersion = 2;
+constexpr size_t kShmSlotNameSize = 20;
+constexpr size_t kShmSlotUnitSize = 12;
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free &&
+              std::atomic<int64_t>::is_always_lock_free &&
+              std::atomic<double>::is_always_lock_free,
+              "Shared-memory slots need address-free (lock-free) atomics");
+
+/**
+ * @brief Segment header
+ */
+struct alignas(64) ShmTableHeader {
+    std::atomic<uint32_t> magic;          // kShmTableMagic once the table is ready; 0 after the publisher exits
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t slot_size;
+    int64_t created_ns;                   // Publisher start, ns since the Unix epoch
+    int32_t publisher_pid;
+    uint32_t reserved;
+    std::atomic<uint64_t> publish_count;  // Slot updates since creation
+};
+
+/**
+ * @brief One register; exactly one cache line so slots never share a line
+ */
+struct alignas(64) ShmSlot {
+    std::atomic<uint32_t> sequence;       // Odd while being written; 0 = no sample yet
+    uint16_t address;
+    uint16_t reserved;
+    std::atomic<int64_t> raw_value;
+    std::atomic<int64_t> timestamp_ns;    // Acquisition time, ns since the Unix epoch
+    std::atomic<double> value;            // Scaled value
+    char name[kShmSlotNameSize];          // NUL-terminated, truncated
+    char unit[kShmSlotUnitSize];
+};
+
+static_assert(sizeof(ShmTableHeader) == 64, "ShmTableHeader must be one cache line");
+static_assert(sizeof(ShmSlot) == 64, "ShmSlot must be one cache line");
+
+/**
+ * @brief Size of a segment holding @p slot_count slots
+ */
+inline size_t shmTableSize(uint32_t slot_count) {
+    return sizeof(ShmTableHeader) + static_cast<size_t>(slot_count) * sizeof(ShmSlot);
+}
+
+/**
+ * @brief Consistent copy of one slot
+ */
+struct ShmReading {
+    uint16_t address = 0;
+    int64_t raw_value = 0;
+    double value = 0.0;
+    int64_t timestamp_ns = 0;
+    uint32_t sequence = 0;                // Changes on every update; 0 = never written
+};
+
+/**
+ * @brief Maps a table read-only and takes seqlock snapshots of its slots
+ *
+ * Look slots up once with findSlot() and keep the index; tryRead() is a
+ * single wait-free attempt (a few loads), read() retries while the
+ * publisher is mid-update. When the publisher restarts it creates a new
+ * segment, so a reader seeing valid() turn false should reopen.
+ *
+ * @code
+ * ecoWatt::ShmLatestReader table("/ecowatt_latest");
+ * int voltage = table.findSlot(0);
+ * ecoWatt::ShmReading reading;
+ * if (voltage >= 0 && table.read(voltage, reading) && reading.sequence != 0) {
+ *     use(reading.value);
+ * }
+ * @endcode
+ */
+class ShmLatestReader {
+public:
+    /**
+     * @param name POSIX shared-memory name, e.g. "/ecowatt_latest"
+     * @throws std::system_error if the segment cannot be opened or mapped
+     * @throws std::runtime_error if it is not a compatible table
+     */
+    explicit ShmLatestReader(const std::string& name) {
+        const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "fstat " + name);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ < sizeof(ShmTableHeader)) {
+            ::close(fd);
+            throw std::runtime_error(name + " is not initialized");
+        }
+        void* base = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        const int error = errno;
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), "mmap " + name);
+        }
+        base_ = base;
+        header_ = static_cast<const ShmTableHeader*>(base);
+        slots_ = reinterpret_cast<const ShmSlot*>(static_cast<const char*>(base) + sizeof(ShmTableHeader));
+
+        if (header_->magic.load(std::memory_order_acquire) != kShmTableMagic ||
+            header_->version != kShmTableVersion || header_->slot_size != sizeof(ShmSlot) ||
+            shmTableSize(header_->slot_count) > size_) {
+            unmap();
+            throw std::runtime_error(name + " is not a compatible latest-value table");
+        }
+    }
+
+    ~ShmLatestReader() { unmap(); }
+
+    ShmLatestReader(const ShmLatestReader&) = delete;
+    ShmLatestReader& operator=(const ShmLatestReader&) = delete;
+
+    /**
+     * @brief False once the publisher has exited (reopen to follow a new one)
+     */
+    bool valid() const { return header_->magic.load(std::memory_order_acquire) == kShmTableMagic; }
+
+    size_t slotCount() const { return header_->slot_count; }
+    uint64_t publishCount() const { return header_->publish_count.load(std::memory_order_relaxed); }
+    int32_t publisherPid() const { return header_->publisher_pid; }
+
+    /**
+     * @brief Slot index of a register address, or -1
+     */
+    int findSlot(uint16_t address) const {
+        for (uint32_t i = 0; i < header_->slot_count; ++i) {
+            if (slots_[i].address == address) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    const char* name(size_t slot) const { return slots_[slot].name; }
+    const char* unit(size_t slot) const { return slots_[slot].unit; }
+    uint16_t address(size_t slot) const { return slots_[slot].address; }
+
+    /**
+     * @brief One snapshot attempt
+     * @return False if the publisher was writing the slot; @p out is then unspecified
+     */
+    bool tryRead(size_t slot, ShmReading& out) const {
+        const ShmSlot& s = slots_[slot];
+        const uint32_t before = s.sequence.load(std::memory_order_acquire);
+        if (before & 1u) {
+            return false;
+        }
+        out.raw_value = s.raw_value.load(std::memory_order_relaxed);
+        out.value = s.value.load(std::memory_order_relaxed);
+        out.timestamp_ns = s.timestamp_ns.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s.sequence.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        out.address = s.address;
+        out.sequence = before;
+        return true;
+    }
+
+    /**
+     * @brief Snapshot, retrying while the publisher is mid-update
+     * @return False only if every attempt overlapped a write
+     */
+    bool read(size_t slot, ShmReading& out, unsigned max_attempts = 64) const {
+        for (unsigned attempt = 0; attempt < max_attempts; ++attempt) {
+            if (tryRead(slot, out)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    void unmap() {
+        if (base_) {
+            ::munmap(base_, size_);
+            base_ = nullptr;
+        }
+    }
+
+    void* base_ = nullptr;
+    size_t size_ = 0;
+    const ShmTableHeader* header_ = nullptr;
+    const ShmSlot* slots_ = nullptr;
+};
+
+} // namespace ecoWatt
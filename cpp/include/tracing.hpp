@@ -0,0 +1,117 @@
+/**
+ * @file tracing.hpp
+ * @brief RAII trace spans recorded to per-thread rings, exported as Chrome trace JSON
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace ecoWatt {
+
+/**
+ * @brief Process-wide span recorder
+ *
+ * Every thread that records gets its own ring of complete events (name,
+ * category, start and duration in nanoseconds of steady_clock). A ring
+ * grows with the spans recorded up to buffer_events; once full, its
+ * oldest spans are overwritten.
+ * Rings outlive their threads until clear().
+ *
+ * The export is Chrome trace-event JSON ("ph": "X" events, microsecond
+ * timestamps with nanosecond fractions), loadable in chrome://tracing and
+ * Perfetto.
+ *
+ * While disabled, a span costs one relaxed atomic load.
+ */
+class Tracer {
+public:
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Enable or disable recording
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * @brief Apply a tracing configuration (ring size, enable flag, periodic dumps)
+     */
+    static void configure(const TracingConfig& config);
+
+    /**
+     * @brief Nanoseconds since the tracer epoch
+     */
+    static uint64_t now();
+
+    /**
+     * @brief Append a complete span to the calling thread's ring
+     * @param name, category String literals (stored by pointer)
+     */
+    static void record(const char* name, const char* category, uint64_t start_ns, uint64_t end_ns);
+
+    /**
+     * @brief Export all rings as Chrome trace-event JSON
+     */
+    static std::string toChromeJson();
+
+    /**
+     * @brief Write toChromeJson() to @p path
+     * @return False when the file cannot be written
+     */
+    static bool writeChromeTrace(const std::string& path);
+
+    /**
+     * @brief Drop recorded spans and the rings of exited threads
+     */
+    static void clear();
+
+    /**
+     * @brief Spans currently held across all rings
+     */
+    static size_t eventCount();
+
+    /**
+     * @brief Write <output stem>.<n>.json every @p interval, cycling n over @p files
+     */
+    static void startPeriodicDump(const std::string& output, Duration interval, uint32_t files);
+    static void stopPeriodicDump();
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * @brief Records the enclosing scope as one span while tracing is enabled
+ */
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name, const char* category = "ecoWatt")
+        : name_(name), category_(category), start_(Tracer::enabled() ? Tracer::now() : 0) {}
+
+    ~TraceSpan() {
+        if (start_ != 0) {
+            Tracer::record(name_, category_, start_, Tracer::now());
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name_;
+    const char* category_;
+    uint64_t start_;
+};
+
+#define ECOWATT_TRACE_CONCAT_INNER(a, b) a##b
+#define ECOWATT_TRACE_CONCAT(a, b) ECOWATT_TRACE_CONCAT_INNER(a, b)
+
+// Span covering the rest of the enclosing scope
+#define TRACE_SPAN(...) ecoWatt::TraceSpan ECOWATT_TRACE_CONCAT(ecowatt_trace_span_, __LINE__)(__VA_ARGS__)
+
+} // namespace ecoWatt
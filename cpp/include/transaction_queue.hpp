@@ -0,0 +1,108 @@
+/**
+ * @file transaction_queue.hpp
+ * @brief Prioritized admission of inverter transactions
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include "latency_histogram.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace ecoWatt {
+
+/**
+ * @brief Transaction lanes, highest priority first
+ */
+enum class TransactionLane : size_t {
+    CONTROL = 0,      // Setpoint writes
+    INTERACTIVE = 1,  // Status refreshes and on-demand reads
+    BACKGROUND = 2    // Periodic polling
+};
+
+/**
+ * @brief Lets transactions onto the wire up to a capacity, highest lane first
+ *
+ * Waiting callers are admitted strictly by lane and FIFO within a lane, so a
+ * control write queued behind a background poll goes next instead of waiting
+ * for the rest of the poll cycle. Admission is per wire transaction: callers
+ * should hold a Slot for one request/response exchange only, not across
+ * retry delays.
+ *
+ * The capacity defaults to one (serial links); pipelining transports such as
+ * Modbus TCP raise it to their in-flight limit.
+ */
+class TransactionQueue {
+public:
+    static constexpr size_t kLaneCount = 3;
+
+    /**
+     * @brief RAII admission; the wire is released when the slot is destroyed
+     */
+    class Slot {
+    public:
+        Slot(Slot&& other) noexcept : queue_(other.queue_) { other.queue_ = nullptr; }
+        Slot(const Slot&) = delete;
+        Slot& operator=(const Slot&) = delete;
+        Slot& operator=(Slot&&) = delete;
+        ~Slot() { if (queue_) queue_->release(); }
+
+    private:
+        friend class TransactionQueue;
+        explicit Slot(TransactionQueue* queue) : queue_(queue) {}
+
+        TransactionQueue* queue_;
+    };
+
+    struct LaneStatistics {
+        uint64_t admitted = 0;
+        size_t waiting = 0;
+        HistogramSnapshot queue_latency; // Enqueue to admission
+    };
+
+    TransactionQueue() = default;
+    TransactionQueue(const TransactionQueue&) = delete;
+    TransactionQueue& operator=(const TransactionQueue&) = delete;
+
+    /**
+     * @brief Block until @p lane may use the wire
+     */
+    Slot acquire(TransactionLane lane);
+
+    /**
+     * @brief Set how many transactions may be on the wire at once (minimum 1)
+     */
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const;
+
+    /**
+     * @brief Transactions currently admitted
+     */
+    size_t inFlight() const;
+
+    LaneStatistics getLaneStatistics(TransactionLane lane) const;
+    void resetStatistics();
+
+    static const char* laneName(TransactionLane lane);
+
+private:
+    void release();
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    size_t capacity_ = 1;
+    size_t in_flight_ = 0;
+    uint64_t next_ticket_ = 0;
+    std::array<std::deque<uint64_t>, kLaneCount> waiting_;
+
+    std::array<std::atomic<uint64_t>, kLaneCount> admitted_{};
+    std::array<LatencyHistogram, kLaneCount> queue_latency_;
+};
+
+} // namespace ecoWatt
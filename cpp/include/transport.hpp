@@ -0,0 +1,88 @@
+/**
+ * @file transport.hpp
+ * @brief Transport interface between ProtocolAdapter and the inverter
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include "exceptions.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ecoWatt {
+
+class ConfigManager;
+
+/**
+ * @brief Kind of request, for transports that route reads and writes differently
+ */
+enum class TransportOperation {
+    READ,
+    WRITE
+};
+
+/**
+ * @brief Carries one Modbus request/response exchange
+ *
+ * Requests and responses are Modbus RTU frames (slave address, PDU, CRC) so
+ * ModbusFrame builds and parses them the same way for every transport.
+ * Implementations must be safe to call from several threads; at most
+ * maxInFlight() calls are admitted concurrently by ProtocolAdapter.
+ *
+ * Link-level failures are reported as HttpException, TransportException or
+ * TimeoutException, which ProtocolAdapter retries. An empty response means
+ * the slave did not answer.
+ */
+class Transport {
+public:
+    virtual ~Transport() = default;
+
+    /**
+     * @brief Send @p request and wait for the matching response
+     */
+    virtual std::vector<uint8_t> transact(const std::vector<uint8_t>& request,
+                                          TransportOperation operation) = 0;
+
+    /**
+     * @brief Send several requests in one round trip
+     *
+     * Only called when supportsBatch() is true. Responses come back in
+     * request order; an empty entry means that request got no response.
+     * A failure of the round trip itself throws as transact() does.
+     */
+    virtual std::vector<std::vector<uint8_t>> transactBatch(const std::vector<std::vector<uint8_t>>& requests,
+                                                            TransportOperation operation) {
+        (void)requests;
+        (void)operation;
+        throw TransportException("Batch requests are not supported by " + describe());
+    }
+
+    virtual bool supportsBatch() const { return false; }
+
+    /**
+     * @brief Largest number of requests per transactBatch() call
+     */
+    virtual size_t maxBatchSize() const { return 1; }
+
+    /**
+     * @brief Requests that may be outstanding at once
+     */
+    virtual size_t maxInFlight() const { return 1; }
+
+    /**
+     * @brief Human-readable endpoint, for logs
+     */
+    virtual std::string describe() const = 0;
+};
+
+/**
+ * @brief Create the transport selected by ModbusConfig::transport
+ * @throws ConfigException for an unsupported transport
+ */
+UniquePtr<Transport> createTransport(const ConfigManager& config);
+
+} // namespace ecoWatt
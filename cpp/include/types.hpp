@@ -19,6 +19,7 @@ namespace ecoWatt {
 // Type aliases for clarity
 using RegisterAddress = uint16_t;
 using RegisterValue = uint16_t;
+using SampleRawValue = int64_t;   // Raw value of a sample; derived registers may be wide or negative
 using SlaveAddress = uint8_t;
 using FunctionCode = uint8_t;
 using TimePoint = std::chrono::system_clock::time_point;
@@ -27,7 +28,43 @@ using Duration = std::chrono::milliseconds;
 // Modbus function codes
 enum class ModbusFunction : FunctionCode {
     READ_HOLDING_REGISTERS = 0x03,
-    WRITE_SINGLE_REGISTER = 0x06
+    WRITE_SINGLE_REGISTER = 0x06,
+    WRITE_MULTIPLE_REGISTERS = 0x10,
+    READ_WRITE_MULTIPLE_REGISTERS = 0x17
+};
+
+// Transport between ProtocolAdapter and the inverter
+enum class TransportType {
+    HTTP,        // Hex frames in the Inverter SIM JSON envelope
+    MODBUS_TCP,  // Native Modbus TCP (MBAP framing)
+    MODBUS_RTU   // Binary RTU frames on a serial line (RS-485)
+};
+
+// Serial line parity (Modbus RTU uses 2 stop bits when parity is NONE)
+enum class SerialParity {
+    NONE,
+    EVEN,
+    ODD
+};
+
+// Storage-side compression of slowly varying registers
+enum class CompressionMode {
+    NONE,          // Deadband only (report by exception)
+    SWINGING_DOOR  // Piecewise-linear, deadband is the corridor half-width
+};
+
+// Alarm rule conditions (rates are per second)
+enum class AlarmCondition {
+    ABOVE,
+    BELOW,
+    RATE_ABOVE,
+    RATE_BELOW
+};
+
+enum class AlarmSeverity {
+    INFO,
+    WARNING,
+    CRITICAL
 };
 
 // Register access types
@@ -50,6 +87,12 @@ enum class LogLevel {
     CRITICAL
 };
 
+// What an async logger does when its queue is full
+enum class LogOverflowPolicy {
+    BLOCK,          // Caller waits for space
+    OVERRUN_OLDEST  // Oldest queued message is dropped
+};
+
 // Register configuration structure
 struct RegisterConfig {
     RegisterAddress address;
@@ -58,6 +101,13 @@ struct RegisterConfig {
     double gain;
     AccessType access;
     std::string description;
+    Duration max_age = Duration(0); // Latest-value cache freshness (0 = acquisition default)
+    
+    // Storage filtering (see SampleFilter); scaled units, 0 = off
+    double deadband = 0.0;
+    double deadband_percent = 0.0;  // Of the last stored value
+    CompressionMode compression = CompressionMode::NONE;
+    Duration max_interval = Duration(0); // Heartbeat: store at least this often
     
     RegisterConfig() = default;
     
@@ -66,19 +116,43 @@ struct RegisterConfig {
         : address(addr), name(n), unit(u), gain(g), access(a), description(desc) {}
 };
 
+// Virtual register computed from other registers after each poll cycle
+struct DerivedMetricConfig {
+    RegisterAddress address = 0;
+    std::string name;
+    std::string unit;
+    std::string description;
+    double gain = 1.0;                   // raw_value = llround(value * gain), signed; > 0
+    std::string expression;              // Over register names or r<address>
+    bool integrate = false;              // Publish the running integral of expression (per hour)
+    double scale = 1.0;                  // Applied to the integral, e.g. 0.001 for Wh -> kWh
+    Duration max_gap = Duration(60000);  // Longer gaps between cycles are not integrated across
+};
+
+// Alarm rule evaluated on each sample of one register
+struct AlarmRuleConfig {
+    std::string name;
+    RegisterAddress address = 0;
+    AlarmCondition condition = AlarmCondition::ABOVE;
+    double threshold = 0.0;             // Scaled units (per second for rates)
+    double hysteresis = 0.0;            // Clears once back past threshold by this much
+    Duration duration = Duration(0);    // Condition must hold this long before raising
+    AlarmSeverity severity = AlarmSeverity::WARNING;
+};
+
 // Acquisition sample structure
 struct AcquisitionSample {
     TimePoint timestamp;
     RegisterAddress register_address;
     std::string register_name;
-    RegisterValue raw_value;
+    SampleRawValue raw_value;
     double scaled_value;
     std::string unit;
     
     AcquisitionSample() = default;
     
     AcquisitionSample(TimePoint ts, RegisterAddress addr, const std::string& name,
-                     RegisterValue raw, double scaled, const std::string& u)
+                     SampleRawValue raw, double scaled, const std::string& u)
         : timestamp(ts), register_address(addr), register_name(name),
           raw_value(raw), scaled_value(scaled), unit(u) {}
 };
@@ -110,6 +184,14 @@ struct AcquisitionStatistics {
     }
 };
 
+// One persisted row with its insertion id (raw register units)
+struct StoredSample {
+    uint64_t id = 0;
+    RegisterAddress register_address = 0;
+    double value = 0.0;
+    TimePoint timestamp;
+};
+
 struct StorageStatistics {
     uint64_t total_samples = 0;
     std::map<RegisterAddress, uint64_t> samples_by_register;
@@ -124,6 +206,13 @@ struct ModbusConfig {
     Duration timeout = Duration(5000);
     uint32_t max_retries = 3;
     Duration retry_delay = Duration(1000);
+    TransportType transport = TransportType::HTTP;
+    std::string tcp_host = "127.0.0.1";
+    uint16_t tcp_port = 502;
+    uint32_t tcp_max_in_flight = 4; // Pipelined requests per Modbus TCP connection
+    std::string serial_device = "/dev/ttyUSB0";
+    uint32_t serial_baud_rate = 9600;
+    SerialParity serial_parity = SerialParity::EVEN; // Modbus RTU default 8E1
 };
 
 struct AcquisitionConfig {
@@ -131,6 +220,8 @@ struct AcquisitionConfig {
     uint32_t max_samples_per_register = 1000;
     std::vector<RegisterAddress> minimum_registers = {0, 1};
     bool enable_background_polling = true;
+    Duration cache_max_age = Duration(20000); // Default freshness for cached latest values
+    Duration setpoint_min_interval = Duration(1000); // Minimum spacing of writes to one setpoint register
 };
 
 struct StorageConfig {
@@ -139,6 +230,8 @@ struct StorageConfig {
     Duration cleanup_interval = Duration(24 * 60 * 60 * 1000); // 24 hours
     uint32_t data_retention_days = 30;
     std::string database_path = "ecoWatt_milestone2.db";
+    std::string snapshot_path;              // Memory-mapped copy of the memory rings; empty disables
+    uint32_t snapshot_max_registers = 64;
 };
 
 struct ApiConfig {
@@ -146,6 +239,9 @@ struct ApiConfig {
     std::string api_key;
     std::string read_endpoint = "/api/inverter/read";
     std::string write_endpoint = "/api/inverter/write";
+    std::string batch_endpoint = "/api/inverter/batch"; // {"frames":[...]}; empty disables
+    bool enable_batch = false;    // Probe the gateway for batch support at startup
+    uint32_t batch_max_frames = 32;
     std::string content_type = "application/json";
     std::string accept = "*/*";
 };
@@ -157,6 +253,71 @@ struct LoggingConfig {
     uint32_t max_file_size_mb = 10;
     uint32_t max_files = 5;
     std::string format = "[%Y-%m-%d %H:%M:%S] [%l] %v";
+    bool async = false;                  // Format and write on a background thread
+    uint32_t async_queue_size = 8192;    // Messages
+    LogOverflowPolicy async_overflow = LogOverflowPolicy::BLOCK;
+    // Per-call-site limits for warnings and errors (see LogSite)
+    bool suppress_enabled = true;
+    uint32_t suppress_burst = 10;                       // Messages before rate limiting
+    double suppress_per_minute = 6.0;                   // Sustained rate after the burst
+    Duration suppress_summary_interval = Duration(60000);
+};
+
+// Span tracing configuration
+struct TracingConfig {
+    bool enabled = false;
+    uint32_t buffer_events = 4096;            // Ring size per thread (32 bytes per span)
+    std::string output = "ecoWatt_trace.json";
+    Duration dump_interval = Duration(0);     // 0 = only on demand and at shutdown
+    uint32_t dump_files = 4;                  // Periodic dumps cycle over this many files
+};
+
+struct MetricsConfig {
+    bool enabled = false;
+    std::string listen_url = "http://0.0.0.0:9464";
+    std::string path = "/metrics";
+    Duration refresh_interval = Duration(5000);  // Scrapes are served from the last refresh
+};
+
+struct QueryApiConfig {
+    bool enabled = false;
+    std::string listen_url = "http://0.0.0.0:8081";
+    uint32_t threads = 2;                 // Request workers
+    uint32_t queue_limit = 64;            // Requests waiting for a worker before 503
+    uint32_t max_history_points = 2000;   // Coarsens the requested resolution to fit
+};
+
+struct StreamConfig {
+    bool enabled = false;
+    std::string listen_url = "http://0.0.0.0:8082";
+    std::string path = "/api/v1/stream";
+    uint32_t client_queue = 1024;         // Events a client may lag behind before losing the oldest
+    uint32_t max_buffered_kb = 256;       // Unsent bytes per connection before it counts as not draining
+    uint32_t max_clients = 500;
+    Duration heartbeat_interval = Duration(15000);
+};
+
+struct SharedMemoryConfig {
+    bool enabled = false;
+    std::string name = "/ecowatt_latest";  // POSIX shm name (appears as /dev/shm/ecowatt_latest)
+    bool unlink_on_exit = true;            // Remove the segment on shutdown
+};
+
+// Store-and-forward delivery of persisted samples to a cloud collector
+struct UplinkConfig {
+    bool enabled = false;
+    std::string collector_url = "http://127.0.0.1:8090";
+    std::string path = "/api/v1/ingest";
+    std::string api_key;                         // From UPLINK_API_KEY in .env; sent as Authorization
+    uint32_t batch_max_samples = 5000;           // A full batch is sent at once
+    uint32_t batch_max_bytes = 256 * 1024;       // Encoded size before compression
+    Duration batch_max_age = Duration(30000);    // A partial batch is sent once its oldest row is this old
+    Duration poll_interval = Duration(1000);     // Checks for new rows while caught up
+    Duration request_timeout = Duration(30000);
+    Duration retry_initial = Duration(1000);     // Backoff after a failed delivery, doubling
+    Duration retry_max = Duration(300000);
+    double max_batches_per_second = 5.0;         // Catch-up pacing (0 = unlimited)
+    bool compress = true;                        // gzip the encoded batch
 };
 
 // Smart pointer aliases
@@ -193,6 +354,82 @@ inline AccessType access_from_string(const std::string& str) {
     return AccessType::READ_ONLY;
 }
 
+inline std::string to_string(TransportType transport) {
+    switch (transport) {
+        case TransportType::HTTP: return "http";
+        case TransportType::MODBUS_TCP: return "modbus_tcp";
+        case TransportType::MODBUS_RTU: return "modbus_rtu";
+        default: return "unknown";
+    }
+}
+
+inline TransportType transport_from_string(const std::string& str) {
+    if (str == "http") return TransportType::HTTP;
+    if (str == "modbus_tcp") return TransportType::MODBUS_TCP;
+    if (str == "modbus_rtu") return TransportType::MODBUS_RTU;
+    return TransportType::HTTP;
+}
+
+inline std::string to_string(SerialParity parity) {
+    switch (parity) {
+        case SerialParity::NONE: return "none";
+        case SerialParity::EVEN: return "even";
+        case SerialParity::ODD: return "odd";
+        default: return "unknown";
+    }
+}
+
+inline SerialParity parity_from_string(const std::string& str) {
+    if (str == "none") return SerialParity::NONE;
+    if (str == "odd") return SerialParity::ODD;
+    return SerialParity::EVEN;
+}
+
+inline std::string to_string(CompressionMode mode) {
+    switch (mode) {
+        case CompressionMode::NONE: return "none";
+        case CompressionMode::SWINGING_DOOR: return "swinging_door";
+        default: return "unknown";
+    }
+}
+
+inline CompressionMode compression_from_string(const std::string& str) {
+    if (str == "swinging_door") return CompressionMode::SWINGING_DOOR;
+    return CompressionMode::NONE;
+}
+
+inline std::string to_string(AlarmCondition condition) {
+    switch (condition) {
+        case AlarmCondition::ABOVE: return "above";
+        case AlarmCondition::BELOW: return "below";
+        case AlarmCondition::RATE_ABOVE: return "rate_above";
+        case AlarmCondition::RATE_BELOW: return "rate_below";
+        default: return "unknown";
+    }
+}
+
+inline AlarmCondition alarm_condition_from_string(const std::string& str) {
+    if (str == "below") return AlarmCondition::BELOW;
+    if (str == "rate_above") return AlarmCondition::RATE_ABOVE;
+    if (str == "rate_below") return AlarmCondition::RATE_BELOW;
+    return AlarmCondition::ABOVE;
+}
+
+inline std::string to_string(AlarmSeverity severity) {
+    switch (severity) {
+        case AlarmSeverity::INFO: return "info";
+        case AlarmSeverity::WARNING: return "warning";
+        case AlarmSeverity::CRITICAL: return "critical";
+        default: return "unknown";
+    }
+}
+
+inline AlarmSeverity alarm_severity_from_string(const std::string& str) {
+    if (str == "info") return AlarmSeverity::INFO;
+    if (str == "critical") return AlarmSeverity::CRITICAL;
+    return AlarmSeverity::WARNING;
+}
+
 inline std::string to_string(LogLevel level) {
     switch (level) {
         case LogLevel::TRACE: return "TRACE";
@@ -215,4 +452,17 @@ inline LogLevel log_level_from_string(const std::string& str) {
     return LogLevel::INFO;
 }
 
+inline std::string to_string(LogOverflowPolicy policy) {
+    switch (policy) {
+        case LogOverflowPolicy::BLOCK: return "block";
+        case LogOverflowPolicy::OVERRUN_OLDEST: return "overrun_oldest";
+        default: return "unknown";
+    }
+}
+
+inline LogOverflowPolicy log_overflow_from_string(const std::string& str) {
+    if (str == "overrun_oldest") return LogOverflowPolicy::OVERRUN_OLDEST;
+    return LogOverflowPolicy::BLOCK;
+}
+
 } // namespace ecoWatt
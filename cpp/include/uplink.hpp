@@ -0,0 +1,153 @@
+/**
+ * @file uplink.hpp
+ * @brief Store-and-forward delivery of persisted samples to the cloud collector
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include "data_storage.hpp"
+#include "http_client.hpp"
+#include "latency_histogram.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ecoWatt {
+
+/**
+ * @brief Forwards SQLite rows to a collector in batches, resuming after restarts
+ *
+ * The uplink owns a cursor (the last acknowledged row id) persisted in the
+ * database's cursors table. Each cycle reads the rows after it on the
+ * read-only connection, encodes them with UplinkBatchEncoder (up to
+ * batch_max_samples rows or batch_max_bytes), gzips the result and POSTs
+ * it. The cursor only moves to the id the collector acknowledges, so a
+ * crash, a timeout or an outage at any point leads to a resend, never a
+ * gap; the collector drops rows it already has. An ack that does not
+ * move the cursor forward counts as a failed delivery.
+ *
+ * A batch is sent when it is full or when its oldest row is batch_max_age
+ * old. While rows are waiting, a cycle costs one MAX(id) query. Failed
+ * deliveries back off exponentially (with jitter) from retry_initial to
+ * retry_max. After an outage the backlog is drained at up to
+ * max_batches_per_second full batches, reading by primary key on the
+ * read-only connection, so catch-up does not hold the writer that
+ * acquisition stores through.
+ */
+class UplinkForwarder {
+public:
+    static constexpr const char* kCursorName = "uplink";
+
+    /**
+     * @brief One encoded batch ready to send
+     */
+    struct Delivery {
+        std::vector<uint8_t> body;
+        std::string content_encoding;   // "gzip" or empty
+        uint64_t first_id = 0;
+        uint64_t last_id = 0;
+        size_t samples = 0;
+    };
+
+    /**
+     * @brief Sends a batch and returns the highest id the collector acknowledged
+     * @throws on transport errors and rejected batches
+     */
+    using Sender = std::function<uint64_t(const Delivery&)>;
+
+    enum class CycleResult {
+        SENT,       // A batch was acknowledged
+        WAITING,    // Rows pending, batch neither full nor old enough
+        IDLE,       // Nothing after the cursor
+        FAILED      // Delivery failed; backing off
+    };
+
+    struct Statistics {
+        uint64_t batches_sent = 0;
+        uint64_t samples_sent = 0;
+        uint64_t bytes_encoded = 0;       // Before compression
+        uint64_t bytes_sent = 0;          // Request bodies as sent
+        uint64_t failures = 0;
+        uint32_t consecutive_failures = 0;
+        uint64_t cursor = 0;              // Last acknowledged row id
+        uint64_t newest_id = 0;           // Newest row seen in storage
+        uint64_t backlog = 0;             // Rows between the two
+        std::string last_error;
+        HistogramSnapshot send_latency;   // Per acknowledged batch
+
+        double compression_ratio() const {
+            return bytes_sent > 0 ? static_cast<double>(bytes_encoded) / bytes_sent : 0.0;
+        }
+    };
+
+    /**
+     * @param config Batch, retry and collector settings
+     * @param storage Source of rows and home of the cursor
+     * @param sender Delivery function; empty = POST to config.collector_url + config.path
+     */
+    UplinkForwarder(const UplinkConfig& config, std::shared_ptr<HybridDataStorage> storage, Sender sender = nullptr);
+    ~UplinkForwarder();
+
+    UplinkForwarder(const UplinkForwarder&) = delete;
+    UplinkForwarder& operator=(const UplinkForwarder&) = delete;
+
+    /**
+     * @brief Try to send one batch (the worker loop; call directly when not started)
+     */
+    CycleResult runOnce();
+
+    /**
+     * @brief Start the worker thread (idempotent)
+     */
+    void start();
+
+    /**
+     * @brief Stop the worker; an in-flight request finishes first (idempotent)
+     */
+    void stop();
+
+    /**
+     * @brief Wait before the next cycle after @p result
+     */
+    Duration nextDelay(CycleResult result);
+
+    bool isRunning() const { return running_; }
+    Statistics getStatistics() const;
+
+private:
+    uint64_t httpSend(const Delivery& delivery);
+    void workerLoop();
+
+    UplinkConfig config_;
+    std::shared_ptr<HybridDataStorage> storage_;
+    Sender sender_;
+    std::unique_ptr<HttpClient> http_client_;
+
+    // Worker state (runOnce is not reentrant)
+    std::atomic<uint64_t> cursor_{0};
+    std::atomic<uint64_t> newest_id_{0};
+    std::optional<TimePoint> oldest_pending_;   // Timestamp of the first row after the cursor
+    std::mt19937 jitter_{std::random_device{}()};
+
+    mutable std::mutex stats_mutex_;
+    Statistics stats_;
+    LatencyHistogram send_latency_;
+
+    std::thread worker_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    bool stop_requested_ = false;
+    bool running_ = false;
+};
+
+} // namespace ecoWatt
@@ -0,0 +1,87 @@
+/**
+ * @file uplink_codec.hpp
+ * @brief Delta-encoded, gzip-compressed batch format for the cloud uplink
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include "exceptions.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ecoWatt {
+
+/**
+ * @brief Builds one uplink batch incrementally so its size can be checked per row
+ *
+ * Layout: "EWB" + version byte, then one record per row until the end:
+ *
+ *   varint   id - previous id           (first: the id itself)
+ *   varint   register address
+ *   varint   zigzag(timestamp_ms - previous timestamp_ms)
+ *   varint   zigzag(value - previous value of this register) << 1
+ *            or 1 followed by the 8-byte IEEE-754 value (little endian)
+ *            when the value is not an integer
+ *
+ * Rows are consecutive polls of a handful of registers, so ids step by
+ * one, timestamps by the poll interval and raw values barely move: most
+ * records take 4-6 bytes before compression.
+ */
+class UplinkBatchEncoder {
+public:
+    UplinkBatchEncoder();
+
+    void add(const StoredSample& row);
+
+    size_t size() const { return buffer_.size(); }
+    size_t count() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    uint64_t firstId() const { return first_id_; }
+    uint64_t lastId() const { return previous_id_; }
+
+    /**
+     * @brief Take the encoded batch and start a new one
+     */
+    std::vector<uint8_t> finish();
+
+private:
+    void reset();
+
+    std::vector<uint8_t> buffer_;
+    size_t count_ = 0;
+    uint64_t first_id_ = 0;
+    uint64_t previous_id_ = 0;
+    int64_t previous_timestamp_ = 0;
+    std::unordered_map<RegisterAddress, int64_t> previous_values_;
+};
+
+/**
+ * @brief Batch decoding and gzip helpers (shared by the uplink and the stand-in collector)
+ */
+class UplinkCodec {
+public:
+    static constexpr const char* kContentType = "application/vnd.ecowatt.batch";
+
+    /**
+     * @brief Decode a batch built by UplinkBatchEncoder
+     * @throws ValidationException if the data is truncated or not a batch
+     */
+    static std::vector<StoredSample> decode(const std::vector<uint8_t>& data);
+
+    /**
+     * @brief gzip (RFC 1952) compress
+     */
+    static std::vector<uint8_t> gzip(const std::vector<uint8_t>& data, int level = 6);
+
+    /**
+     * @brief gzip decompress
+     * @throws ValidationException if the data is corrupt or inflates beyond @p max_size
+     */
+    static std::vector<uint8_t> gunzip(const std::vector<uint8_t>& data, size_t max_size = 64 * 1024 * 1024);
+};
+
+} // namespace ecoWatt
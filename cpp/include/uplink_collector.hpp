@@ -0,0 +1,106 @@
+/**
+ * @file uplink_collector.hpp
+ * @brief Local stand-in for the cloud collector that receives uplink batches
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include <cpprest/http_listener.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ecoWatt {
+
+/**
+ * @brief Accepts POSTed uplink batches the way the cloud collector does
+ *
+ * Intended for tests and the Inverter SIM, which point
+ * UplinkConfig::collector_url at baseUrl(). Each batch is gunzipped
+ * (Content-Encoding: gzip), decoded and appended to an in-memory list.
+ * Rows at or below the highest id already received are counted as
+ * duplicates and dropped, so a batch resent after a lost acknowledgement
+ * is harmless. The reply is {"ack": <highest id received>}.
+ *
+ * setAvailable(false) answers 503 and failNext(n) answers 500 to the next
+ * n batches, to exercise outages and retries.
+ */
+class UplinkCollectorServer {
+public:
+    struct Statistics {
+        uint64_t batches = 0;         // Accepted
+        uint64_t samples = 0;         // New rows
+        uint64_t duplicates = 0;      // Rows already received
+        uint64_t rejected = 0;        // Unavailable, injected failures, bad requests
+        uint64_t bytes_received = 0;  // As sent (compressed)
+        uint64_t bytes_decoded = 0;   // After gunzip
+    };
+
+    struct Reply {
+        int status = 200;
+        uint64_t ack = 0;
+    };
+
+    /**
+     * @param base_url Listen address, e.g. "http://127.0.0.1:18095"
+     * @param path Ingest path
+     * @param api_key Expected Authorization header (empty disables the check)
+     */
+    explicit UplinkCollectorServer(const std::string& base_url = "http://127.0.0.1:8090",
+                                   const std::string& path = "/api/v1/ingest",
+                                   const std::string& api_key = "");
+    ~UplinkCollectorServer();
+
+    UplinkCollectorServer(const UplinkCollectorServer&) = delete;
+    UplinkCollectorServer& operator=(const UplinkCollectorServer&) = delete;
+
+    /**
+     * @brief Open the listener
+     * @throws HttpException if the address cannot be bound
+     */
+    void start();
+
+    /**
+     * @brief Close the listener (idempotent)
+     */
+    void stop();
+
+    /**
+     * @brief Process one batch body (what the HTTP handler does after auth)
+     * @param content_encoding "gzip" or empty
+     */
+    Reply ingest(const std::vector<uint8_t>& body, const std::string& content_encoding);
+
+    void setAvailable(bool available);
+    void failNext(uint32_t count);
+
+    std::vector<StoredSample> samples() const;
+    uint64_t highWater() const;
+    Statistics getStatistics() const;
+
+    bool isRunning() const { return running_; }
+    const std::string& baseUrl() const { return base_url_; }
+
+private:
+    void handlePost(web::http::http_request request);
+
+    std::string base_url_;
+    std::string path_;
+    std::string api_key_;
+
+    mutable std::mutex mutex_;
+    std::vector<StoredSample> samples_;
+    uint64_t high_water_ = 0;
+    bool available_ = true;
+    uint32_t fail_next_ = 0;
+    Statistics stats_;
+
+    std::unique_ptr<web::http::experimental::listener::http_listener> listener_;
+    bool running_ = false;
+};
+
+} // namespace ecoWatt
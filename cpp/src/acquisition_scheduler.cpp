@@ -7,6 +7,7 @@
 
 #include "acquisition_scheduler.hpp"
 #include "logger.hpp"
+#include "tracing.hpp"
 #include <chrono>
 #include <algorithm>
 #include <thread>
@@ -16,12 +17,23 @@ namespace ecoWatt {
 // Constructor
 AcquisitionScheduler::AcquisitionScheduler(SharedPtr<ProtocolAdapter> protocol_adapter,
                                          const ConfigManager& config)
-    : protocol_adapter_(protocol_adapter), max_buffer_size_(10000) {
+    : protocol_adapter_(protocol_adapter),
+      register_configs_(std::make_shared<const RegisterConfigs>()),
+      latest_cache_(config.getAcquisitionConfig().cache_max_age),
+      max_buffer_size_(10000) {
     
     // Get configuration
     config_ = config.getAcquisitionConfig();
     minimum_registers_ = config_.minimum_registers;
     
+    if (!config.getDerivedMetricConfigs().empty()) {
+        derived_metrics_ = std::make_unique<DerivedMetricsEngine>(config.getDerivedMetricConfigs(),
+                                                                  config.getRegisterConfigs());
+    }
+    if (!config.getAlarmRuleConfigs().empty()) {
+        alarm_engine_ = std::make_unique<AlarmEngine>(config.getAlarmRuleConfigs());
+    }
+    
     LOG_INFO("AcquisitionScheduler initialized with interval: {}ms", config_.polling_interval.count());
 }
 
@@ -61,6 +73,11 @@ void AcquisitionScheduler::stopPolling() {
     LOG_INFO("AcquisitionScheduler stopped polling");
 }
 
+// Run a single poll cycle
+void AcquisitionScheduler::pollOnce() {
+    performPollCycle();
+}
+
 // Set polling interval
 void AcquisitionScheduler::setPollingInterval(Duration interval) {
     config_.polling_interval = interval;
@@ -75,8 +92,15 @@ void AcquisitionScheduler::setMinimumRegisters(const std::vector<RegisterAddress
 
 // Configure registers
 void AcquisitionScheduler::configureRegisters(const std::map<RegisterAddress, RegisterConfig>& register_configs) {
+    auto configs = std::make_shared<const RegisterConfigs>(register_configs);
+    std::lock_guard<std::mutex> lock(buffer_mutex_);
+    register_configs_ = std::move(configs);
+    latest_cache_.configure(register_configs);
+}
+
+std::shared_ptr<const AcquisitionScheduler::RegisterConfigs> AcquisitionScheduler::registerConfigs() const {
     std::lock_guard<std::mutex> lock(buffer_mutex_);
-    register_configs_ = register_configs;
+    return register_configs_;
 }
 
 // Add sample callback
@@ -91,35 +115,24 @@ void AcquisitionScheduler::addErrorCallback(ErrorCallback callback) {
     error_callbacks_.push_back(callback);
 }
 
+// Add alarm callback
+void AcquisitionScheduler::addAlarmCallback(AlarmEngine::Callback callback) {
+    if (alarm_engine_) {
+        alarm_engine_->addCallback(std::move(callback));
+    }
+}
+
 // Read single register
-UniquePtr<AcquisitionSample> AcquisitionScheduler::readSingleRegister(RegisterAddress address) {
+UniquePtr<AcquisitionSample> AcquisitionScheduler::readSingleRegister(RegisterAddress address,
+                                                                     TransactionLane lane) {
     try {
-        auto values = protocol_adapter_->readRegisters(address, 1);
+        auto values = protocol_adapter_->readRegisters(address, 1, lane);
         if (values.empty()) {
             return nullptr;
         }
         
-        RegisterValue value = values[0];
-        
-        auto it = register_configs_.find(address);
-        std::string name = (it != register_configs_.end()) ? it->second.name : "Unknown";
-        std::string unit = (it != register_configs_.end()) ? it->second.unit : "";
-        double gain = (it != register_configs_.end()) ? it->second.gain : 1.0;
-        
-        // Per API docs, 'gain' is a scaling divisor (e.g., gain 10 => value / 10)
-        double scaled = (gain != 0.0) ? static_cast<double>(value) / gain
-                                       : static_cast<double>(value);
-
-        auto sample = std::make_unique<AcquisitionSample>(
-            std::chrono::system_clock::now(),
-            address,
-            name,
-            value,
-            scaled,
-            unit
-        );
-        
-        return sample;
+        return std::make_unique<AcquisitionSample>(
+            makeSample(*registerConfigs(), address, values[0], std::chrono::system_clock::now()));
         
     } catch (const std::exception& e) {
         LOG_ERROR("Failed to read register {}: {}", address, e.what());
@@ -128,23 +141,128 @@ UniquePtr<AcquisitionSample> AcquisitionScheduler::readSingleRegister(RegisterAd
 }
 
 // Read multiple registers
-std::vector<AcquisitionSample> AcquisitionScheduler::readMultipleRegisters(const std::vector<RegisterAddress>& addresses) {
+std::vector<AcquisitionSample> AcquisitionScheduler::readMultipleRegisters(const std::vector<RegisterAddress>& addresses,
+                                                                         TransactionLane lane) {
     std::vector<AcquisitionSample> samples;
+    samples.reserve(addresses.size());
     
+    // One frame per register; batching transports send them in one round trip
+    std::vector<std::pair<RegisterAddress, uint16_t>> blocks;
+    blocks.reserve(addresses.size());
     for (auto address : addresses) {
-        auto sample = readSingleRegister(address);
-        if (sample) {
-            samples.push_back(*sample);
+        blocks.emplace_back(address, 1);
+    }
+    
+    auto configs = registerConfigs();
+    for (const auto& result : protocol_adapter_->readRegisterBlocks(blocks, lane)) {
+        if (result.ok()) {
+            samples.push_back(makeSample(*configs, result.start_address, result.values[0],
+                                         std::chrono::system_clock::now()));
+        } else {
+            LOG_ERROR("Failed to read register {}: {}", result.start_address, result.error);
         }
     }
     
     return samples;
 }
 
+// Read registers in blocks
+std::vector<AcquisitionSample> AcquisitionScheduler::readRegisterBlock(const std::vector<RegisterAddress>& addresses,
+                                                                     TransactionLane lane) {
+    std::vector<AcquisitionSample> samples;
+    if (addresses.empty()) {
+        return samples;
+    }
+    
+    auto sorted = addresses;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    
+    // One request for the whole span if it only covers configured registers
+    auto configs = registerConfigs();
+    std::vector<std::pair<RegisterAddress, uint16_t>> blocks;
+    uint32_t span = static_cast<uint32_t>(sorted.back()) - sorted.front() + 1;
+    bool span_configured = span <= 125;
+    for (uint32_t addr = sorted.front(); span_configured && addr <= sorted.back(); ++addr) {
+        span_configured = configs->count(static_cast<RegisterAddress>(addr)) > 0;
+    }
+    
+    if (span_configured) {
+        blocks.emplace_back(sorted.front(), static_cast<uint16_t>(span));
+    } else {
+        for (const auto& group : groupConsecutiveRegisters(sorted)) {
+            for (size_t offset = 0; offset < group.size(); offset += 125) {
+                size_t count = std::min<size_t>(125, group.size() - offset);
+                blocks.emplace_back(group[offset], static_cast<uint16_t>(count));
+            }
+        }
+    }
+    
+    samples.reserve(span_configured ? span : sorted.size());
+    for (const auto& result : protocol_adapter_->readRegisterBlocks(blocks, lane)) {
+        RegisterAddress start = result.start_address;
+        if (!result.ok()) {
+            LOG_ERROR("Failed to read registers {}-{}: {}", start, start + result.num_registers - 1, result.error);
+            continue;
+        }
+        
+        auto timestamp = std::chrono::system_clock::now();
+        for (uint16_t i = 0; i < result.values.size(); ++i) {
+            samples.push_back(makeSample(*configs, static_cast<RegisterAddress>(start + i), result.values[i],
+                                         timestamp));
+        }
+    }
+    
+    return samples;
+}
+
+// Get latest samples (cache first)
+std::vector<AcquisitionSample> AcquisitionScheduler::getLatestSamples(const std::vector<RegisterAddress>& addresses) {
+    auto lookup = latest_cache_.lookup(addresses);
+    
+    if (derived_metrics_) {
+        // Virtual registers only come from poll cycles
+        lookup.stale.erase(std::remove_if(lookup.stale.begin(), lookup.stale.end(),
+                                          [this](RegisterAddress address) {
+                                              return derived_metrics_->isDerived(address);
+                                          }),
+                           lookup.stale.end());
+    }
+    
+    if (!lookup.stale.empty()) {
+        LOG_DEBUG("Latest-value cache: {} fresh, {} stale - reading live", 
+                 lookup.fresh.size(), lookup.stale.size());
+        
+        uint64_t read_epoch = latest_cache_.epoch();
+        auto live = readRegisterBlock(lookup.stale);
+        latest_cache_.update(live, read_epoch);
+        
+        // Only return what was asked for (a block may cover extra registers)
+        for (auto& sample : live) {
+            if (std::find(lookup.stale.begin(), lookup.stale.end(), sample.register_address) != lookup.stale.end()) {
+                lookup.fresh.push_back(std::move(sample));
+            }
+        }
+    }
+    
+    return std::move(lookup.fresh);
+}
+
+// Set cache max-age
+void AcquisitionScheduler::setCacheMaxAge(Duration max_age) {
+    latest_cache_.setDefaultMaxAge(max_age);
+    config_.cache_max_age = max_age;
+}
+
 // Perform write operation
 bool AcquisitionScheduler::performWriteOperation(RegisterAddress register_address, RegisterValue value) {
     try {
-        return protocol_adapter_->writeRegister(register_address, value);
+        bool success = protocol_adapter_->writeRegister(register_address, value, TransactionLane::CONTROL);
+        if (success) {
+            // Also fences off polls that were in flight across the write
+            latest_cache_.invalidate(register_address);
+        }
+        return success;
     } catch (const std::exception& e) {
         LOG_ERROR("Failed to write register {}: {}", register_address, e.what());
         return false;
@@ -182,10 +300,17 @@ std::vector<AcquisitionSample> AcquisitionScheduler::getSamplesByRegister(Regist
     return result;
 }
 
+// Get statistics
+AcquisitionStatistics AcquisitionScheduler::getStatistics() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return statistics_;
+}
+
 // Reset statistics
 void AcquisitionScheduler::resetStatistics() {
     std::lock_guard<std::mutex> lock(stats_mutex_);
     statistics_ = AcquisitionStatistics{};
+    cycle_latency_.reset();
 }
 
 // Main polling loop
@@ -209,12 +334,14 @@ void AcquisitionScheduler::pollingLoop() {
 
 // Perform poll cycle
 void AcquisitionScheduler::performPollCycle() {
+    TRACE_SPAN("AcquisitionScheduler::performPollCycle", "acquisition");
+    const auto cycle_start = std::chrono::steady_clock::now();
     std::vector<RegisterAddress> addresses_to_read;
     
     // Collect all configured register addresses
     {
         std::lock_guard<std::mutex> lock(buffer_mutex_);
-        for (const auto& pair : register_configs_) {
+        for (const auto& pair : *register_configs_) {
             addresses_to_read.push_back(pair.first);
         }
     }
@@ -226,12 +353,20 @@ void AcquisitionScheduler::performPollCycle() {
         }
     }
     
-    // Read all registers
-    auto samples = readMultipleRegisters(addresses_to_read);
+    // Read all registers; each read yields to queued writes and status refreshes
+    uint64_t read_epoch = latest_cache_.epoch();
+    auto samples = readMultipleRegisters(addresses_to_read, TransactionLane::BACKGROUND);
     
     // Store samples and notify callbacks
     for (const auto& sample : samples) {
-        storeSample(sample);
+        storeSample(sample, read_epoch);
+    }
+    
+    // Derived metrics over the latest values, published like polled registers
+    if (derived_metrics_) {
+        for (const auto& sample : derived_metrics_->evaluate(samples)) {
+            storeSample(sample, read_epoch);
+        }
     }
     
     // Update statistics
@@ -247,10 +382,14 @@ void AcquisitionScheduler::performPollCycle() {
             statistics_.last_error = "No samples acquired";
         }
     }
+    cycle_latency_.record(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - cycle_start));
 }
 
 // Store sample
-void AcquisitionScheduler::storeSample(const AcquisitionSample& sample) {
+void AcquisitionScheduler::storeSample(const AcquisitionSample& sample, uint64_t read_epoch) {
+    latest_cache_.update(sample, read_epoch);
+    
     // Store in buffer
     {
         std::lock_guard<std::mutex> lock(buffer_mutex_);
@@ -262,6 +401,10 @@ void AcquisitionScheduler::storeSample(const AcquisitionSample& sample) {
         }
     }
     
+    if (alarm_engine_) {
+        alarm_engine_->evaluate(sample);
+    }
+    
     // Notify callbacks
     {
         std::lock_guard<std::mutex> lock(callbacks_mutex_);
@@ -287,6 +430,21 @@ void AcquisitionScheduler::notifyError(const std::string& error_message) {
     }
 }
 
+// Build sample from raw value
+AcquisitionSample AcquisitionScheduler::makeSample(const RegisterConfigs& configs, RegisterAddress address,
+                                                  RegisterValue value, TimePoint timestamp) {
+    auto it = configs.find(address);
+    std::string name = (it != configs.end()) ? it->second.name : "Unknown";
+    std::string unit = (it != configs.end()) ? it->second.unit : "";
+    double gain = (it != configs.end()) ? it->second.gain : 1.0;
+    
+    // Per API docs, 'gain' is a scaling divisor (e.g., gain 10 => value / 10)
+    double scaled = (gain != 0.0) ? static_cast<double>(value) / gain
+                                   : static_cast<double>(value);
+    
+    return AcquisitionSample(timestamp, address, name, value, scaled, unit);
+}
+
 // Group consecutive registers
 std::vector<std::vector<RegisterAddress>> AcquisitionScheduler::groupConsecutiveRegisters(
     const std::vector<RegisterAddress>& addresses) {
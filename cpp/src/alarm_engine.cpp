@@ -0,0 +1,173 @@
+/**
+ * @file alarm_engine.cpp
+ * @brief Implementation of the per-sample alarm rule engine
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "alarm_engine.hpp"
+#include "exceptions.hpp"
+#include "logger.hpp"
+#include <algorithm>
+
+namespace ecoWatt {
+
+namespace {
+
+bool isRate(AlarmCondition condition) {
+    return condition == AlarmCondition::RATE_ABOVE || condition == AlarmCondition::RATE_BELOW;
+}
+
+bool isUpper(AlarmCondition condition) {
+    return condition == AlarmCondition::ABOVE || condition == AlarmCondition::RATE_ABOVE;
+}
+
+} // namespace
+
+AlarmEngine::AlarmEngine(const std::vector<AlarmRuleConfig>& rules) {
+    RegisterAddress max_address = 0;
+    for (const auto& config : rules) {
+        if (config.hysteresis < 0.0 || config.duration.count() < 0) {
+            throw ConfigException("Alarm rule '" + config.name + "' has a negative hysteresis or duration");
+        }
+        max_address = std::max(max_address, config.address);
+    }
+
+    rules_.reserve(rules.size());
+    for (const auto& config : rules) {
+        Rule rule;
+        rule.config = config;
+        rule.clear_threshold = isUpper(config.condition) ? config.threshold - config.hysteresis
+                                                         : config.threshold + config.hysteresis;
+        rules_.push_back(std::move(rule));
+    }
+    std::stable_sort(rules_.begin(), rules_.end(),
+                     [](const Rule& a, const Rule& b) { return a.config.address < b.config.address; });
+
+    // Dispatch table: offsets_[a]..offsets_[a + 1] is register a's slice of rules_
+    if (!rules_.empty()) {
+        offsets_.assign(static_cast<size_t>(max_address) + 2, 0);
+        rate_slot_.assign(static_cast<size_t>(max_address) + 1, -1);
+        for (const auto& rule : rules_) {
+            ++offsets_[rule.config.address + 1];
+            if (isRate(rule.config.condition) && rate_slot_[rule.config.address] < 0) {
+                rate_slot_[rule.config.address] = static_cast<int32_t>(rate_states_.size());
+                rate_states_.emplace_back();
+            }
+        }
+        for (size_t i = 1; i < offsets_.size(); ++i) {
+            offsets_[i] += offsets_[i - 1];
+        }
+    }
+
+    LOG_INFO("Alarm engine initialized with {} rules", rules_.size());
+}
+
+void AlarmEngine::addCallback(Callback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    callbacks_.push_back(std::move(callback));
+}
+
+void AlarmEngine::evaluate(const AcquisitionSample& sample) {
+    size_t address = sample.register_address;
+    if (address + 1 >= offsets_.size() || offsets_[address] == offsets_[address + 1]) {
+        return;
+    }
+
+    evaluated_samples_.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const double value = sample.scaled_value;
+    const TimePoint timestamp = sample.timestamp;
+
+    double rate = 0.0;
+    bool has_rate = false;
+    if (rate_slot_[address] >= 0) {
+        RateState& state = rate_states_[rate_slot_[address]];
+        if (!state.has_previous || timestamp > state.previous_time) {
+            if (state.has_previous) {
+                rate = (value - state.previous) /
+                       std::chrono::duration<double>(timestamp - state.previous_time).count();
+                has_rate = true;
+            }
+            state.has_previous = true;
+            state.previous = value;
+            state.previous_time = timestamp;
+        }
+    }
+
+    for (uint32_t i = offsets_[address]; i < offsets_[address + 1]; ++i) {
+        Rule& rule = rules_[i];
+        const AlarmRuleConfig& config = rule.config;
+
+        bool rate_rule = isRate(config.condition);
+        if (rate_rule && !has_rate) {
+            continue;
+        }
+
+        double x = rate_rule ? rate : value;
+        bool upper = isUpper(config.condition);
+
+        if (!rule.active) {
+            bool violated = upper ? x > config.threshold : x < config.threshold;
+            if (!violated) {
+                rule.pending = false;
+                continue;
+            }
+
+            if (!rule.pending) {
+                rule.pending = true;
+                rule.pending_since = timestamp;
+            }
+            if (timestamp - rule.pending_since >= config.duration) {
+                rule.active = true;
+                rule.pending = false;
+                rule.active_since = timestamp;
+                raised_.fetch_add(1, std::memory_order_relaxed);
+                emit(rule, AlarmTransition::RAISED, x, timestamp);
+            }
+        } else {
+            bool cleared = upper ? x <= rule.clear_threshold : x >= rule.clear_threshold;
+            if (cleared) {
+                rule.active = false;
+                cleared_.fetch_add(1, std::memory_order_relaxed);
+                emit(rule, AlarmTransition::CLEARED, x, timestamp);
+            }
+        }
+    }
+}
+
+std::vector<AlarmEngine::ActiveAlarm> AlarmEngine::getActiveAlarms() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<ActiveAlarm> active;
+    for (const auto& rule : rules_) {
+        if (rule.active) {
+            active.push_back({rule.config.name, rule.config.address, rule.config.severity, rule.active_since});
+        }
+    }
+    return active;
+}
+
+AlarmEngine::Statistics AlarmEngine::getStatistics() const {
+    Statistics stats;
+    stats.evaluated_samples = evaluated_samples_.load(std::memory_order_relaxed);
+    stats.raised = raised_.load(std::memory_order_relaxed);
+    stats.cleared = cleared_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void AlarmEngine::emit(const Rule& rule, AlarmTransition transition, double value, TimePoint timestamp) {
+    AlarmEvent event{transition, rule.config.name, rule.config.address, rule.config.severity,
+                     value, rule.config.threshold, timestamp};
+
+    for (const auto& callback : callbacks_) {
+        try {
+            callback(event);
+        } catch (const std::exception& e) {
+            LOG_ERROR("Error in alarm callback: {}", e.what());
+        }
+    }
+}
+
+} // namespace ecoWatt
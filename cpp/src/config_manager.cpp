@@ -89,6 +89,31 @@ void ConfigManager::loadJsonConfiguration(const std::string& config_file) {
         modbus_config_.timeout = Duration(modbus.value("timeout_ms", 5000));
         modbus_config_.max_retries = modbus.value("max_retries", 3);
         modbus_config_.retry_delay = Duration(modbus.value("retry_delay_ms", 1000));
+        
+        std::string transport = modbus.value("transport", "http");
+        modbus_config_.transport = transport_from_string(transport);
+        if (to_string(modbus_config_.transport) != transport) {
+            throw ConfigException("Unknown Modbus transport: " + transport);
+        }
+        
+        if (modbus.contains("tcp")) {
+            const auto& tcp = modbus["tcp"];
+            modbus_config_.tcp_host = tcp.value("host", "127.0.0.1");
+            modbus_config_.tcp_port = tcp.value("port", 502);
+            modbus_config_.tcp_max_in_flight = tcp.value("max_in_flight", 4);
+        }
+        
+        if (modbus.contains("serial")) {
+            const auto& serial = modbus["serial"];
+            modbus_config_.serial_device = serial.value("device", "/dev/ttyUSB0");
+            modbus_config_.serial_baud_rate = serial.value("baud_rate", 9600);
+            
+            std::string parity = serial.value("parity", "even");
+            modbus_config_.serial_parity = parity_from_string(parity);
+            if (to_string(modbus_config_.serial_parity) != parity) {
+                throw ConfigException("Unknown serial parity: " + parity);
+            }
+        }
     }
 
     // Override with environment variables
@@ -111,6 +136,9 @@ void ConfigManager::loadJsonConfiguration(const std::string& config_file) {
         acquisition_config_.polling_interval = Duration(acq.value("polling_interval_ms", 10000));
         acquisition_config_.max_samples_per_register = acq.value("max_samples_per_register", 1000);
         acquisition_config_.enable_background_polling = acq.value("enable_background_polling", true);
+        acquisition_config_.cache_max_age = Duration(acq.value("cache_max_age_ms",
+                                                               2 * acquisition_config_.polling_interval.count()));
+        acquisition_config_.setpoint_min_interval = Duration(acq.value("setpoint_min_interval_ms", 1000));
         
         if (acq.contains("minimum_registers")) {
             acquisition_config_.minimum_registers.clear();
@@ -127,6 +155,12 @@ void ConfigManager::loadJsonConfiguration(const std::string& config_file) {
         storage_config_.enable_persistent_storage = storage.value("enable_persistent_storage", true);
         storage_config_.cleanup_interval = Duration(storage.value("cleanup_interval_hours", 24) * 60 * 60 * 1000);
         storage_config_.data_retention_days = storage.value("data_retention_days", 30);
+        storage_config_.snapshot_path = storage.value("snapshot_path", "");
+        storage_config_.snapshot_max_registers = storage.value("snapshot_max_registers", 64);
+        if (!storage_config_.snapshot_path.empty() &&
+            (storage_config_.snapshot_max_registers == 0 || storage_config_.memory_retention_samples == 0)) {
+            throw ConfigException("storage.snapshot_path needs snapshot_max_registers and memory_retention_samples above 0");
+        }
     }
 
     // Override database path from environment
@@ -140,6 +174,11 @@ void ConfigManager::loadJsonConfiguration(const std::string& config_file) {
         if (api.contains("endpoints")) {
             api_config_.read_endpoint = api["endpoints"].value("read", "/api/inverter/read");
             api_config_.write_endpoint = api["endpoints"].value("write", "/api/inverter/write");
+            api_config_.batch_endpoint = api["endpoints"].value("batch", "/api/inverter/batch");
+        }
+        if (api.contains("batch")) {
+            api_config_.enable_batch = api["batch"].value("enabled", false);
+            api_config_.batch_max_frames = api["batch"].value("max_frames", 32);
         }
         if (api.contains("headers")) {
             api_config_.content_type = api["headers"].value("content_type", "application/json");
@@ -163,6 +202,31 @@ void ConfigManager::loadJsonConfiguration(const std::string& config_file) {
         logging_config_.max_file_size_mb = logging.value("max_file_size_mb", 10);
         logging_config_.max_files = logging.value("max_files", 5);
         logging_config_.format = logging.value("format", "[%Y-%m-%d %H:%M:%S] [%l] %v");
+        if (logging.contains("async")) {
+            const auto& async = logging["async"];
+            logging_config_.async = async.value("enabled", false);
+            logging_config_.async_queue_size = async.value("queue_size", 8192);
+
+            std::string overflow = async.value("overflow_policy", "block");
+            logging_config_.async_overflow = log_overflow_from_string(overflow);
+            if (to_string(logging_config_.async_overflow) != overflow) {
+                throw ConfigException("Unknown logging.async.overflow_policy: " + overflow);
+            }
+            if (logging_config_.async_queue_size == 0) {
+                throw ConfigException("logging.async.queue_size must be positive");
+            }
+        }
+        if (logging.contains("suppression")) {
+            const auto& suppression = logging["suppression"];
+            logging_config_.suppress_enabled = suppression.value("enabled", true);
+            logging_config_.suppress_burst = suppression.value("burst", 10);
+            logging_config_.suppress_per_minute = suppression.value("per_minute", 6.0);
+            logging_config_.suppress_summary_interval = Duration(suppression.value("summary_interval_ms", 60000));
+            if (logging_config_.suppress_burst == 0 || logging_config_.suppress_per_minute < 0.0 ||
+                logging_config_.suppress_summary_interval.count() <= 0) {
+                throw ConfigException("logging.suppression needs a positive burst and summary interval");
+            }
+        }
     }
 
     // Override log settings from environment
@@ -173,8 +237,128 @@ void ConfigManager::loadJsonConfiguration(const std::string& config_file) {
         logging_config_.log_file = env_vars_["LOG_FILE"];
     }
 
+    // Tracing configuration
+    if (json.contains("tracing")) {
+        const auto& tracing = json["tracing"];
+        tracing_config_.enabled = tracing.value("enabled", false);
+        tracing_config_.buffer_events = tracing.value("buffer_events", TracingConfig{}.buffer_events);
+        tracing_config_.output = tracing.value("output", "ecoWatt_trace.json");
+        tracing_config_.dump_interval = Duration(tracing.value("dump_interval_ms", 0));
+        tracing_config_.dump_files = tracing.value("dump_files", 4);
+        if (tracing_config_.buffer_events == 0 || tracing_config_.dump_files == 0 ||
+            tracing_config_.dump_interval.count() < 0) {
+            throw ConfigException("tracing needs positive buffer_events and dump_files");
+        }
+    }
+
+    // Metrics endpoint configuration
+    if (json.contains("metrics")) {
+        const auto& metrics = json["metrics"];
+        metrics_config_.enabled = metrics.value("enabled", false);
+        metrics_config_.listen_url = metrics.value("listen_url", "http://0.0.0.0:9464");
+        metrics_config_.path = metrics.value("path", "/metrics");
+        metrics_config_.refresh_interval = Duration(metrics.value("refresh_interval_ms", 5000));
+        if (metrics_config_.listen_url.rfind("http://", 0) != 0) {
+            throw ConfigException("metrics.listen_url must be an http:// URL");
+        }
+        if (metrics_config_.path.empty() || metrics_config_.path[0] != '/') {
+            throw ConfigException("metrics.path must start with '/'");
+        }
+        if (metrics_config_.refresh_interval.count() <= 0) {
+            throw ConfigException("metrics.refresh_interval_ms must be positive");
+        }
+    }
+
+    // REST query API configuration
+    if (json.contains("query_api")) {
+        const auto& query_api = json["query_api"];
+        query_api_config_.enabled = query_api.value("enabled", false);
+        query_api_config_.listen_url = query_api.value("listen_url", "http://0.0.0.0:8081");
+        query_api_config_.threads = query_api.value("threads", 2);
+        query_api_config_.queue_limit = query_api.value("queue_limit", 64);
+        query_api_config_.max_history_points = query_api.value("max_history_points", 2000);
+        if (query_api_config_.listen_url.rfind("http://", 0) != 0) {
+            throw ConfigException("query_api.listen_url must be an http:// URL");
+        }
+        if (query_api_config_.threads == 0 || query_api_config_.queue_limit == 0 ||
+            query_api_config_.max_history_points == 0) {
+            throw ConfigException("query_api needs positive threads, queue_limit and max_history_points");
+        }
+    }
+
+    // Live sample stream configuration
+    if (json.contains("stream")) {
+        const auto& stream = json["stream"];
+        stream_config_.enabled = stream.value("enabled", false);
+        stream_config_.listen_url = stream.value("listen_url", "http://0.0.0.0:8082");
+        stream_config_.path = stream.value("path", "/api/v1/stream");
+        stream_config_.client_queue = stream.value("client_queue", 1024);
+        stream_config_.max_buffered_kb = stream.value("max_buffered_kb", 256);
+        stream_config_.max_clients = stream.value("max_clients", 500);
+        stream_config_.heartbeat_interval = Duration(stream.value("heartbeat_interval_ms", 15000));
+        if (stream_config_.listen_url.rfind("http://", 0) != 0) {
+            throw ConfigException("stream.listen_url must be an http:// URL");
+        }
+        if (stream_config_.path.empty() || stream_config_.path[0] != '/') {
+            throw ConfigException("stream.path must start with '/'");
+        }
+        if (stream_config_.client_queue == 0 || stream_config_.max_clients == 0 ||
+            stream_config_.heartbeat_interval.count() <= 0) {
+            throw ConfigException("stream needs positive client_queue, max_clients and heartbeat_interval_ms");
+        }
+    }
+    
+    // Shared-memory latest-value table configuration
+    if (json.contains("shared_memory")) {
+        const auto& shm = json["shared_memory"];
+        shared_memory_config_.enabled = shm.value("enabled", false);
+        shared_memory_config_.name = shm.value("name", "/ecowatt_latest");
+        shared_memory_config_.unlink_on_exit = shm.value("unlink_on_exit", true);
+        const auto& name = shared_memory_config_.name;
+        if (name.size() < 2 || name[0] != '/' || name.find('/', 1) != std::string::npos) {
+            throw ConfigException("shared_memory.name must be '/' followed by a name without slashes");
+        }
+    }
+    
+    // Store-and-forward uplink configuration
+    if (json.contains("uplink")) {
+        const auto& uplink = json["uplink"];
+        uplink_config_.enabled = uplink.value("enabled", false);
+        uplink_config_.collector_url = uplink.value("collector_url", "http://127.0.0.1:8090");
+        uplink_config_.path = uplink.value("path", "/api/v1/ingest");
+        uplink_config_.batch_max_samples = uplink.value("batch_max_samples", 5000);
+        uplink_config_.batch_max_bytes = uplink.value("batch_max_bytes", 256 * 1024);
+        uplink_config_.batch_max_age = Duration(uplink.value("batch_max_age_ms", 30000));
+        uplink_config_.poll_interval = Duration(uplink.value("poll_interval_ms", 1000));
+        uplink_config_.request_timeout = Duration(uplink.value("request_timeout_ms", 30000));
+        uplink_config_.retry_initial = Duration(uplink.value("retry_initial_ms", 1000));
+        uplink_config_.retry_max = Duration(uplink.value("retry_max_ms", 300000));
+        uplink_config_.max_batches_per_second = uplink.value("max_batches_per_second", 5.0);
+        uplink_config_.compress = uplink.value("compress", true);
+        if (uplink_config_.collector_url.rfind("http://", 0) != 0 &&
+            uplink_config_.collector_url.rfind("https://", 0) != 0) {
+            throw ConfigException("uplink.collector_url must be an http:// or https:// URL");
+        }
+        if (uplink_config_.path.empty() || uplink_config_.path[0] != '/') {
+            throw ConfigException("uplink.path must start with '/'");
+        }
+        if (uplink_config_.batch_max_samples == 0 || uplink_config_.batch_max_bytes == 0 ||
+            uplink_config_.poll_interval.count() <= 0 || uplink_config_.retry_initial.count() <= 0 ||
+            uplink_config_.retry_max < uplink_config_.retry_initial ||
+            uplink_config_.max_batches_per_second < 0.0) {
+            throw ConfigException("uplink needs positive batch limits, poll and retry intervals (retry_max >= retry_initial)");
+        }
+    }
+    
+    // Override uplink key from environment, like the inverter API key
+    if (env_vars_.count("UPLINK_API_KEY")) {
+        uplink_config_.api_key = env_vars_["UPLINK_API_KEY"];
+    }
+
     // Register configurations
     parseRegisterConfigs(json);
+    parseDerivedMetricConfigs(json);
+    parseAlarmRuleConfigs(json);
 }
 
 void ConfigManager::parseRegisterConfigs(const nlohmann::json& json) {
@@ -192,6 +376,19 @@ void ConfigManager::parseRegisterConfigs(const nlohmann::json& json) {
         config.gain = reg_json.value("gain", 1.0);
         config.access = access_from_string(reg_json.value("access", "Read"));
         config.description = reg_json.value("description", "");
+        config.max_age = Duration(reg_json.value("max_age_ms", 0));
+        config.deadband = reg_json.value("deadband", 0.0);
+        config.deadband_percent = reg_json.value("deadband_percent", 0.0);
+        config.max_interval = Duration(reg_json.value("max_interval_ms", 0));
+        
+        std::string compression = reg_json.value("compression", "none");
+        config.compression = compression_from_string(compression);
+        if (to_string(config.compression) != compression) {
+            throw ConfigException("Unknown compression for register " + key + ": " + compression);
+        }
+        if (config.deadband < 0.0 || config.deadband_percent < 0.0) {
+            throw ConfigException("Negative deadband for register " + key);
+        }
         
         register_configs_[address] = config;
     }
@@ -199,6 +396,82 @@ void ConfigManager::parseRegisterConfigs(const nlohmann::json& json) {
     LOG_DEBUG("Loaded {} register configurations", register_configs_.size());
 }
 
+void ConfigManager::parseDerivedMetricConfigs(const nlohmann::json& json) {
+    derived_metric_configs_.clear();
+    if (!json.contains("derived_metrics")) {
+        return;
+    }
+
+    for (const auto& [key, metric_json] : json["derived_metrics"].items()) {
+        DerivedMetricConfig config;
+        config.address = static_cast<RegisterAddress>(std::stoi(key));
+        config.name = metric_json.value("name", "Derived_" + key);
+        config.unit = metric_json.value("unit", "");
+        config.description = metric_json.value("description", "");
+        config.gain = metric_json.value("gain", 1.0);
+        config.scale = metric_json.value("scale", 1.0);
+        config.max_gap = Duration(metric_json.value("max_gap_ms", config.max_gap.count()));
+
+        bool has_expression = metric_json.contains("expression");
+        bool has_integral = metric_json.contains("integral_of");
+        if (has_expression == has_integral) {
+            throw ConfigException("Derived metric " + key + " needs exactly one of 'expression' or 'integral_of'");
+        }
+        config.integrate = has_integral;
+        config.expression = metric_json.value(has_integral ? "integral_of" : "expression", "");
+
+        if (register_configs_.count(config.address) > 0) {
+            throw ConfigException("Derived metric " + key + " clashes with a physical register");
+        }
+        derived_metric_configs_.push_back(config);
+    }
+
+    LOG_DEBUG("Loaded {} derived metric configurations", derived_metric_configs_.size());
+}
+
+void ConfigManager::parseAlarmRuleConfigs(const nlohmann::json& json) {
+    alarm_rule_configs_.clear();
+    if (!json.contains("alarms")) {
+        return;
+    }
+
+    for (const auto& alarm_json : json["alarms"]) {
+        AlarmRuleConfig config;
+        config.name = alarm_json.value("name", "");
+        if (config.name.empty() || !alarm_json.contains("register") || !alarm_json.contains("threshold")) {
+            throw ConfigException("Alarm rules need 'name', 'register' and 'threshold'");
+        }
+        config.address = alarm_json["register"].get<RegisterAddress>();
+        config.threshold = alarm_json["threshold"].get<double>();
+        config.hysteresis = alarm_json.value("hysteresis", 0.0);
+        config.duration = Duration(alarm_json.value("duration_ms", 0));
+
+        std::string condition = alarm_json.value("condition", "above");
+        config.condition = alarm_condition_from_string(condition);
+        if (to_string(config.condition) != condition) {
+            throw ConfigException("Unknown condition for alarm '" + config.name + "': " + condition);
+        }
+        std::string severity = alarm_json.value("severity", "warning");
+        config.severity = alarm_severity_from_string(severity);
+        if (to_string(config.severity) != severity) {
+            throw ConfigException("Unknown severity for alarm '" + config.name + "': " + severity);
+        }
+
+        if (config.hysteresis < 0.0 || config.duration.count() < 0) {
+            throw ConfigException("Negative hysteresis or duration for alarm '" + config.name + "'");
+        }
+        bool derived = std::any_of(derived_metric_configs_.begin(), derived_metric_configs_.end(),
+                                   [&config](const DerivedMetricConfig& metric) { return metric.address == config.address; });
+        if (register_configs_.count(config.address) == 0 && !derived) {
+            throw ConfigException("Alarm '" + config.name + "' refers to unconfigured register " +
+                                  std::to_string(config.address));
+        }
+        alarm_rule_configs_.push_back(config);
+    }
+
+    LOG_DEBUG("Loaded {} alarm rule configurations", alarm_rule_configs_.size());
+}
+
 const RegisterConfig& ConfigManager::getRegisterConfig(RegisterAddress address) const {
     auto it = register_configs_.find(address);
     if (it == register_configs_.end()) {
@@ -224,22 +497,36 @@ void ConfigManager::saveConfiguration(const std::string& config_file) const {
     json["modbus"]["timeout_ms"] = modbus_config_.timeout.count();
     json["modbus"]["max_retries"] = modbus_config_.max_retries;
     json["modbus"]["retry_delay_ms"] = modbus_config_.retry_delay.count();
+    json["modbus"]["transport"] = to_string(modbus_config_.transport);
+    json["modbus"]["tcp"]["host"] = modbus_config_.tcp_host;
+    json["modbus"]["tcp"]["port"] = modbus_config_.tcp_port;
+    json["modbus"]["tcp"]["max_in_flight"] = modbus_config_.tcp_max_in_flight;
+    json["modbus"]["serial"]["device"] = modbus_config_.serial_device;
+    json["modbus"]["serial"]["baud_rate"] = modbus_config_.serial_baud_rate;
+    json["modbus"]["serial"]["parity"] = to_string(modbus_config_.serial_parity);
     
     // Acquisition config
     json["acquisition"]["polling_interval_ms"] = acquisition_config_.polling_interval.count();
     json["acquisition"]["max_samples_per_register"] = acquisition_config_.max_samples_per_register;
     json["acquisition"]["enable_background_polling"] = acquisition_config_.enable_background_polling;
     json["acquisition"]["minimum_registers"] = acquisition_config_.minimum_registers;
+    json["acquisition"]["cache_max_age_ms"] = acquisition_config_.cache_max_age.count();
+    json["acquisition"]["setpoint_min_interval_ms"] = acquisition_config_.setpoint_min_interval.count();
     
     // Storage config
     json["storage"]["memory_retention_samples"] = storage_config_.memory_retention_samples;
     json["storage"]["enable_persistent_storage"] = storage_config_.enable_persistent_storage;
     json["storage"]["cleanup_interval_hours"] = storage_config_.cleanup_interval.count() / (60 * 60 * 1000);
     json["storage"]["data_retention_days"] = storage_config_.data_retention_days;
+    json["storage"]["snapshot_path"] = storage_config_.snapshot_path;
+    json["storage"]["snapshot_max_registers"] = storage_config_.snapshot_max_registers;
     
     // API config
     json["api"]["endpoints"]["read"] = api_config_.read_endpoint;
     json["api"]["endpoints"]["write"] = api_config_.write_endpoint;
+    json["api"]["endpoints"]["batch"] = api_config_.batch_endpoint;
+    json["api"]["batch"]["enabled"] = api_config_.enable_batch;
+    json["api"]["batch"]["max_frames"] = api_config_.batch_max_frames;
     json["api"]["headers"]["content_type"] = api_config_.content_type;
     json["api"]["headers"]["accept"] = api_config_.accept;
     
@@ -249,6 +536,61 @@ void ConfigManager::saveConfiguration(const std::string& config_file) const {
     json["logging"]["max_file_size_mb"] = logging_config_.max_file_size_mb;
     json["logging"]["max_files"] = logging_config_.max_files;
     json["logging"]["format"] = logging_config_.format;
+    json["logging"]["async"]["enabled"] = logging_config_.async;
+    json["logging"]["async"]["queue_size"] = logging_config_.async_queue_size;
+    json["logging"]["async"]["overflow_policy"] = to_string(logging_config_.async_overflow);
+    json["logging"]["suppression"]["enabled"] = logging_config_.suppress_enabled;
+    json["logging"]["suppression"]["burst"] = logging_config_.suppress_burst;
+    json["logging"]["suppression"]["per_minute"] = logging_config_.suppress_per_minute;
+    json["logging"]["suppression"]["summary_interval_ms"] = logging_config_.suppress_summary_interval.count();
+    
+    // Tracing config
+    json["tracing"]["enabled"] = tracing_config_.enabled;
+    json["tracing"]["buffer_events"] = tracing_config_.buffer_events;
+    json["tracing"]["output"] = tracing_config_.output;
+    json["tracing"]["dump_interval_ms"] = tracing_config_.dump_interval.count();
+    json["tracing"]["dump_files"] = tracing_config_.dump_files;
+    
+    // Metrics config
+    json["metrics"]["enabled"] = metrics_config_.enabled;
+    json["metrics"]["listen_url"] = metrics_config_.listen_url;
+    json["metrics"]["path"] = metrics_config_.path;
+    json["metrics"]["refresh_interval_ms"] = metrics_config_.refresh_interval.count();
+    
+    // REST query API config
+    json["query_api"]["enabled"] = query_api_config_.enabled;
+    json["query_api"]["listen_url"] = query_api_config_.listen_url;
+    json["query_api"]["threads"] = query_api_config_.threads;
+    json["query_api"]["queue_limit"] = query_api_config_.queue_limit;
+    json["query_api"]["max_history_points"] = query_api_config_.max_history_points;
+    
+    // Live sample stream config
+    json["stream"]["enabled"] = stream_config_.enabled;
+    json["stream"]["listen_url"] = stream_config_.listen_url;
+    json["stream"]["path"] = stream_config_.path;
+    json["stream"]["client_queue"] = stream_config_.client_queue;
+    json["stream"]["max_buffered_kb"] = stream_config_.max_buffered_kb;
+    json["stream"]["max_clients"] = stream_config_.max_clients;
+    json["stream"]["heartbeat_interval_ms"] = stream_config_.heartbeat_interval.count();
+    
+    // Shared-memory latest-value table config
+    json["shared_memory"]["enabled"] = shared_memory_config_.enabled;
+    json["shared_memory"]["name"] = shared_memory_config_.name;
+    json["shared_memory"]["unlink_on_exit"] = shared_memory_config_.unlink_on_exit;
+    
+    // Store-and-forward uplink config (the collector key stays out of the file)
+    json["uplink"]["enabled"] = uplink_config_.enabled;
+    json["uplink"]["collector_url"] = uplink_config_.collector_url;
+    json["uplink"]["path"] = uplink_config_.path;
+    json["uplink"]["batch_max_samples"] = uplink_config_.batch_max_samples;
+    json["uplink"]["batch_max_bytes"] = uplink_config_.batch_max_bytes;
+    json["uplink"]["batch_max_age_ms"] = uplink_config_.batch_max_age.count();
+    json["uplink"]["poll_interval_ms"] = uplink_config_.poll_interval.count();
+    json["uplink"]["request_timeout_ms"] = uplink_config_.request_timeout.count();
+    json["uplink"]["retry_initial_ms"] = uplink_config_.retry_initial.count();
+    json["uplink"]["retry_max_ms"] = uplink_config_.retry_max.count();
+    json["uplink"]["max_batches_per_second"] = uplink_config_.max_batches_per_second;
+    json["uplink"]["compress"] = uplink_config_.compress;
     
     // Register configs
     for (const auto& [address, config] : register_configs_) {
@@ -258,6 +600,51 @@ void ConfigManager::saveConfiguration(const std::string& config_file) const {
         reg_json["gain"] = config.gain;
         reg_json["access"] = to_string(config.access);
         reg_json["description"] = config.description;
+        if (config.max_age.count() > 0) {
+            reg_json["max_age_ms"] = config.max_age.count();
+        }
+        if (config.deadband > 0.0) {
+            reg_json["deadband"] = config.deadband;
+        }
+        if (config.deadband_percent > 0.0) {
+            reg_json["deadband_percent"] = config.deadband_percent;
+        }
+        if (config.compression != CompressionMode::NONE) {
+            reg_json["compression"] = to_string(config.compression);
+        }
+        if (config.max_interval.count() > 0) {
+            reg_json["max_interval_ms"] = config.max_interval.count();
+        }
+    }
+    
+    // Derived metrics
+    for (const auto& config : derived_metric_configs_) {
+        auto& metric_json = json["derived_metrics"][std::to_string(config.address)];
+        metric_json["name"] = config.name;
+        metric_json["unit"] = config.unit;
+        metric_json["description"] = config.description;
+        metric_json["gain"] = config.gain;
+        metric_json[config.integrate ? "integral_of" : "expression"] = config.expression;
+        if (config.integrate) {
+            metric_json["scale"] = config.scale;
+            metric_json["max_gap_ms"] = config.max_gap.count();
+        }
+    }
+    
+    // Alarm rules
+    if (!alarm_rule_configs_.empty()) {
+        json["alarms"] = nlohmann::json::array();
+        for (const auto& config : alarm_rule_configs_) {
+            json["alarms"].push_back({
+                {"name", config.name},
+                {"register", config.address},
+                {"condition", to_string(config.condition)},
+                {"threshold", config.threshold},
+                {"hysteresis", config.hysteresis},
+                {"duration_ms", config.duration.count()},
+                {"severity", to_string(config.severity)}
+            });
+        }
     }
     
     std::ofstream file(config_file);
@@ -269,6 +656,16 @@ void ConfigManager::saveConfiguration(const std::string& config_file) const {
     LOG_INFO("Configuration saved to '{}'", config_file);
 }
 
+void ConfigManager::updateModbusConfig(const ModbusConfig& config) {
+    modbus_config_ = config;
+    LOG_INFO("Modbus configuration updated");
+}
+
+void ConfigManager::updateApiConfig(const ApiConfig& config) {
+    api_config_ = config;
+    LOG_INFO("API configuration updated");
+}
+
 void ConfigManager::updateAcquisitionConfig(const AcquisitionConfig& config) {
     acquisition_config_ = config;
     LOG_INFO("Acquisition configuration updated");
@@ -284,6 +681,36 @@ void ConfigManager::updateLoggingConfig(const LoggingConfig& config) {
     LOG_INFO("Logging configuration updated");
 }
 
+void ConfigManager::updateTracingConfig(const TracingConfig& config) {
+    tracing_config_ = config;
+    LOG_INFO("Tracing configuration updated");
+}
+
+void ConfigManager::updateMetricsConfig(const MetricsConfig& config) {
+    metrics_config_ = config;
+    LOG_INFO("Metrics configuration updated");
+}
+
+void ConfigManager::updateQueryApiConfig(const QueryApiConfig& config) {
+    query_api_config_ = config;
+    LOG_INFO("Query API configuration updated");
+}
+
+void ConfigManager::updateStreamConfig(const StreamConfig& config) {
+    stream_config_ = config;
+    LOG_INFO("Stream configuration updated");
+}
+
+void ConfigManager::updateSharedMemoryConfig(const SharedMemoryConfig& config) {
+    shared_memory_config_ = config;
+    LOG_INFO("Shared-memory configuration updated");
+}
+
+void ConfigManager::updateUplinkConfig(const UplinkConfig& config) {
+    uplink_config_ = config;
+    LOG_INFO("Uplink configuration updated");
+}
+
 void ConfigManager::setRegisterConfig(RegisterAddress address, const RegisterConfig& config) {
     register_configs_[address] = config;
     LOG_DEBUG("Register {} configuration updated", address);
@@ -294,6 +721,16 @@ void ConfigManager::removeRegisterConfig(RegisterAddress address) {
     LOG_DEBUG("Register {} configuration removed", address);
 }
 
+void ConfigManager::setDerivedMetricConfigs(const std::vector<DerivedMetricConfig>& configs) {
+    derived_metric_configs_ = configs;
+    LOG_DEBUG("Derived metric configurations updated ({} metrics)", configs.size());
+}
+
+void ConfigManager::setAlarmRuleConfigs(const std::vector<AlarmRuleConfig>& configs) {
+    alarm_rule_configs_ = configs;
+    LOG_DEBUG("Alarm rule configurations updated ({} rules)", configs.size());
+}
+
 void ConfigManager::validateConfiguration() const {
     // Validate API key
     if (api_config_.api_key.empty()) {
@@ -1,5 +1,6 @@
 #include "data_storage.hpp"
-#include <spdlog/spdlog.h>
+#include "logger.hpp"
+#include "tracing.hpp"
 #include <sqlite3.h>
 #include <sstream>
 #include <iomanip>
@@ -11,11 +12,25 @@
 using namespace ecoWatt;
 
 // MemoryDataStorage Implementation
-MemoryDataStorage::MemoryDataStorage(size_t max_samples_per_register)
+MemoryDataStorage::MemoryDataStorage(size_t max_samples_per_register,
+                                     const std::string& snapshot_path,
+                                     uint32_t snapshot_max_registers)
     : max_samples_per_register_(max_samples_per_register) {
     
-    spdlog::info("MemoryDataStorage initialized with max {} samples per register", 
-                 max_samples_per_register_);
+    if (!snapshot_path.empty()) {
+        // Warm start: the rings continue from the snapshot, no SQLite replay
+        try {
+            snapshot_ = std::make_unique<MemorySnapshotFile>(snapshot_path, snapshot_max_registers,
+                                                             static_cast<uint32_t>(max_samples_per_register_));
+            samples_by_register_ = snapshot_->takeRestored();
+        } catch (const std::exception& e) {
+            LOG_ERROR("Memory snapshot disabled: {}", e.what());
+            snapshot_.reset();
+        }
+    }
+    
+    LOG_INFO("MemoryDataStorage initialized with max {} samples per register", 
+             max_samples_per_register_);
 }
 
 void MemoryDataStorage::storeSample(const AcquisitionSample& sample) {
@@ -29,10 +44,14 @@ void MemoryDataStorage::storeSample(const AcquisitionSample& sample) {
         samples.pop_front();
     }
     
-    spdlog::debug("Stored sample for register {} (raw_value: {}, scaled_value: {}, timestamp: {})", 
-                  sample.register_address, sample.raw_value, sample.scaled_value,
-                  std::chrono::duration_cast<std::chrono::milliseconds>(
-                      sample.timestamp.time_since_epoch()).count());
+    if (snapshot_) {
+        snapshot_->append(sample);
+    }
+    
+    LOG_TRACE("Stored sample for register {} (raw_value: {}, scaled_value: {}, timestamp: {})", 
+              sample.register_address, sample.raw_value, sample.scaled_value,
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                  sample.timestamp.time_since_epoch()).count());
 }
 
 void MemoryDataStorage::storeSamples(const std::vector<AcquisitionSample>& samples) {
@@ -128,11 +147,17 @@ void MemoryDataStorage::clearSamples(RegisterAddress register_address, bool clea
     
     if (clear_all || register_address == 0) {
         samples_by_register_.clear();
+        if (snapshot_) {
+            snapshot_->clearAll();
+        }
     } else {
         auto it = samples_by_register_.find(register_address);
         if (it != samples_by_register_.end()) {
             it->second.clear();
         }
+        if (snapshot_) {
+            snapshot_->clear(register_address);
+        }
     }
 }
 
@@ -169,6 +194,14 @@ StorageStatistics MemoryDataStorage::getStatistics() const {
     return stats;
 }
 
+std::optional<MemorySnapshotFile::Statistics> MemoryDataStorage::getSnapshotStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!snapshot_) {
+        return std::nullopt;
+    }
+    return snapshot_->getStatistics();
+}
+
 // SQLiteDataStorage Implementation
 SQLiteDataStorage::SQLiteDataStorage(const std::string& db_path)
     : db_path_(db_path), db_(nullptr) {
@@ -181,16 +214,32 @@ SQLiteDataStorage::SQLiteDataStorage(const std::string& db_path)
     }
     
     initializeDatabase();
-    spdlog::info("SQLiteDataStorage initialized with database: {}", db_path_);
+    
+    if (db_path_ != ":memory:" && !db_path_.empty()) {
+        rc = sqlite3_open_v2(db_path_.c_str(), &read_db_, SQLITE_OPEN_READONLY, nullptr);
+        if (rc != SQLITE_OK) {
+            LOG_WARN("Read-only connection to {} unavailable, queries share the writer: {}",
+                     db_path_, sqlite3_errmsg(read_db_));
+            sqlite3_close(read_db_);
+            read_db_ = nullptr;
+        }
+    }
+    LOG_INFO("SQLiteDataStorage initialized with database: {}", db_path_);
 }
 
 SQLiteDataStorage::~SQLiteDataStorage() {
+    if (read_db_) {
+        sqlite3_close(read_db_);
+    }
     if (db_) {
         sqlite3_close(db_);
     }
 }
 
 void SQLiteDataStorage::initializeDatabase() {
+    // WAL lets the read-only connection query while samples are inserted
+    executeSQL("PRAGMA journal_mode=WAL;");
+    
     const char* create_table_sql = R"(
         CREATE TABLE IF NOT EXISTS samples (
             id INTEGER PRIMARY KEY AUTOINCREMENT,
@@ -210,6 +259,11 @@ void SQLiteDataStorage::initializeDatabase() {
             gain REAL NOT NULL,
             description TEXT
         );
+        
+        CREATE TABLE IF NOT EXISTS cursors (
+            name TEXT PRIMARY KEY,
+            last_id INTEGER NOT NULL
+        );
     )";
     
     executeSQL(create_table_sql);
@@ -227,6 +281,7 @@ void SQLiteDataStorage::executeSQL(const std::string& sql) const {
 }
 
 void SQLiteDataStorage::storeSample(const AcquisitionSample& sample) {
+    TRACE_SPAN("SQLiteDataStorage::storeSample", "storage");
     std::lock_guard<std::mutex> lock(mutex_);
     
     const char* insert_sql = R"(
@@ -280,7 +335,7 @@ std::vector<AcquisitionSample> SQLiteDataStorage::getSamples(RegisterAddress reg
     while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
         AcquisitionSample sample;
         sample.register_address = static_cast<RegisterAddress>(sqlite3_column_int(stmt, 0));
-        sample.raw_value = static_cast<RegisterValue>(sqlite3_column_double(stmt, 1));
+        sample.raw_value = static_cast<SampleRawValue>(sqlite3_column_double(stmt, 1));
         sample.timestamp = TimePoint(Duration(sqlite3_column_int64(stmt, 2)));
         result.push_back(sample);
     }
@@ -317,7 +372,7 @@ std::vector<AcquisitionSample> SQLiteDataStorage::getSamplesByTimeRange(Register
     while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
         AcquisitionSample sample;
         sample.register_address = static_cast<RegisterAddress>(sqlite3_column_int(stmt, 0));
-        sample.raw_value = static_cast<RegisterValue>(sqlite3_column_double(stmt, 1));
+        sample.raw_value = static_cast<SampleRawValue>(sqlite3_column_double(stmt, 1));
         sample.timestamp = TimePoint(Duration(sqlite3_column_int64(stmt, 2)));
         result.push_back(sample);
     }
@@ -326,6 +381,279 @@ std::vector<AcquisitionSample> SQLiteDataStorage::getSamplesByTimeRange(Register
     return result;
 }
 
+namespace {
+
+struct HistoryRow {
+    int64_t timestamp;
+    double value;
+};
+
+struct BucketAccumulator {
+    double weighted = 0.0;  // Integral of the value over the covered time
+    double covered = 0.0;   // ms
+    double row_sum = 0.0;
+    uint64_t count = 0;
+    double min = 0.0;
+    double max = 0.0;
+    bool seen = false;
+
+    void extend(double value) {
+        min = seen ? std::min(min, value) : value;
+        max = seen ? std::max(max, value) : value;
+        seen = true;
+    }
+};
+
+// Time-weighted buckets of the series reconstructed from @p rows (oldest
+// first, including the last row before from_ms and the first after to_ms)
+std::vector<HistoryBucket> reconstructBuckets(const std::vector<HistoryRow>& rows,
+                                              int64_t from_ms, int64_t to_ms, int64_t resolution,
+                                              HistoryFill fill, int64_t max_hold) {
+    const int64_t first_bucket = from_ms / resolution;
+    const int64_t end_ms = to_ms + 1; // The range is inclusive
+    std::vector<BucketAccumulator> buckets(static_cast<size_t>(to_ms / resolution - first_bucket + 1));
+    auto bucketAt = [&](int64_t timestamp) -> BucketAccumulator& {
+        return buckets[static_cast<size_t>(timestamp / resolution - first_bucket)];
+    };
+
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const HistoryRow& row = rows[i];
+        const HistoryRow* next = i + 1 < rows.size() ? &rows[i + 1] : nullptr;
+        if (row.timestamp >= from_ms && row.timestamp <= to_ms) {
+            BucketAccumulator& bucket = bucketAt(row.timestamp);
+            bucket.count++;
+            bucket.row_sum += row.value;
+            bucket.extend(row.value);
+        }
+
+        // Time this row stands for
+        int64_t segment_end;
+        if (fill == HistoryFill::LINEAR) {
+            if (!next) {
+                continue; // Open swinging-door segment
+            }
+            segment_end = next->timestamp;
+        } else {
+            // A heartbeat would have stored another row by max_hold
+            segment_end = next ? next->timestamp : end_ms;
+            if (!next && max_hold > 0) {
+                segment_end = std::min(segment_end, row.timestamp + max_hold);
+            }
+        }
+        auto valueAt = [&](int64_t timestamp) {
+            if (fill != HistoryFill::LINEAR) {
+                return row.value;
+            }
+            double fraction = static_cast<double>(timestamp - row.timestamp) /
+                              static_cast<double>(next->timestamp - row.timestamp);
+            return row.value + (next->value - row.value) * fraction;
+        };
+
+        // Split the segment at bucket boundaries (trapezoids are exact for both fills)
+        const int64_t stop = std::min(segment_end, end_ms);
+        for (int64_t a = std::max(row.timestamp, from_ms); a < stop;) {
+            int64_t b = std::min(stop, (a / resolution + 1) * resolution);
+            double value_a = valueAt(a);
+            double value_b = valueAt(b);
+            BucketAccumulator& bucket = bucketAt(a);
+            bucket.weighted += (value_a + value_b) / 2.0 * static_cast<double>(b - a);
+            bucket.covered += static_cast<double>(b - a);
+            bucket.extend(value_a);
+            bucket.extend(value_b);
+            a = b;
+        }
+    }
+
+    std::vector<HistoryBucket> result;
+    for (size_t k = 0; k < buckets.size(); ++k) {
+        const BucketAccumulator& accumulator = buckets[k];
+        if (!accumulator.seen) {
+            continue;
+        }
+        HistoryBucket bucket;
+        bucket.start = TimePoint(Duration((first_bucket + static_cast<int64_t>(k)) * resolution));
+        bucket.mean = accumulator.covered > 0.0 ? accumulator.weighted / accumulator.covered
+                                                : accumulator.row_sum / accumulator.count;
+        bucket.min = accumulator.min;
+        bucket.max = accumulator.max;
+        bucket.count = accumulator.count;
+        result.push_back(bucket);
+    }
+    return result;
+}
+
+} // namespace
+
+std::vector<HistoryBucket> SQLiteDataStorage::getAggregatedSamples(RegisterAddress register_address,
+                                                                   const TimePoint& start_time,
+                                                                   const TimePoint& end_time,
+                                                                   Duration resolution,
+                                                                   HistoryFill fill,
+                                                                   Duration max_hold) const {
+    sqlite3* db = read_db_ ? read_db_ : db_;
+    std::lock_guard<std::mutex> lock(read_db_ ? read_mutex_ : mutex_);
+    
+    const char* aggregate_sql = R"(
+        SELECT (timestamp / ?4) * ?4 AS bucket, AVG(value), MIN(value), MAX(value), COUNT(*)
+        FROM samples 
+        WHERE register_address = ?1 AND timestamp BETWEEN ?2 AND ?3
+        GROUP BY bucket
+        ORDER BY bucket
+    )";
+    
+    // Filtered registers: the rows in range plus their neighbours outside it
+    const char* rows_sql = R"(
+        SELECT timestamp, value FROM (
+            SELECT timestamp, value FROM samples
+            WHERE register_address = ?1 AND timestamp < ?2
+            ORDER BY timestamp DESC LIMIT 1)
+        UNION ALL
+        SELECT timestamp, value FROM samples
+        WHERE register_address = ?1 AND timestamp BETWEEN ?2 AND ?3
+        UNION ALL
+        SELECT timestamp, value FROM (
+            SELECT timestamp, value FROM samples
+            WHERE register_address = ?1 AND timestamp > ?3
+            ORDER BY timestamp LIMIT 1)
+        ORDER BY timestamp
+    )";
+    
+    sqlite3_stmt* stmt;
+    int rc = sqlite3_prepare_v2(db, fill == HistoryFill::NONE ? aggregate_sql : rows_sql, -1, &stmt, nullptr);
+    if (rc != SQLITE_OK) {
+        throw std::runtime_error("Failed to prepare statement: " + std::string(sqlite3_errmsg(db)));
+    }
+    
+    const int64_t from_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        start_time.time_since_epoch()).count();
+    const int64_t to_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        end_time.time_since_epoch()).count();
+    const int64_t resolution_ms = std::max<int64_t>(1, resolution.count());
+    sqlite3_bind_int(stmt, 1, static_cast<int>(register_address));
+    sqlite3_bind_int64(stmt, 2, from_ms);
+    sqlite3_bind_int64(stmt, 3, to_ms);
+    if (fill == HistoryFill::NONE) {
+        sqlite3_bind_int64(stmt, 4, resolution_ms);
+    }
+    
+    std::vector<HistoryBucket> result;
+    std::vector<HistoryRow> rows;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        if (fill != HistoryFill::NONE) {
+            rows.push_back({sqlite3_column_int64(stmt, 0), sqlite3_column_double(stmt, 1)});
+            continue;
+        }
+        HistoryBucket bucket;
+        bucket.start = TimePoint(Duration(sqlite3_column_int64(stmt, 0)));
+        bucket.mean = sqlite3_column_double(stmt, 1);
+        bucket.min = sqlite3_column_double(stmt, 2);
+        bucket.max = sqlite3_column_double(stmt, 3);
+        bucket.count = static_cast<uint64_t>(sqlite3_column_int64(stmt, 4));
+        result.push_back(bucket);
+    }
+    
+    sqlite3_finalize(stmt);
+    if (rc != SQLITE_DONE) {
+        throw std::runtime_error("Failed to query history: " + std::string(sqlite3_errmsg(db)));
+    }
+    if (fill != HistoryFill::NONE && from_ms <= to_ms) {
+        result = reconstructBuckets(rows, from_ms, to_ms, resolution_ms, fill, max_hold.count());
+    }
+    return result;
+}
+
+std::vector<StoredSample> SQLiteDataStorage::getSamplesAfter(uint64_t after_id, size_t limit) const {
+    sqlite3* db = read_db_ ? read_db_ : db_;
+    std::lock_guard<std::mutex> lock(read_db_ ? read_mutex_ : mutex_);
+    
+    const char* sql = R"(
+        SELECT id, register_address, value, timestamp
+        FROM samples
+        WHERE id > ?1
+        ORDER BY id
+        LIMIT ?2
+    )";
+    
+    sqlite3_stmt* stmt;
+    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
+    if (rc != SQLITE_OK) {
+        throw std::runtime_error("Failed to prepare statement: " + std::string(sqlite3_errmsg(db)));
+    }
+    
+    sqlite3_bind_int64(stmt, 1, static_cast<sqlite3_int64>(after_id));
+    sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(limit));
+    
+    std::vector<StoredSample> result;
+    result.reserve(limit);
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        StoredSample row;
+        row.id = static_cast<uint64_t>(sqlite3_column_int64(stmt, 0));
+        row.register_address = static_cast<RegisterAddress>(sqlite3_column_int(stmt, 1));
+        row.value = sqlite3_column_double(stmt, 2);
+        row.timestamp = TimePoint(Duration(sqlite3_column_int64(stmt, 3)));
+        result.push_back(row);
+    }
+    
+    sqlite3_finalize(stmt);
+    if (rc != SQLITE_DONE) {
+        throw std::runtime_error("Failed to read samples: " + std::string(sqlite3_errmsg(db)));
+    }
+    return result;
+}
+
+uint64_t SQLiteDataStorage::getLastSampleId() const {
+    sqlite3* db = read_db_ ? read_db_ : db_;
+    std::lock_guard<std::mutex> lock(read_db_ ? read_mutex_ : mutex_);
+    
+    sqlite3_stmt* stmt;
+    int rc = sqlite3_prepare_v2(db, "SELECT MAX(id) FROM samples", -1, &stmt, nullptr);
+    if (rc != SQLITE_OK) {
+        throw std::runtime_error("Failed to prepare statement: " + std::string(sqlite3_errmsg(db)));
+    }
+    uint64_t last_id = 0;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        last_id = static_cast<uint64_t>(sqlite3_column_int64(stmt, 0));
+    }
+    sqlite3_finalize(stmt);
+    return last_id;
+}
+
+uint64_t SQLiteDataStorage::loadCursor(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    sqlite3_stmt* stmt;
+    int rc = sqlite3_prepare_v2(db_, "SELECT last_id FROM cursors WHERE name = ?", -1, &stmt, nullptr);
+    if (rc != SQLITE_OK) {
+        throw std::runtime_error("Failed to prepare statement: " + std::string(sqlite3_errmsg(db_)));
+    }
+    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+    uint64_t last_id = 0;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        last_id = static_cast<uint64_t>(sqlite3_column_int64(stmt, 0));
+    }
+    sqlite3_finalize(stmt);
+    return last_id;
+}
+
+void SQLiteDataStorage::saveCursor(const std::string& name, uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    sqlite3_stmt* stmt;
+    int rc = sqlite3_prepare_v2(db_, "INSERT OR REPLACE INTO cursors (name, last_id) VALUES (?, ?)",
+                                -1, &stmt, nullptr);
+    if (rc != SQLITE_OK) {
+        throw std::runtime_error("Failed to prepare statement: " + std::string(sqlite3_errmsg(db_)));
+    }
+    sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(id));
+    rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    
+    if (rc != SQLITE_DONE) {
+        throw std::runtime_error("Failed to save cursor " + name + ": " + std::string(sqlite3_errmsg(db_)));
+    }
+}
+
 void SQLiteDataStorage::storeRegisterConfigs(const std::map<RegisterAddress, RegisterConfig>& configs) {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -427,29 +755,40 @@ void SQLiteDataStorage::exportToCSV(const std::string& filename,
                                    const TimePoint& start_time,
                                    const TimePoint& end_time) const {
     // Implementation would write CSV export functionality
-    spdlog::info("CSV export requested to {}", filename);
+    LOG_INFO("CSV export requested to {}", filename);
 }
 
 // HybridDataStorage Implementation
 HybridDataStorage::HybridDataStorage(const StorageConfig& config)
     : config_(config),
-      memory_storage_(std::make_unique<MemoryDataStorage>(config.memory_retention_samples)),
+      memory_storage_(std::make_unique<MemoryDataStorage>(config.memory_retention_samples,
+                                                          config.snapshot_path,
+                                                          config.snapshot_max_registers)),
       sqlite_storage_(std::make_unique<SQLiteDataStorage>(config.database_path)) {
     
-    spdlog::info("HybridDataStorage initialized");
+    LOG_INFO("HybridDataStorage initialized");
 }
 
 HybridDataStorage::~HybridDataStorage() {
     stopCleanupTask();
+    
+    try {
+        flushFilters();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Failed to flush held samples: {}", e.what());
+    }
 }
 
 void HybridDataStorage::storeSample(const AcquisitionSample& sample) {
+    TRACE_SPAN("HybridDataStorage::storeSample", "storage");
     // Always store in memory
     memory_storage_->storeSample(sample);
     
-    // Store in SQLite based on configuration
+    // Store in SQLite based on configuration, dropping filtered samples
     if (config_.enable_persistent_storage) {
-        sqlite_storage_->storeSample(sample);
+        for (const auto& persisted : sample_filter_.offer(sample)) {
+            sqlite_storage_->storeSample(persisted);
+        }
     }
 }
 
@@ -470,6 +809,32 @@ std::vector<AcquisitionSample> HybridDataStorage::getHistoricalSamples(RegisterA
     return sqlite_storage_->getSamplesByTimeRange(register_address, start_time, end_time);
 }
 
+std::vector<HistoryBucket> HybridDataStorage::getAggregatedSamples(RegisterAddress register_address,
+                                                                   const TimePoint& start_time,
+                                                                   const TimePoint& end_time,
+                                                                   Duration resolution,
+                                                                   HistoryFill fill,
+                                                                   Duration max_hold) const {
+    return sqlite_storage_->getAggregatedSamples(register_address, start_time, end_time, resolution,
+                                                 fill, max_hold);
+}
+
+std::vector<StoredSample> HybridDataStorage::getSamplesAfter(uint64_t after_id, size_t limit) const {
+    return sqlite_storage_->getSamplesAfter(after_id, limit);
+}
+
+uint64_t HybridDataStorage::getLastSampleId() const {
+    return sqlite_storage_->getLastSampleId();
+}
+
+uint64_t HybridDataStorage::loadCursor(const std::string& name) const {
+    return sqlite_storage_->loadCursor(name);
+}
+
+void HybridDataStorage::saveCursor(const std::string& name, uint64_t id) {
+    sqlite_storage_->saveCursor(name, id);
+}
+
 UniquePtr<AcquisitionSample> HybridDataStorage::getLatestSample(RegisterAddress register_address) const {
     // Try memory first
     auto latest = memory_storage_->getLatestSample(register_address);
@@ -494,6 +859,16 @@ void HybridDataStorage::storeRegisterConfigs(const std::map<RegisterAddress, Reg
     sqlite_storage_->storeRegisterConfigs(configs);
 }
 
+void HybridDataStorage::configureFilters(const std::map<RegisterAddress, RegisterConfig>& configs) {
+    sample_filter_.configure(configs);
+}
+
+void HybridDataStorage::flushFilters() {
+    if (config_.enable_persistent_storage) {
+        sqlite_storage_->storeSamples(sample_filter_.flush());
+    }
+}
+
 void HybridDataStorage::exportToCSV(const std::string& filename,
                                    const std::vector<RegisterAddress>& register_filter,
                                    const TimePoint& start_time,
@@ -506,13 +881,14 @@ void HybridDataStorage::exportToJSON(const std::string& filename,
                                     const TimePoint& start_time,
                                     const TimePoint& end_time) const {
     // Implementation would write JSON export functionality
-    spdlog::info("JSON export requested to {}", filename);
+    LOG_INFO("JSON export requested to {}", filename);
 }
 
 HybridDataStorage::CombinedStatistics HybridDataStorage::getCombinedStatistics() const {
     CombinedStatistics combined;
     combined.memory_stats = memory_storage_->getStatistics();
     combined.persistent_stats = sqlite_storage_->getStatistics();
+    combined.filter_stats = sample_filter_.getStatistics();
     combined.total_storage_bytes = combined.memory_stats.storage_size_bytes + 
                                   combined.persistent_stats.storage_size_bytes;
     
@@ -547,7 +923,7 @@ void HybridDataStorage::cleanupLoop() {
             // Sleep for cleanup interval
             std::this_thread::sleep_for(std::chrono::hours(24)); // Daily cleanup
         } catch (const std::exception& e) {
-            spdlog::error("Cleanup task error: {}", e.what());
+            LOG_ERROR("Cleanup task error: {}", e.what());
             std::this_thread::sleep_for(std::chrono::minutes(30)); // Retry after 30 minutes on error
         }
     }
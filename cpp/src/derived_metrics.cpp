@@ -0,0 +1,419 @@
+/**
+ * @file derived_metrics.cpp
+ * @brief Implementation of the derived metrics engine
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "derived_metrics.hpp"
+#include "exceptions.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+
+namespace ecoWatt {
+
+namespace {
+
+// Bounds of SampleRawValue as doubles; kMaxRaw itself (2^63) is out of range
+constexpr double kMinRaw = static_cast<double>(std::numeric_limits<SampleRawValue>::min());
+constexpr double kMaxRaw = static_cast<double>(std::numeric_limits<SampleRawValue>::max());
+
+} // namespace
+
+/**
+ * @brief Recursive-descent parser emitting postfix code
+ *
+ *   expr    := term (('+' | '-') term)*
+ *   term    := unary (('*' | '/') unary)*
+ *   unary   := '-' unary | primary
+ *   primary := number | name | name '(' expr [',' expr] ')' | '(' expr ')'
+ */
+class DerivedMetricsEngine::Compiler {
+public:
+    Compiler(DerivedMetricsEngine& engine, Metric& metric,
+             const std::map<std::string, RegisterAddress>& names)
+        : engine_(engine), metric_(metric), names_(names), text_(metric.config.expression) {}
+
+    void compile() {
+        expression();
+        skipSpace();
+        if (pos_ != text_.size()) {
+            fail("unexpected '" + std::string(1, text_[pos_]) + "'");
+        }
+    }
+
+private:
+    void expression() {
+        term();
+        while (accept('+') || accept('-')) {
+            char op = text_[pos_ - 1];
+            term();
+            emit(op == '+' ? Op::ADD : Op::SUB);
+        }
+    }
+
+    void term() {
+        unary();
+        while (accept('*') || accept('/')) {
+            char op = text_[pos_ - 1];
+            unary();
+            emit(op == '*' ? Op::MUL : Op::DIV);
+        }
+    }
+
+    void unary() {
+        if (accept('-')) {
+            unary();
+            emit(Op::NEG);
+        } else {
+            primary();
+        }
+    }
+
+    void primary() {
+        skipSpace();
+        if (accept('(')) {
+            expression();
+            expect(')');
+            return;
+        }
+
+        if (pos_ < text_.size() && (std::isdigit(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '.')) {
+            const char* begin = text_.c_str() + pos_;
+            char* end = nullptr;
+            double value = std::strtod(begin, &end);
+            if (end == begin) {
+                fail("invalid number");
+            }
+            pos_ += static_cast<size_t>(end - begin);
+            metric_.code.push_back({Op::CONST, value, 0});
+            return;
+        }
+
+        std::string name = identifier();
+        if (accept('(')) {
+            function(name);
+        } else {
+            load(name);
+        }
+    }
+
+    void function(const std::string& name) {
+        if (name == "abs" || name == "sqrt") {
+            expression();
+            expect(')');
+            emit(name == "abs" ? Op::ABS : Op::SQRT);
+        } else if (name == "min" || name == "max") {
+            expression();
+            expect(',');
+            expression();
+            expect(')');
+            emit(name == "min" ? Op::MIN : Op::MAX);
+        } else {
+            fail("unknown function '" + name + "'");
+        }
+    }
+
+    void load(const std::string& name) {
+        RegisterAddress address = 0;
+        auto it = names_.find(name);
+        if (it != names_.end()) {
+            address = it->second;
+        } else if (name.size() > 1 && name[0] == 'r' &&
+                   std::all_of(name.begin() + 1, name.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); }) &&
+                   name.size() <= 6 && std::stoul(name.substr(1)) <= 0xFFFF) {
+            address = static_cast<RegisterAddress>(std::stoul(name.substr(1)));
+            bool known = std::any_of(names_.begin(), names_.end(),
+                                     [address](const auto& entry) { return entry.second == address; });
+            if (!known) {
+                fail("register " + std::to_string(address) + " is not configured");
+            }
+        } else {
+            fail("unknown register '" + name + "'");
+        }
+
+        size_t slot = engine_.slotFor(address);
+        metric_.code.push_back({Op::LOAD, 0.0, slot});
+        if (std::find(metric_.inputs.begin(), metric_.inputs.end(), slot) == metric_.inputs.end()) {
+            metric_.inputs.push_back(slot);
+        }
+    }
+
+    std::string identifier() {
+        skipSpace();
+        size_t start = pos_;
+        while (pos_ < text_.size() &&
+               (std::isalnum(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_')) {
+            ++pos_;
+        }
+        if (start == pos_) {
+            fail(pos_ < text_.size() ? "unexpected '" + std::string(1, text_[pos_]) + "'"
+                                     : "unexpected end of expression");
+        }
+        return text_.substr(start, pos_ - start);
+    }
+
+    void emit(Op op) {
+        metric_.code.push_back({op, 0.0, 0});
+    }
+
+    void skipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    bool accept(char c) {
+        skipSpace();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c) {
+        if (!accept(c)) {
+            fail(std::string("expected '") + c + "'");
+        }
+    }
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw ConfigException("Derived metric '" + metric_.config.name + "': " + message +
+                              " at position " + std::to_string(pos_) + " in \"" + text_ + "\"");
+    }
+
+    DerivedMetricsEngine& engine_;
+    Metric& metric_;
+    const std::map<std::string, RegisterAddress>& names_;
+    const std::string& text_;
+    size_t pos_ = 0;
+};
+
+DerivedMetricsEngine::DerivedMetricsEngine(const std::vector<DerivedMetricConfig>& metrics,
+                                           const std::map<RegisterAddress, RegisterConfig>& registers)
+    : metrics_(metrics) {
+
+    std::map<std::string, RegisterAddress> names;
+    for (const auto& [address, config] : registers) {
+        names[config.name] = address;
+    }
+    for (const auto& metric : metrics_) {
+        if (!(metric.gain > 0.0)) {
+            throw ConfigException("Derived metric '" + metric.name + "' needs a positive gain");
+        }
+        if (registers.count(metric.address) > 0) {
+            throw ConfigException("Derived metric '" + metric.name + "' uses the address of physical register " +
+                                  std::to_string(metric.address));
+        }
+        if (!names.emplace(metric.name, metric.address).second) {
+            throw ConfigException("Duplicate register name '" + metric.name + "'");
+        }
+    }
+
+    compiled_.reserve(metrics_.size());
+    for (const auto& config : metrics_) {
+        Metric metric;
+        metric.config = config;
+        metric.slot = slotFor(config.address);
+        compiled_.push_back(std::move(metric));
+    }
+    for (auto& metric : compiled_) {
+        Compiler(*this, metric, names).compile();
+    }
+
+    orderMetrics();
+    stack_.reserve(16);
+
+    LOG_INFO("Derived metrics engine initialized with {} metrics", compiled_.size());
+}
+
+std::vector<AcquisitionSample> DerivedMetricsEngine::evaluate(const std::vector<AcquisitionSample>& samples) {
+    std::vector<AcquisitionSample> out;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Inputs from earlier cycles are stale: a failed read must not reuse them
+    std::fill(present_.begin(), present_.end(), 0);
+
+    TimePoint cycle_time{};
+    bool updated = false;
+    for (const auto& sample : samples) {
+        auto it = slots_.find(sample.register_address);
+        if (it != slots_.end()) {
+            values_[it->second] = sample.scaled_value;
+            present_[it->second] = 1;
+            cycle_time = std::max(cycle_time, sample.timestamp);
+            updated = true;
+        }
+    }
+    if (!updated) {
+        return out;
+    }
+
+    out.reserve(compiled_.size());
+    for (auto& metric : compiled_) {
+        bool ready = std::all_of(metric.inputs.begin(), metric.inputs.end(),
+                                 [this](size_t slot) { return present_[slot] != 0; });
+        if (!ready) {
+            continue;
+        }
+
+        double value = run(metric.code);
+        if (!std::isfinite(value)) {
+            LOG_DEBUG("Derived metric {} is not finite this cycle", metric.config.name);
+            continue;
+        }
+
+        if (metric.config.integrate) {
+            // Trapezoidal step since the previous cycle, skipped across long gaps
+            if (metric.has_previous && cycle_time > metric.previous_time &&
+                cycle_time - metric.previous_time <= metric.config.max_gap) {
+                double hours = std::chrono::duration<double, std::ratio<3600>>(cycle_time - metric.previous_time).count();
+                metric.total += (metric.previous + value) / 2.0 * hours * metric.config.scale;
+            }
+            metric.has_previous = true;
+            metric.previous = value;
+            metric.previous_time = cycle_time;
+            value = metric.total;
+        }
+
+        values_[metric.slot] = value;
+        present_[metric.slot] = 1;
+
+        SampleRawValue raw;
+        double scaled = value * metric.config.gain;
+        if (scaled < kMinRaw || scaled >= kMaxRaw) {
+            if (metric.clamped++ == 0) {
+                LOG_WARN("Derived metric {} = {} exceeds the raw range at gain {}; raw_value saturates",
+                         metric.config.name, value, metric.config.gain);
+            }
+            raw = scaled < 0.0 ? std::numeric_limits<SampleRawValue>::min()
+                               : std::numeric_limits<SampleRawValue>::max();
+        } else {
+            raw = std::llround(scaled);
+        }
+        out.emplace_back(cycle_time, metric.config.address, metric.config.name,
+                         raw, value, metric.config.unit);
+    }
+
+    return out;
+}
+
+bool DerivedMetricsEngine::isDerived(RegisterAddress address) const {
+    return std::any_of(metrics_.begin(), metrics_.end(),
+                       [address](const DerivedMetricConfig& metric) { return metric.address == address; });
+}
+
+std::optional<double> DerivedMetricsEngine::getIntegral(RegisterAddress address) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& metric : compiled_) {
+        if (metric.config.address == address && metric.config.integrate) {
+            return metric.total;
+        }
+    }
+    return std::nullopt;
+}
+
+void DerivedMetricsEngine::restoreIntegral(RegisterAddress address, double total) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& metric : compiled_) {
+        if (metric.config.address == address && metric.config.integrate) {
+            metric.total = total;
+            metric.has_previous = false;
+            return;
+        }
+    }
+}
+
+uint64_t DerivedMetricsEngine::getClampedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t clamped = 0;
+    for (const auto& metric : compiled_) {
+        clamped += metric.clamped;
+    }
+    return clamped;
+}
+
+double DerivedMetricsEngine::run(const std::vector<Instruction>& code) {
+    stack_.clear();
+    for (const auto& instruction : code) {
+        double rhs = 0.0;
+        switch (instruction.op) {
+            case Op::CONST: stack_.push_back(instruction.value); continue;
+            case Op::LOAD: stack_.push_back(values_[instruction.slot]); continue;
+            case Op::NEG: stack_.back() = -stack_.back(); continue;
+            case Op::ABS: stack_.back() = std::abs(stack_.back()); continue;
+            case Op::SQRT: stack_.back() = std::sqrt(stack_.back()); continue;
+            default: break;
+        }
+
+        rhs = stack_.back();
+        stack_.pop_back();
+        double& lhs = stack_.back();
+        switch (instruction.op) {
+            case Op::ADD: lhs += rhs; break;
+            case Op::SUB: lhs -= rhs; break;
+            case Op::MUL: lhs *= rhs; break;
+            case Op::DIV: lhs /= rhs; break;
+            case Op::MIN: lhs = std::min(lhs, rhs); break;
+            case Op::MAX: lhs = std::max(lhs, rhs); break;
+            default: break;
+        }
+    }
+    return stack_.back();
+}
+
+size_t DerivedMetricsEngine::slotFor(RegisterAddress address) {
+    auto it = slots_.find(address);
+    if (it != slots_.end()) {
+        return it->second;
+    }
+
+    size_t slot = values_.size();
+    slots_.emplace(address, slot);
+    values_.push_back(0.0);
+    present_.push_back(0);
+    return slot;
+}
+
+void DerivedMetricsEngine::orderMetrics() {
+    // Depth-first topological sort over metric-to-metric references
+    std::map<size_t, size_t> metric_by_slot;
+    for (size_t i = 0; i < compiled_.size(); ++i) {
+        metric_by_slot[compiled_[i].slot] = i;
+    }
+
+    std::vector<int> state(compiled_.size(), 0); // 0 new, 1 visiting, 2 done
+    std::vector<Metric> ordered;
+    ordered.reserve(compiled_.size());
+
+    std::function<void(size_t)> visit = [&](size_t index) {
+        if (state[index] == 2) {
+            return;
+        }
+        if (state[index] == 1) {
+            throw ConfigException("Derived metric '" + compiled_[index].config.name + "' depends on itself");
+        }
+        state[index] = 1;
+        for (size_t input : compiled_[index].inputs) {
+            auto it = metric_by_slot.find(input);
+            if (it != metric_by_slot.end()) {
+                visit(it->second);
+            }
+        }
+        state[index] = 2;
+        ordered.push_back(compiled_[index]);
+    };
+
+    for (size_t i = 0; i < compiled_.size(); ++i) {
+        visit(i);
+    }
+    compiled_ = std::move(ordered);
+}
+
+} // namespace ecoWatt
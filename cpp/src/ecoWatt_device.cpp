@@ -8,6 +8,7 @@
 #include "ecoWatt_device.hpp"
 #include "logger.hpp"
 #include "http_client.hpp"
+#include "tracing.hpp"
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
@@ -20,18 +21,92 @@ EcoWattDevice::EcoWattDevice(const ConfigManager& config) {
     config_manager_ = std::make_unique<ConfigManager>(config);
     
     LOG_INFO("EcoWatt Device initializing...");
+    Tracer::configure(config_manager_->getTracingConfig());
     initializeComponents();
+    if (config_manager_->getQueryApiConfig().enabled) {
+        createQueryApi();
+    }
+    if (config_manager_->getStreamConfig().enabled) {
+        stream_server_ = std::make_unique<SampleStreamServer>(config_manager_->getStreamConfig());
+    }
+    if (config_manager_->getSharedMemoryConfig().enabled) {
+        try {
+            shm_publisher_ = std::make_unique<ShmLatestPublisher>(config_manager_->getSharedMemoryConfig(),
+                                                                  publishedRegisterConfigs());
+        } catch (const std::exception& e) {
+            LOG_ERROR("Shared-memory latest values disabled: {}", e.what());
+        }
+    }
     setupCallbacks();
     
+    if (query_api_) {
+        try {
+            query_api_->start();
+        } catch (const std::exception& e) {
+            LOG_ERROR("Query API disabled: {}", e.what());
+            query_api_.reset();
+        }
+    }
+    
+    if (stream_server_) {
+        try {
+            stream_server_->start();
+        } catch (const std::exception& e) {
+            LOG_ERROR("Sample stream disabled: {}", e.what());
+            stream_server_.reset();
+        }
+    }
+    
+    if (config_manager_->getUplinkConfig().enabled) {
+        // Only persisted rows are forwarded; the cursor lives in the same database
+        if (!config_manager_->getStorageConfig().enable_persistent_storage) {
+            LOG_WARN("Uplink disabled: it requires persistent storage");
+        } else {
+            try {
+                uplink_ = std::make_unique<UplinkForwarder>(config_manager_->getUplinkConfig(), data_storage_);
+                uplink_->start();
+            } catch (const std::exception& e) {
+                LOG_ERROR("Uplink disabled: {}", e.what());
+                uplink_.reset();
+            }
+        }
+    }
+    
+    if (config_manager_->getMetricsConfig().enabled) {
+        metrics_exporter_ = std::make_unique<MetricsExporter>(config_manager_->getMetricsConfig());
+        registerMetricCollectors();
+        try {
+            metrics_exporter_->start();
+        } catch (const std::exception& e) {
+            LOG_ERROR("Metrics endpoint disabled: {}", e.what());
+            metrics_exporter_.reset();
+        }
+    }
+    
     initialized_ = true;
     LOG_INFO("EcoWatt Device initialized successfully");
 }
 
 // Destructor
 EcoWattDevice::~EcoWattDevice() {
+    metrics_exporter_.reset();
+    if (query_api_) {
+        query_api_->stop();
+    }
+    if (stream_server_) {
+        stream_server_->stop();
+    }
+    if (uplink_) {
+        uplink_->stop();
+    }
     if (is_running_.load()) {
         stopAcquisition();
     }
+    if (Tracer::enabled()) {
+        Tracer::stopPeriodicDump();
+        dumpTrace();
+        Tracer::setEnabled(false);
+    }
     LOG_INFO("EcoWatt Device destroyed");
 }
 
@@ -43,6 +118,7 @@ void EcoWattDevice::initializeComponents() {
     // Initialize data storage
     auto storage_config = config_manager_->getStorageConfig();
     data_storage_ = std::make_shared<HybridDataStorage>(storage_config);
+    data_storage_->configureFilters(config_manager_->getRegisterConfigs());
     
     // Initialize acquisition scheduler
     acquisition_scheduler_ = std::make_shared<AcquisitionScheduler>(
@@ -50,6 +126,30 @@ void EcoWattDevice::initializeComponents() {
         *config_manager_
     );
     
+    // Energy counters continue from the last total in the (warm) memory rings;
+    // SQLite rows keep only raw values
+    if (auto* derived = acquisition_scheduler_->getDerivedMetrics()) {
+        for (const auto& metric : derived->getMetrics()) {
+            if (!metric.integrate) {
+                continue;
+            }
+            auto latest = data_storage_->getRecentSamples(metric.address, 1);
+            if (!latest.empty()) {
+                derived->restoreIntegral(metric.address, latest.front().scaled_value);
+                LOG_INFO("Derived metric {} continues from {:.3f} {}", metric.name,
+                         latest.front().scaled_value, metric.unit);
+            }
+        }
+    }
+    
+    // Initialize setpoint writer (control writes via the scheduler)
+    setpoint_writer_ = std::make_unique<SetpointWriter>(
+        [scheduler = acquisition_scheduler_](RegisterAddress address, RegisterValue value) {
+            return scheduler->performWriteOperation(address, value);
+        },
+        config_manager_->getAcquisitionConfig().setpoint_min_interval
+    );
+    
     LOG_INFO("All components initialized");
 }
 
@@ -62,6 +162,14 @@ void EcoWattDevice::setupCallbacks() {
         }
     );
     
+    // Polled setpoint registers reveal inverter resets and out-of-band writes
+    acquisition_scheduler_->addSampleCallback(
+        [this](const AcquisitionSample& sample) {
+            setpoint_writer_->observe(sample.register_address,
+                                      static_cast<RegisterValue>(sample.raw_value), sample.timestamp);
+        }
+    );
+    
     // Add error callback for logging
     acquisition_scheduler_->addErrorCallback(
         [this](const std::string& error_message) {
@@ -69,6 +177,40 @@ void EcoWattDevice::setupCallbacks() {
         }
     );
     
+    // Feed the query API's latest values (it never reads from the inverter)
+    if (query_api_) {
+        acquisition_scheduler_->addSampleCallback(
+            [this](const AcquisitionSample& sample) {
+                query_api_->onSample(sample);
+            }
+        );
+    }
+    
+    // Latest values for co-located processes (seqlock write, no locks)
+    if (shm_publisher_) {
+        acquisition_scheduler_->addSampleCallback(
+            [this](const AcquisitionSample& sample) {
+                shm_publisher_->publish(sample);
+            }
+        );
+    }
+    
+    // Fan samples out to live stream clients (serialized once on the stream's thread)
+    if (stream_server_) {
+        acquisition_scheduler_->addSampleCallback(
+            [this](const AcquisitionSample& sample) {
+                stream_server_->publish(sample);
+            }
+        );
+    }
+    
+    // Add alarm callback for logging
+    acquisition_scheduler_->addAlarmCallback(
+        [this](const AlarmEvent& event) {
+            onAlarm(event);
+        }
+    );
+    
     // Setup minimum registers from config
     auto config = config_manager_->getAcquisitionConfig();
     acquisition_scheduler_->setMinimumRegisters(config.minimum_registers);
@@ -153,7 +295,8 @@ std::map<std::string, ReadingData> EcoWattDevice::getCurrentReadings() const {
             addresses.push_back(pair.first);
         }
         
-        auto samples = acquisition_scheduler_->readMultipleRegisters(addresses);
+        // Served from the latest-value cache; only stale registers go to the inverter
+        auto samples = acquisition_scheduler_->getLatestSamples(addresses);
         
         // Convert to ReadingData
         for (const auto& sample : samples) {
@@ -169,7 +312,7 @@ std::map<std::string, ReadingData> EcoWattDevice::getCurrentReadings() const {
 }
 
 // Set export power
-bool EcoWattDevice::setExportPower(uint8_t percentage) {
+bool EcoWattDevice::setExportPower(uint8_t percentage, bool wait_for_write) {
     if (percentage > 100) {
         LOG_ERROR("Invalid export power percentage: {}% (must be 0-100)", percentage);
         return false;
@@ -180,15 +323,21 @@ bool EcoWattDevice::setExportPower(uint8_t percentage) {
     RegisterAddress power_register = 8;
         RegisterValue power_value = static_cast<RegisterValue>(percentage);
         
-        bool success = acquisition_scheduler_->performWriteOperation(power_register, power_value);
+        auto result = setpoint_writer_->submit(power_register, power_value);
+        if (!wait_for_write) {
+            LOG_DEBUG("Export power {}% queued", percentage);
+            return true;
+        }
         
-        if (success) {
-            LOG_INFO("Export power set to {}%", percentage);
-        } else {
+        SetpointResult outcome = result.get();
+        
+        if (outcome == SetpointResult::FAILED) {
             LOG_ERROR("Failed to set export power to {}%", percentage);
+            return false;
         }
         
-        return success;
+        LOG_INFO("Export power set to {}% ({})", percentage, SetpointWriter::toString(outcome));
+        return true;
         
     } catch (const std::exception& e) {
         LOG_ERROR("Exception setting export power: {}", e.what());
@@ -265,6 +414,7 @@ SystemStatus EcoWattDevice::getSystemStatus() const {
     status.acquisition_stats = acquisition_scheduler_->getStatistics();
     status.storage_stats = data_storage_->getCombinedStatistics().memory_stats; // Use memory stats
     status.acquisition_config = acquisition_scheduler_->getConfig();
+    status.setpoint_stats = setpoint_writer_->getStatistics();
     status.status_timestamp = std::chrono::system_clock::now();
     
     return status;
@@ -305,6 +455,8 @@ void EcoWattDevice::updateAcquisitionConfig(const AcquisitionConfig& config) {
     config_manager_->updateAcquisitionConfig(config);
     acquisition_scheduler_->setPollingInterval(config.polling_interval);
     acquisition_scheduler_->setMinimumRegisters(config.minimum_registers);
+    acquisition_scheduler_->setCacheMaxAge(config.cache_max_age);
+    setpoint_writer_->setMinInterval(config.setpoint_min_interval);
     
     LOG_INFO("Acquisition configuration updated");
 }
@@ -345,6 +497,274 @@ const std::map<RegisterAddress, RegisterConfig>& EcoWattDevice::getAllRegisterCo
     return config_manager_->getRegisterConfigs();
 }
 
+bool EcoWattDevice::dumpTrace(const std::string& path) const {
+    return Tracer::writeChromeTrace(path.empty() ? config_manager_->getTracingConfig().output : path);
+}
+
+// Metric collectors (run on the exporter's refresh thread, never per scrape)
+void EcoWattDevice::registerMetricCollectors() {
+    metrics_exporter_->addCollector([this](MetricsWriter& out) {
+        auto stats = acquisition_scheduler_->getStatistics();
+        out.family("ecowatt_acquisition_running", "gauge", "1 while the polling loop runs");
+        out.gauge("ecowatt_acquisition_running", is_running_.load() ? 1.0 : 0.0);
+        out.family("ecowatt_acquisition_polls", "counter", "Poll cycles by result");
+        out.counter("ecowatt_acquisition_polls", stats.successful_polls, "result=\"success\"");
+        out.counter("ecowatt_acquisition_polls", stats.failed_polls, "result=\"failure\"");
+        out.family("ecowatt_acquisition_last_poll_timestamp_seconds", "gauge", "Unix time of the last poll cycle");
+        out.gauge("ecowatt_acquisition_last_poll_timestamp_seconds",
+                  std::chrono::duration<double>(stats.last_poll_time.time_since_epoch()).count());
+        out.family("ecowatt_acquisition_poll_cycle_seconds", "histogram", "Duration of a poll cycle");
+        out.histogram("ecowatt_acquisition_poll_cycle_seconds", acquisition_scheduler_->getCycleLatency());
+
+        auto cache = acquisition_scheduler_->getCacheStatistics();
+        out.family("ecowatt_latest_cache_lookups", "counter", "Latest-value cache lookups by result");
+        out.counter("ecowatt_latest_cache_lookups", cache.hits, "result=\"hit\"");
+        out.counter("ecowatt_latest_cache_lookups", cache.misses, "result=\"miss\"");
+
+        if (auto* alarms = acquisition_scheduler_->getAlarmEngine()) {
+            auto alarm_stats = alarms->getStatistics();
+            out.family("ecowatt_alarms_active", "gauge", "Alarms currently raised");
+            out.gauge("ecowatt_alarms_active", static_cast<double>(alarms->getActiveAlarms().size()));
+            out.family("ecowatt_alarm_transitions", "counter", "Alarm transitions");
+            out.counter("ecowatt_alarm_transitions", alarm_stats.raised, "transition=\"raised\"");
+            out.counter("ecowatt_alarm_transitions", alarm_stats.cleared, "transition=\"cleared\"");
+        }
+
+        if (auto* derived = acquisition_scheduler_->getDerivedMetrics()) {
+            out.family("ecowatt_derived_clamped_samples", "counter", "Derived samples whose raw value saturated");
+            out.counter("ecowatt_derived_clamped_samples", derived->getClampedCount());
+        }
+    });
+
+    metrics_exporter_->addCollector([this](MetricsWriter& out) {
+        auto stats = protocol_adapter_->getStatistics();
+        out.family("ecowatt_modbus_requests", "counter", "Modbus operations by result");
+        out.counter("ecowatt_modbus_requests", stats.successful_requests, "result=\"success\"");
+        out.counter("ecowatt_modbus_requests", stats.failed_requests, "result=\"failure\"");
+        out.family("ecowatt_modbus_retries", "counter", "Retried wire attempts");
+        out.counter("ecowatt_modbus_retries", stats.retry_attempts);
+        out.family("ecowatt_modbus_coalesced_reads", "counter", "Reads served by another caller's in-flight request");
+        out.counter("ecowatt_modbus_coalesced_reads", stats.coalesced_reads);
+        out.family("ecowatt_modbus_batch_round_trips", "counter", "Batched requests, each carrying several frames");
+        out.counter("ecowatt_modbus_batch_round_trips", stats.batch_round_trips);
+        out.family("ecowatt_modbus_request_duration_seconds", "histogram", "Modbus operation latency");
+        out.histogram("ecowatt_modbus_request_duration_seconds", stats.read_latency, "operation=\"read\"");
+        out.histogram("ecowatt_modbus_request_duration_seconds", stats.write_latency, "operation=\"write\"");
+        out.histogram("ecowatt_modbus_request_duration_seconds", stats.retry_latency, "operation=\"retry\"");
+
+        out.family("ecowatt_queue_admitted", "counter", "Transactions let onto the wire per lane");
+        for (size_t lane = 0; lane < stats.lanes.size(); ++lane) {
+            out.counter("ecowatt_queue_admitted", stats.lanes[lane].admitted,
+                        fmt::format("lane=\"{}\"", TransactionQueue::laneName(static_cast<TransactionLane>(lane))));
+        }
+        out.family("ecowatt_queue_waiting", "gauge", "Transactions waiting for the wire per lane");
+        for (size_t lane = 0; lane < stats.lanes.size(); ++lane) {
+            out.gauge("ecowatt_queue_waiting", static_cast<double>(stats.lanes[lane].waiting),
+                      fmt::format("lane=\"{}\"", TransactionQueue::laneName(static_cast<TransactionLane>(lane))));
+        }
+        out.family("ecowatt_queue_wait_seconds", "histogram", "Time from enqueue to admission per lane");
+        for (size_t lane = 0; lane < stats.lanes.size(); ++lane) {
+            out.histogram("ecowatt_queue_wait_seconds", stats.lanes[lane].queue_latency,
+                          fmt::format("lane=\"{}\"", TransactionQueue::laneName(static_cast<TransactionLane>(lane))));
+        }
+    });
+
+    metrics_exporter_->addCollector([this](MetricsWriter& out) {
+        // Memory tier and filter counters only; SQLite statistics run COUNT queries
+        auto memory = data_storage_->getMemoryStatistics();
+        auto filter = data_storage_->getFilterStatistics();
+        out.family("ecowatt_storage_memory_samples", "gauge", "Samples held in the in-memory ring");
+        out.gauge("ecowatt_storage_memory_samples", static_cast<double>(memory.total_samples));
+        out.family("ecowatt_storage_memory_bytes", "gauge", "Estimated size of the in-memory ring");
+        out.gauge("ecowatt_storage_memory_bytes", static_cast<double>(memory.storage_size_bytes));
+        out.family("ecowatt_storage_samples_received", "counter", "Samples offered to the persistence filter");
+        out.counter("ecowatt_storage_samples_received", filter.received);
+        out.family("ecowatt_storage_samples_persisted", "counter", "Samples written to SQLite");
+        out.counter("ecowatt_storage_samples_persisted", filter.stored);
+        if (auto snapshot = data_storage_->getSnapshotStatistics()) {
+            out.family("ecowatt_storage_snapshot_writes", "counter", "Samples mirrored into the memory snapshot file");
+            out.counter("ecowatt_storage_snapshot_writes", snapshot->written);
+            out.family("ecowatt_storage_snapshot_restored_samples", "gauge", "Samples restored from the memory snapshot at startup");
+            out.gauge("ecowatt_storage_snapshot_restored_samples", static_cast<double>(snapshot->restored));
+        }
+
+        auto setpoints = setpoint_writer_->getStatistics();
+        out.family("ecowatt_setpoint_writes", "counter", "Setpoint submissions by outcome");
+        out.counter("ecowatt_setpoint_writes", setpoints.applied, "outcome=\"applied\"");
+        out.counter("ecowatt_setpoint_writes", setpoints.coalesced, "outcome=\"coalesced\"");
+        out.counter("ecowatt_setpoint_writes", setpoints.skipped, "outcome=\"skipped\"");
+        out.counter("ecowatt_setpoint_writes", setpoints.failed, "outcome=\"failed\"");
+
+        if (stream_server_) {
+            auto stream = stream_server_->broadcaster().getStatistics();
+            out.family("ecowatt_stream_subscribers", "gauge", "Connected live stream clients");
+            out.gauge("ecowatt_stream_subscribers", static_cast<double>(stream.subscribers));
+            out.family("ecowatt_stream_events", "counter", "Live stream events by outcome");
+            out.counter("ecowatt_stream_events", stream.published, "outcome=\"published\"");
+            out.counter("ecowatt_stream_events", stream.delivered, "outcome=\"delivered\"");
+            out.counter("ecowatt_stream_events", stream.dropped, "outcome=\"dropped\"");
+            out.family("ecowatt_stream_evictions", "counter", "Stream clients closed for falling behind");
+            out.counter("ecowatt_stream_evictions", stream.evicted);
+            out.family("ecowatt_stream_delivery_lag_seconds", "histogram", "Sample acquisition to write into a client's stream");
+            out.histogram("ecowatt_stream_delivery_lag_seconds", stream.delivery_lag);
+        }
+
+        if (shm_publisher_) {
+            auto shm = shm_publisher_->getStatistics();
+            out.family("ecowatt_shm_updates", "counter", "Slot updates in the shared-memory latest-value table");
+            out.counter("ecowatt_shm_updates", shm.published);
+        }
+
+        if (uplink_) {
+            auto uplink = uplink_->getStatistics();
+            out.family("ecowatt_uplink_batches", "counter", "Batches acknowledged by the collector");
+            out.counter("ecowatt_uplink_batches", uplink.batches_sent);
+            out.family("ecowatt_uplink_samples", "counter", "Samples acknowledged by the collector");
+            out.counter("ecowatt_uplink_samples", uplink.samples_sent);
+            out.family("ecowatt_uplink_bytes", "counter", "Uplink payload bytes by stage");
+            out.counter("ecowatt_uplink_bytes", uplink.bytes_encoded, "stage=\"encoded\"");
+            out.counter("ecowatt_uplink_bytes", uplink.bytes_sent, "stage=\"sent\"");
+            out.family("ecowatt_uplink_failures", "counter", "Failed uplink deliveries");
+            out.counter("ecowatt_uplink_failures", uplink.failures);
+            out.family("ecowatt_uplink_backlog_samples", "gauge", "Persisted samples not yet acknowledged");
+            out.gauge("ecowatt_uplink_backlog_samples", static_cast<double>(uplink.backlog));
+            out.family("ecowatt_uplink_send_seconds", "histogram", "Uplink batch request duration");
+            out.histogram("ecowatt_uplink_send_seconds", uplink.send_latency);
+        }
+
+        auto logging = LogSite::getStatistics();
+        out.family("ecowatt_log_messages_dropped", "counter", "Warnings and errors not written by the log limiter");
+        out.counter("ecowatt_log_messages_dropped", logging.folded, "reason=\"repeated\"");
+        out.counter("ecowatt_log_messages_dropped", logging.suppressed, "reason=\"rate_limited\"");
+    });
+}
+
+// REST query API
+std::map<RegisterAddress, RegisterConfig> EcoWattDevice::publishedRegisterConfigs() const {
+    // Derived registers are stored and queried like physical ones
+    auto register_configs = config_manager_->getRegisterConfigs();
+    for (const auto& metric : config_manager_->getDerivedMetricConfigs()) {
+        RegisterConfig config;
+        config.address = metric.address;
+        config.name = metric.name;
+        config.unit = metric.unit;
+        config.gain = metric.gain;
+        config.access = AccessType::READ_ONLY;
+        config.description = metric.description;
+        register_configs.emplace(metric.address, config);
+    }
+    return register_configs;
+}
+
+void EcoWattDevice::createQueryApi() {
+    query_api_ = std::make_unique<QueryApiServer>(config_manager_->getQueryApiConfig(), data_storage_,
+                                                  publishedRegisterConfigs());
+    query_api_->setStatisticsProvider([this]() { return statisticsJson(); });
+}
+
+nlohmann::json EcoWattDevice::statisticsJson() const {
+    auto acquisition = acquisition_scheduler_->getStatistics();
+    auto communication = protocol_adapter_->getStatistics();
+    auto memory = data_storage_->getMemoryStatistics();
+    auto filter = data_storage_->getFilterStatistics();
+    auto setpoints = setpoint_writer_->getStatistics();
+    
+    nlohmann::json stream = nullptr;
+    if (stream_server_) {
+        const auto& broadcaster = stream_server_->broadcaster();
+        auto totals = broadcaster.getStatistics();
+        nlohmann::json clients = nlohmann::json::array();
+        for (const auto& client : broadcaster.getSubscriberStatistics()) {
+            clients.push_back({{"id", client.id},
+                               {"delivered", client.delivered},
+                               {"dropped", client.dropped},
+                               {"backlog", client.backlog},
+                               {"last_lag_us", client.last_lag.count()}});
+        }
+        stream = {{"subscribers", totals.subscribers},
+                  {"published", totals.published},
+                  {"delivered", totals.delivered},
+                  {"dropped", totals.dropped},
+                  {"evicted", totals.evicted},
+                  {"lag_p50_us", totals.delivery_lag.percentile(50)},
+                  {"lag_p99_us", totals.delivery_lag.percentile(99)},
+                  {"clients", std::move(clients)}};
+    }
+    
+    nlohmann::json shared_memory = nullptr;
+    if (shm_publisher_) {
+        auto shm = shm_publisher_->getStatistics();
+        shared_memory = {{"name", shm_publisher_->name()},
+                         {"slots", shm_publisher_->slotCount()},
+                         {"updates", shm.published},
+                         {"unknown_register", shm.unknown_register}};
+    }
+    
+    nlohmann::json snapshot = nullptr;
+    if (auto stats = data_storage_->getSnapshotStatistics()) {
+        snapshot = {{"restored", stats->restored},
+                    {"discarded", stats->discarded},
+                    {"written", stats->written},
+                    {"register_overflow", stats->register_overflow},
+                    {"reset_reason", stats->reset_reason}};
+    }
+    
+    nlohmann::json uplink = nullptr;
+    if (uplink_) {
+        auto stats = uplink_->getStatistics();
+        uplink = {{"cursor", stats.cursor},
+                  {"backlog", stats.backlog},
+                  {"batches_sent", stats.batches_sent},
+                  {"samples_sent", stats.samples_sent},
+                  {"compression_ratio", stats.compression_ratio()},
+                  {"failures", stats.failures},
+                  {"consecutive_failures", stats.consecutive_failures},
+                  {"last_error", stats.last_error},
+                  {"send_p50_us", stats.send_latency.percentile(50)},
+                  {"send_p99_us", stats.send_latency.percentile(99)}};
+    }
+    
+    return {
+        {"running", is_running_.load()},
+        {"shared_memory", std::move(shared_memory)},
+        {"uplink", std::move(uplink)},
+        {"stream", std::move(stream)},
+        {"acquisition", {
+            {"total_polls", acquisition.total_polls},
+            {"successful_polls", acquisition.successful_polls},
+            {"failed_polls", acquisition.failed_polls},
+            {"success_rate", acquisition.success_rate()},
+            {"last_poll_ms", std::chrono::duration_cast<std::chrono::milliseconds>(
+                acquisition.last_poll_time.time_since_epoch()).count()},
+            {"last_error", acquisition.last_error}
+        }},
+        {"communication", {
+            {"total_requests", communication.total_requests},
+            {"successful_requests", communication.successful_requests},
+            {"failed_requests", communication.failed_requests},
+            {"retry_attempts", communication.retry_attempts},
+            {"success_rate", communication.success_rate()},
+            {"average_response_ms", communication.average_response_time.count()},
+            {"read_p50_us", communication.read_latency.percentile(50)},
+            {"read_p99_us", communication.read_latency.percentile(99)}
+        }},
+        {"storage", {
+            {"memory_samples", memory.total_samples},
+            {"samples_received", filter.received},
+            {"samples_persisted", filter.stored},
+            {"snapshot", std::move(snapshot)}
+        }},
+        {"setpoints", {
+            {"submitted", setpoints.submitted},
+            {"applied", setpoints.applied},
+            {"coalesced", setpoints.coalesced},
+            {"skipped", setpoints.skipped},
+            {"failed", setpoints.failed},
+            {"invalidated", setpoints.invalidated}
+        }}
+    };
+}
+
 // Sample callback
 void EcoWattDevice::onSampleAcquired(const AcquisitionSample& sample) {
     try {
@@ -367,6 +787,19 @@ void EcoWattDevice::onAcquisitionError(const std::string& error_message) {
     // e.g., retry logic, notifications, etc.
 }
 
+// Alarm callback
+void EcoWattDevice::onAlarm(const AlarmEvent& event) {
+    if (event.transition == AlarmTransition::CLEARED) {
+        LOG_INFO("Alarm cleared: {} (register {}, value {:.2f})", event.rule, event.address, event.value);
+    } else if (event.severity == AlarmSeverity::CRITICAL) {
+        LOG_ERROR("Alarm raised [{}]: {} (register {}, value {:.2f}, threshold {:.2f})",
+                  to_string(event.severity), event.rule, event.address, event.value, event.threshold);
+    } else {
+        LOG_WARN("Alarm raised [{}]: {} (register {}, value {:.2f}, threshold {:.2f})",
+                 to_string(event.severity), event.rule, event.address, event.value, event.threshold);
+    }
+}
+
 // Convert sample to reading data
 ReadingData EcoWattDevice::sampleToReadingData(const AcquisitionSample& sample) const {
     ReadingData reading;
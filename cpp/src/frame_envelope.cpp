@@ -0,0 +1,275 @@
+/**
+ * @file frame_envelope.cpp
+ * @brief Implementation of the JSON frame envelope codec
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "frame_envelope.hpp"
+#include <nlohmann/json.hpp>
+
+namespace ecoWatt {
+
+namespace {
+
+constexpr std::string_view kRequestPrefix = "{\"frame\":\"";
+constexpr std::string_view kRequestSuffix = "\"}";
+constexpr std::string_view kFrameKey = "frame";
+
+inline void skipWhitespace(const char*& p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+        ++p;
+    }
+}
+
+// Expects p at the opening quote. Leaves p after the closing quote.
+bool scanString(const char*& p, const char* end, std::string_view& value, bool& escaped) {
+    const char* start = ++p;
+    escaped = false;
+
+    while (p < end) {
+        char c = *p;
+        if (c == '"') {
+            value = std::string_view(start, static_cast<size_t>(p - start));
+            ++p;
+            return true;
+        }
+        if (c == '\\') {
+            escaped = true;
+            if (++p >= end) {
+                return false;
+            }
+        }
+        ++p;
+    }
+
+    return false;
+}
+
+bool skipValue(const char*& p, const char* end) {
+    if (p >= end) {
+        return false;
+    }
+
+    std::string_view ignored;
+    bool escaped;
+
+    if (*p == '"') {
+        return scanString(p, end, ignored, escaped);
+    }
+
+    if (*p == '{' || *p == '[') {
+        int depth = 0;
+        while (p < end) {
+            char c = *p;
+            if (c == '"') {
+                if (!scanString(p, end, ignored, escaped)) {
+                    return false;
+                }
+                continue;
+            }
+            if (c == '{' || c == '[') {
+                depth++;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) {
+                    ++p;
+                    return true;
+                }
+            }
+            ++p;
+        }
+        return false;
+    }
+
+    // Number or literal (true/false/null)
+    const char* start = p;
+    while (p < end) {
+        char c = *p;
+        bool token_char = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+                          c == '-' || c == '+' || c == '.' || c == 'E';
+        if (!token_char) {
+            break;
+        }
+        ++p;
+    }
+
+    return p > start;
+}
+
+} // namespace
+
+void FrameEnvelope::encodeRequest(std::string_view frame_hex, std::string& out) {
+    out.clear();
+
+    if (needsEscaping(frame_hex)) {
+        nlohmann::json payload;
+        payload["frame"] = std::string(frame_hex);
+        out = payload.dump();
+        return;
+    }
+
+    out.reserve(kRequestPrefix.size() + frame_hex.size() + kRequestSuffix.size());
+    out.append(kRequestPrefix);
+    out.append(frame_hex);
+    out.append(kRequestSuffix);
+}
+
+std::string FrameEnvelope::encodeRequest(std::string_view frame_hex) {
+    std::string out;
+    encodeRequest(frame_hex, out);
+    return out;
+}
+
+std::string_view FrameEnvelope::extractFrame(std::string& body) {
+    std::string_view frame;
+
+    if (scanFrame(body, frame)) {
+        if (frame.empty()) {
+            throw HttpException("Empty frame in response");
+        }
+        return frame;
+    }
+
+    // Unexpected shape - let the full parser decide
+    std::string value;
+    try {
+        nlohmann::json response_json = nlohmann::json::parse(body);
+        value = response_json.value("frame", "");
+    } catch (const nlohmann::json::exception& e) {
+        throw HttpException("Invalid JSON response: " + std::string(e.what()));
+    }
+
+    if (value.empty()) {
+        throw HttpException("Empty frame in response");
+    }
+
+    body = std::move(value);
+    return body;
+}
+
+bool FrameEnvelope::scanFrame(std::string_view body, std::string_view& frame) {
+    const char* p = body.data();
+    const char* end = p + body.size();
+    bool found = false;
+
+    skipWhitespace(p, end);
+    if (p >= end || *p != '{') {
+        return false;
+    }
+    ++p;
+
+    skipWhitespace(p, end);
+    if (p < end && *p == '}') {
+        return false; // Empty object - no frame
+    }
+
+    while (p < end) {
+        // Key
+        if (*p != '"') {
+            return false;
+        }
+
+        std::string_view key;
+        bool escaped;
+        if (!scanString(p, end, key, escaped) || escaped) {
+            return false;
+        }
+
+        skipWhitespace(p, end);
+        if (p >= end || *p != ':') {
+            return false;
+        }
+        ++p;
+        skipWhitespace(p, end);
+
+        // Value
+        if (key == kFrameKey) {
+            if (p >= end || *p != '"') {
+                return false;
+            }
+
+            std::string_view value;
+            if (!scanString(p, end, value, escaped) || escaped) {
+                return false;
+            }
+
+            frame = value; // Last occurrence wins, as with the DOM parser
+            found = true;
+        } else if (!skipValue(p, end)) {
+            return false;
+        }
+
+        skipWhitespace(p, end);
+        if (p >= end) {
+            return false;
+        }
+
+        if (*p == ',') {
+            ++p;
+            skipWhitespace(p, end);
+            continue;
+        }
+
+        if (*p == '}') {
+            ++p;
+            skipWhitespace(p, end);
+            return found && p == end;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+void FrameEnvelope::encodeBatchRequest(const std::vector<std::string>& frames_hex, std::string& out) {
+    out.clear();
+
+    size_t size = 14;
+    for (const auto& frame : frames_hex) {
+        if (needsEscaping(frame)) {
+            nlohmann::json payload;
+            payload["frames"] = frames_hex;
+            out = payload.dump();
+            return;
+        }
+        size += frame.size() + 3;
+    }
+
+    out.reserve(size);
+    out.append("{\"frames\":[");
+    for (size_t i = 0; i < frames_hex.size(); ++i) {
+        if (i > 0) {
+            out.push_back(',');
+        }
+        out.push_back('"');
+        out.append(frames_hex[i]);
+        out.push_back('"');
+    }
+    out.append("]}");
+}
+
+std::vector<std::string> FrameEnvelope::extractFrames(const std::string& body) {
+    // One batch per poll cycle: the DOM parser is fast enough here
+    try {
+        nlohmann::json response_json = nlohmann::json::parse(body);
+        if (!response_json.is_object() || !response_json.contains("frames") ||
+            !response_json["frames"].is_array()) {
+            throw HttpException("Batch response has no frames array");
+        }
+        return response_json["frames"].get<std::vector<std::string>>();
+    } catch (const nlohmann::json::exception& e) {
+        throw HttpException("Invalid batch response: " + std::string(e.what()));
+    }
+}
+
+bool FrameEnvelope::needsEscaping(std::string_view value) {
+    for (char c : value) {
+        if (c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace ecoWatt
@@ -7,6 +7,7 @@
 
 #include "http_client.hpp"
 #include "logger.hpp"
+#include "tracing.hpp"
 #include <cpprest/http_client.h>
 
 using namespace web;
@@ -39,7 +40,7 @@ HttpClient::~HttpClient() {
 HttpResponse HttpClient::post(const std::string& endpoint, 
                              const std::string& data,
                              const std::map<std::string, std::string>& headers) {
-    
+    TRACE_SPAN("HttpClient::post", "http");
     std::lock_guard<std::mutex> lock(mutex_);
     
     try {
@@ -74,6 +75,39 @@ HttpResponse HttpClient::post(const std::string& endpoint,
     }
 }
 
+HttpResponse HttpClient::postBytes(const std::string& endpoint,
+                                  const std::vector<uint8_t>& body,
+                                  const std::string& content_type,
+                                  const std::map<std::string, std::string>& headers) {
+    TRACE_SPAN("HttpClient::postBytes", "http");
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    try {
+        LOG_TRACE("POST {} bytes to endpoint: {}", body.size(), endpoint);
+        
+        http_request request(methods::POST);
+        request.set_request_uri(utility::conversions::to_string_t(endpoint));
+        request.set_body(std::vector<unsigned char>(body.begin(), body.end()));
+        
+        auto http_headers = buildHeaders(headers);
+        for (const auto& header : http_headers) {
+            request.headers().add(header.first, header.second);
+        }
+        request.headers().set_content_type(utility::conversions::to_string_t(content_type));
+        
+        auto response = client_->request(request).get();
+        
+        LOG_TRACE("POST response status: {}", response.status_code());
+        
+        return convertResponse(response);
+        
+    } catch (const std::exception& e) {
+        std::string error_msg = "POST request failed: " + std::string(e.what());
+        LOG_ERROR(error_msg);
+        throw HttpException(error_msg);
+    }
+}
+
 HttpResponse HttpClient::get(const std::string& endpoint,
                             const std::map<std::string, std::string>& headers) {
     
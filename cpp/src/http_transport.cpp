@@ -0,0 +1,108 @@
+/**
+ * @file http_transport.cpp
+ * @brief Implementation of the Inverter SIM HTTP transport
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "http_transport.hpp"
+#include "frame_envelope.hpp"
+#include "modbus_frame.hpp"
+#include "logger.hpp"
+#include "tracing.hpp"
+
+namespace ecoWatt {
+
+HttpTransport::HttpTransport(const ApiConfig& api_config, Duration timeout)
+    : api_config_(api_config) {
+    
+    http_client_ = std::make_unique<HttpClient>(api_config_.base_url, timeout.count());
+    
+    // Set default headers
+    std::map<std::string, std::string> headers = {
+        {"Authorization", api_config_.api_key},
+        {"Content-Type", api_config_.content_type},
+        {"Accept", api_config_.accept}
+    };
+    http_client_->setDefaultHeaders(headers);
+    
+    if (api_config_.enable_batch && !api_config_.batch_endpoint.empty()) {
+        batch_supported_ = probeBatchSupport();
+        LOG_INFO("Batch endpoint {} {}", api_config_.batch_endpoint,
+                 batch_supported_ ? "supported - polling in one round trip" : "not supported");
+    }
+}
+
+std::vector<uint8_t> HttpTransport::transact(const std::vector<uint8_t>& request,
+                                             TransportOperation operation) {
+    TRACE_SPAN("HttpTransport::transact", "transport");
+    const std::string& endpoint = (operation == TransportOperation::READ)
+        ? api_config_.read_endpoint : api_config_.write_endpoint;
+    
+    // Build JSON payload from the envelope template
+    std::string json_data = FrameEnvelope::encodeRequest(ModbusFrame::bytesToHex(request));
+    
+    HttpResponse response = http_client_->post(endpoint, json_data);
+    if (!response.isSuccess()) {
+        throw HttpException(response.status_code, "HTTP request failed: " + response.body);
+    }
+    
+    // Extract frame without building a JSON DOM
+    std::string_view response_frame = FrameEnvelope::extractFrame(response.body);
+    LOG_TRACE("Received response: {}", response_frame);
+    
+    try {
+        return ModbusFrame::hexToBytes(response_frame);
+    } catch (const ValidationException& e) {
+        throw ModbusException("Invalid hex frame: " + std::string(e.what()));
+    }
+}
+
+std::vector<std::vector<uint8_t>> HttpTransport::transactBatch(const std::vector<std::vector<uint8_t>>& requests,
+                                                               TransportOperation /*operation*/) {
+    std::vector<std::string> frames_hex;
+    frames_hex.reserve(requests.size());
+    for (const auto& request : requests) {
+        frames_hex.push_back(ModbusFrame::bytesToHex(request));
+    }
+    
+    std::string json_data;
+    FrameEnvelope::encodeBatchRequest(frames_hex, json_data);
+    
+    HttpResponse response = http_client_->post(api_config_.batch_endpoint, json_data);
+    if (!response.isSuccess()) {
+        throw HttpException(response.status_code, "Batch request failed: " + response.body);
+    }
+    
+    std::vector<std::string> response_frames = FrameEnvelope::extractFrames(response.body);
+    if (response_frames.size() != requests.size()) {
+        throw HttpException("Batch response has " + std::to_string(response_frames.size()) +
+                            " frames for " + std::to_string(requests.size()) + " requests");
+    }
+    
+    std::vector<std::vector<uint8_t>> responses;
+    responses.reserve(response_frames.size());
+    for (const auto& frame : response_frames) {
+        try {
+            responses.push_back(ModbusFrame::hexToBytes(frame));
+        } catch (const ValidationException&) {
+            responses.emplace_back(); // Reported to that caller as no response
+        }
+    }
+    return responses;
+}
+
+bool HttpTransport::probeBatchSupport() {
+    try {
+        std::string json_data;
+        FrameEnvelope::encodeBatchRequest({}, json_data);
+        
+        HttpResponse response = http_client_->post(api_config_.batch_endpoint, json_data);
+        return response.isSuccess() && FrameEnvelope::extractFrames(response.body).empty();
+    } catch (const std::exception& e) {
+        LOG_DEBUG("Batch probe failed: {}", e.what());
+        return false;
+    }
+}
+
+} // namespace ecoWatt
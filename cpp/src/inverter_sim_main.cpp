@@ -0,0 +1,189 @@
+/**
+ * @file inverter_sim_main.cpp
+ * @brief Standalone local Inverter SIM for load and latency testing
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "inverter_sim_server.hpp"
+#include "modbus_tcp_sim_server.hpp"
+#include "modbus_rtu_sim_slave.hpp"
+#include "uplink_collector.hpp"
+#include "logger.hpp"
+#include "exceptions.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+std::atomic<bool> g_stop{false};
+
+void signalHandler(int) {
+    g_stop = true;
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --port <n>           Listen port (default 18080)\n"
+              << "  --host <addr>        Listen address (default 127.0.0.1)\n"
+              << "  --tcp-port <n>       Also serve Modbus TCP on this port\n"
+              << "  --rtu-pty <baud>     Also serve Modbus RTU on a new pseudo-terminal\n"
+              << "  --collector-port <n> Also accept uplink batches on this port\n"
+              << "  --config <file>      Simulator JSON configuration\n"
+              << "  --api-key <key>      Require this Authorization header\n"
+              << "  --latency-ms <ms>    Fixed response latency\n"
+              << "  --error-rate <p>     Modbus exception probability\n"
+              << "  --drop-rate <p>      Dropped request probability\n"
+              << "  --help               Show this message\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    using namespace ecoWatt;
+
+    std::string host = "127.0.0.1";
+    int port = 18080;
+    int tcp_port = -1;
+    int rtu_baud = -1;
+    int collector_port = -1;
+    std::string config_file;
+    std::string api_key;
+    double latency_ms = -1.0;
+    double error_rate = -1.0;
+    double drop_rate = -1.0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--port" && has_value) {
+            port = std::stoi(argv[++i]);
+        } else if (arg == "--tcp-port" && has_value) {
+            tcp_port = std::stoi(argv[++i]);
+        } else if (arg == "--rtu-pty" && has_value) {
+            rtu_baud = std::stoi(argv[++i]);
+        } else if (arg == "--collector-port" && has_value) {
+            collector_port = std::stoi(argv[++i]);
+        } else if (arg == "--host" && has_value) {
+            host = argv[++i];
+        } else if (arg == "--config" && has_value) {
+            config_file = argv[++i];
+        } else if (arg == "--api-key" && has_value) {
+            api_key = argv[++i];
+        } else if (arg == "--latency-ms" && has_value) {
+            latency_ms = std::stod(argv[++i]);
+        } else if (arg == "--error-rate" && has_value) {
+            error_rate = std::stod(argv[++i]);
+        } else if (arg == "--drop-rate" && has_value) {
+            drop_rate = std::stod(argv[++i]);
+        } else {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    try {
+        LoggingConfig logging_config;
+        logging_config.log_file = "inverter_sim.log";
+        Logger::initialize(logging_config);
+
+        InverterSimConfig sim_config = InverterSimConfig::defaults();
+        if (!config_file.empty()) {
+            std::ifstream file(config_file);
+            if (!file.is_open()) {
+                throw ConfigException("Cannot open simulator configuration: " + config_file);
+            }
+            sim_config = InverterSimConfig::fromJson(nlohmann::json::parse(file));
+        }
+
+        if (latency_ms >= 0.0) {
+            sim_config.latency.distribution = LatencyDistribution::FIXED;
+            sim_config.latency.mean = std::chrono::microseconds(static_cast<int64_t>(latency_ms * 1000.0));
+        }
+        if (error_rate >= 0.0) {
+            sim_config.faults.exception_rate = error_rate;
+        }
+        if (drop_rate >= 0.0) {
+            sim_config.faults.drop_rate = drop_rate;
+        }
+
+        auto simulator = std::make_shared<InverterSimulator>(sim_config);
+        InverterSimServer server(simulator, "http://" + host + ":" + std::to_string(port), api_key);
+        server.start();
+
+        std::unique_ptr<ModbusTcpSimServer> tcp_server;
+        if (tcp_port >= 0) {
+            tcp_server = std::make_unique<ModbusTcpSimServer>(simulator, static_cast<uint16_t>(tcp_port), host);
+            tcp_server->start();
+        }
+
+        std::unique_ptr<ModbusRtuSimSlave> rtu_slave;
+        if (rtu_baud > 0) {
+            rtu_slave = std::make_unique<ModbusRtuSimSlave>(simulator, static_cast<uint32_t>(rtu_baud));
+            rtu_slave->start();
+        }
+
+        std::unique_ptr<UplinkCollectorServer> collector;
+        if (collector_port >= 0) {
+            collector = std::make_unique<UplinkCollectorServer>(
+                "http://" + host + ":" + std::to_string(collector_port), "/api/v1/ingest", api_key);
+            collector->start();
+        }
+
+        std::signal(SIGINT, signalHandler);
+        std::signal(SIGTERM, signalHandler);
+
+        std::cout << "Inverter SIM listening on " << server.baseUrl();
+        if (tcp_server) {
+            std::cout << " and modbus-tcp://" << host << ":" << tcp_server->port();
+        }
+        if (rtu_slave) {
+            std::cout << " and modbus-rtu on " << rtu_slave->devicePath();
+        }
+        if (collector) {
+            std::cout << ", uplink collector on " << collector->baseUrl() << "/api/v1/ingest";
+        }
+        std::cout << " (Ctrl+C to stop)\n";
+
+        while (!g_stop) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+
+        if (collector) {
+            collector->stop();
+            auto uplink = collector->getStatistics();
+            std::cout << "Uplink batches: " << uplink.batches << ", samples: " << uplink.samples
+                      << ", duplicates: " << uplink.duplicates << ", rejected: " << uplink.rejected
+                      << ", bytes: " << uplink.bytes_received << " (" << uplink.bytes_decoded << " decoded)\n";
+        }
+        if (rtu_slave) {
+            rtu_slave->stop();
+        }
+        if (tcp_server) {
+            tcp_server->stop();
+        }
+        server.stop();
+
+        auto stats = simulator->getStatistics();
+        std::cout << "Requests: " << stats.requests << ", replies: " << stats.replies
+                  << ", drops: " << stats.drops << ", exceptions: " << stats.exceptions_injected
+                  << ", CRC errors: " << stats.crc_errors_injected
+                  << ", invalid: " << stats.invalid_frames << "\n";
+
+        Logger::shutdown();
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Inverter SIM failed: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,161 @@
+/**
+ * @file inverter_sim_server.cpp
+ * @brief Implementation of the HTTP front end for the local Inverter SIM
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "inverter_sim_server.hpp"
+#include "frame_envelope.hpp"
+#include "modbus_frame.hpp"
+#include "logger.hpp"
+#include <thread>
+
+using namespace web;
+using namespace web::http;
+using namespace web::http::experimental::listener;
+
+namespace ecoWatt {
+
+InverterSimServer::InverterSimServer(std::shared_ptr<InverterSimulator> simulator,
+                                     const std::string& base_url,
+                                     const std::string& api_key,
+                                     const ApiConfig& api_config)
+    : simulator_(std::move(simulator)),
+      base_url_(base_url),
+      api_key_(api_key),
+      read_endpoint_(api_config.read_endpoint),
+      write_endpoint_(api_config.write_endpoint),
+      batch_endpoint_(api_config.batch_endpoint) {
+
+    if (!simulator_) {
+        throw ValidationException("InverterSimServer requires a simulator");
+    }
+}
+
+InverterSimServer::~InverterSimServer() {
+    try {
+        stop();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error stopping Inverter SIM server: {}", e.what());
+    }
+}
+
+void InverterSimServer::start() {
+    if (running_) {
+        return;
+    }
+
+    try {
+        listener_ = std::make_unique<http_listener>(utility::conversions::to_string_t(base_url_));
+        listener_->support(methods::POST, [this](http_request request) { handlePost(request); });
+        listener_->open().wait();
+        running_ = true;
+
+        LOG_INFO("Inverter SIM server listening on {}", base_url_);
+    } catch (const std::exception& e) {
+        listener_.reset();
+        throw HttpException("Failed to start Inverter SIM server on " + base_url_ + ": " + e.what());
+    }
+}
+
+void InverterSimServer::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    listener_->close().wait();
+    listener_.reset();
+
+    LOG_INFO("Inverter SIM server stopped");
+}
+
+void InverterSimServer::handlePost(http_request request) {
+    std::string path = utility::conversions::to_utf8string(request.relative_uri().path());
+    bool batch = !batch_endpoint_.empty() && path == batch_endpoint_;
+    if (path != read_endpoint_ && path != write_endpoint_ && !batch) {
+        request.reply(status_codes::NotFound);
+        return;
+    }
+
+    if (!api_key_.empty()) {
+        auto it = request.headers().find(U("Authorization"));
+        if (it == request.headers().end() ||
+            utility::conversions::to_utf8string(it->second) != api_key_) {
+            request.reply(static_cast<status_code>(401));
+            return;
+        }
+    }
+
+    std::vector<uint8_t> request_frame;
+    try {
+        std::string body = utility::conversions::to_utf8string(request.extract_string().get());
+        if (batch) {
+            handleBatch(request, body);
+            return;
+        }
+        request_frame = ModbusFrame::hexToBytes(FrameEnvelope::extractFrame(body));
+    } catch (const std::exception& e) {
+        LOG_DEBUG("Inverter SIM rejected request body: {}", e.what());
+        request.reply(status_codes::BadRequest);
+        return;
+    }
+
+    std::chrono::microseconds delay = simulator_->sampleLatency();
+    auto response = simulator_->processFrame(request_frame);
+
+    if (!response) {
+        std::this_thread::sleep_for(delay + simulator_->getFaultProfile().drop_hold);
+        replyFrame(request, "");
+        return;
+    }
+
+    if (delay.count() > 0) {
+        std::this_thread::sleep_for(delay);
+    }
+
+    replyFrame(request, ModbusFrame::bytesToHex(*response));
+}
+
+void InverterSimServer::handleBatch(const http_request& request, const std::string& body) {
+    std::vector<std::string> frames = FrameEnvelope::extractFrames(body);
+
+    // One round trip: one latency sample for the whole batch
+    std::chrono::microseconds delay = simulator_->sampleLatency();
+    bool dropped = false;
+
+    std::vector<std::string> responses;
+    responses.reserve(frames.size());
+    for (const auto& frame : frames) {
+        std::optional<std::vector<uint8_t>> response;
+        try {
+            response = simulator_->processFrame(ModbusFrame::hexToBytes(frame));
+        } catch (const ValidationException&) {
+            // Invalid hex: answered as an unresponsive slave
+        }
+
+        dropped = dropped || !response;
+        responses.push_back(response ? ModbusFrame::bytesToHex(*response) : "");
+    }
+
+    if (dropped) {
+        delay += std::chrono::duration_cast<std::chrono::microseconds>(
+            simulator_->getFaultProfile().drop_hold);
+    }
+    if (delay.count() > 0) {
+        std::this_thread::sleep_for(delay);
+    }
+
+    std::string reply;
+    FrameEnvelope::encodeBatchRequest(responses, reply);
+    request.reply(status_codes::OK, utility::conversions::to_string_t(reply), U("application/json"));
+}
+
+void InverterSimServer::replyFrame(const http_request& request, const std::string& frame_hex) {
+    request.reply(status_codes::OK,
+                  utility::conversions::to_string_t(FrameEnvelope::encodeRequest(frame_hex)),
+                  U("application/json"));
+}
+
+} // namespace ecoWatt
@@ -0,0 +1,520 @@
+/**
+ * @file inverter_simulator.cpp
+ * @brief Implementation of the local Inverter SIM register model
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "inverter_simulator.hpp"
+#include "modbus_frame.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ecoWatt {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+RegisterDynamics dynamicsFromString(const std::string& str) {
+    if (str == "constant") return RegisterDynamics::CONSTANT;
+    if (str == "sine") return RegisterDynamics::SINE;
+    if (str == "random_walk") return RegisterDynamics::RANDOM_WALK;
+    if (str == "ramp") return RegisterDynamics::RAMP;
+    throw ConfigException("Unknown register dynamics: " + str);
+}
+
+LatencyDistribution distributionFromString(const std::string& str) {
+    if (str == "none") return LatencyDistribution::NONE;
+    if (str == "fixed") return LatencyDistribution::FIXED;
+    if (str == "uniform") return LatencyDistribution::UNIFORM;
+    if (str == "normal") return LatencyDistribution::NORMAL;
+    if (str == "log_normal") return LatencyDistribution::LOG_NORMAL;
+    throw ConfigException("Unknown latency distribution: " + str);
+}
+
+std::chrono::microseconds msToMicros(double ms) {
+    return std::chrono::microseconds(static_cast<int64_t>(ms * 1000.0));
+}
+
+double checkedRate(const nlohmann::json& json, const char* key, double default_value) {
+    double rate = json.value(key, default_value);
+    if (rate < 0.0 || rate > 1.0) {
+        throw ConfigException(std::string("Simulator rate '") + key + "' must be within [0, 1]");
+    }
+    return rate;
+}
+
+SimRegisterModel makeModel(RegisterValue base, RegisterDynamics dynamics, double amplitude,
+                           double period_s, double step, RegisterValue min_value,
+                           RegisterValue max_value, bool writable = false) {
+    SimRegisterModel model;
+    model.base = base;
+    model.dynamics = dynamics;
+    model.amplitude = amplitude;
+    model.period_s = period_s;
+    model.step = step;
+    model.min_value = min_value;
+    model.max_value = max_value;
+    model.writable = writable;
+    return model;
+}
+
+} // namespace
+
+// InverterSimConfig
+
+InverterSimConfig InverterSimConfig::defaults() {
+    InverterSimConfig config;
+
+    // Raw values follow the register gains in config.json
+    config.registers[0] = makeModel(2300, RegisterDynamics::SINE, 20, 60, 0, 2000, 2600);           // 230.0 V
+    config.registers[1] = makeModel(45, RegisterDynamics::RANDOM_WALK, 0, 0, 2, 0, 200);             // 4.5 A
+    config.registers[2] = makeModel(5000, RegisterDynamics::RANDOM_WALK, 0, 0, 1, 4950, 5050);       // 50.00 Hz
+    config.registers[3] = makeModel(3500, RegisterDynamics::SINE, 200, 120, 0, 0, 6000);             // 350.0 V
+    config.registers[4] = makeModel(3400, RegisterDynamics::SINE, 200, 120, 0, 0, 6000);             // 340.0 V
+    config.registers[5] = makeModel(60, RegisterDynamics::RANDOM_WALK, 0, 0, 2, 0, 150);             // 6.0 A
+    config.registers[6] = makeModel(58, RegisterDynamics::RANDOM_WALK, 0, 0, 2, 0, 150);             // 5.8 A
+    config.registers[7] = makeModel(450, RegisterDynamics::RANDOM_WALK, 0, 0, 1, 200, 900);          // 45.0 degC
+    config.registers[8] = makeModel(100, RegisterDynamics::CONSTANT, 0, 0, 0, 0, 100, true);         // 100 %
+    config.registers[9] = makeModel(2000, RegisterDynamics::SINE, 300, 90, 0, 0, 10000);             // 2000 W
+
+    return config;
+}
+
+InverterSimConfig InverterSimConfig::fromJson(const nlohmann::json& json) {
+    InverterSimConfig config = defaults();
+
+    try {
+        config.slave_address = json.value("slave_address", config.slave_address);
+        config.seed = json.value("seed", config.seed);
+
+        if (json.contains("latency")) {
+            const auto& latency = json["latency"];
+            config.latency.distribution = distributionFromString(latency.value("distribution", "none"));
+            config.latency.mean = msToMicros(latency.value("mean_ms", 0.0));
+            config.latency.stddev = msToMicros(latency.value("stddev_ms", 0.0));
+            config.latency.min = msToMicros(latency.value("min_ms", 0.0));
+            config.latency.max = msToMicros(latency.value("max_ms", 10000.0));
+
+            if (config.latency.min > config.latency.max) {
+                throw ConfigException("Simulator latency min_ms exceeds max_ms");
+            }
+        }
+
+        if (json.contains("faults")) {
+            const auto& faults = json["faults"];
+            config.faults.exception_rate = checkedRate(faults, "exception_rate", 0.0);
+            config.faults.exception_code = faults.value("exception_code", config.faults.exception_code);
+            config.faults.crc_error_rate = checkedRate(faults, "crc_error_rate", 0.0);
+            config.faults.drop_rate = checkedRate(faults, "drop_rate", 0.0);
+            config.faults.drop_hold = Duration(faults.value("drop_hold_ms", 0));
+        }
+
+        if (json.contains("registers")) {
+            for (const auto& [key, reg_json] : json["registers"].items()) {
+                RegisterAddress address = static_cast<RegisterAddress>(std::stoi(key));
+                SimRegisterModel model = config.registers.count(address) ? config.registers[address]
+                                                                         : SimRegisterModel{};
+
+                model.base = reg_json.value("base", model.base);
+                if (reg_json.contains("dynamics")) {
+                    model.dynamics = dynamicsFromString(reg_json["dynamics"].get<std::string>());
+                }
+                model.amplitude = reg_json.value("amplitude", model.amplitude);
+                model.period_s = reg_json.value("period_s", model.period_s);
+                model.step = reg_json.value("step", model.step);
+                model.min_value = reg_json.value("min", model.min_value);
+                model.max_value = reg_json.value("max", model.max_value);
+                model.writable = reg_json.value("writable", model.writable);
+
+                if (model.min_value > model.max_value) {
+                    throw ConfigException("Simulator register " + key + " has min > max");
+                }
+
+                config.registers[address] = model;
+            }
+        }
+    } catch (const nlohmann::json::exception& e) {
+        throw ConfigException("Invalid simulator configuration: " + std::string(e.what()));
+    }
+
+    return config;
+}
+
+// InverterSimulator
+
+InverterSimulator::InverterSimulator(InverterSimConfig config)
+    : slave_address_(config.slave_address),
+      registers_(std::move(config.registers)),
+      latency_(config.latency),
+      faults_(config.faults),
+      start_time_(std::chrono::steady_clock::now()),
+      rng_(config.seed) {
+
+    LOG_INFO("Inverter simulator initialized with slave address {} and {} registers",
+             slave_address_, registers_.size());
+}
+
+std::optional<std::vector<uint8_t>> InverterSimulator::processFrame(const std::vector<uint8_t>& request) {
+    requests_.fetch_add(1, std::memory_order_relaxed);
+
+    if (request.size() < 4 || !ModbusFrame::validateFrame(request) || request[0] != slave_address_) {
+        invalid_frames_.fetch_add(1, std::memory_order_relaxed);
+        LOG_DEBUG("Simulator ignoring invalid request frame ({} bytes)", request.size());
+        return std::nullopt;
+    }
+
+    SlaveAddress slave = request[0];
+    FunctionCode function = request[1];
+    std::vector<uint8_t> response;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (chance(faults_.drop_rate)) {
+            drops_.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        if (chance(faults_.exception_rate)) {
+            exceptions_injected_.fetch_add(1, std::memory_order_relaxed);
+            response = exceptionFrame(slave, function, faults_.exception_code);
+        } else if (function == static_cast<FunctionCode>(ModbusFunction::READ_HOLDING_REGISTERS)) {
+            response = handleRead(slave, request);
+        } else if (function == static_cast<FunctionCode>(ModbusFunction::WRITE_SINGLE_REGISTER)) {
+            response = handleWriteSingle(slave, request);
+        } else if (function == static_cast<FunctionCode>(ModbusFunction::WRITE_MULTIPLE_REGISTERS)) {
+            response = handleWriteMultiple(slave, request);
+        } else if (function == static_cast<FunctionCode>(ModbusFunction::READ_WRITE_MULTIPLE_REGISTERS)) {
+            response = handleReadWriteMultiple(slave, request);
+        } else {
+            response = exceptionFrame(slave, function, 0x01); // Illegal Function
+        }
+
+        if (chance(faults_.crc_error_rate)) {
+            crc_errors_injected_.fetch_add(1, std::memory_order_relaxed);
+            response.back() ^= 0xFF;
+        }
+    }
+
+    replies_.fetch_add(1, std::memory_order_relaxed);
+    return response;
+}
+
+std::chrono::microseconds InverterSimulator::sampleLatency() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    double micros = 0.0;
+    double mean = static_cast<double>(latency_.mean.count());
+    double stddev = static_cast<double>(latency_.stddev.count());
+
+    switch (latency_.distribution) {
+        case LatencyDistribution::NONE:
+            return std::chrono::microseconds(0);
+        case LatencyDistribution::FIXED:
+            micros = mean;
+            break;
+        case LatencyDistribution::UNIFORM: {
+            std::uniform_real_distribution<double> dist(static_cast<double>(latency_.min.count()),
+                                                        static_cast<double>(latency_.max.count()));
+            micros = dist(rng_);
+            break;
+        }
+        case LatencyDistribution::NORMAL: {
+            std::normal_distribution<double> dist(mean, stddev);
+            micros = dist(rng_);
+            break;
+        }
+        case LatencyDistribution::LOG_NORMAL: {
+            if (mean <= 0.0) {
+                micros = 0.0;
+                break;
+            }
+            double sigma2 = std::log(1.0 + (stddev * stddev) / (mean * mean));
+            double mu = std::log(mean) - sigma2 / 2.0;
+            std::lognormal_distribution<double> dist(mu, std::sqrt(sigma2));
+            micros = dist(rng_);
+            break;
+        }
+    }
+
+    micros = std::clamp(micros, static_cast<double>(latency_.min.count()),
+                        static_cast<double>(latency_.max.count()));
+    return std::chrono::microseconds(static_cast<int64_t>(micros));
+}
+
+RegisterValue InverterSimulator::readRegister(RegisterAddress address) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = registers_.find(address);
+    if (it == registers_.end()) {
+        throw ValidationException("Simulator register " + std::to_string(address) + " not defined");
+    }
+    return currentValue(address, it->second);
+}
+
+void InverterSimulator::setRegister(RegisterAddress address, RegisterValue value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto& model = registers_[address];
+    model.base = value;
+    model.dynamics = RegisterDynamics::CONSTANT;
+    walk_state_.erase(address);
+}
+
+void InverterSimulator::setLatencyProfile(const SimLatencyProfile& profile) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    latency_ = profile;
+}
+
+void InverterSimulator::setFaultProfile(const SimFaultProfile& profile) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    faults_ = profile;
+}
+
+SimFaultProfile InverterSimulator::getFaultProfile() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return faults_;
+}
+
+InverterSimulator::Statistics InverterSimulator::getStatistics() const {
+    Statistics stats;
+    stats.requests = requests_.load(std::memory_order_relaxed);
+    stats.replies = replies_.load(std::memory_order_relaxed);
+    stats.invalid_frames = invalid_frames_.load(std::memory_order_relaxed);
+    stats.exceptions_injected = exceptions_injected_.load(std::memory_order_relaxed);
+    stats.crc_errors_injected = crc_errors_injected_.load(std::memory_order_relaxed);
+    stats.drops = drops_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void InverterSimulator::resetStatistics() {
+    requests_.store(0, std::memory_order_relaxed);
+    replies_.store(0, std::memory_order_relaxed);
+    invalid_frames_.store(0, std::memory_order_relaxed);
+    exceptions_injected_.store(0, std::memory_order_relaxed);
+    crc_errors_injected_.store(0, std::memory_order_relaxed);
+    drops_.store(0, std::memory_order_relaxed);
+}
+
+std::vector<uint8_t> InverterSimulator::handleRead(SlaveAddress slave, const std::vector<uint8_t>& request) {
+    const FunctionCode function = static_cast<FunctionCode>(ModbusFunction::READ_HOLDING_REGISTERS);
+
+    if (request.size() != 8) {
+        return exceptionFrame(slave, function, 0x03);
+    }
+
+    RegisterAddress start = static_cast<RegisterAddress>((request[2] << 8) | request[3]);
+    uint16_t count = static_cast<uint16_t>((request[4] << 8) | request[5]);
+
+    if (count == 0 || count > 125) {
+        return exceptionFrame(slave, function, 0x03); // Illegal Data Value
+    }
+
+    std::vector<uint8_t> response = {slave, function, static_cast<uint8_t>(count * 2)};
+    response.reserve(3 + count * 2 + 2);
+
+    if (uint8_t code = appendRegisters(response, start, count)) {
+        return exceptionFrame(slave, function, code);
+    }
+
+    appendCRC(response);
+    return response;
+}
+
+std::vector<uint8_t> InverterSimulator::handleWriteSingle(SlaveAddress slave,
+                                                          const std::vector<uint8_t>& request) {
+    const FunctionCode function = static_cast<FunctionCode>(ModbusFunction::WRITE_SINGLE_REGISTER);
+
+    if (request.size() != 8) {
+        return exceptionFrame(slave, function, 0x03);
+    }
+
+    RegisterAddress address = static_cast<RegisterAddress>((request[2] << 8) | request[3]);
+    RegisterValue value = static_cast<RegisterValue>((request[4] << 8) | request[5]);
+
+    auto it = registers_.find(address);
+    if (it == registers_.end() || !it->second.writable) {
+        return exceptionFrame(slave, function, 0x02);
+    }
+
+    if (value < it->second.min_value || value > it->second.max_value) {
+        return exceptionFrame(slave, function, 0x03);
+    }
+
+    it->second.base = value;
+    walk_state_.erase(address);
+
+    // Successful write echoes the request
+    return request;
+}
+
+std::vector<uint8_t> InverterSimulator::handleWriteMultiple(SlaveAddress slave,
+                                                            const std::vector<uint8_t>& request) {
+    const FunctionCode function = static_cast<FunctionCode>(ModbusFunction::WRITE_MULTIPLE_REGISTERS);
+
+    // slave, fc, start(2), quantity(2), byte count, values, crc(2)
+    if (request.size() < 11) {
+        return exceptionFrame(slave, function, 0x03);
+    }
+
+    RegisterAddress start = static_cast<RegisterAddress>((request[2] << 8) | request[3]);
+    uint16_t count = static_cast<uint16_t>((request[4] << 8) | request[5]);
+    uint8_t byte_count = request[6];
+
+    if (count == 0 || count > 123 || byte_count != count * 2 ||
+        request.size() != 9u + byte_count) {
+        return exceptionFrame(slave, function, 0x03);
+    }
+
+    if (uint8_t code = applyWrites(start, count, request.data() + 7)) {
+        return exceptionFrame(slave, function, code);
+    }
+
+    // Successful write echoes start address and quantity
+    std::vector<uint8_t> response(request.begin(), request.begin() + 6);
+    appendCRC(response);
+    return response;
+}
+
+std::vector<uint8_t> InverterSimulator::handleReadWriteMultiple(SlaveAddress slave,
+                                                                const std::vector<uint8_t>& request) {
+    const FunctionCode function = static_cast<FunctionCode>(ModbusFunction::READ_WRITE_MULTIPLE_REGISTERS);
+
+    // slave, fc, read start(2), read qty(2), write start(2), write qty(2), byte count, values, crc(2)
+    if (request.size() < 15) {
+        return exceptionFrame(slave, function, 0x03);
+    }
+
+    RegisterAddress read_start = static_cast<RegisterAddress>((request[2] << 8) | request[3]);
+    uint16_t read_count = static_cast<uint16_t>((request[4] << 8) | request[5]);
+    RegisterAddress write_start = static_cast<RegisterAddress>((request[6] << 8) | request[7]);
+    uint16_t write_count = static_cast<uint16_t>((request[8] << 8) | request[9]);
+    uint8_t byte_count = request[10];
+
+    if (read_count == 0 || read_count > 125 || write_count == 0 || write_count > 121 ||
+        byte_count != write_count * 2 || request.size() != 13u + byte_count) {
+        return exceptionFrame(slave, function, 0x03);
+    }
+
+    // The write happens before the read
+    if (uint8_t code = applyWrites(write_start, write_count, request.data() + 11)) {
+        return exceptionFrame(slave, function, code);
+    }
+
+    std::vector<uint8_t> response = {slave, function, static_cast<uint8_t>(read_count * 2)};
+    response.reserve(3 + read_count * 2 + 2);
+
+    if (uint8_t code = appendRegisters(response, read_start, read_count)) {
+        return exceptionFrame(slave, function, code);
+    }
+
+    appendCRC(response);
+    return response;
+}
+
+uint8_t InverterSimulator::appendRegisters(std::vector<uint8_t>& out, RegisterAddress start, uint16_t count) {
+    for (uint32_t address = start; address < static_cast<uint32_t>(start) + count; ++address) {
+        auto it = registers_.find(static_cast<RegisterAddress>(address));
+        if (it == registers_.end()) {
+            return 0x02; // Illegal Data Address
+        }
+
+        RegisterValue value = currentValue(it->first, it->second);
+        out.push_back((value >> 8) & 0xFF);
+        out.push_back(value & 0xFF);
+    }
+
+    return 0;
+}
+
+uint8_t InverterSimulator::applyWrites(RegisterAddress start, uint16_t count, const uint8_t* values) {
+    if (static_cast<uint32_t>(start) + count > 0x10000) {
+        return 0x02;
+    }
+
+    for (uint16_t i = 0; i < count; ++i) {
+        auto it = registers_.find(static_cast<RegisterAddress>(start + i));
+        if (it == registers_.end() || !it->second.writable) {
+            return 0x02; // Illegal Data Address
+        }
+
+        RegisterValue value = static_cast<RegisterValue>((values[2 * i] << 8) | values[2 * i + 1]);
+        if (value < it->second.min_value || value > it->second.max_value) {
+            return 0x03; // Illegal Data Value
+        }
+    }
+
+    for (uint16_t i = 0; i < count; ++i) {
+        RegisterAddress address = static_cast<RegisterAddress>(start + i);
+        registers_[address].base = static_cast<RegisterValue>((values[2 * i] << 8) | values[2 * i + 1]);
+        walk_state_.erase(address);
+    }
+
+    return 0;
+}
+
+RegisterValue InverterSimulator::currentValue(RegisterAddress address, SimRegisterModel& model) {
+    double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+    double value = model.base;
+
+    switch (model.dynamics) {
+        case RegisterDynamics::CONSTANT:
+            break;
+        case RegisterDynamics::SINE:
+            if (model.period_s > 0.0) {
+                value = model.base + model.amplitude * std::sin(2.0 * kPi * t / model.period_s);
+            }
+            break;
+        case RegisterDynamics::RANDOM_WALK: {
+            auto [it, inserted] = walk_state_.emplace(address, static_cast<double>(model.base));
+            std::uniform_real_distribution<double> dist(-model.step, model.step);
+            it->second = std::clamp(it->second + dist(rng_),
+                                    static_cast<double>(model.min_value),
+                                    static_cast<double>(model.max_value));
+            value = it->second;
+            break;
+        }
+        case RegisterDynamics::RAMP: {
+            double range = static_cast<double>(model.max_value) - model.min_value + 1.0;
+            double offset = std::fmod(model.base - model.min_value + model.step * t, range);
+            if (offset < 0.0) {
+                offset += range;
+            }
+            value = model.min_value + offset;
+            break;
+        }
+    }
+
+    value = std::clamp(std::round(value), static_cast<double>(model.min_value),
+                       static_cast<double>(model.max_value));
+    return static_cast<RegisterValue>(value);
+}
+
+bool InverterSimulator::chance(double probability) {
+    if (probability <= 0.0) {
+        return false;
+    }
+    if (probability >= 1.0) {
+        return true;
+    }
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    return dist(rng_) < probability;
+}
+
+std::vector<uint8_t> InverterSimulator::exceptionFrame(SlaveAddress slave, FunctionCode function,
+                                                       uint8_t exception_code) {
+    std::vector<uint8_t> frame = {slave, static_cast<uint8_t>(function | 0x80), exception_code};
+    appendCRC(frame);
+    return frame;
+}
+
+void InverterSimulator::appendCRC(std::vector<uint8_t>& frame) {
+    uint16_t crc = ModbusFrame::calculateCRC(frame);
+    frame.push_back(crc & 0xFF);
+    frame.push_back((crc >> 8) & 0xFF);
+}
+
+} // namespace ecoWatt
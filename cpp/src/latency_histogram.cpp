@@ -0,0 +1,181 @@
+/**
+ * @file latency_histogram.cpp
+ * @brief Implementation of lock-free latency histogram and EWMA gauge
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "latency_histogram.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace ecoWatt {
+
+namespace {
+
+inline unsigned highestBit(uint64_t value) {
+    unsigned bit = 0;
+    while (value >>= 1) {
+        bit++;
+    }
+    return bit;
+}
+
+inline uint64_t doubleToBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double bitsToDouble(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+// HistogramSnapshot
+
+uint64_t HistogramSnapshot::percentile(double percentile) const {
+    uint64_t total = 0;
+    for (uint64_t bucket : buckets) {
+        total += bucket;
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * total));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        cumulative += buckets[i];
+        if (cumulative >= rank) {
+            uint64_t lower = LatencyHistogram::bucketLowerBound(i);
+            uint64_t upper = LatencyHistogram::bucketUpperBound(i);
+            uint64_t estimate = lower + (upper - lower - 1) / 2;
+            return std::clamp(estimate, min_us, std::max(min_us, max_us));
+        }
+    }
+
+    return max_us;
+}
+
+// LatencyHistogram
+
+LatencyHistogram::LatencyHistogram() : min_us_(std::numeric_limits<uint64_t>::max()) {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::record(uint64_t value_us) {
+    buckets_[bucketIndex(value_us)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_us_.fetch_add(value_us, std::memory_order_relaxed);
+
+    uint64_t current_min = min_us_.load(std::memory_order_relaxed);
+    while (value_us < current_min &&
+           !min_us_.compare_exchange_weak(current_min, value_us, std::memory_order_relaxed)) {
+    }
+
+    uint64_t current_max = max_us_.load(std::memory_order_relaxed);
+    while (value_us > current_max &&
+           !max_us_.compare_exchange_weak(current_max, value_us, std::memory_order_relaxed)) {
+    }
+}
+
+HistogramSnapshot LatencyHistogram::snapshot() const {
+    HistogramSnapshot snapshot;
+    snapshot.buckets.resize(kBucketCount);
+
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+
+    snapshot.count = count_.load(std::memory_order_relaxed);
+    snapshot.sum_us = sum_us_.load(std::memory_order_relaxed);
+    snapshot.max_us = max_us_.load(std::memory_order_relaxed);
+
+    uint64_t min_us = min_us_.load(std::memory_order_relaxed);
+    snapshot.min_us = (min_us == std::numeric_limits<uint64_t>::max()) ? 0 : min_us;
+
+    return snapshot;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_us_.store(0, std::memory_order_relaxed);
+    min_us_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    max_us_.store(0, std::memory_order_relaxed);
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value_us) {
+    if (value_us < kSubBucketCount) {
+        return static_cast<size_t>(value_us);
+    }
+
+    unsigned exponent = highestBit(value_us);
+    if (exponent >= kMaxExponent) {
+        return kBucketCount - 1;
+    }
+
+    unsigned shift = exponent - kSubBucketBits;
+    uint64_t sub_bucket = (value_us >> shift) - kSubBucketCount;
+    return static_cast<size_t>(kSubBucketCount + shift * kSubBucketCount + sub_bucket);
+}
+
+uint64_t LatencyHistogram::bucketLowerBound(size_t index) {
+    if (index < kSubBucketCount) {
+        return index;
+    }
+
+    size_t group = (index - kSubBucketCount) / kSubBucketCount;
+    size_t sub_bucket = (index - kSubBucketCount) % kSubBucketCount;
+    return (kSubBucketCount + sub_bucket) << group;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < kSubBucketCount) {
+        return index + 1;
+    }
+
+    size_t group = (index - kSubBucketCount) / kSubBucketCount;
+    size_t sub_bucket = (index - kSubBucketCount) % kSubBucketCount;
+    return (kSubBucketCount + sub_bucket + 1) << group;
+}
+
+// EwmaGauge
+
+EwmaGauge::EwmaGauge(double alpha)
+    : alpha_(alpha), bits_(doubleToBits(std::numeric_limits<double>::quiet_NaN())) {}
+
+void EwmaGauge::update(double sample) {
+    uint64_t old_bits = bits_.load(std::memory_order_relaxed);
+    uint64_t new_bits;
+
+    do {
+        double current = bitsToDouble(old_bits);
+        double next = std::isnan(current) ? sample : current + alpha_ * (sample - current);
+        new_bits = doubleToBits(next);
+    } while (!bits_.compare_exchange_weak(old_bits, new_bits, std::memory_order_relaxed));
+}
+
+double EwmaGauge::value() const {
+    double current = bitsToDouble(bits_.load(std::memory_order_relaxed));
+    return std::isnan(current) ? 0.0 : current;
+}
+
+void EwmaGauge::reset() {
+    bits_.store(doubleToBits(std::numeric_limits<double>::quiet_NaN()), std::memory_order_relaxed);
+}
+
+} // namespace ecoWatt
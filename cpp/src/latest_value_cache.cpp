@@ -0,0 +1,140 @@
+/**
+ * @file latest_value_cache.cpp
+ * @brief Implementation of the latest-value cache
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "latest_value_cache.hpp"
+
+namespace ecoWatt {
+
+LatestValueCache::LatestValueCache(Duration default_max_age)
+    : default_max_age_(default_max_age) {
+}
+
+void LatestValueCache::update(const AcquisitionSample& sample, uint64_t read_epoch) {
+    auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    updateLocked(sample, now, read_epoch);
+}
+
+void LatestValueCache::update(const std::vector<AcquisitionSample>& samples, uint64_t read_epoch) {
+    auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& sample : samples) {
+        updateLocked(sample, now, read_epoch);
+    }
+}
+
+LatestValueCache::Lookup LatestValueCache::lookup(const std::vector<RegisterAddress>& addresses) const {
+    return lookup(addresses, Clock::now());
+}
+
+LatestValueCache::Lookup LatestValueCache::lookup(const std::vector<RegisterAddress>& addresses,
+                                                  Clock::time_point now) const {
+    Lookup result;
+    result.fresh.reserve(addresses.size());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (RegisterAddress address : addresses) {
+            auto it = entries_.find(address);
+            if (it == entries_.end()) {
+                result.stale.push_back(address);
+                continue;
+            }
+
+            auto age_it = max_ages_.find(address);
+            Duration max_age = (age_it != max_ages_.end()) ? age_it->second : default_max_age_;
+
+            if (now - it->second.cached_at <= max_age) {
+                result.fresh.push_back(it->second.sample);
+            } else {
+                result.stale.push_back(address);
+            }
+        }
+    }
+
+    hits_.fetch_add(result.fresh.size(), std::memory_order_relaxed);
+    misses_.fetch_add(result.stale.size(), std::memory_order_relaxed);
+    return result;
+}
+
+void LatestValueCache::setDefaultMaxAge(Duration max_age) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    default_max_age_ = max_age;
+}
+
+void LatestValueCache::setMaxAge(RegisterAddress address, Duration max_age) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (max_age.count() > 0) {
+        max_ages_[address] = max_age;
+    } else {
+        max_ages_.erase(address);
+    }
+}
+
+void LatestValueCache::configure(const std::map<RegisterAddress, RegisterConfig>& register_configs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_ages_.clear();
+    for (const auto& [address, config] : register_configs) {
+        if (config.max_age.count() > 0) {
+            max_ages_[address] = config.max_age;
+        }
+    }
+}
+
+Duration LatestValueCache::getMaxAge(RegisterAddress address) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = max_ages_.find(address);
+    return (it != max_ages_.end()) ? it->second : default_max_age_;
+}
+
+void LatestValueCache::invalidate(RegisterAddress address) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(address);
+    invalidated_at_[address] = epoch_.fetch_add(1, std::memory_order_acq_rel) + 1;
+}
+
+void LatestValueCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    invalidated_at_.clear(); // Covered by cleared_at_
+    cleared_at_ = epoch_.fetch_add(1, std::memory_order_acq_rel) + 1;
+}
+
+LatestValueCache::Statistics LatestValueCache::getStatistics() const {
+    Statistics stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.updates = updates_.load(std::memory_order_relaxed);
+    stats.rejected = rejected_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void LatestValueCache::updateLocked(const AcquisitionSample& sample, Clock::time_point now,
+                                    uint64_t read_epoch) {
+    // A read that started before the register was invalidated may predate the write
+    auto stamp = invalidated_at_.find(sample.register_address);
+    if (read_epoch < cleared_at_ ||
+        (stamp != invalidated_at_.end() && read_epoch < stamp->second)) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto it = entries_.find(sample.register_address);
+    if (it == entries_.end()) {
+        entries_.emplace(sample.register_address, Entry{sample, now});
+    } else if (sample.timestamp >= it->second.sample.timestamp) {
+        it->second.sample = sample;
+        it->second.cached_at = now;
+    } else {
+        return; // Out-of-order sample from a slower reader
+    }
+
+    updates_.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace ecoWatt
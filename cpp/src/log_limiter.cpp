@@ -0,0 +1,156 @@
+/**
+ * @file log_limiter.cpp
+ * @brief Implementation of per-call-site log suppression
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "log_limiter.hpp"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace ecoWatt {
+
+namespace {
+
+struct Policy {
+    std::atomic<bool> enabled{true};
+    std::atomic<double> burst{10.0};
+    std::atomic<double> per_minute{6.0};
+    std::atomic<int64_t> summary_interval_ms{60000};
+};
+
+Policy& policy() {
+    static Policy instance;
+    return instance;
+}
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<LogSite*> sites;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+std::atomic<uint64_t> g_folded{0};
+std::atomic<uint64_t> g_suppressed{0};
+
+} // namespace
+
+LogSite::LogSite(const char* file, int line) {
+    const char* slash = std::strrchr(file, '/');
+    const char* backslash = std::strrchr(file, '\\');
+    const char* base = std::max(slash, backslash);
+    site_ = std::string(base ? base + 1 : file) + ":" + std::to_string(line);
+
+    auto& sites = registry();
+    std::lock_guard<std::mutex> lock(sites.mutex);
+    sites.sites.push_back(this);
+}
+
+LogSite::~LogSite() {
+    auto& sites = registry();
+    std::lock_guard<std::mutex> lock(sites.mutex);
+    sites.sites.erase(std::remove(sites.sites.begin(), sites.sites.end(), this), sites.sites.end());
+}
+
+void LogSite::submit(spdlog::logger& logger, spdlog::level::level_enum level, std::string message) {
+    const Policy& limits = policy();
+    if (!limits.enabled.load(std::memory_order_relaxed)) {
+        logger.log(level, message);
+        return;
+    }
+
+    const double burst = limits.burst.load(std::memory_order_relaxed);
+    const auto interval = std::chrono::milliseconds(limits.summary_interval_ms.load(std::memory_order_relaxed));
+    const Clock::time_point now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!started_) {
+        started_ = true;
+        tokens_ = burst;
+        last_refill_ = now;
+        window_start_ = now;
+    }
+    level_ = std::max(level_, level);
+    const bool summary_due = now - window_start_ >= interval;
+
+    // Duplicate of the last written message: fold
+    if (has_last_ && message == last_message_) {
+        ++repeated_;
+        g_folded.fetch_add(1, std::memory_order_relaxed);
+        if (summary_due) {
+            writeSummary(logger, now);
+        }
+        return;
+    }
+
+    double minutes = std::chrono::duration<double, std::ratio<60>>(now - last_refill_).count();
+    tokens_ = std::min(burst, tokens_ + minutes * limits.per_minute.load(std::memory_order_relaxed));
+    last_refill_ = now;
+
+    if (tokens_ >= 1.0) {
+        tokens_ -= 1.0;
+        // A different message ends the run of repeats
+        if (repeated_ > 0) {
+            writeSummary(logger, now);
+        }
+        logger.log(level, message);
+        last_message_ = std::move(message);
+        has_last_ = true;
+    } else {
+        ++suppressed_;
+        g_suppressed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (summary_due && suppressed_ > 0) {
+        writeSummary(logger, now);
+    }
+}
+
+void LogSite::writeSummary(spdlog::logger& logger, Clock::time_point now) {
+    if (repeated_ > 0) {
+        logger.log(level_, "[{}] last message repeated {} times", site_, repeated_);
+    }
+    if (suppressed_ > 0) {
+        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(now - window_start_).count();
+        logger.log(level_, "[{}] {} messages suppressed in the last {}s", site_, suppressed_, seconds);
+    }
+    repeated_ = 0;
+    suppressed_ = 0;
+    window_start_ = now;
+    level_ = spdlog::level::warn;
+}
+
+void LogSite::configure(const LoggingConfig& config) {
+    Policy& limits = policy();
+    limits.enabled.store(config.suppress_enabled);
+    limits.burst.store(std::max(1.0, static_cast<double>(config.suppress_burst)));
+    limits.per_minute.store(config.suppress_per_minute);
+    limits.summary_interval_ms.store(config.suppress_summary_interval.count());
+}
+
+void LogSite::flushAll(spdlog::logger& logger) {
+    auto& sites = registry();
+    std::lock_guard<std::mutex> registry_lock(sites.mutex);
+    const Clock::time_point now = Clock::now();
+    for (LogSite* site : sites.sites) {
+        std::lock_guard<std::mutex> lock(site->mutex_);
+        if (site->repeated_ > 0 || site->suppressed_ > 0) {
+            site->writeSummary(logger, now);
+        }
+    }
+}
+
+LogSite::Statistics LogSite::getStatistics() {
+    Statistics stats;
+    stats.folded = g_folded.load(std::memory_order_relaxed);
+    stats.suppressed = g_suppressed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace ecoWatt
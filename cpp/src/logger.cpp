@@ -6,17 +6,31 @@
  */
 
 #include "logger.hpp"
+#include <algorithm>
 #include <iostream>
 
 namespace ecoWatt {
 
-std::shared_ptr<spdlog::logger> Logger::logger_;
-bool Logger::initialized_ = false;
+std::atomic<spdlog::logger*> Logger::current_{nullptr};
+std::vector<std::shared_ptr<spdlog::logger>> Logger::loggers_;
+bool Logger::defaulted_ = false;
+std::mutex Logger::init_mutex_;
 
 void Logger::initialize(const LoggingConfig& config) {
-    if (initialized_) {
+    std::lock_guard<std::mutex> lock(init_mutex_);
+    initializeLocked(config, false);
+}
+
+void Logger::initializeLocked(const LoggingConfig& config, bool defaulted) {
+    spdlog::logger* current = current_.load(std::memory_order_relaxed);
+    if (current && !defaulted_) {
         return;
     }
+    if (current) {
+        // Replace the implicit default logger; it stays in loggers_ for callers still using it
+        current->flush();
+        spdlog::drop_all();
+    }
 
     try {
         // Create sinks
@@ -37,22 +51,39 @@ void Logger::initialize(const LoggingConfig& config) {
         sinks.push_back(file_sink);
 
         // Create logger
-        logger_ = std::make_shared<spdlog::logger>("ecoWatt", sinks.begin(), sinks.end());
-        logger_->set_level(spdlog::level::trace); // Let sinks filter
-        logger_->flush_on(spdlog::level::warn);
+        std::shared_ptr<spdlog::logger> logger;
+        if (config.async) {
+            spdlog::init_thread_pool(config.async_queue_size, 1);
+            auto policy = config.async_overflow == LogOverflowPolicy::OVERRUN_OLDEST
+                              ? spdlog::async_overflow_policy::overrun_oldest
+                              : spdlog::async_overflow_policy::block;
+            logger = std::make_shared<spdlog::async_logger>("ecoWatt", sinks.begin(), sinks.end(),
+                                                            spdlog::thread_pool(), policy);
+        } else {
+            logger = std::make_shared<spdlog::logger>("ecoWatt", sinks.begin(), sinks.end());
+        }
+        // Most verbose sink level, so disabled calls are rejected before formatting
+        logger->set_level(std::min(convertLogLevel(config.console_level), convertLogLevel(config.file_level)));
+        logger->flush_on(spdlog::level::warn);
 
         // Set pattern
-        logger_->set_pattern(config.format);
+        logger->set_pattern(config.format);
 
         // Register as default logger
-        spdlog::set_default_logger(logger_);
+        spdlog::set_default_logger(logger);
+        LogSite::configure(config);
 
-        initialized_ = true;
+        loggers_.push_back(logger);
+        defaulted_ = defaulted;
+        current_.store(logger.get(), std::memory_order_release);
         
         LOG_INFO("Logging system initialized");
-        LOG_INFO("Console level: {}, File level: {}", 
+        LOG_INFO("Console level: {}, File level: {}, Mode: {}", 
                 to_string(config.console_level), 
-                to_string(config.file_level));
+                to_string(config.file_level),
+                config.async ? "async (queue " + std::to_string(config.async_queue_size) + ", " +
+                                   to_string(config.async_overflow) + ")"
+                             : std::string("sync"));
         
     } catch (const spdlog::spdlog_ex& ex) {
         std::cerr << "Log initialization failed: " << ex.what() << std::endl;
@@ -61,20 +92,25 @@ void Logger::initialize(const LoggingConfig& config) {
 }
 
 std::shared_ptr<spdlog::logger> Logger::get(const std::string& name) {
-    if (!initialized_) {
-        // Initialize with default config if not already done
-        LoggingConfig default_config;
-        initialize(default_config);
+    std::shared_ptr<spdlog::logger> logger;
+    {
+        std::lock_guard<std::mutex> lock(init_mutex_);
+        if (!current_.load(std::memory_order_relaxed)) {
+            // Initialize with default config if not already done
+            LoggingConfig default_config;
+            initializeLocked(default_config, true);
+        }
+        logger = loggers_.back();
     }
     
     if (name == "ecoWatt" || name.empty()) {
-        return logger_;
+        return logger;
     }
     
     // Return named logger or create it
     auto named_logger = spdlog::get(name);
     if (!named_logger) {
-        named_logger = logger_->clone(name);
+        named_logger = logger->clone(name);
         spdlog::register_logger(named_logger);
     }
     
@@ -82,23 +118,25 @@ std::shared_ptr<spdlog::logger> Logger::get(const std::string& name) {
 }
 
 void Logger::setLevel(LogLevel level) {
-    if (logger_) {
-        logger_->set_level(convertLogLevel(level));
+    if (spdlog::logger* logger = current_.load(std::memory_order_acquire)) {
+        logger->set_level(convertLogLevel(level));
     }
 }
 
 void Logger::flush() {
-    if (logger_) {
-        logger_->flush();
+    if (spdlog::logger* logger = current_.load(std::memory_order_acquire)) {
+        logger->flush();
     }
 }
 
 void Logger::shutdown() {
-    if (initialized_) {
+    std::lock_guard<std::mutex> lock(init_mutex_);
+    if (spdlog::logger* logger = current_.load(std::memory_order_relaxed)) {
         LOG_INFO("Shutting down logging system");
-        flush();
+        LogSite::flushAll(*logger);
+        logger->flush();
         spdlog::shutdown();
-        initialized_ = false;
+        current_.store(nullptr, std::memory_order_release);
     }
 }
 
@@ -0,0 +1,379 @@
+/**
+ * @file memory_snapshot.cpp
+ * @brief Implementation of the memory-mapped sample ring snapshot
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "memory_snapshot.hpp"
+#include "exceptions.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ecoWatt {
+
+namespace {
+
+uint32_t fnv1a(const void* data, size_t size, uint32_t hash = 2166136261u) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+uint32_t headerChecksum(const SnapshotHeader& header) {
+    return fnv1a(&header, offsetof(SnapshotHeader, checksum));
+}
+
+uint32_t entryChecksum(SnapshotRegister entry) {
+    entry.checksum = 0;
+    return fnv1a(&entry, sizeof(entry));
+}
+
+uint32_t recordChecksum(const SnapshotRecord& record, uint32_t slot) {
+    // Seeded with the ring index so a record copied into another ring is rejected
+    return fnv1a(&record, offsetof(SnapshotRecord, checksum), fnv1a(&slot, sizeof(slot)));
+}
+
+void copyTruncated(char* dest, size_t size, const std::string& text) {
+    const size_t length = std::min(size - 1, text.size());
+    std::memcpy(dest, text.data(), length);
+    std::memset(dest + length, 0, size - length);
+}
+
+std::string fixedString(const char* text, size_t size) {
+    return std::string(text, ::strnlen(text, size));
+}
+
+} // namespace
+
+size_t MemorySnapshotFile::fileSize(uint32_t max_registers, uint32_t samples_per_register) {
+    return sizeof(SnapshotHeader) +
+           static_cast<size_t>(max_registers) * sizeof(SnapshotRegister) +
+           static_cast<size_t>(max_registers) * samples_per_register * sizeof(SnapshotRecord);
+}
+
+MemorySnapshotFile::MemorySnapshotFile(const std::string& path, uint32_t max_registers, uint32_t samples_per_register)
+    : path_(path), max_registers_(max_registers), samples_per_register_(samples_per_register) {
+
+    if (max_registers_ == 0 || samples_per_register_ == 0) {
+        throw ValidationException("Memory snapshot needs at least one register and one sample per register");
+    }
+
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw StorageException("open " + path_ + ": " + std::strerror(errno));
+    }
+
+    try {
+        struct stat st {};
+        if (::fstat(fd_, &st) != 0) {
+            throw StorageException("fstat " + path_ + ": " + std::strerror(errno));
+        }
+
+        std::string reason;
+        if (st.st_size == 0) {
+            create();
+        } else {
+            map(static_cast<size_t>(st.st_size));
+            if (!restore(reason)) {
+                RegisterSamples samples = std::move(restored_);
+                restored_.clear();
+                unmap();
+                create();
+                adopt(std::move(samples));
+            }
+        }
+        stats_.reset_reason = reason;
+    } catch (...) {
+        unmap();
+        ::close(fd_);
+        throw;
+    }
+
+    for (const auto& [address, samples] : restored_) {
+        stats_.restored += samples.size();
+    }
+    if (!stats_.reset_reason.empty()) {
+        LOG_WARN("Memory snapshot {} rebuilt: {}", path_, stats_.reset_reason);
+    }
+    LOG_INFO("Memory snapshot {} ({} registers x {} samples): restored {} samples of {} registers, {} discarded",
+             path_, max_registers_, samples_per_register_, stats_.restored, restored_.size(), stats_.discarded);
+}
+
+MemorySnapshotFile::~MemorySnapshotFile() {
+    if (base_) {
+        ::msync(base_, size_, MS_SYNC);
+    }
+    unmap();
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+void MemorySnapshotFile::map(size_t size) {
+    void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (base == MAP_FAILED) {
+        throw StorageException("mmap " + path_ + ": " + std::strerror(errno));
+    }
+    base_ = base;
+    size_ = size;
+}
+
+void MemorySnapshotFile::unmap() {
+    if (base_) {
+        ::munmap(base_, size_);
+        base_ = nullptr;
+        size_ = 0;
+    }
+}
+
+void MemorySnapshotFile::create() {
+    // Truncating first zero-fills every entry and record
+    const size_t size = fileSize(max_registers_, samples_per_register_);
+    if (::ftruncate(fd_, 0) != 0 || ::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+        throw StorageException("ftruncate " + path_ + ": " + std::strerror(errno));
+    }
+    map(size);
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+    header.version = kSnapshotVersion;
+    header.header_size = sizeof(SnapshotHeader);
+    header.register_entry_size = sizeof(SnapshotRegister);
+    header.record_size = sizeof(SnapshotRecord);
+    header.max_registers = max_registers_;
+    header.samples_per_register = samples_per_register_;
+    header.created_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    header.checksum = headerChecksum(header);
+    *this->header() = header;
+
+    slots_.assign(max_registers_, Slot{});
+    slot_by_address_.clear();
+    next_sequence_ = 1;
+}
+
+bool MemorySnapshotFile::restore(std::string& reason) {
+    if (size_ < sizeof(SnapshotHeader)) {
+        reason = "file shorter than its header";
+        return false;
+    }
+    const SnapshotHeader header = *this->header();
+    if (std::memcmp(header.magic, kSnapshotMagic, sizeof(header.magic)) != 0) {
+        reason = "not a snapshot file";
+        return false;
+    }
+    if (header.version != kSnapshotVersion) {
+        reason = "version " + std::to_string(header.version) + " (expected " + std::to_string(kSnapshotVersion) + ")";
+        return false;
+    }
+    if (header.checksum != headerChecksum(header)) {
+        reason = "header checksum mismatch";
+        return false;
+    }
+    if (header.header_size != sizeof(SnapshotHeader) || header.register_entry_size != sizeof(SnapshotRegister) ||
+        header.record_size != sizeof(SnapshotRecord)) {
+        reason = "record layout mismatch";
+        return false;
+    }
+    if (header.max_registers == 0 || header.samples_per_register == 0 ||
+        fileSize(header.max_registers, header.samples_per_register) != size_) {
+        reason = "file size does not match its header";
+        return false;
+    }
+
+    // Read with the file's own geometry; reuse in place only if it matches ours
+    const uint32_t registers = header.max_registers;
+    const uint32_t capacity = header.samples_per_register;
+    const bool reuse = registers == max_registers_ && capacity == samples_per_register_;
+    auto* file_entries = reinterpret_cast<SnapshotRegister*>(static_cast<char*>(base_) + sizeof(SnapshotHeader));
+    auto* file_records = reinterpret_cast<SnapshotRecord*>(file_entries + registers);
+    if (reuse) {
+        slots_.assign(max_registers_, Slot{});
+        slot_by_address_.clear();
+    }
+
+    uint64_t max_sequence = 0;
+    for (uint32_t slot = 0; slot < registers; ++slot) {
+        SnapshotRegister& entry = file_entries[slot];
+        SnapshotRecord* records = file_records + static_cast<size_t>(slot) * capacity;
+        if (entry.in_use == 0) {
+            continue;
+        }
+        if (entry.checksum != entryChecksum(entry) || restored_.count(entry.address) > 0) {
+            ++stats_.discarded;
+            if (reuse) {
+                std::memset(&entry, 0, sizeof(entry));
+                std::memset(records, 0, capacity * sizeof(SnapshotRecord));
+            }
+            continue;
+        }
+
+        std::vector<std::pair<uint64_t, uint32_t>> order;   // (sequence, ring index)
+        for (uint32_t index = 0; index < capacity; ++index) {
+            const SnapshotRecord& record = records[index];
+            if (record.sequence == 0) {
+                continue;
+            }
+            if (record.checksum != recordChecksum(record, slot)) {
+                ++stats_.discarded;
+                if (reuse) {
+                    std::memset(&records[index], 0, sizeof(SnapshotRecord));
+                }
+                continue;
+            }
+            order.emplace_back(record.sequence, index);
+        }
+        std::sort(order.begin(), order.end());
+
+        const std::string name = fixedString(entry.name, sizeof(entry.name));
+        const std::string unit = fixedString(entry.unit, sizeof(entry.unit));
+        auto& samples = restored_[entry.address];
+        for (const auto& [sequence, index] : order) {
+            const SnapshotRecord& record = records[index];
+            samples.emplace_back(TimePoint(std::chrono::duration_cast<TimePoint::duration>(
+                                     std::chrono::nanoseconds(record.timestamp_ns))),
+                                 entry.address, name, record.raw_value, record.scaled_value, unit);
+            max_sequence = std::max(max_sequence, sequence);
+        }
+
+        if (reuse) {
+            Slot& state = slots_[slot];
+            state.used = true;
+            state.next = order.empty() ? 0 : (order.back().second + 1) % capacity;
+            state.name = name;
+            state.unit = unit;
+            slot_by_address_[entry.address] = slot;
+        }
+    }
+    for (auto it = restored_.begin(); it != restored_.end();) {
+        it = it->second.empty() ? restored_.erase(it) : std::next(it);
+    }
+    next_sequence_ = max_sequence + 1;
+
+    if (!reuse) {
+        reason = "geometry changed from " + std::to_string(registers) + " registers x " +
+                 std::to_string(capacity) + " samples";
+        return false;
+    }
+    return true;
+}
+
+void MemorySnapshotFile::adopt(RegisterSamples samples) {
+    // Keep what fits the new geometry, dropping each register's oldest samples
+    for (auto& [address, ring] : samples) {
+        while (ring.size() > samples_per_register_) {
+            ring.pop_front();
+        }
+        for (const auto& sample : ring) {
+            append(sample);
+        }
+    }
+    restored_ = std::move(samples);
+    stats_.written = 0;
+}
+
+MemorySnapshotFile::RegisterSamples MemorySnapshotFile::takeRestored() {
+    RegisterSamples samples = std::move(restored_);
+    restored_.clear();
+    return samples;
+}
+
+SnapshotRegister* MemorySnapshotFile::entries() const {
+    return reinterpret_cast<SnapshotRegister*>(static_cast<char*>(base_) + sizeof(SnapshotHeader));
+}
+
+SnapshotRecord* MemorySnapshotFile::ring(uint32_t slot) const {
+    return reinterpret_cast<SnapshotRecord*>(entries() + max_registers_) +
+           static_cast<size_t>(slot) * samples_per_register_;
+}
+
+void MemorySnapshotFile::writeEntry(uint32_t slot, RegisterAddress address,
+                                    const std::string& name, const std::string& unit) {
+    SnapshotRegister entry{};
+    entry.address = address;
+    entry.in_use = 1;
+    copyTruncated(entry.name, sizeof(entry.name), name);
+    copyTruncated(entry.unit, sizeof(entry.unit), unit);
+    entry.checksum = entryChecksum(entry);
+    entries()[slot] = entry;
+
+    slots_[slot].name = name;
+    slots_[slot].unit = unit;
+}
+
+int32_t MemorySnapshotFile::slotFor(const AcquisitionSample& sample) {
+    auto it = slot_by_address_.find(sample.register_address);
+    if (it != slot_by_address_.end()) {
+        const Slot& state = slots_[it->second];
+        if (state.name != sample.register_name || state.unit != sample.unit) {
+            writeEntry(it->second, sample.register_address, sample.register_name, sample.unit);
+        }
+        return static_cast<int32_t>(it->second);
+    }
+
+    for (uint32_t slot = 0; slot < max_registers_; ++slot) {
+        if (!slots_[slot].used) {
+            slots_[slot].used = true;
+            slots_[slot].next = 0;
+            writeEntry(slot, sample.register_address, sample.register_name, sample.unit);
+            slot_by_address_.emplace(sample.register_address, slot);
+            return static_cast<int32_t>(slot);
+        }
+    }
+    return -1;
+}
+
+void MemorySnapshotFile::append(const AcquisitionSample& sample) {
+    const int32_t slot = slotFor(sample);
+    if (slot < 0) {
+        ++stats_.register_overflow;
+        return;
+    }
+
+    SnapshotRecord record{};
+    record.sequence = next_sequence_++;
+    record.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        sample.timestamp.time_since_epoch()).count();
+    record.scaled_value = sample.scaled_value;
+    record.raw_value = sample.raw_value;
+    record.checksum = recordChecksum(record, static_cast<uint32_t>(slot));
+
+    Slot& state = slots_[slot];
+    ring(static_cast<uint32_t>(slot))[state.next] = record;
+    state.next = (state.next + 1) % samples_per_register_;
+    ++stats_.written;
+}
+
+void MemorySnapshotFile::clear(RegisterAddress address) {
+    auto it = slot_by_address_.find(address);
+    if (it == slot_by_address_.end()) {
+        return;
+    }
+    std::memset(ring(it->second), 0, samples_per_register_ * sizeof(SnapshotRecord));
+    slots_[it->second].next = 0;
+}
+
+void MemorySnapshotFile::clearAll() {
+    std::memset(entries(), 0, size_ - sizeof(SnapshotHeader));
+    slots_.assign(max_registers_, Slot{});
+    slot_by_address_.clear();
+}
+
+void MemorySnapshotFile::flush(bool wait) {
+    if (::msync(base_, size_, wait ? MS_SYNC : MS_ASYNC) != 0) {
+        LOG_WARN("msync {}: {}", path_, std::strerror(errno));
+    }
+}
+
+} // namespace ecoWatt
@@ -0,0 +1,254 @@
+/**
+ * @file metrics_exporter.cpp
+ * @brief Implementation of the OpenMetrics writer and /metrics endpoint
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "metrics_exporter.hpp"
+#include "exceptions.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace web;
+using namespace web::http;
+using namespace web::http::experimental::listener;
+
+namespace ecoWatt {
+
+namespace {
+
+void appendNumber(std::string& out, double value) {
+    if (std::isnan(value)) {
+        out += "NaN";
+    } else if (std::isinf(value)) {
+        out += value > 0 ? "+Inf" : "-Inf";
+    } else {
+        fmt::format_to(std::back_inserter(out), "{}", value);
+    }
+}
+
+std::string boundLabel(double bound) {
+    std::string label = fmt::format("{}", bound);
+    if (label.find_first_of(".e") == std::string::npos) {
+        label += ".0";  // Canonical float, e.g. le="1.0"
+    }
+    return "le=\"" + label + "\"";
+}
+
+} // namespace
+
+// MetricsWriter
+
+void MetricsWriter::family(std::string_view name, std::string_view type, std::string_view help) {
+    fmt::format_to(std::back_inserter(out_), "# TYPE {} {}\n# HELP {} {}\n", name, type, name, help);
+}
+
+void MetricsWriter::sampleLine(std::string_view name, std::string_view suffix, std::string_view labels,
+                               std::string_view extra_label) {
+    out_.append(name).append(suffix);
+    if (!labels.empty() || !extra_label.empty()) {
+        out_ += '{';
+        out_.append(labels);
+        if (!labels.empty() && !extra_label.empty()) {
+            out_ += ',';
+        }
+        out_.append(extra_label);
+        out_ += '}';
+    }
+    out_ += ' ';
+}
+
+void MetricsWriter::counter(std::string_view name, uint64_t value, std::string_view labels) {
+    sampleLine(name, "_total", labels, {});
+    fmt::format_to(std::back_inserter(out_), "{}\n", value);
+}
+
+void MetricsWriter::gauge(std::string_view name, double value, std::string_view labels) {
+    sampleLine(name, {}, labels, {});
+    appendNumber(out_, value);
+    out_ += '\n';
+}
+
+void MetricsWriter::histogram(std::string_view name, const HistogramSnapshot& snapshot, std::string_view labels) {
+    static const std::vector<std::string> bound_labels = [] {
+        std::vector<std::string> result;
+        for (double bound : defaultBounds()) {
+            result.push_back(boundLabel(bound));
+        }
+        return result;
+    }();
+    static const std::vector<uint64_t> bounds_us = [] {
+        std::vector<uint64_t> result;
+        for (double bound : defaultBounds()) {
+            result.push_back(static_cast<uint64_t>(std::llround(bound * 1e6)));
+        }
+        return result;
+    }();
+
+    // Per-bound counts, then cumulated
+    std::vector<uint64_t> counts(bounds_us.size() + 1, 0);
+    for (size_t i = 0; i < snapshot.buckets.size(); ++i) {
+        if (snapshot.buckets[i] == 0) {
+            continue;
+        }
+        uint64_t largest = LatencyHistogram::bucketUpperBound(i) - 1;
+        size_t slot = std::lower_bound(bounds_us.begin(), bounds_us.end(), largest) - bounds_us.begin();
+        counts[slot] += snapshot.buckets[i];
+    }
+
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < bounds_us.size(); ++i) {
+        cumulative += counts[i];
+        sampleLine(name, "_bucket", labels, bound_labels[i]);
+        fmt::format_to(std::back_inserter(out_), "{}\n", cumulative);
+    }
+    // Buckets and count are read without a common lock; keep them monotonic
+    uint64_t total = std::max(cumulative + counts.back(), snapshot.count);
+    sampleLine(name, "_bucket", labels, "le=\"+Inf\"");
+    fmt::format_to(std::back_inserter(out_), "{}\n", total);
+    sampleLine(name, "_count", labels, {});
+    fmt::format_to(std::back_inserter(out_), "{}\n", total);
+    sampleLine(name, "_sum", labels, {});
+    appendNumber(out_, static_cast<double>(snapshot.sum_us) / 1e6);
+    out_ += '\n';
+}
+
+const std::vector<double>& MetricsWriter::defaultBounds() {
+    static const std::vector<double> bounds = {0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+                                               0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0};
+    return bounds;
+}
+
+// MetricsExporter
+
+MetricsExporter::MetricsExporter(const MetricsConfig& config)
+    : config_(config), body_(std::make_shared<const std::string>("# EOF\n")) {
+
+    if (config_.refresh_interval.count() <= 0) {
+        throw ValidationException("MetricsExporter requires a positive refresh interval");
+    }
+}
+
+MetricsExporter::~MetricsExporter() {
+    try {
+        stop();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error stopping metrics endpoint: {}", e.what());
+    }
+}
+
+void MetricsExporter::addCollector(Collector collector) {
+    std::lock_guard<std::mutex> lock(refresh_mutex_);
+    collectors_.push_back(std::move(collector));
+    sections_.emplace_back();
+}
+
+bool MetricsExporter::refresh() {
+    std::lock_guard<std::mutex> lock(refresh_mutex_);
+
+    bool changed = false;
+    size_t total_size = 0;
+    for (size_t i = 0; i < collectors_.size(); ++i) {
+        scratch_.clear();
+        MetricsWriter writer(scratch_);
+        try {
+            collectors_[i](writer);
+        } catch (const std::exception& e) {
+            LOG_WARN("Metrics collector failed: {}", e.what());
+            scratch_ = sections_[i];  // Keep serving the last good section
+        }
+        if (scratch_ != sections_[i]) {
+            sections_[i].swap(scratch_);
+            changed = true;
+        }
+        total_size += sections_[i].size();
+    }
+    if (!changed) {
+        return false;
+    }
+
+    auto body = std::make_shared<std::string>();
+    body->reserve(total_size + 6);
+    for (const auto& section : sections_) {
+        body->append(section);
+    }
+    body->append("# EOF\n");
+    std::atomic_store(&body_, std::shared_ptr<const std::string>(std::move(body)));
+    return true;
+}
+
+std::shared_ptr<const std::string> MetricsExporter::body() const {
+    return std::atomic_load(&body_);
+}
+
+void MetricsExporter::start() {
+    if (running_) {
+        return;
+    }
+
+    refresh();
+    try {
+        listener_ = std::make_unique<http_listener>(utility::conversions::to_string_t(config_.listen_url));
+        listener_->support(methods::GET, [this](http_request request) { handleGet(request); });
+        listener_->open().wait();
+    } catch (const std::exception& e) {
+        listener_.reset();
+        throw HttpException("Failed to start metrics endpoint on " + config_.listen_url + ": " + e.what());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(thread_mutex_);
+        stop_requested_ = false;
+    }
+    refresh_thread_ = std::thread(&MetricsExporter::refreshLoop, this);
+    running_ = true;
+
+    LOG_INFO("Metrics endpoint listening on {}{}", config_.listen_url, config_.path);
+}
+
+void MetricsExporter::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    {
+        std::lock_guard<std::mutex> lock(thread_mutex_);
+        stop_requested_ = true;
+    }
+    thread_cv_.notify_all();
+    if (refresh_thread_.joinable()) {
+        refresh_thread_.join();
+    }
+    listener_->close().wait();
+    listener_.reset();
+
+    LOG_INFO("Metrics endpoint stopped");
+}
+
+void MetricsExporter::refreshLoop() {
+    std::unique_lock<std::mutex> lock(thread_mutex_);
+    while (!thread_cv_.wait_for(lock, config_.refresh_interval, [this] { return stop_requested_; })) {
+        lock.unlock();
+        refresh();
+        lock.lock();
+    }
+}
+
+void MetricsExporter::handleGet(http_request request) {
+    std::string path = utility::conversions::to_utf8string(request.relative_uri().path());
+    if (path != config_.path) {
+        request.reply(status_codes::NotFound);
+        return;
+    }
+
+    scrapes_.fetch_add(1, std::memory_order_relaxed);
+    std::shared_ptr<const std::string> body = this->body();
+    http_response response(status_codes::OK);
+    response.set_body(*body, kContentType);
+    request.reply(response);
+}
+
+} // namespace ecoWatt
@@ -7,15 +7,16 @@
 
 #include "modbus_frame.hpp"
 #include "logger.hpp"
+#include "tracing.hpp"
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 
 namespace ecoWatt {
 
-std::string ModbusFrame::createReadFrame(SlaveAddress slave_address,
-                                       RegisterAddress start_address,
-                                       uint16_t num_registers) {
+std::vector<uint8_t> ModbusFrame::createReadFrameBytes(SlaveAddress slave_address,
+                                                     RegisterAddress start_address,
+                                                     uint16_t num_registers) {
     
     std::vector<uint8_t> data;
     
@@ -27,19 +28,22 @@ std::string ModbusFrame::createReadFrame(SlaveAddress slave_address,
     data.push_back((num_registers >> 8) & 0xFF);
     data.push_back(num_registers & 0xFF);
     
-    auto frame = buildFrame(slave_address, 
-                           static_cast<FunctionCode>(ModbusFunction::READ_HOLDING_REGISTERS), 
-                           data);
-    
-    std::string frame_hex = bytesToHex(frame);
+    return buildFrame(slave_address,
+                      static_cast<FunctionCode>(ModbusFunction::READ_HOLDING_REGISTERS), 
+                      data);
+}
+
+std::string ModbusFrame::createReadFrame(SlaveAddress slave_address,
+                                       RegisterAddress start_address,
+                                       uint16_t num_registers) {
+    std::string frame_hex = bytesToHex(createReadFrameBytes(slave_address, start_address, num_registers));
     LOG_TRACE("Created read frame: {}", frame_hex);
-    
     return frame_hex;
 }
 
-std::string ModbusFrame::createWriteFrame(SlaveAddress slave_address,
-                                        RegisterAddress register_address,
-                                        RegisterValue value) {
+std::vector<uint8_t> ModbusFrame::createWriteFrameBytes(SlaveAddress slave_address,
+                                                      RegisterAddress register_address,
+                                                      RegisterValue value) {
     
     std::vector<uint8_t> data;
     
@@ -51,17 +55,96 @@ std::string ModbusFrame::createWriteFrame(SlaveAddress slave_address,
     data.push_back((value >> 8) & 0xFF);
     data.push_back(value & 0xFF);
     
-    auto frame = buildFrame(slave_address,
-                           static_cast<FunctionCode>(ModbusFunction::WRITE_SINGLE_REGISTER),
-                           data);
-    
-    std::string frame_hex = bytesToHex(frame);
+    return buildFrame(slave_address,
+                      static_cast<FunctionCode>(ModbusFunction::WRITE_SINGLE_REGISTER),
+                      data);
+}
+
+std::string ModbusFrame::createWriteFrame(SlaveAddress slave_address,
+                                        RegisterAddress register_address,
+                                        RegisterValue value) {
+    std::string frame_hex = bytesToHex(createWriteFrameBytes(slave_address, register_address, value));
     LOG_TRACE("Created write frame: {}", frame_hex);
+    return frame_hex;
+}
+
+std::vector<uint8_t> ModbusFrame::createWriteMultipleFrameBytes(SlaveAddress slave_address,
+                                                              RegisterAddress start_address,
+                                                              const std::vector<RegisterValue>& values) {
+    
+    std::vector<uint8_t> data;
+    data.reserve(5 + values.size() * 2);
     
+    // Add start address and quantity (big-endian)
+    data.push_back((start_address >> 8) & 0xFF);
+    data.push_back(start_address & 0xFF);
+    data.push_back((values.size() >> 8) & 0xFF);
+    data.push_back(values.size() & 0xFF);
+    
+    // Add byte count and values (big-endian)
+    data.push_back(static_cast<uint8_t>(values.size() * 2));
+    for (RegisterValue value : values) {
+        data.push_back((value >> 8) & 0xFF);
+        data.push_back(value & 0xFF);
+    }
+    
+    return buildFrame(slave_address,
+                      static_cast<FunctionCode>(ModbusFunction::WRITE_MULTIPLE_REGISTERS),
+                      data);
+}
+
+std::string ModbusFrame::createWriteMultipleFrame(SlaveAddress slave_address,
+                                                RegisterAddress start_address,
+                                                const std::vector<RegisterValue>& values) {
+    std::string frame_hex = bytesToHex(createWriteMultipleFrameBytes(slave_address, start_address, values));
+    LOG_TRACE("Created write multiple frame: {}", frame_hex);
     return frame_hex;
 }
 
-ModbusResponse ModbusFrame::parseResponse(const std::string& frame_hex) {
+std::vector<uint8_t> ModbusFrame::createReadWriteMultipleFrameBytes(SlaveAddress slave_address,
+                                                                  RegisterAddress read_start,
+                                                                  uint16_t read_count,
+                                                                  RegisterAddress write_start,
+                                                                  const std::vector<RegisterValue>& values) {
+    
+    std::vector<uint8_t> data;
+    data.reserve(9 + values.size() * 2);
+    
+    // Add read start address and quantity (big-endian)
+    data.push_back((read_start >> 8) & 0xFF);
+    data.push_back(read_start & 0xFF);
+    data.push_back((read_count >> 8) & 0xFF);
+    data.push_back(read_count & 0xFF);
+    
+    // Add write start address and quantity (big-endian)
+    data.push_back((write_start >> 8) & 0xFF);
+    data.push_back(write_start & 0xFF);
+    data.push_back((values.size() >> 8) & 0xFF);
+    data.push_back(values.size() & 0xFF);
+    
+    // Add byte count and values (big-endian)
+    data.push_back(static_cast<uint8_t>(values.size() * 2));
+    for (RegisterValue value : values) {
+        data.push_back((value >> 8) & 0xFF);
+        data.push_back(value & 0xFF);
+    }
+    
+    return buildFrame(slave_address,
+                      static_cast<FunctionCode>(ModbusFunction::READ_WRITE_MULTIPLE_REGISTERS),
+                      data);
+}
+
+std::string ModbusFrame::createReadWriteMultipleFrame(SlaveAddress slave_address,
+                                                    RegisterAddress read_start,
+                                                    uint16_t read_count,
+                                                    RegisterAddress write_start,
+                                                    const std::vector<RegisterValue>& values) {
+    std::string frame_hex = bytesToHex(createReadWriteMultipleFrameBytes(slave_address, read_start, read_count, write_start, values));
+    LOG_TRACE("Created read/write multiple frame: {}", frame_hex);
+    return frame_hex;
+}
+
+ModbusResponse ModbusFrame::parseResponse(std::string_view frame_hex) {
     if (frame_hex.empty()) {
         throw ModbusException("Empty response frame");
     }
@@ -75,6 +158,15 @@ ModbusResponse ModbusFrame::parseResponse(const std::string& frame_hex) {
         throw ModbusException("Invalid hex frame: " + std::string(e.what()));
     }
     
+    return parseResponse(frame_bytes);
+}
+
+ModbusResponse ModbusFrame::parseResponse(const std::vector<uint8_t>& frame_bytes) {
+    TRACE_SPAN("ModbusFrame::parseResponse", "modbus");
+    if (frame_bytes.empty()) {
+        throw ModbusException("Empty response frame");
+    }
+    
     if (frame_bytes.size() < 5) {
         throw ModbusException("Frame too short (minimum 5 bytes required)");
     }
@@ -103,7 +195,9 @@ ModbusResponse ModbusFrame::parseResponse(const std::string& frame_hex) {
     }
     
     // Parse data based on function code
-    if (function_code == static_cast<FunctionCode>(ModbusFunction::READ_HOLDING_REGISTERS)) {
+    if (function_code == static_cast<FunctionCode>(ModbusFunction::READ_HOLDING_REGISTERS) ||
+        function_code == static_cast<FunctionCode>(ModbusFunction::READ_WRITE_MULTIPLE_REGISTERS)) {
+        // FC23 answers with the read part only, laid out like FC03
         if (frame_bytes.size() < 4) {
             throw ModbusException("Read response too short");
         }
@@ -119,6 +213,13 @@ ModbusResponse ModbusFrame::parseResponse(const std::string& frame_hex) {
         // Write response echoes the request (register address + value)
         response.data.assign(frame_bytes.begin() + 2, frame_bytes.end() - 2);
         
+    } else if (function_code == static_cast<FunctionCode>(ModbusFunction::WRITE_MULTIPLE_REGISTERS)) {
+        // Write multiple response echoes start address + quantity
+        if (frame_bytes.size() != 8) {
+            throw ModbusException("Write multiple response must be 8 bytes");
+        }
+        response.data.assign(frame_bytes.begin() + 2, frame_bytes.end() - 2);
+        
     } else {
         // Generic data extraction
         response.data.assign(frame_bytes.begin() + 2, frame_bytes.end() - 2);
@@ -148,7 +249,7 @@ uint16_t ModbusFrame::calculateCRC(const std::vector<uint8_t>& data) {
     return crc;
 }
 
-std::vector<uint8_t> ModbusFrame::hexToBytes(const std::string& hex_string) {
+std::vector<uint8_t> ModbusFrame::hexToBytes(std::string_view hex_string) {
     if (hex_string.length() % 2 != 0) {
         throw ValidationException("Hex string length must be even");
     }
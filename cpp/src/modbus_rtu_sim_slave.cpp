@@ -0,0 +1,135 @@
+/**
+ * @file modbus_rtu_sim_slave.cpp
+ * @brief Implementation of the pty-backed Modbus RTU slave emulator
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "modbus_rtu_sim_slave.hpp"
+#include "exceptions.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace ecoWatt {
+
+namespace {
+
+constexpr std::chrono::microseconds kStopPollInterval{50000};
+
+} // namespace
+
+ModbusRtuSimSlave::ModbusRtuSimSlave(std::shared_ptr<InverterSimulator> simulator, uint32_t baud_rate)
+    : simulator_(std::move(simulator)),
+      baud_rate_(baud_rate),
+      timing_(ModbusRtuTransport::timingForBaud(baud_rate)) {
+
+    if (!simulator_) {
+        throw ValidationException("ModbusRtuSimSlave requires a simulator");
+    }
+}
+
+ModbusRtuSimSlave::~ModbusRtuSimSlave() {
+    stop();
+}
+
+void ModbusRtuSimSlave::start() {
+    if (running_) {
+        return;
+    }
+
+    master_fd_ = ::posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (master_fd_ < 0 || ::grantpt(master_fd_) != 0 || ::unlockpt(master_fd_) != 0) {
+        std::string reason = std::strerror(errno);
+        stop();
+        throw TransportException("Cannot create pseudo-terminal: " + reason);
+    }
+
+    char name[128];
+    if (::ptsname_r(master_fd_, name, sizeof(name)) != 0) {
+        std::string reason = std::strerror(errno);
+        stop();
+        throw TransportException("Cannot name pseudo-terminal: " + reason);
+    }
+    device_path_ = name;
+
+    // Raw mode on the slave side, before the transport opens it
+    slave_fd_ = ::open(name, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (slave_fd_ < 0) {
+        std::string reason = std::strerror(errno);
+        stop();
+        throw TransportException("Cannot open " + device_path_ + ": " + reason);
+    }
+    ModbusRtuTransport::configureLine(slave_fd_, baud_rate_, SerialParity::NONE);
+    ::fcntl(master_fd_, F_SETFL, ::fcntl(master_fd_, F_GETFL, 0) | O_NONBLOCK);
+
+    running_ = true;
+    thread_ = std::thread(&ModbusRtuSimSlave::serve, this);
+
+    LOG_INFO("Modbus RTU Inverter SIM on {} ({} baud)", device_path_, baud_rate_);
+}
+
+void ModbusRtuSimSlave::stop() {
+    bool was_running = running_.exchange(false);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    if (slave_fd_ >= 0) {
+        ::close(slave_fd_);
+        slave_fd_ = -1;
+    }
+    if (master_fd_ >= 0) {
+        ::close(master_fd_);
+        master_fd_ = -1;
+    }
+
+    if (was_running) {
+        LOG_INFO("Modbus RTU Inverter SIM stopped");
+    }
+}
+
+void ModbusRtuSimSlave::serve() {
+    while (running_) {
+        std::vector<uint8_t> request;
+        try {
+            request = ModbusRtuTransport::receiveFrame(master_fd_, timing_, kStopPollInterval,
+                                                       &ModbusRtuTransport::expectedRequestLength);
+        } catch (const TransportException& e) {
+            LOG_DEBUG("Modbus RTU Inverter SIM read failed: {}", e.what());
+            std::this_thread::sleep_for(kStopPollInterval);
+            continue;
+        }
+        if (request.empty()) {
+            continue;
+        }
+
+        auto request_end = std::chrono::steady_clock::now();
+        std::chrono::microseconds delay = simulator_->sampleLatency();
+        auto response = simulator_->processFrame(request);
+        if (!response) {
+            continue;
+        }
+
+        // A slave may not answer inside the request's inter-frame gap
+        std::this_thread::sleep_until(request_end + std::max(delay, timing_.inter_frame));
+
+        size_t offset = 0;
+        while (offset < response->size()) {
+            ssize_t written = ::write(master_fd_, response->data() + offset, response->size() - offset);
+            if (written < 0 && (errno == EINTR || errno == EAGAIN)) {
+                continue;
+            }
+            if (written <= 0) {
+                break;
+            }
+            offset += static_cast<size_t>(written);
+        }
+    }
+}
+
+} // namespace ecoWatt
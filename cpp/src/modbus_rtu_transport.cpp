@@ -0,0 +1,288 @@
+/**
+ * @file modbus_rtu_transport.cpp
+ * @brief Implementation of the Modbus RTU serial transport
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "modbus_rtu_transport.hpp"
+#include "logger.hpp"
+#include "tracing.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+
+namespace ecoWatt {
+
+namespace {
+
+constexpr size_t kMaxRtuFrameSize = 256;
+constexpr uint32_t kBitsPerCharacter = 11; // Start, 8 data, parity (or 2nd stop), stop
+
+speed_t toSpeed(uint32_t baud_rate) {
+    switch (baud_rate) {
+        case 1200: return B1200;
+        case 2400: return B2400;
+        case 4800: return B4800;
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        default:
+            throw ConfigException("Unsupported serial baud rate: " + std::to_string(baud_rate));
+    }
+}
+
+/**
+ * @brief Wait until @p fd is readable or @p timeout passes
+ * @return True if data (or EOF) is ready
+ */
+bool waitReadable(int fd, std::chrono::microseconds timeout) {
+    pollfd waiter{fd, POLLIN, 0};
+    timespec deadline{static_cast<time_t>(timeout.count() / 1000000),
+                      static_cast<long>((timeout.count() % 1000000) * 1000)};
+
+    int ready;
+    do {
+        ready = ::ppoll(&waiter, 1, &deadline, nullptr);
+    } while (ready < 0 && errno == EINTR);
+
+    if (ready < 0) {
+        throw TransportException(std::string("poll failed: ") + std::strerror(errno));
+    }
+    return ready > 0;
+}
+
+} // namespace
+
+ModbusRtuTransport::ModbusRtuTransport(std::string device, uint32_t baud_rate,
+                                       SerialParity parity, Duration timeout)
+    : device_(std::move(device)),
+      baud_rate_(baud_rate),
+      parity_(parity),
+      timeout_(timeout),
+      timing_(timingForBaud(baud_rate)) {
+    
+    toSpeed(baud_rate_); // Reject unsupported rates at configuration time
+}
+
+ModbusRtuTransport::~ModbusRtuTransport() {
+    close();
+}
+
+std::vector<uint8_t> ModbusRtuTransport::transact(const std::vector<uint8_t>& request,
+                                                  TransportOperation /*operation*/) {
+    TRACE_SPAN("ModbusRtuTransport::transact", "transport");
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (fd_ < 0) {
+        open();
+    }
+    
+    // Keep the mandatory t3.5 gap after the previous frame
+    std::this_thread::sleep_until(last_activity_ + timing_.inter_frame);
+    
+    try {
+        // Late replies to an earlier timed-out request must not be taken
+        // for this one
+        ::tcflush(fd_, TCIFLUSH);
+        
+        const uint8_t* data = request.data();
+        size_t remaining = request.size();
+        while (remaining > 0) {
+            ssize_t written = ::write(fd_, data, remaining);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written < 0 && errno == EAGAIN) {
+                pollfd waiter{fd_, POLLOUT, 0};
+                ::poll(&waiter, 1, static_cast<int>(timeout_.count()));
+                continue;
+            }
+            if (written <= 0) {
+                throw TransportException("Write to " + device_ + " failed: " + std::strerror(errno));
+            }
+            data += written;
+            remaining -= static_cast<size_t>(written);
+        }
+        ::tcdrain(fd_);
+        
+        std::vector<uint8_t> response = receiveFrame(
+            fd_, timing_, std::chrono::duration_cast<std::chrono::microseconds>(timeout_),
+            &ModbusRtuTransport::expectedResponseLength);
+        last_activity_ = std::chrono::steady_clock::now();
+        
+        if (response.empty()) {
+            throw TimeoutException("No response on " + device_ + " within " +
+                                   std::to_string(timeout_.count()) + "ms");
+        }
+        return response;
+        
+    } catch (const TransportException&) {
+        close(); // Reopen on the next request
+        throw;
+    }
+}
+
+std::string ModbusRtuTransport::describe() const {
+    return "modbus-rtu://" + device_ + "@" + std::to_string(baud_rate_) + "/" + to_string(parity_);
+}
+
+RtuTiming ModbusRtuTransport::timingForBaud(uint32_t baud_rate) {
+    RtuTiming timing;
+    timing.character = std::chrono::microseconds(
+        (kBitsPerCharacter * 1000000ULL + baud_rate - 1) / baud_rate);
+    
+    if (baud_rate > 19200) {
+        // Fixed values recommended by the Modbus serial line specification
+        timing.inter_char = std::chrono::microseconds(750);
+        timing.inter_frame = std::chrono::microseconds(1750);
+    } else {
+        timing.inter_char = timing.character * 3 / 2;
+        timing.inter_frame = timing.character * 7 / 2;
+    }
+    return timing;
+}
+
+size_t ModbusRtuTransport::expectedResponseLength(const std::vector<uint8_t>& partial) {
+    if (partial.size() < 2) {
+        return 0;
+    }
+    
+    FunctionCode function = partial[1];
+    if (function & 0x80) {
+        return 5; // Address, function, exception code, CRC
+    }
+    
+    switch (static_cast<ModbusFunction>(function)) {
+        case ModbusFunction::READ_HOLDING_REGISTERS:
+        case ModbusFunction::READ_WRITE_MULTIPLE_REGISTERS:
+            return partial.size() < 3 ? 0 : 5 + partial[2];
+        case ModbusFunction::WRITE_SINGLE_REGISTER:
+        case ModbusFunction::WRITE_MULTIPLE_REGISTERS:
+            return 8;
+        default:
+            return 0; // Unknown: fall back to the silent interval
+    }
+}
+
+size_t ModbusRtuTransport::expectedRequestLength(const std::vector<uint8_t>& partial) {
+    if (partial.size() < 2) {
+        return 0;
+    }
+    
+    switch (static_cast<ModbusFunction>(partial[1])) {
+        case ModbusFunction::READ_HOLDING_REGISTERS:
+        case ModbusFunction::WRITE_SINGLE_REGISTER:
+            return 8;
+        case ModbusFunction::WRITE_MULTIPLE_REGISTERS:
+            return partial.size() < 7 ? 0 : 9 + partial[6];
+        case ModbusFunction::READ_WRITE_MULTIPLE_REGISTERS:
+            return partial.size() < 11 ? 0 : 13 + partial[10];
+        default:
+            return 0;
+    }
+}
+
+std::vector<uint8_t> ModbusRtuTransport::receiveFrame(int fd, const RtuTiming& timing,
+                                                      std::chrono::microseconds first_byte_timeout,
+                                                      size_t (*expected_length)(const std::vector<uint8_t>&)) {
+    std::vector<uint8_t> frame;
+    if (!waitReadable(fd, first_byte_timeout)) {
+        return frame;
+    }
+    
+    uint8_t buffer[kMaxRtuFrameSize];
+    while (true) {
+        ssize_t received = ::read(fd, buffer, sizeof(buffer));
+        if (received < 0 && (errno == EINTR || errno == EAGAIN)) {
+            received = 0;
+        } else if (received < 0) {
+            throw TransportException(std::string("Serial read failed: ") + std::strerror(errno));
+        } else if (received == 0) {
+            throw TransportException("Serial line closed");
+        }
+        
+        frame.insert(frame.end(), buffer, buffer + received);
+        if (frame.size() > kMaxRtuFrameSize) {
+            throw TransportException("Serial frame exceeds " + std::to_string(kMaxRtuFrameSize) + " bytes");
+        }
+        
+        // Complete by length: no need to wait out the silent interval
+        size_t expected = expected_length ? expected_length(frame) : 0;
+        if (expected != 0 && frame.size() >= expected) {
+            return frame;
+        }
+        
+        // t3.5 of silence ends the frame
+        if (!waitReadable(fd, timing.inter_frame)) {
+            return frame;
+        }
+    }
+}
+
+void ModbusRtuTransport::configureLine(int fd, uint32_t baud_rate, SerialParity parity) {
+    termios options{};
+    if (::tcgetattr(fd, &options) != 0) {
+        throw TransportException(std::string("tcgetattr failed: ") + std::strerror(errno));
+    }
+    
+    ::cfmakeraw(&options);
+    speed_t speed = toSpeed(baud_rate);
+    ::cfsetispeed(&options, speed);
+    ::cfsetospeed(&options, speed);
+    
+    options.c_cflag |= CLOCAL | CREAD;
+    options.c_cflag &= ~(PARENB | PARODD | CSTOPB);
+    switch (parity) {
+        case SerialParity::EVEN:
+            options.c_cflag |= PARENB;
+            break;
+        case SerialParity::ODD:
+            options.c_cflag |= PARENB | PARODD;
+            break;
+        case SerialParity::NONE:
+            options.c_cflag |= CSTOPB; // Keeps the 11-bit character
+            break;
+    }
+    
+    // Non-blocking reads; frame boundaries come from ppoll() deadlines
+    options.c_cc[VMIN] = 0;
+    options.c_cc[VTIME] = 0;
+    
+    if (::tcsetattr(fd, TCSANOW, &options) != 0) {
+        throw TransportException(std::string("tcsetattr failed: ") + std::strerror(errno));
+    }
+}
+
+void ModbusRtuTransport::open() {
+    fd_ = ::open(device_.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd_ < 0) {
+        throw TransportException("Cannot open " + device_ + ": " + std::strerror(errno));
+    }
+    
+    try {
+        configureLine(fd_, baud_rate_, parity_);
+    } catch (...) {
+        close();
+        throw;
+    }
+    
+    last_activity_ = std::chrono::steady_clock::now();
+    LOG_INFO("Opened {}", describe());
+}
+
+void ModbusRtuTransport::close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+} // namespace ecoWatt
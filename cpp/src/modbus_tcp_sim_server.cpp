@@ -0,0 +1,204 @@
+/**
+ * @file modbus_tcp_sim_server.cpp
+ * @brief Implementation of the Modbus TCP front end for the local Inverter SIM
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "modbus_tcp_sim_server.hpp"
+#include "modbus_tcp_transport.hpp"
+#include "exceptions.hpp"
+#include "logger.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ecoWatt {
+
+namespace {
+
+bool recvAll(int fd, uint8_t* data, size_t length) {
+    while (length > 0) {
+        ssize_t received = ::recv(fd, data, length, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        data += received;
+        length -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+} // namespace
+
+ModbusTcpSimServer::Session::~Session() {
+    ::close(fd);
+}
+
+ModbusTcpSimServer::ModbusTcpSimServer(std::shared_ptr<InverterSimulator> simulator,
+                                       uint16_t port, const std::string& host)
+    : simulator_(std::move(simulator)),
+      host_(host),
+      port_(port) {
+
+    if (!simulator_) {
+        throw ValidationException("ModbusTcpSimServer requires a simulator");
+    }
+}
+
+ModbusTcpSimServer::~ModbusTcpSimServer() {
+    stop();
+}
+
+void ModbusTcpSimServer::start() {
+    if (running_) {
+        return;
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port_);
+    if (::inet_pton(AF_INET, host_.c_str(), &address.sin_addr) != 1) {
+        throw TransportException("Invalid listen address: " + host_);
+    }
+
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        throw TransportException(std::string("Cannot create socket: ") + std::strerror(errno));
+    }
+
+    int reuse = 1;
+    ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listen_fd_, 16) != 0) {
+        std::string reason = std::strerror(errno);
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        throw TransportException("Cannot listen on " + host_ + ":" + std::to_string(port_) + ": " + reason);
+    }
+
+    socklen_t length = sizeof(address);
+    ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+
+    running_ = true;
+    accept_thread_ = std::thread(&ModbusTcpSimServer::acceptLoop, this);
+
+    LOG_INFO("Modbus TCP Inverter SIM listening on {}:{}", host_, port_);
+}
+
+void ModbusTcpSimServer::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    ::shutdown(listen_fd_, SHUT_RDWR);
+    accept_thread_.join();
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+
+    std::vector<std::pair<std::shared_ptr<Session>, std::thread>> sessions;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        sessions.swap(sessions_);
+    }
+    for (auto& [session, thread] : sessions) {
+        ::shutdown(session->fd, SHUT_RDWR);
+        thread.join();
+    }
+
+    LOG_INFO("Modbus TCP Inverter SIM stopped");
+}
+
+void ModbusTcpSimServer::acceptLoop() {
+    while (running_) {
+        int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break; // Listener shut down
+        }
+
+        int nodelay = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+        auto session = std::make_shared<Session>(fd);
+        std::lock_guard<std::mutex> lock(sessions_mutex_);
+        if (!running_) {
+            break;
+        }
+        sessions_.emplace_back(session, std::thread(&ModbusTcpSimServer::serve, this, session));
+    }
+}
+
+void ModbusTcpSimServer::serve(std::shared_ptr<Session> session) {
+    std::vector<uint8_t> pdu;
+
+    while (true) {
+        uint8_t header[ModbusTcpTransport::kMbapHeaderSize];
+        if (!recvAll(session->fd, header, sizeof(header))) {
+            break;
+        }
+
+        uint16_t transaction_id = (header[0] << 8) | header[1];
+        uint16_t protocol_id = (header[2] << 8) | header[3];
+        uint16_t length = (header[4] << 8) | header[5];
+
+        if (protocol_id != 0 || length < 2 || length > 254) {
+            LOG_DEBUG("Modbus TCP Inverter SIM closing connection: invalid MBAP header");
+            break;
+        }
+
+        pdu.resize(length - 1);
+        if (!recvAll(session->fd, pdu.data(), pdu.size())) {
+            break;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(session->mutex);
+            ++session->active_requests;
+        }
+
+        // Requests complete independently so pipelined clients overlap latency
+        std::thread(&ModbusTcpSimServer::respond, this, session, transaction_id,
+                    ModbusTcpTransport::toRtuFrame(header[6], pdu.data(), pdu.size())).detach();
+    }
+
+    ::shutdown(session->fd, SHUT_RDWR);
+
+    std::unique_lock<std::mutex> lock(session->mutex);
+    session->idle.wait(lock, [&] { return session->active_requests == 0; });
+}
+
+void ModbusTcpSimServer::respond(const std::shared_ptr<Session>& session, uint16_t transaction_id,
+                                 std::vector<uint8_t> request) {
+    std::chrono::microseconds delay = simulator_->sampleLatency();
+    auto response = simulator_->processFrame(request);
+
+    if (delay.count() > 0) {
+        std::this_thread::sleep_for(delay);
+    }
+
+    if (response) {
+        std::vector<uint8_t> adu = ModbusTcpTransport::encodeAdu(transaction_id, *response);
+        std::lock_guard<std::mutex> lock(session->write_mutex);
+        ::send(session->fd, adu.data(), adu.size(), MSG_NOSIGNAL);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        --session->active_requests;
+    }
+    session->idle.notify_all();
+}
+
+} // namespace ecoWatt
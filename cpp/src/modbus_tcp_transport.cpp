@@ -0,0 +1,316 @@
+/**
+ * @file modbus_tcp_transport.cpp
+ * @brief Implementation of the native Modbus TCP transport
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "modbus_tcp_transport.hpp"
+#include "modbus_frame.hpp"
+#include "logger.hpp"
+#include "tracing.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ecoWatt {
+
+namespace {
+
+bool sendAll(int fd, const uint8_t* data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = ::send(fd, data, length, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        length -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool recvAll(int fd, uint8_t* data, size_t length) {
+    while (length > 0) {
+        ssize_t received = ::recv(fd, data, length, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        data += received;
+        length -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+} // namespace
+
+ModbusTcpTransport::Connection::~Connection() {
+    ::close(fd);
+}
+
+void ModbusTcpTransport::Connection::shutdown() {
+    ::shutdown(fd, SHUT_RDWR);
+}
+
+ModbusTcpTransport::ModbusTcpTransport(std::string host, uint16_t port, Duration timeout,
+                                       size_t max_in_flight)
+    : host_(std::move(host)),
+      port_(port),
+      timeout_(timeout),
+      max_in_flight_(std::max<size_t>(max_in_flight, 1)) {
+}
+
+ModbusTcpTransport::~ModbusTcpTransport() {
+    std::lock_guard<std::mutex> connect_lock(connect_mutex_);
+    
+    std::shared_ptr<Connection> current;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current = connection_;
+    }
+    if (current) {
+        current->shutdown(); // Wakes the reader, which fails anything outstanding
+    }
+    if (reader_.joinable()) {
+        reader_.join();
+    }
+}
+
+std::vector<uint8_t> ModbusTcpTransport::transact(const std::vector<uint8_t>& request,
+                                                  TransportOperation /*operation*/) {
+    TRACE_SPAN("ModbusTcpTransport::transact", "transport");
+    if (request.size() < 4) {
+        throw ModbusException("Request frame too short for Modbus TCP");
+    }
+    
+    std::shared_ptr<Connection> current = connection();
+    
+    uint16_t transaction_id;
+    std::future<std::vector<uint8_t>> response;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (connection_ != current) {
+            throw TransportException("Connection to " + describe() + " lost");
+        }
+        
+        do {
+            transaction_id = next_transaction_id_++;
+        } while (pending_.count(transaction_id) != 0);
+        
+        response = pending_[transaction_id].get_future();
+    }
+    
+    std::vector<uint8_t> adu = encodeAdu(transaction_id, request);
+    bool sent;
+    {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        sent = sendAll(current->fd, adu.data(), adu.size());
+    }
+    
+    if (!sent) {
+        std::string reason = std::strerror(errno);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.erase(transaction_id);
+        }
+        current->shutdown(); // Let the reader tear the connection down
+        throw TransportException("Send to " + describe() + " failed: " + reason);
+    }
+    
+    if (response.wait_for(timeout_) != std::future_status::ready) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.erase(transaction_id) != 0) {
+            // A late response for this ID is discarded by the reader
+            throw TimeoutException("No response from " + describe() + " within " +
+                                   std::to_string(timeout_.count()) + "ms");
+        }
+    }
+    
+    return response.get();
+}
+
+std::string ModbusTcpTransport::describe() const {
+    return "modbus-tcp://" + host_ + ":" + std::to_string(port_);
+}
+
+bool ModbusTcpTransport::isConnected() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return connection_ != nullptr;
+}
+
+std::vector<uint8_t> ModbusTcpTransport::encodeAdu(uint16_t transaction_id,
+                                                   const std::vector<uint8_t>& rtu_frame) {
+    // Unit identifier + PDU; the RTU CRC has no place in an ADU
+    const size_t length = rtu_frame.size() - 2;
+    
+    std::vector<uint8_t> adu;
+    adu.reserve(kMbapHeaderSize - 1 + length);
+    adu.push_back(static_cast<uint8_t>(transaction_id >> 8));
+    adu.push_back(static_cast<uint8_t>(transaction_id & 0xFF));
+    adu.push_back(0x00); // Protocol identifier (Modbus)
+    adu.push_back(0x00);
+    adu.push_back(static_cast<uint8_t>(length >> 8));
+    adu.push_back(static_cast<uint8_t>(length & 0xFF));
+    adu.insert(adu.end(), rtu_frame.begin(), rtu_frame.end() - 2);
+    return adu;
+}
+
+std::vector<uint8_t> ModbusTcpTransport::toRtuFrame(uint8_t unit_id, const uint8_t* pdu, size_t pdu_length) {
+    std::vector<uint8_t> frame;
+    frame.reserve(pdu_length + 3);
+    frame.push_back(unit_id);
+    frame.insert(frame.end(), pdu, pdu + pdu_length);
+    
+    uint16_t crc = ModbusFrame::calculateCRC(frame);
+    frame.push_back(crc & 0xFF);
+    frame.push_back((crc >> 8) & 0xFF);
+    return frame;
+}
+
+std::shared_ptr<ModbusTcpTransport::Connection> ModbusTcpTransport::connection() {
+    std::lock_guard<std::mutex> connect_lock(connect_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (connection_) {
+            return connection_;
+        }
+    }
+    
+    // The previous reader cleared connection_ on its way out
+    if (reader_.joinable()) {
+        reader_.join();
+    }
+    
+    std::shared_ptr<Connection> fresh = connect();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        connection_ = fresh;
+    }
+    reader_ = std::thread(&ModbusTcpTransport::readerLoop, this, fresh);
+    
+    connects_.fetch_add(1, std::memory_order_relaxed);
+    LOG_INFO("Connected to {}", describe());
+    return fresh;
+}
+
+std::shared_ptr<ModbusTcpTransport::Connection> ModbusTcpTransport::connect() {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    
+    addrinfo* addresses = nullptr;
+    int rc = ::getaddrinfo(host_.c_str(), std::to_string(port_).c_str(), &hints, &addresses);
+    if (rc != 0) {
+        throw TransportException("Cannot resolve " + host_ + ": " + ::gai_strerror(rc));
+    }
+    std::unique_ptr<addrinfo, decltype(&::freeaddrinfo)> guard(addresses, &::freeaddrinfo);
+    
+    std::string last_error = "no addresses";
+    for (addrinfo* address = addresses; address != nullptr; address = address->ai_next) {
+        int fd = ::socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+        if (fd < 0) {
+            last_error = std::strerror(errno);
+            continue;
+        }
+        auto candidate = std::make_shared<Connection>(fd);
+        
+        // Non-blocking connect so the configured timeout applies
+        int flags = ::fcntl(fd, F_GETFL, 0);
+        ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        
+        if (::connect(fd, address->ai_addr, address->ai_addrlen) != 0) {
+            if (errno != EINPROGRESS) {
+                last_error = std::strerror(errno);
+                continue;
+            }
+            
+            pollfd waiter{fd, POLLOUT, 0};
+            int ready = ::poll(&waiter, 1, static_cast<int>(timeout_.count()));
+            if (ready == 0) {
+                throw TimeoutException("Connect to " + describe() + " timed out");
+            }
+            
+            int error = 0;
+            socklen_t error_length = sizeof(error);
+            ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &error_length);
+            if (ready < 0 || error != 0) {
+                last_error = std::strerror(ready < 0 ? errno : error);
+                continue;
+            }
+        }
+        
+        ::fcntl(fd, F_SETFL, flags);
+        
+        // Requests are small and latency-bound
+        int nodelay = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+        return candidate;
+    }
+    
+    throw TransportException("Cannot connect to " + describe() + ": " + last_error);
+}
+
+void ModbusTcpTransport::readerLoop(std::shared_ptr<Connection> current) {
+    std::string reason = "connection closed by peer";
+    std::vector<uint8_t> pdu;
+    
+    while (true) {
+        uint8_t header[kMbapHeaderSize];
+        if (!recvAll(current->fd, header, sizeof(header))) {
+            break;
+        }
+        
+        uint16_t transaction_id = (header[0] << 8) | header[1];
+        uint16_t protocol_id = (header[2] << 8) | header[3];
+        uint16_t length = (header[4] << 8) | header[5];
+        
+        if (protocol_id != 0 || length < 2 || length > 254) {
+            reason = "invalid MBAP header";
+            break;
+        }
+        
+        pdu.resize(length - 1);
+        if (!recvAll(current->fd, pdu.data(), pdu.size())) {
+            break;
+        }
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pending_.find(transaction_id);
+        if (it == pending_.end()) {
+            LOG_DEBUG("Discarding response for unknown transaction {}", transaction_id);
+            continue;
+        }
+        it->second.set_value(toRtuFrame(header[6], pdu.data(), pdu.size()));
+        pending_.erase(it);
+    }
+    
+    // Detach the dead connection and fail everything still waiting on it
+    std::unordered_map<uint16_t, std::promise<std::vector<uint8_t>>> orphaned;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (connection_ == current) {
+            connection_.reset();
+        }
+        orphaned.swap(pending_);
+    }
+    
+    LOG_WARN("Connection to {} closed: {}", describe(), reason);
+    for (auto& [transaction_id, promise] : orphaned) {
+        promise.set_exception(std::make_exception_ptr(
+            TransportException("Connection to " + describe() + " closed: " + reason)));
+    }
+}
+
+} // namespace ecoWatt
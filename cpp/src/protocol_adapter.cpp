@@ -7,101 +7,231 @@
 
 #include "protocol_adapter.hpp"
 #include "logger.hpp"
-#include <nlohmann/json.hpp>
+#include "tracing.hpp"
+#include <algorithm>
 #include <thread>
 #include <chrono>
 
 namespace ecoWatt {
 
 ProtocolAdapter::ProtocolAdapter(const ConfigManager& config)
+    : ProtocolAdapter(config, createTransport(config)) {
+}
+
+ProtocolAdapter::ProtocolAdapter(const ConfigManager& config, UniquePtr<Transport> transport)
     : modbus_config_(config.getModbusConfig()),
-      api_config_(config.getApiConfig()) {
+      transport_(std::move(transport)) {
     
-    // Initialize HTTP client
-    http_client_ = std::make_unique<HttpClient>(api_config_.base_url, 
-                                               modbus_config_.timeout.count());
+    if (!transport_) {
+        throw ConfigException("Protocol adapter requires a transport");
+    }
     
-    // Set default headers
-    std::map<std::string, std::string> headers = {
-        {"Authorization", api_config_.api_key},
-        {"Content-Type", api_config_.content_type},
-        {"Accept", api_config_.accept}
-    };
-    http_client_->setDefaultHeaders(headers);
+    // Let as many transactions onto the link as the transport can pipeline
+    transaction_queue_.setCapacity(transport_->maxInFlight());
     
-    LOG_INFO("Protocol adapter initialized with slave address {}", modbus_config_.slave_address);
+    LOG_INFO("Protocol adapter initialized with slave address {} via {}",
+             modbus_config_.slave_address, transport_->describe());
 }
 
 std::vector<RegisterValue> ProtocolAdapter::readRegisters(RegisterAddress start_address,
-                                                         uint16_t num_registers) {
+                                                         uint16_t num_registers,
+                                                         TransactionLane lane) {
+    TRACE_SPAN("ProtocolAdapter::readRegisters", "protocol");
     if (num_registers == 0 || num_registers > 125) {
         throw ModbusException("Invalid number of registers: " + std::to_string(num_registers));
     }
     
+    return read_coalescer_.read(modbus_config_.slave_address, start_address, num_registers, lane,
+                                [this, lane](RegisterAddress start, uint16_t count) {
+                                    return performRead(start, count, lane);
+                                });
+}
+
+std::vector<RegisterValue> ProtocolAdapter::performRead(RegisterAddress start_address,
+                                                       uint16_t num_registers,
+                                                       TransactionLane lane) {
     LOG_DEBUG("Reading {} registers starting from address {}", num_registers, start_address);
     
-    auto start_time = std::chrono::high_resolution_clock::now();
-    request_start_time_ = start_time;
+    auto start_time = std::chrono::steady_clock::now();
     
     try {
         // Create Modbus frame
-        std::string request_frame = ModbusFrame::createReadFrame(
+        std::vector<uint8_t> request_frame = ModbusFrame::createReadFrameBytes(
             modbus_config_.slave_address, start_address, num_registers);
         
         // Send request
-        std::string response_frame = sendRequest(api_config_.read_endpoint, request_frame);
-        
-        // Parse response
-        ModbusResponse response = ModbusFrame::parseResponse(response_frame);
-        
-        if (response.is_error) {
-            std::string error_msg = ModbusFrame::getErrorMessage(response.error_code);
-            throw ModbusException(response.error_code, error_msg);
-        }
-        
-        // Extract register values
-        std::vector<RegisterValue> values = parseRegisterValues(response.data);
+        std::vector<uint8_t> response_frame = sendRequest(request_frame, TransportOperation::READ, lane);
         
-        if (values.size() != num_registers) {
-            throw ModbusException("Register count mismatch: expected " + 
-                                std::to_string(num_registers) + ", got " + 
-                                std::to_string(values.size()));
-        }
+        // Parse response and extract register values
+        std::vector<RegisterValue> values = decodeReadResponse(response_frame, num_registers);
         
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<Duration>(end_time - start_time);
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
         
-        updateStats(true, duration);
+        updateStats(OperationType::READ, true, duration);
         
-        LOG_DEBUG("Successfully read {} registers in {}ms", values.size(), duration.count());
+        LOG_DEBUG("Successfully read {} registers in {}us", values.size(), duration.count());
         return values;
         
     } catch (const ModbusException&) {
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<Duration>(end_time - start_time);
-        updateStats(false, duration);
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        updateStats(OperationType::READ, false, duration);
         throw;
     } catch (const std::exception& e) {
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<Duration>(end_time - start_time);
-        updateStats(false, duration);
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        updateStats(OperationType::READ, false, duration);
         throw ModbusException("Read operation failed: " + std::string(e.what()));
     }
 }
 
-bool ProtocolAdapter::writeRegister(RegisterAddress register_address, RegisterValue value) {
+std::vector<ProtocolAdapter::BlockRead> ProtocolAdapter::readRegisterBlocks(
+    const std::vector<std::pair<RegisterAddress, uint16_t>>& blocks, TransactionLane lane) {
+    
+    std::vector<BlockRead> results(blocks.size());
+    std::vector<size_t> pending;
+    pending.reserve(blocks.size());
+    
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        results[i].start_address = blocks[i].first;
+        results[i].num_registers = blocks[i].second;
+        if (blocks[i].second == 0 || blocks[i].second > 125) {
+            results[i].error = "Invalid number of registers: " + std::to_string(blocks[i].second);
+        } else {
+            pending.push_back(i);
+        }
+    }
+    
+    if (!transport_->supportsBatch() || pending.size() < 2) {
+        for (size_t i : pending) {
+            try {
+                results[i].values = readRegisters(results[i].start_address, results[i].num_registers, lane);
+            } catch (const std::exception& e) {
+                results[i].error = e.what();
+            }
+        }
+        return results;
+    }
+    
+    // Register every block first: blocks covered by a read already in flight
+    // wait for it, and writes retire the batched reads like any other
+    std::vector<std::optional<ReadCoalescer::Claim>> claims(blocks.size());
+    std::vector<size_t> leading;
+    for (size_t i : pending) {
+        claims[i].emplace(read_coalescer_.claim(modbus_config_.slave_address, results[i].start_address,
+                                                results[i].num_registers, lane));
+        if (claims[i]->leading()) {
+            leading.push_back(i);
+        }
+    }
+    
+    const size_t batch_size = std::max<size_t>(transport_->maxBatchSize(), 1);
+    for (size_t offset = 0; offset < leading.size(); offset += batch_size) {
+        std::vector<size_t> chunk(leading.begin() + offset,
+                                  leading.begin() + std::min(offset + batch_size, leading.size()));
+        performBatchRead(results, claims, chunk, lane);
+    }
+    
+    // Only after our own leads are published, so two batches never wait on each other
+    for (size_t i : pending) {
+        if (claims[i]->leading()) {
+            continue;
+        }
+        try {
+            results[i].values = claims[i]->wait();
+        } catch (const std::exception& e) {
+            results[i].error = e.what();
+        }
+    }
+    
+    return results;
+}
+
+void ProtocolAdapter::performBatchRead(std::vector<BlockRead>& results,
+                                       std::vector<std::optional<ReadCoalescer::Claim>>& claims,
+                                       const std::vector<size_t>& indices, TransactionLane lane) {
+    LOG_DEBUG("Reading {} register blocks in one batch", indices.size());
+    
+    auto start_time = std::chrono::steady_clock::now();
+    
+    std::vector<std::vector<uint8_t>> requests;
+    requests.reserve(indices.size());
+    for (size_t i : indices) {
+        requests.push_back(ModbusFrame::createReadFrameBytes(
+            modbus_config_.slave_address, results[i].start_address, results[i].num_registers));
+    }
+    
+    std::vector<std::vector<uint8_t>> responses;
+    try {
+        responses = withRetries(lane, [&] {
+            return transport_->transactBatch(requests, TransportOperation::READ);
+        });
+    } catch (const std::exception& e) {
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start_time);
+        for (size_t i : indices) {
+            results[i].error = e.what();
+            claims[i]->fail(std::current_exception());
+            updateStats(OperationType::READ, false, duration);
+        }
+        return;
+    }
+    
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_time);
+    batch_round_trips_.fetch_add(1, std::memory_order_relaxed);
+    batched_frames_.fetch_add(indices.size(), std::memory_order_relaxed);
+    
+    // Each frame succeeds or fails for its own caller
+    for (size_t k = 0; k < indices.size(); ++k) {
+        BlockRead& result = results[indices[k]];
+        ReadCoalescer::Claim& claim = *claims[indices[k]];
+        try {
+            result.values = decodeReadResponse(responses[k], result.num_registers);
+            claim.complete(result.values);
+            updateStats(OperationType::READ, true, duration);
+        } catch (const std::exception& e) {
+            result.error = e.what();
+            claim.fail(std::current_exception());
+            updateStats(OperationType::READ, false, duration);
+        }
+    }
+}
+
+std::vector<RegisterValue> ProtocolAdapter::decodeReadResponse(const std::vector<uint8_t>& response_frame,
+                                                              uint16_t num_registers) {
+    ModbusResponse response = ModbusFrame::parseResponse(response_frame);
+    
+    if (response.is_error) {
+        std::string error_msg = ModbusFrame::getErrorMessage(response.error_code);
+        throw ModbusException(response.error_code, error_msg);
+    }
+    
+    std::vector<RegisterValue> values = parseRegisterValues(response.data);
+    
+    if (values.size() != num_registers) {
+        throw ModbusException("Register count mismatch: expected " + 
+                            std::to_string(num_registers) + ", got " + 
+                            std::to_string(values.size()));
+    }
+    
+    return values;
+}
+
+bool ProtocolAdapter::writeRegister(RegisterAddress register_address, RegisterValue value,
+                                    TransactionLane lane) {
     LOG_DEBUG("Writing value {} to register {}", value, register_address);
     
-    auto start_time = std::chrono::high_resolution_clock::now();
-    request_start_time_ = start_time;
+    auto start_time = std::chrono::steady_clock::now();
     
     try {
         // Create Modbus frame
-        std::string request_frame = ModbusFrame::createWriteFrame(
+        std::vector<uint8_t> request_frame = ModbusFrame::createWriteFrameBytes(
             modbus_config_.slave_address, register_address, value);
         
         // Send request
-        std::string response_frame = sendRequest(api_config_.write_endpoint, request_frame);
+        std::vector<uint8_t> response_frame = sendWrite(request_frame, register_address, 1, lane);
         
         // Parse response
         ModbusResponse response = ModbusFrame::parseResponse(response_frame);
@@ -127,28 +257,167 @@ bool ProtocolAdapter::writeRegister(RegisterAddress register_address, RegisterVa
             }
         }
         
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<Duration>(end_time - start_time);
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
         
-        updateStats(true, duration);
+        updateStats(OperationType::WRITE, true, duration);
         
-        LOG_DEBUG("Successfully wrote value {} to register {} in {}ms", 
+        LOG_DEBUG("Successfully wrote value {} to register {} in {}us", 
                  value, register_address, duration.count());
         return true;
         
     } catch (const ModbusException&) {
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<Duration>(end_time - start_time);
-        updateStats(false, duration);
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        updateStats(OperationType::WRITE, false, duration);
         throw;
     } catch (const std::exception& e) {
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<Duration>(end_time - start_time);
-        updateStats(false, duration);
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        updateStats(OperationType::WRITE, false, duration);
         throw ModbusException("Write operation failed: " + std::string(e.what()));
     }
 }
 
+bool ProtocolAdapter::writeRegisters(RegisterAddress start_address, const std::vector<RegisterValue>& values,
+                                     TransactionLane lane) {
+    if (values.empty() || values.size() > 123 ||
+        static_cast<uint32_t>(start_address) + values.size() > 0x10000) {
+        throw ModbusException("Invalid number of registers to write: " + std::to_string(values.size()));
+    }
+    
+    LOG_DEBUG("Writing {} registers starting from address {}", values.size(), start_address);
+    
+    auto start_time = std::chrono::steady_clock::now();
+    
+    try {
+        // Create Modbus frame
+        std::vector<uint8_t> request_frame = ModbusFrame::createWriteMultipleFrameBytes(
+            modbus_config_.slave_address, start_address, values);
+        
+        // Send request
+        std::vector<uint8_t> response_frame = sendWrite(request_frame, start_address,
+                                                        static_cast<uint16_t>(values.size()), lane);
+        
+        // Parse response
+        ModbusResponse response = ModbusFrame::parseResponse(response_frame);
+        
+        if (response.is_error) {
+            std::string error_msg = ModbusFrame::getErrorMessage(response.error_code);
+            throw ModbusException(response.error_code, error_msg);
+        }
+        
+        // Verify write response (echoes start address and quantity)
+        if (response.function_code != static_cast<FunctionCode>(ModbusFunction::WRITE_MULTIPLE_REGISTERS) ||
+            response.data.size() < 4) {
+            throw ModbusException("Unexpected write response: function 0x" +
+                                  ModbusFrame::bytesToHex({response.function_code}) + " with " +
+                                  std::to_string(response.data.size()) + " data bytes");
+        }
+        uint16_t written_start = (response.data[0] << 8) | response.data[1];
+        uint16_t written_count = (response.data[2] << 8) | response.data[3];
+        
+        if (written_start != start_address || written_count != values.size()) {
+            throw ModbusException("Write verification failed: expected start=" + 
+                                std::to_string(start_address) + ", count=" + 
+                                std::to_string(values.size()) + ", got start=" + 
+                                std::to_string(written_start) + ", count=" + 
+                                std::to_string(written_count));
+        }
+        
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        
+        updateStats(OperationType::WRITE, true, duration);
+        
+        LOG_DEBUG("Successfully wrote {} registers in {}us", values.size(), duration.count());
+        return true;
+        
+    } catch (const ModbusException&) {
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        updateStats(OperationType::WRITE, false, duration);
+        throw;
+    } catch (const std::exception& e) {
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        updateStats(OperationType::WRITE, false, duration);
+        throw ModbusException("Write multiple operation failed: " + std::string(e.what()));
+    }
+}
+
+std::vector<RegisterValue> ProtocolAdapter::readWriteRegisters(RegisterAddress read_start, uint16_t read_count,
+                                                              RegisterAddress write_start,
+                                                              const std::vector<RegisterValue>& values,
+                                                              TransactionLane lane) {
+    if (read_count == 0 || read_count > 125) {
+        throw ModbusException("Invalid number of registers to read: " + std::to_string(read_count));
+    }
+    if (values.empty() || values.size() > 121 ||
+        static_cast<uint32_t>(write_start) + values.size() > 0x10000) {
+        throw ModbusException("Invalid number of registers to write: " + std::to_string(values.size()));
+    }
+    
+    LOG_DEBUG("Writing {} registers at {} and reading {} registers at {}", 
+             values.size(), write_start, read_count, read_start);
+    
+    auto start_time = std::chrono::steady_clock::now();
+    
+    try {
+        // Create Modbus frame
+        std::vector<uint8_t> request_frame = ModbusFrame::createReadWriteMultipleFrameBytes(
+            modbus_config_.slave_address, read_start, read_count, write_start, values);
+        
+        // Send request (it writes, so it is routed as a write)
+        std::vector<uint8_t> response_frame = sendWrite(request_frame, write_start,
+                                                        static_cast<uint16_t>(values.size()), lane);
+        
+        // Parse response
+        ModbusResponse response = ModbusFrame::parseResponse(response_frame);
+        
+        if (response.is_error) {
+            std::string error_msg = ModbusFrame::getErrorMessage(response.error_code);
+            throw ModbusException(response.error_code, error_msg);
+        }
+        
+        // A CRC-valid reply to another request (e.g. FC03 with the same byte count) is not ours
+        if (response.function_code != static_cast<FunctionCode>(ModbusFunction::READ_WRITE_MULTIPLE_REGISTERS)) {
+            throw ModbusException("Unexpected read/write response: function 0x" +
+                                  ModbusFrame::bytesToHex({response.function_code}));
+        }
+        
+        // Extract register values
+        std::vector<RegisterValue> read_values = parseRegisterValues(response.data);
+        
+        if (read_values.size() != read_count) {
+            throw ModbusException("Register count mismatch: expected " + 
+                                std::to_string(read_count) + ", got " + 
+                                std::to_string(read_values.size()));
+        }
+        
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        
+        // Counted as a write: it is a control transaction
+        updateStats(OperationType::WRITE, true, duration);
+        
+        LOG_DEBUG("Successfully wrote {} and read {} registers in {}us", 
+                 values.size(), read_values.size(), duration.count());
+        return read_values;
+        
+    } catch (const ModbusException&) {
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        updateStats(OperationType::WRITE, false, duration);
+        throw;
+    } catch (const std::exception& e) {
+        auto end_time = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        updateStats(OperationType::WRITE, false, duration);
+        throw ModbusException("Read/write operation failed: " + std::string(e.what()));
+    }
+}
+
 bool ProtocolAdapter::testCommunication() {
     LOG_INFO("Testing communication with inverter SIM...");
     
@@ -186,60 +455,88 @@ bool ProtocolAdapter::testCommunication() {
     }
 }
 
+ProtocolAdapter::CommunicationStats ProtocolAdapter::getStatistics() const {
+    CommunicationStats stats;
+    stats.total_requests = total_requests_.load(std::memory_order_relaxed);
+    stats.successful_requests = successful_requests_.load(std::memory_order_relaxed);
+    stats.failed_requests = failed_requests_.load(std::memory_order_relaxed);
+    stats.retry_attempts = retry_attempts_.load(std::memory_order_relaxed);
+    
+    auto coalescing = read_coalescer_.getStatistics();
+    stats.coalesced_reads = coalescing.coalesced_reads;
+    stats.coalesced_registers = coalescing.coalesced_registers;
+    stats.batch_round_trips = batch_round_trips_.load(std::memory_order_relaxed);
+    stats.batched_frames = batched_frames_.load(std::memory_order_relaxed);
+    
+    stats.read_latency = latency_[static_cast<size_t>(OperationType::READ)].snapshot();
+    stats.write_latency = latency_[static_cast<size_t>(OperationType::WRITE)].snapshot();
+    stats.retry_latency = latency_[static_cast<size_t>(OperationType::RETRY)].snapshot();
+    
+    for (size_t lane = 0; lane < TransactionQueue::kLaneCount; ++lane) {
+        stats.lanes[lane] = transaction_queue_.getLaneStatistics(static_cast<TransactionLane>(lane));
+    }
+    
+    // True mean across completed read and write operations
+    uint64_t operations = stats.read_latency.count + stats.write_latency.count;
+    if (operations > 0) {
+        uint64_t total_us = stats.read_latency.sum_us + stats.write_latency.sum_us;
+        stats.average_response_time = std::chrono::duration_cast<Duration>(
+            std::chrono::microseconds(total_us / operations));
+    }
+    
+    stats.ewma_response_time = std::chrono::microseconds(
+        static_cast<int64_t>(ewma_response_us_.value()));
+    
+    return stats;
+}
+
 void ProtocolAdapter::resetStatistics() {
-    stats_ = CommunicationStats{};
+    total_requests_.store(0, std::memory_order_relaxed);
+    successful_requests_.store(0, std::memory_order_relaxed);
+    failed_requests_.store(0, std::memory_order_relaxed);
+    retry_attempts_.store(0, std::memory_order_relaxed);
+    batch_round_trips_.store(0, std::memory_order_relaxed);
+    batched_frames_.store(0, std::memory_order_relaxed);
+    read_coalescer_.resetStatistics();
+    transaction_queue_.resetStatistics();
+    for (auto& histogram : latency_) {
+        histogram.reset();
+    }
+    ewma_response_us_.reset();
     LOG_DEBUG("Communication statistics reset");
 }
 
-std::string ProtocolAdapter::sendRequest(const std::string& endpoint, const std::string& frame) {
-    // Create JSON payload
-    nlohmann::json payload;
-    payload["frame"] = frame;
-    std::string json_data = payload.dump();
-    
-    uint32_t attempt = 0;
+template <typename Attempt>
+auto ProtocolAdapter::withRetries(TransactionLane lane, Attempt&& attempt) -> decltype(attempt()) {
+    uint32_t tries = 0;
     std::string last_error;
     
-    while (attempt < modbus_config_.max_retries) {
+    while (tries < modbus_config_.max_retries) {
+        auto attempt_start = std::chrono::steady_clock::now();
+        
         try {
-            LOG_TRACE("Sending request (attempt {}): {}", attempt + 1, frame);
-            
-            HttpResponse response = http_client_->post(endpoint, json_data);
-            
-            if (response.isSuccess()) {
-                // Parse JSON response
-                try {
-                    nlohmann::json response_json = nlohmann::json::parse(response.body);
-                    std::string response_frame = response_json.value("frame", "");
-                    
-                    if (!response_frame.empty()) {
-                        LOG_TRACE("Received response: {}", response_frame);
-                        return response_frame;
-                    } else {
-                        throw HttpException("Empty frame in response");
-                    }
-                    
-                } catch (const nlohmann::json::exception& e) {
-                    throw HttpException("Invalid JSON response: " + std::string(e.what()));
-                }
-            } else {
-                throw HttpException(response.status_code, "HTTP request failed: " + response.body);
-            }
+            auto slot = transaction_queue_.acquire(lane);
+            return attempt();
             
         } catch (const HttpException& e) {
             last_error = e.what();
-            LOG_WARN("Request attempt {} failed: {}", attempt + 1, last_error);
-            
-            if (attempt > 0) {
-                updateStats(false, Duration(0), true); // Mark as retry
-            }
-            
-            attempt++;
-            
-            if (attempt < modbus_config_.max_retries) {
-                LOG_DEBUG("Retrying in {}ms...", modbus_config_.retry_delay.count());
-                std::this_thread::sleep_for(modbus_config_.retry_delay);
-            }
+        } catch (const TransportException& e) {
+            last_error = e.what();
+        } catch (const TimeoutException& e) {
+            last_error = e.what();
+        }
+        
+        // Link-level failure: retry; Modbus-level errors propagate above
+        LOG_WARN("Request attempt {} failed: {}", tries + 1, last_error);
+        
+        tries++;
+        
+        if (tries < modbus_config_.max_retries) {
+            recordRetry(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - attempt_start));
+
+            LOG_DEBUG("Retrying in {}ms...", modbus_config_.retry_delay.count());
+            std::this_thread::sleep_for(modbus_config_.retry_delay);
         }
     }
     
@@ -247,6 +544,26 @@ std::string ProtocolAdapter::sendRequest(const std::string& endpoint, const std:
                          " attempts. Last error: " + last_error);
 }
 
+std::vector<uint8_t> ProtocolAdapter::sendRequest(const std::vector<uint8_t>& frame,
+                                                 TransportOperation operation,
+                                                 TransactionLane lane) {
+    LOG_TRACE("Sending request ({} bytes)", frame.size());
+    return withRetries(lane, [&] { return transport_->transact(frame, operation); });
+}
+
+std::vector<uint8_t> ProtocolAdapter::sendWrite(const std::vector<uint8_t>& frame, RegisterAddress start_address,
+                                               uint16_t num_registers, TransactionLane lane) {
+    try {
+        std::vector<uint8_t> response = sendRequest(frame, TransportOperation::WRITE, lane);
+        read_coalescer_.retire(modbus_config_.slave_address, start_address, num_registers);
+        return response;
+    } catch (...) {
+        // The write may have reached the device before the failure
+        read_coalescer_.retire(modbus_config_.slave_address, start_address, num_registers);
+        throw;
+    }
+}
+
 std::vector<RegisterValue> ProtocolAdapter::parseRegisterValues(const std::vector<uint8_t>& data) {
     if (data.size() % 2 != 0) {
         throw ModbusException("Invalid data length for register values");
@@ -264,29 +581,23 @@ std::vector<RegisterValue> ProtocolAdapter::parseRegisterValues(const std::vecto
     return values;
 }
 
-void ProtocolAdapter::updateStats(bool success, Duration response_time, bool was_retry) {
-    stats_.total_requests++;
+void ProtocolAdapter::updateStats(OperationType operation, bool success,
+                                  std::chrono::microseconds response_time) {
+    total_requests_.fetch_add(1, std::memory_order_relaxed);
     
     if (success) {
-        stats_.successful_requests++;
+        successful_requests_.fetch_add(1, std::memory_order_relaxed);
     } else {
-        stats_.failed_requests++;
-    }
-    
-    if (was_retry) {
-        stats_.retry_attempts++;
+        failed_requests_.fetch_add(1, std::memory_order_relaxed);
     }
     
-    // Update average response time (simple moving average)
-    if (response_time.count() > 0) {
-        if (stats_.average_response_time.count() == 0) {
-            stats_.average_response_time = response_time;
-        } else {
-            auto avg_ms = stats_.average_response_time.count();
-            auto new_ms = response_time.count();
-            stats_.average_response_time = Duration((avg_ms + new_ms) / 2);
-        }
-    }
+    latency_[static_cast<size_t>(operation)].record(response_time);
+    ewma_response_us_.update(static_cast<double>(response_time.count()));
+}
+
+void ProtocolAdapter::recordRetry(std::chrono::microseconds attempt_time) {
+    retry_attempts_.fetch_add(1, std::memory_order_relaxed);
+    latency_[static_cast<size_t>(OperationType::RETRY)].record(attempt_time);
 }
 
 } // namespace ecoWatt
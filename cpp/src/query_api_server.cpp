@@ -0,0 +1,446 @@
+/**
+ * @file query_api_server.cpp
+ * @brief Implementation of the read-only REST query API
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "query_api_server.hpp"
+#include "exceptions.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+using namespace web;
+using namespace web::http;
+using namespace web::http::experimental::listener;
+
+namespace ecoWatt {
+
+namespace {
+
+constexpr const char* kLatestPath = "/api/v1/latest";
+constexpr const char* kHistoryPath = "/api/v1/history";
+constexpr const char* kStatisticsPath = "/api/v1/statistics";
+
+int64_t toMilliseconds(const TimePoint& time) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
+nlohmann::json sampleToJson(const AcquisitionSample& sample, uint64_t version) {
+    return {{"address", sample.register_address},
+            {"name", sample.register_name},
+            {"value", sample.scaled_value},
+            {"raw", sample.raw_value},
+            {"unit", sample.unit},
+            {"timestamp_ms", toMilliseconds(sample.timestamp)},
+            {"version", version}};
+}
+
+bool parseInteger(const std::map<std::string, std::string>& query, const std::string& key, int64_t& value) {
+    auto it = query.find(key);
+    if (it == query.end()) {
+        return false;
+    }
+    size_t used = 0;
+    value = std::stoll(it->second, &used);
+    if (used != it->second.size()) {
+        throw std::invalid_argument(key);
+    }
+    return true;
+}
+
+} // namespace
+
+QueryApiServer::QueryApiServer(const QueryApiConfig& config,
+                               SharedPtr<HybridDataStorage> storage,
+                               const std::map<RegisterAddress, RegisterConfig>& register_configs)
+    : config_(config),
+      storage_(std::move(storage)),
+      register_configs_(register_configs) {
+
+    if (config_.threads == 0 || config_.queue_limit == 0 || config_.max_history_points == 0) {
+        throw ValidationException("QueryApiServer needs positive threads, queue_limit and max_history_points");
+    }
+
+    std::ostringstream epoch;
+    epoch << std::hex << toMilliseconds(std::chrono::system_clock::now());
+    epoch_ = epoch.str();
+}
+
+QueryApiServer::~QueryApiServer() {
+    try {
+        stop();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error stopping query API: {}", e.what());
+    }
+}
+
+void QueryApiServer::onSample(const AcquisitionSample& sample) {
+    std::lock_guard<std::mutex> lock(latest_mutex_);
+    Latest& entry = latest_[sample.register_address];
+    entry.sample = sample;
+    ++entry.version;
+    generation_.fetch_add(1, std::memory_order_release);
+}
+
+void QueryApiServer::setStatisticsProvider(StatisticsProvider provider) {
+    statistics_provider_ = std::move(provider);
+}
+
+QueryApiServer::Response QueryApiServer::handle(const std::string& path,
+                                                const std::map<std::string, std::string>& query,
+                                                const std::string& if_none_match) {
+    requests_.fetch_add(1, std::memory_order_relaxed);
+
+    const std::string latest_prefix = std::string(kLatestPath) + "/";
+    if (path == kLatestPath) {
+        return latestAll(if_none_match);
+    }
+    if (path.compare(0, latest_prefix.size(), latest_prefix) == 0) {
+        return latestOne(path.substr(latest_prefix.size()), if_none_match);
+    }
+    if (path == kHistoryPath) {
+        return history(query);
+    }
+    if (path == kStatisticsPath) {
+        return statistics();
+    }
+    return errorResponse(404, "Unknown endpoint: " + path);
+}
+
+QueryApiServer::Response QueryApiServer::latestAll(const std::string& if_none_match) {
+    // A client holding the current generation gets 304 without any serialization
+    uint64_t generation = generation_.load(std::memory_order_acquire);
+    if (!if_none_match.empty() && etagMatches(if_none_match, makeEtag(std::to_string(generation)))) {
+        not_modified_.fetch_add(1, std::memory_order_relaxed);
+        Response response;
+        response.status = 304;
+        response.etag = makeEtag(std::to_string(generation));
+        return response;
+    }
+
+    std::lock_guard<std::mutex> body_lock(latest_body_mutex_);
+    if (latest_body_ && latest_body_generation_ == generation) {
+        latest_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+        Response response;
+        response.body = latest_body_;
+        response.etag = makeEtag(std::to_string(generation));
+        return response;
+    }
+
+    nlohmann::json readings = nlohmann::json::array();
+    {
+        std::lock_guard<std::mutex> lock(latest_mutex_);
+        generation = generation_.load(std::memory_order_acquire);
+        for (const auto& [address, entry] : latest_) {
+            readings.push_back(sampleToJson(entry.sample, entry.version));
+        }
+    }
+
+    nlohmann::json body = {{"generation", generation}, {"readings", std::move(readings)}};
+    latest_body_ = std::make_shared<const std::string>(body.dump());
+    latest_body_generation_ = generation;
+
+    Response response;
+    response.body = latest_body_;
+    response.etag = makeEtag(std::to_string(generation));
+    return response;
+}
+
+QueryApiServer::Response QueryApiServer::latestOne(const std::string& address_text, const std::string& if_none_match) {
+    RegisterAddress address = 0;
+    try {
+        size_t used = 0;
+        unsigned long parsed = std::stoul(address_text, &used);
+        if (used != address_text.size() || parsed > 0xFFFF) {
+            throw std::out_of_range(address_text);
+        }
+        address = static_cast<RegisterAddress>(parsed);
+    } catch (const std::exception&) {
+        return errorResponse(400, "Invalid register address: " + address_text);
+    }
+
+    Latest entry;
+    {
+        std::lock_guard<std::mutex> lock(latest_mutex_);
+        auto it = latest_.find(address);
+        if (it == latest_.end()) {
+            return errorResponse(404, "No sample for register " + address_text);
+        }
+        entry = it->second;
+    }
+
+    std::string etag = makeEtag("r" + std::to_string(address) + "." + std::to_string(entry.version));
+    if (!if_none_match.empty() && etagMatches(if_none_match, etag)) {
+        not_modified_.fetch_add(1, std::memory_order_relaxed);
+        Response response;
+        response.status = 304;
+        response.etag = etag;
+        return response;
+    }
+    return jsonResponse(200, sampleToJson(entry.sample, entry.version), etag);
+}
+
+QueryApiServer::Response QueryApiServer::history(const std::map<std::string, std::string>& query) {
+    int64_t address = 0;
+    int64_t to_ms = toMilliseconds(std::chrono::system_clock::now());
+    int64_t from_ms = 0;
+    int64_t resolution_ms = 0;
+    try {
+        if (!parseInteger(query, "register", address)) {
+            return errorResponse(400, "register is required");
+        }
+        parseInteger(query, "to", to_ms);
+        if (!parseInteger(query, "from", from_ms)) {
+            from_ms = to_ms - 60 * 60 * 1000;
+        }
+        parseInteger(query, "resolution", resolution_ms);
+    } catch (const std::exception&) {
+        return errorResponse(400, "register, from, to and resolution must be integers");
+    }
+    if (from_ms > to_ms || resolution_ms < 0) {
+        return errorResponse(400, "Invalid range or resolution");
+    }
+
+    auto config_it = (address >= 0 && address <= 0xFFFF)
+                         ? register_configs_.find(static_cast<RegisterAddress>(address))
+                         : register_configs_.end();
+    if (config_it == register_configs_.end()) {
+        return errorResponse(404, "Unknown register " + std::to_string(address));
+    }
+    if (!storage_) {
+        return errorResponse(503, "History storage unavailable");
+    }
+
+    // Never return more than max_history_points buckets
+    const int64_t span = to_ms - from_ms + 1;
+    const int64_t points = static_cast<int64_t>(config_.max_history_points);
+    resolution_ms = std::max({resolution_ms, (span + points - 1) / points, int64_t{1}});
+
+    // Filtered registers only persist rows that passed SampleFilter
+    const RegisterConfig& reg = config_it->second;
+    HistoryFill fill = HistoryFill::NONE;
+    if (reg.compression == CompressionMode::SWINGING_DOOR) {
+        fill = HistoryFill::LINEAR;
+    } else if (reg.deadband > 0.0 || reg.deadband_percent > 0.0 || reg.max_interval.count() > 0) {
+        fill = HistoryFill::HOLD;
+    }
+    // Carried values stop at the present, not at a future `to`
+    const int64_t query_to = fill == HistoryFill::NONE
+                                 ? to_ms
+                                 : std::min(to_ms, toMilliseconds(std::chrono::system_clock::now()));
+
+    std::vector<HistoryBucket> buckets;
+    try {
+        buckets = storage_->getAggregatedSamples(static_cast<RegisterAddress>(address),
+                                                 TimePoint(Duration(from_ms)), TimePoint(Duration(query_to)),
+                                                 Duration(resolution_ms), fill, reg.max_interval);
+    } catch (const std::exception& e) {
+        LOG_WARN("History query failed: {}", e.what());
+        return errorResponse(500, "History query failed");
+    }
+
+    auto scale = [&reg](double raw) { return reg.gain != 0.0 ? raw / reg.gain : raw; };
+    nlohmann::json points_json = nlohmann::json::array();
+    for (const auto& bucket : buckets) {
+        points_json.push_back({{"t", toMilliseconds(bucket.start)},
+                               {"mean", scale(bucket.mean)},
+                               {"min", scale(bucket.min)},
+                               {"max", scale(bucket.max)},
+                               {"count", bucket.count}});
+    }
+
+    return jsonResponse(200, {{"register", address},
+                              {"name", reg.name},
+                              {"unit", reg.unit},
+                              {"from_ms", from_ms},
+                              {"to_ms", to_ms},
+                              {"resolution_ms", resolution_ms},
+                              {"filtered", fill != HistoryFill::NONE},
+                              {"fill", fill == HistoryFill::LINEAR ? "linear"
+                                       : fill == HistoryFill::HOLD ? "hold" : "none"},
+                              {"points", std::move(points_json)}});
+}
+
+QueryApiServer::Response QueryApiServer::statistics() {
+    nlohmann::json body = statistics_provider_ ? statistics_provider_() : nlohmann::json::object();
+
+    Statistics stats = getStatistics();
+    body["query_api"] = {{"requests", stats.requests},
+                         {"not_modified", stats.not_modified},
+                         {"latest_cache_hits", stats.latest_cache_hits},
+                         {"rejected", stats.rejected}};
+    return jsonResponse(200, body);
+}
+
+std::string QueryApiServer::makeEtag(const std::string& tag) const {
+    return "\"" + epoch_ + "-" + tag + "\"";
+}
+
+bool QueryApiServer::etagMatches(const std::string& if_none_match, const std::string& etag) {
+    size_t start = 0;
+    while (start <= if_none_match.size()) {
+        size_t end = if_none_match.find(',', start);
+        if (end == std::string::npos) {
+            end = if_none_match.size();
+        }
+        std::string candidate = if_none_match.substr(start, end - start);
+        candidate.erase(0, candidate.find_first_not_of(" \t"));
+        candidate.erase(candidate.find_last_not_of(" \t") + 1);
+        if (candidate.compare(0, 2, "W/") == 0) {
+            candidate.erase(0, 2);
+        }
+        if (candidate == "*" || candidate == etag) {
+            return true;
+        }
+        start = end + 1;
+    }
+    return false;
+}
+
+QueryApiServer::Response QueryApiServer::jsonResponse(uint16_t status, const nlohmann::json& body, std::string etag) {
+    Response response;
+    response.status = status;
+    response.body = std::make_shared<const std::string>(body.dump());
+    response.etag = std::move(etag);
+    return response;
+}
+
+QueryApiServer::Response QueryApiServer::errorResponse(uint16_t status, const std::string& message) {
+    return jsonResponse(status, {{"error", message}});
+}
+
+QueryApiServer::Statistics QueryApiServer::getStatistics() const {
+    Statistics stats;
+    stats.requests = requests_.load(std::memory_order_relaxed);
+    stats.not_modified = not_modified_.load(std::memory_order_relaxed);
+    stats.latest_cache_hits = latest_cache_hits_.load(std::memory_order_relaxed);
+    stats.rejected = rejected_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void QueryApiServer::start() {
+    if (running_) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        stop_requested_ = false;
+    }
+    for (uint32_t i = 0; i < config_.threads; ++i) {
+        workers_.emplace_back(&QueryApiServer::workerLoop, this);
+    }
+
+    try {
+        listener_ = std::make_unique<http_listener>(utility::conversions::to_string_t(config_.listen_url));
+        listener_->support(methods::GET, [this](http_request request) { enqueue(request); });
+        listener_->open().wait();
+    } catch (const std::exception& e) {
+        listener_.reset();
+        running_ = true;
+        stop();
+        throw HttpException("Failed to start query API on " + config_.listen_url + ": " + e.what());
+    }
+    running_ = true;
+
+    LOG_INFO("Query API listening on {} ({} workers)", config_.listen_url, config_.threads);
+}
+
+void QueryApiServer::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    if (listener_) {
+        listener_->close().wait();
+        listener_.reset();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        stop_requested_ = true;
+    }
+    pending_cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+
+    // Requests accepted but not yet served
+    for (auto& request : pending_) {
+        request.reply(status_codes::ServiceUnavailable);
+    }
+    pending_.clear();
+
+    LOG_INFO("Query API stopped");
+}
+
+void QueryApiServer::enqueue(http_request request) {
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        if (!stop_requested_ && pending_.size() < config_.queue_limit) {
+            pending_.push_back(std::move(request));
+            pending_cv_.notify_one();
+            return;
+        }
+    }
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+    request.reply(status_codes::ServiceUnavailable);
+}
+
+void QueryApiServer::workerLoop() {
+    while (true) {
+        http_request request;
+        {
+            std::unique_lock<std::mutex> lock(pending_mutex_);
+            pending_cv_.wait(lock, [this] { return stop_requested_ || !pending_.empty(); });
+            if (stop_requested_) {
+                return;
+            }
+            request = std::move(pending_.front());
+            pending_.pop_front();
+        }
+        serve(request);
+    }
+}
+
+void QueryApiServer::serve(http_request& request) {
+    try {
+        std::string path = utility::conversions::to_utf8string(request.relative_uri().path());
+
+        std::map<std::string, std::string> query;
+        for (const auto& [key, value] : uri::split_query(request.relative_uri().query())) {
+            query[utility::conversions::to_utf8string(uri::decode(key))] =
+                utility::conversions::to_utf8string(uri::decode(value));
+        }
+
+        std::string if_none_match;
+        auto header = request.headers().find(U("If-None-Match"));
+        if (header != request.headers().end()) {
+            if_none_match = utility::conversions::to_utf8string(header->second);
+        }
+
+        Response result = handle(path, query, if_none_match);
+
+        http_response response(result.status);
+        if (result.body) {
+            response.set_body(*result.body, "application/json");
+        }
+        if (!result.etag.empty()) {
+            response.headers().add(U("ETag"), utility::conversions::to_string_t(result.etag));
+            response.headers().add(U("Cache-Control"), U("no-cache"));
+        }
+        request.reply(response);
+    } catch (const std::exception& e) {
+        LOG_WARN("Query API request failed: {}", e.what());
+        request.reply(status_codes::InternalError);
+    }
+}
+
+} // namespace ecoWatt
@@ -0,0 +1,139 @@
+/**
+ * @file read_coalescer.cpp
+ * @brief Implementation of single-flight read coalescing
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "read_coalescer.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace ecoWatt {
+
+ReadCoalescer::Claim::Claim(ReadCoalescer* owner, std::shared_ptr<Flight> flight, bool leading,
+                            RegisterAddress start_address, uint16_t num_registers)
+    : owner_(owner), flight_(std::move(flight)), leading_(leading),
+      start_(start_address), count_(num_registers) {
+}
+
+ReadCoalescer::Claim::Claim(Claim&& other) noexcept
+    : owner_(std::exchange(other.owner_, nullptr)), flight_(std::move(other.flight_)),
+      leading_(other.leading_), start_(other.start_), count_(other.count_),
+      promise_(std::move(other.promise_)) {
+}
+
+ReadCoalescer::Claim::~Claim() {
+    // The promise's destructor then breaks it for any waiters
+    if (owner_ && leading_) {
+        owner_->land(flight_);
+    }
+}
+
+void ReadCoalescer::Claim::complete(const std::vector<RegisterValue>& values) {
+    if (!owner_ || !leading_) {
+        return;
+    }
+    std::exchange(owner_, nullptr)->land(flight_);
+    promise_.set_value(values);
+}
+
+void ReadCoalescer::Claim::fail(std::exception_ptr error) {
+    if (!owner_ || !leading_) {
+        return;
+    }
+    std::exchange(owner_, nullptr)->land(flight_);
+    promise_.set_exception(error);
+}
+
+std::vector<RegisterValue> ReadCoalescer::Claim::wait() const {
+    const auto& values = flight_->result.get();
+    size_t offset = start_ - flight_->start;
+    if (values.size() < offset + count_) {
+        return {}; // Defensive: the leader's reader returned a short result
+    }
+    return std::vector<RegisterValue>(values.begin() + offset, values.begin() + offset + count_);
+}
+
+ReadCoalescer::Claim ReadCoalescer::claim(SlaveAddress slave, RegisterAddress start_address,
+                                          uint16_t num_registers, TransactionLane lane) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Lower lane values are served first
+    auto it = std::find_if(flights_.begin(), flights_.end(), [&](const auto& flight) {
+        return flight->lane <= lane && flight->covers(slave, start_address, num_registers);
+    });
+
+    if (it != flights_.end()) {
+        coalesced_reads_.fetch_add(1, std::memory_order_relaxed);
+        coalesced_registers_.fetch_add(num_registers, std::memory_order_relaxed);
+        return Claim(this, *it, false, start_address, num_registers);
+    }
+
+    leader_reads_.fetch_add(1, std::memory_order_relaxed);
+
+    auto flight = std::make_shared<Flight>();
+    flight->slave = slave;
+    flight->start = start_address;
+    flight->count = num_registers;
+    flight->lane = lane;
+
+    Claim lead(this, flight, true, start_address, num_registers);
+    flight->result = lead.promise_.get_future().share();
+    flights_.push_back(std::move(flight));
+    return lead;
+}
+
+std::vector<RegisterValue> ReadCoalescer::read(SlaveAddress slave, RegisterAddress start_address,
+                                               uint16_t num_registers, TransactionLane lane,
+                                               const Reader& reader) {
+    Claim ticket = claim(slave, start_address, num_registers, lane);
+    if (!ticket.leading()) {
+        return ticket.wait();
+    }
+
+    try {
+        std::vector<RegisterValue> values = reader(start_address, num_registers);
+        ticket.complete(values);
+        return values;
+    } catch (...) {
+        ticket.fail(std::current_exception());
+        throw;
+    }
+}
+
+void ReadCoalescer::retire(SlaveAddress slave, RegisterAddress start_address, uint16_t num_registers) {
+    // The leader still completes its waiters; its land() then finds nothing to erase
+    std::lock_guard<std::mutex> lock(mutex_);
+    flights_.erase(std::remove_if(flights_.begin(), flights_.end(),
+                                  [&](const auto& flight) {
+                                      return flight->overlaps(slave, start_address, num_registers);
+                                  }),
+                   flights_.end());
+}
+
+void ReadCoalescer::land(const std::shared_ptr<Flight>& flight) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flights_.erase(std::remove(flights_.begin(), flights_.end(), flight), flights_.end());
+}
+
+size_t ReadCoalescer::inFlight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return flights_.size();
+}
+
+ReadCoalescer::Statistics ReadCoalescer::getStatistics() const {
+    Statistics stats;
+    stats.leader_reads = leader_reads_.load(std::memory_order_relaxed);
+    stats.coalesced_reads = coalesced_reads_.load(std::memory_order_relaxed);
+    stats.coalesced_registers = coalesced_registers_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ReadCoalescer::resetStatistics() {
+    leader_reads_.store(0, std::memory_order_relaxed);
+    coalesced_reads_.store(0, std::memory_order_relaxed);
+    coalesced_registers_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace ecoWatt
@@ -0,0 +1,167 @@
+/**
+ * @file sample_filter.cpp
+ * @brief Implementation of report-by-exception sample filtering
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "sample_filter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ecoWatt {
+
+namespace {
+
+double secondsBetween(const TimePoint& from, const TimePoint& to) {
+    return std::chrono::duration<double>(to - from).count();
+}
+
+} // namespace
+
+void SampleFilter::configure(const std::map<RegisterAddress, RegisterConfig>& register_configs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::map<RegisterAddress, Channel> channels;
+    for (const auto& [address, config] : register_configs) {
+        Settings settings;
+        settings.deadband = config.deadband;
+        settings.deadband_percent = config.deadband_percent;
+        settings.compression = config.compression;
+        settings.max_interval = config.max_interval;
+        if (settings == Settings{}) {
+            continue;
+        }
+
+        auto it = channels_.find(address);
+        if (it != channels_.end() && it->second.settings == settings) {
+            channels.emplace(address, std::move(it->second));
+        } else {
+            Channel channel;
+            channel.settings = settings;
+            channels.emplace(address, std::move(channel));
+        }
+    }
+
+    channels_ = std::move(channels);
+}
+
+std::vector<AcquisitionSample> SampleFilter::offer(const AcquisitionSample& sample) {
+    std::vector<AcquisitionSample> out;
+    received_.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = channels_.find(sample.register_address);
+        if (it == channels_.end()) {
+            out.push_back(sample);
+        } else {
+            Channel& channel = it->second;
+            const Settings& settings = channel.settings;
+
+            if (!channel.stored) {
+                archive(channel, sample);
+                out.push_back(sample);
+            } else if (sample.timestamp <= (channel.held ? channel.held->timestamp : channel.stored->timestamp)) {
+                out.push_back(sample); // Out of order: persisted as-is, state untouched
+            } else {
+                if (settings.compression == CompressionMode::SWINGING_DOOR) {
+                    swingingDoor(channel, sample, out);
+                } else if (std::abs(sample.scaled_value - channel.stored->scaled_value) >
+                           band(settings, channel.stored->scaled_value)) {
+                    archive(channel, sample);
+                    out.push_back(sample);
+                }
+
+                bool current_stored = !out.empty() && out.back().timestamp == sample.timestamp;
+                if (!current_stored && settings.max_interval.count() > 0 &&
+                    sample.timestamp - channel.stored->timestamp >= settings.max_interval) {
+                    archive(channel, sample);
+                    out.push_back(sample);
+                }
+            }
+        }
+    }
+
+    stored_.fetch_add(out.size(), std::memory_order_relaxed);
+    return out;
+}
+
+std::vector<AcquisitionSample> SampleFilter::flush() {
+    std::vector<AcquisitionSample> out;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [address, channel] : channels_) {
+            if (channel.held) {
+                AcquisitionSample held = *channel.held;
+                archive(channel, held);
+                out.push_back(std::move(held));
+            }
+        }
+    }
+
+    stored_.fetch_add(out.size(), std::memory_order_relaxed);
+    return out;
+}
+
+SampleFilter::Statistics SampleFilter::getStatistics() const {
+    Statistics stats;
+    stats.received = received_.load(std::memory_order_relaxed);
+    stats.stored = stored_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SampleFilter::resetStatistics() {
+    received_.store(0, std::memory_order_relaxed);
+    stored_.store(0, std::memory_order_relaxed);
+}
+
+double SampleFilter::band(const Settings& settings, double reference) {
+    return std::max(settings.deadband, std::abs(reference) * settings.deadband_percent / 100.0);
+}
+
+void SampleFilter::archive(Channel& channel, const AcquisitionSample& sample) {
+    channel.stored = sample;
+    channel.held.reset();
+    channel.slope_min = -std::numeric_limits<double>::infinity();
+    channel.slope_max = std::numeric_limits<double>::infinity();
+}
+
+void SampleFilter::swingingDoor(Channel& channel, const AcquisitionSample& sample,
+                                std::vector<AcquisitionSample>& out) {
+    const AcquisitionSample& origin = *channel.stored;
+    double dt = secondsBetween(origin.timestamp, sample.timestamp);
+    double deviation = band(channel.settings, origin.scaled_value);
+    double rise = sample.scaled_value - origin.scaled_value;
+
+    // Slopes from the stored point that pass within the band of every sample so far
+    double slope_min = std::max(channel.slope_min, (rise - deviation) / dt);
+    double slope_max = std::min(channel.slope_max, (rise + deviation) / dt);
+    double slope = rise / dt;
+
+    if ((slope >= slope_min && slope <= slope_max) || !channel.held) {
+        channel.slope_min = slope_min;
+        channel.slope_max = slope_max;
+        channel.held = sample;
+        return;
+    }
+
+    // The door closed: the held sample ends the segment and starts the next one
+    AcquisitionSample held = *channel.held;
+    archive(channel, held);
+    out.push_back(std::move(held));
+
+    const AcquisitionSample& next_origin = *channel.stored;
+    dt = secondsBetween(next_origin.timestamp, sample.timestamp);
+    deviation = band(channel.settings, next_origin.scaled_value);
+    rise = sample.scaled_value - next_origin.scaled_value;
+
+    channel.slope_min = (rise - deviation) / dt;
+    channel.slope_max = (rise + deviation) / dt;
+    channel.held = sample;
+}
+
+} // namespace ecoWatt
@@ -0,0 +1,409 @@
+/**
+ * @file sample_stream.cpp
+ * @brief Implementation of the sample broadcaster and SSE endpoint
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "sample_stream.hpp"
+#include "exceptions.hpp"
+#include "logger.hpp"
+#include <cpprest/producerconsumerstream.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+
+using namespace web;
+using namespace web::http;
+using namespace web::http::experimental::listener;
+
+namespace ecoWatt {
+
+// SampleBroadcaster
+
+SampleBroadcaster::SampleBroadcaster(size_t client_queue)
+    : client_queue_(std::max<size_t>(1, client_queue)),
+      ring_(client_queue_) {
+}
+
+SampleBroadcaster::~SampleBroadcaster() {
+    closeAll();
+}
+
+void SampleBroadcaster::publish(const AcquisitionSample& sample) {
+    bool overflowed = false;
+    {
+        std::lock_guard<std::mutex> lock(inbox_mutex_);
+        inbox_.emplace_back(sample, Clock::now());
+        // A stalled dispatcher could not keep more than a ring of them anyway
+        if (inbox_.size() > client_queue_) {
+            inbox_.pop_front();
+            overflowed = true;
+        }
+    }
+    published_.fetch_add(1, std::memory_order_relaxed);
+    if (overflowed) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (notifier_) {
+        notifier_();
+    }
+}
+
+uint64_t SampleBroadcaster::subscribe(Writer writer, Closer closer, std::optional<uint64_t> last_event_id) {
+    auto subscriber = std::make_shared<Subscriber>();
+    subscriber->writer = std::move(writer);
+    subscriber->closer = std::move(closer);
+
+    {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        const uint64_t head = head_.load(std::memory_order_acquire);
+        const uint64_t oldest = head > client_queue_ ? head - client_queue_ : 1;
+        subscriber->cursor = head;
+        if (last_event_id && *last_event_id + 1 >= oldest && *last_event_id < head) {
+            subscriber->cursor = *last_event_id + 1;
+        }
+        subscriber->id = next_subscriber_id_++;
+        subscribers_.push_back(subscriber);
+    }
+
+    if (notifier_) {
+        notifier_();
+    }
+    return subscriber->id;
+}
+
+void SampleBroadcaster::unsubscribe(uint64_t id) {
+    std::shared_ptr<Subscriber> removed;
+    {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        auto it = std::find_if(subscribers_.begin(), subscribers_.end(),
+                               [id](const std::shared_ptr<Subscriber>& s) { return s->id == id; });
+        if (it == subscribers_.end()) {
+            return;
+        }
+        removed = *it;
+        subscribers_.erase(it);
+    }
+    if (removed->closer) {
+        removed->closer();
+    }
+}
+
+bool SampleBroadcaster::pump() {
+    // Serialize each new sample once into the ring
+    std::deque<std::pair<AcquisitionSample, Clock::time_point>> batch;
+    {
+        std::lock_guard<std::mutex> lock(inbox_mutex_);
+        batch.swap(inbox_);
+    }
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    for (const auto& [sample, published] : batch) {
+        ring_[head % client_queue_] = Event{head, published,
+                                            std::make_shared<const std::string>(formatEvent(head, sample))};
+        ++head;
+    }
+    head_.store(head, std::memory_order_release);
+    const uint64_t oldest = head > client_queue_ ? head - client_queue_ : 1;
+
+    std::vector<std::shared_ptr<Subscriber>> subscribers;
+    {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        subscribers = subscribers_;
+    }
+
+    bool pending = false;
+    std::vector<std::shared_ptr<Subscriber>> to_close;
+    for (const auto& subscriber : subscribers) {
+        // Only this thread moves cursors once a subscriber is listed
+        uint64_t cursor = subscriber->cursor;
+        uint64_t dropped = 0;
+        if (cursor < oldest) {
+            dropped = oldest - cursor;
+            cursor = oldest;
+        }
+
+        uint64_t delivered = 0;
+        int64_t lag_us = -1;
+        bool failed = false;
+        while (cursor < head) {
+            const Event& event = ring_[cursor % client_queue_];
+            try {
+                if (!subscriber->writer(*event.text)) {
+                    pending = true;
+                    break;
+                }
+            } catch (const std::exception& e) {
+                LOG_DEBUG("Stream subscriber {} closed: {}", subscriber->id, e.what());
+                failed = true;
+                break;
+            }
+            lag_us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - event.published).count();
+            delivery_lag_.record(static_cast<uint64_t>(std::max<int64_t>(0, lag_us)));
+            ++cursor;
+            ++delivered;
+        }
+
+        bool evict = false;
+        {
+            std::lock_guard<std::mutex> lock(subscribers_mutex_);
+            subscriber->cursor = cursor;
+            subscriber->delivered += delivered;
+            subscriber->dropped += dropped;
+            // Drops only add up while behind; catching up to the head forgives them
+            subscriber->episode_dropped = cursor == head ? 0 : subscriber->episode_dropped + dropped;
+            if (lag_us >= 0) {
+                subscriber->last_lag_us = lag_us;
+            }
+            evict = failed || subscriber->episode_dropped >= client_queue_;
+            if (evict) {
+                subscribers_.erase(std::remove(subscribers_.begin(), subscribers_.end(), subscriber),
+                                   subscribers_.end());
+            }
+        }
+        delivered_.fetch_add(delivered, std::memory_order_relaxed);
+        dropped_.fetch_add(dropped, std::memory_order_relaxed);
+
+        if (evict) {
+            if (!failed) {
+                evicted_.fetch_add(1, std::memory_order_relaxed);
+                LOG_WARN("Stream subscriber {} evicted after dropping {} events without catching up",
+                         subscriber->id, subscriber->episode_dropped);
+            }
+            to_close.push_back(subscriber);
+        }
+    }
+
+    for (const auto& subscriber : to_close) {
+        if (subscriber->closer) {
+            subscriber->closer();
+        }
+    }
+    return pending;
+}
+
+void SampleBroadcaster::heartbeat() {
+    static const std::string keepalive = ": keepalive\n\n";
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+
+    std::vector<std::shared_ptr<Subscriber>> subscribers;
+    {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        subscribers = subscribers_;
+    }
+    for (const auto& subscriber : subscribers) {
+        if (subscriber->cursor == head) {
+            try {
+                subscriber->writer(keepalive);
+            } catch (const std::exception&) {
+                unsubscribe(subscriber->id);
+            }
+        }
+    }
+}
+
+void SampleBroadcaster::closeAll() {
+    std::vector<std::shared_ptr<Subscriber>> subscribers;
+    {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        subscribers.swap(subscribers_);
+    }
+    for (const auto& subscriber : subscribers) {
+        if (subscriber->closer) {
+            subscriber->closer();
+        }
+    }
+}
+
+SampleBroadcaster::Statistics SampleBroadcaster::getStatistics() const {
+    Statistics stats;
+    {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        stats.subscribers = subscribers_.size();
+    }
+    stats.published = published_.load(std::memory_order_relaxed);
+    stats.delivered = delivered_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.evicted = evicted_.load(std::memory_order_relaxed);
+    stats.delivery_lag = delivery_lag_.snapshot();
+    return stats;
+}
+
+std::vector<SampleBroadcaster::SubscriberStatistics> SampleBroadcaster::getSubscriberStatistics() const {
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    std::vector<SubscriberStatistics> result;
+    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    result.reserve(subscribers_.size());
+    for (const auto& subscriber : subscribers_) {
+        SubscriberStatistics stats;
+        stats.id = subscriber->id;
+        stats.delivered = subscriber->delivered;
+        stats.dropped = subscriber->dropped;
+        stats.backlog = head > subscriber->cursor ? head - subscriber->cursor : 0;
+        stats.last_lag = std::chrono::microseconds(subscriber->last_lag_us);
+        result.push_back(stats);
+    }
+    return result;
+}
+
+std::string SampleBroadcaster::formatEvent(uint64_t id, const AcquisitionSample& sample) {
+    nlohmann::json data = {
+        {"address", sample.register_address},
+        {"name", sample.register_name},
+        {"value", sample.scaled_value},
+        {"raw", sample.raw_value},
+        {"unit", sample.unit},
+        {"timestamp_ms", std::chrono::duration_cast<std::chrono::milliseconds>(
+            sample.timestamp.time_since_epoch()).count()}};
+    return "id: " + std::to_string(id) + "\nevent: sample\ndata: " + data.dump() + "\n\n";
+}
+
+// SampleStreamServer
+
+SampleStreamServer::SampleStreamServer(const StreamConfig& config)
+    : config_(config), broadcaster_(config.client_queue) {
+
+    if (config_.client_queue == 0 || config_.max_clients == 0 || config_.heartbeat_interval.count() <= 0) {
+        throw ValidationException("SampleStreamServer needs positive client_queue, max_clients and heartbeat interval");
+    }
+    broadcaster_.setNotifier([this]() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            wake_ = true;
+        }
+        wake_cv_.notify_one();
+    });
+}
+
+SampleStreamServer::~SampleStreamServer() {
+    try {
+        stop();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error stopping sample stream: {}", e.what());
+    }
+}
+
+void SampleStreamServer::start() {
+    if (running_) {
+        return;
+    }
+
+    try {
+        listener_ = std::make_unique<http_listener>(utility::conversions::to_string_t(config_.listen_url));
+        listener_->support(methods::GET, [this](http_request request) { handleGet(request); });
+        listener_->open().wait();
+    } catch (const std::exception& e) {
+        listener_.reset();
+        throw HttpException("Failed to start sample stream on " + config_.listen_url + ": " + e.what());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stop_requested_ = false;
+    }
+    dispatcher_ = std::thread(&SampleStreamServer::dispatchLoop, this);
+    running_ = true;
+
+    LOG_INFO("Sample stream listening on {}{}", config_.listen_url, config_.path);
+}
+
+void SampleStreamServer::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stop_requested_ = true;
+    }
+    wake_cv_.notify_all();
+    if (dispatcher_.joinable()) {
+        dispatcher_.join();
+    }
+    broadcaster_.closeAll();
+    listener_->close().wait();
+    listener_.reset();
+
+    LOG_INFO("Sample stream stopped");
+}
+
+void SampleStreamServer::handleGet(http_request request) {
+    std::string path = utility::conversions::to_utf8string(request.relative_uri().path());
+    if (path != config_.path) {
+        request.reply(status_codes::NotFound);
+        return;
+    }
+    if (broadcaster_.getStatistics().subscribers >= config_.max_clients) {
+        request.reply(status_codes::ServiceUnavailable);
+        return;
+    }
+
+    std::optional<uint64_t> last_event_id;
+    auto header = request.headers().find(U("Last-Event-ID"));
+    if (header != request.headers().end()) {
+        try {
+            last_event_id = std::stoull(utility::conversions::to_utf8string(header->second));
+        } catch (const std::exception&) {
+            // Not one of ours; start from the live head
+        }
+    }
+
+    concurrency::streams::producer_consumer_buffer<uint8_t> buffer;
+    const size_t max_buffered = static_cast<size_t>(config_.max_buffered_kb) * 1024;
+
+    auto write = [buffer](const std::string& text) mutable {
+        buffer.putn_nocopy(reinterpret_cast<const uint8_t*>(text.data()), text.size()).wait();
+    };
+    write("retry: 3000\n\n");
+
+    broadcaster_.subscribe(
+        [buffer, max_buffered, write](const std::string& event) mutable {
+            if (!buffer.can_write()) {
+                throw std::runtime_error("stream closed");
+            }
+            if (buffer.in_avail() > max_buffered) {
+                return false;  // Client is not reading; keep the event queued
+            }
+            write(event);
+            return true;
+        },
+        [buffer]() mutable {
+            buffer.close(std::ios_base::out).wait();
+        },
+        last_event_id);
+
+    http_response response(status_codes::OK);
+    response.headers().add(U("Cache-Control"), U("no-cache"));
+    response.headers().add(U("X-Accel-Buffering"), U("no"));
+    response.set_body(buffer.create_istream(), "text/event-stream");
+    request.reply(response);
+}
+
+void SampleStreamServer::dispatchLoop() {
+    using Clock = std::chrono::steady_clock;
+    const auto retry_interval = std::chrono::milliseconds(50);
+    auto next_heartbeat = Clock::now() + config_.heartbeat_interval;
+    bool pending = false;
+
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (!stop_requested_) {
+        // Blocked clients are retried shortly; otherwise sleep until a sample or the heartbeat
+        auto deadline = pending ? std::min(Clock::now() + retry_interval, next_heartbeat) : next_heartbeat;
+        wake_cv_.wait_until(lock, deadline, [this] { return wake_ || stop_requested_; });
+        if (stop_requested_) {
+            break;
+        }
+        wake_ = false;
+        lock.unlock();
+
+        pending = broadcaster_.pump();
+        if (Clock::now() >= next_heartbeat) {
+            broadcaster_.heartbeat();
+            next_heartbeat = Clock::now() + config_.heartbeat_interval;
+        }
+
+        lock.lock();
+    }
+}
+
+} // namespace ecoWatt
@@ -0,0 +1,212 @@
+/**
+ * @file setpoint_writer.cpp
+ * @brief Implementation of the coalescing setpoint writer
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "setpoint_writer.hpp"
+#include "logger.hpp"
+
+namespace ecoWatt {
+
+SetpointWriter::SetpointWriter(Writer writer, Duration min_interval)
+    : writer_(std::move(writer)),
+      min_interval_(min_interval) {
+    worker_ = std::thread(&SetpointWriter::workerLoop, this);
+}
+
+SetpointWriter::~SetpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+std::shared_future<SetpointResult> SetpointWriter::submit(RegisterAddress address, RegisterValue value) {
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+
+    auto promise = std::make_shared<std::promise<SetpointResult>>();
+    std::shared_future<SetpointResult> future = promise->get_future().share();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& state = registers_[address];
+
+        if (state.pending) {
+            if (state.pending->value == value) {
+                coalesced_.fetch_add(1, std::memory_order_relaxed);
+                return state.pending->future; // Same value already queued
+            }
+
+            LOG_DEBUG("Setpoint {} -> {} superseded by {}", address, state.pending->value, value);
+            coalesced_.fetch_add(1, std::memory_order_relaxed);
+            complete(*state.pending, SetpointResult::COALESCED);
+            state.pending.reset();
+        }
+
+        // With a write in flight the outcome is not known yet, so queue instead
+        if (!state.in_flight && state.confirmed == value) {
+            skipped_.fetch_add(1, std::memory_order_relaxed);
+            promise->set_value(SetpointResult::SKIPPED);
+            return future;
+        }
+
+        state.pending = Pending{value, std::move(promise), future};
+    }
+
+    cv_.notify_all();
+    return future;
+}
+
+void SetpointWriter::setMinInterval(Duration min_interval) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        min_interval_ = min_interval;
+    }
+    cv_.notify_all();
+}
+
+Duration SetpointWriter::getMinInterval() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return min_interval_;
+}
+
+std::optional<RegisterValue> SetpointWriter::getConfirmedValue(RegisterAddress address) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = registers_.find(address);
+    return (it != registers_.end()) ? it->second.confirmed : std::nullopt;
+}
+
+void SetpointWriter::invalidate(RegisterAddress address) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = registers_.find(address);
+    if (it != registers_.end()) {
+        it->second.confirmed.reset();
+    }
+}
+
+void SetpointWriter::observe(RegisterAddress address, RegisterValue value, TimePoint read_time) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = registers_.find(address);
+    if (it == registers_.end()) {
+        return;
+    }
+
+    RegisterState& state = it->second;
+    if (state.in_flight || !state.confirmed || *state.confirmed == value || read_time < state.confirmed_at) {
+        return;
+    }
+
+    LOG_WARN("Setpoint register {} reads {} instead of confirmed {}; resending on next submit",
+             address, value, *state.confirmed);
+    state.confirmed.reset();
+    invalidated_.fetch_add(1, std::memory_order_relaxed);
+}
+
+SetpointWriter::Statistics SetpointWriter::getStatistics() const {
+    Statistics stats;
+    stats.submitted = submitted_.load(std::memory_order_relaxed);
+    stats.applied = applied_.load(std::memory_order_relaxed);
+    stats.coalesced = coalesced_.load(std::memory_order_relaxed);
+    stats.skipped = skipped_.load(std::memory_order_relaxed);
+    stats.failed = failed_.load(std::memory_order_relaxed);
+    stats.invalidated = invalidated_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+const char* SetpointWriter::toString(SetpointResult result) {
+    switch (result) {
+        case SetpointResult::APPLIED: return "applied";
+        case SetpointResult::COALESCED: return "coalesced";
+        case SetpointResult::SKIPPED: return "skipped";
+        case SetpointResult::FAILED: return "failed";
+        default: return "unknown";
+    }
+}
+
+void SetpointWriter::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        auto now = Clock::now();
+        std::optional<Clock::time_point> next_due;
+        RegisterAddress address = 0;
+        RegisterState* due = nullptr;
+
+        for (auto& [register_address, state] : registers_) {
+            if (!state.pending || state.in_flight) {
+                continue;
+            }
+
+            // Pending writes are flushed without spacing on shutdown
+            Clock::time_point ready = (state.last_write && !stopping_)
+                ? *state.last_write + min_interval_ : now;
+            if (ready <= now) {
+                address = register_address;
+                due = &state;
+                break;
+            }
+            if (!next_due || ready < *next_due) {
+                next_due = ready;
+            }
+        }
+
+        if (!due) {
+            if (stopping_) {
+                break;
+            }
+            if (next_due) {
+                cv_.wait_until(lock, *next_due);
+            } else {
+                cv_.wait(lock);
+            }
+            continue;
+        }
+
+        Pending pending = std::move(*due->pending);
+        due->pending.reset();
+
+        if (due->confirmed == pending.value) {
+            skipped_.fetch_add(1, std::memory_order_relaxed);
+            complete(pending, SetpointResult::SKIPPED);
+            continue;
+        }
+
+        due->in_flight = true;
+        lock.unlock();
+
+        bool success = false;
+        try {
+            success = writer_(address, pending.value);
+        } catch (const std::exception& e) {
+            LOG_ERROR("Setpoint write {} -> {} failed: {}", address, pending.value, e.what());
+        }
+
+        lock.lock();
+        due->in_flight = false;
+        due->last_write = Clock::now();
+
+        if (success) {
+            due->confirmed = pending.value;
+            due->confirmed_at = std::chrono::system_clock::now();
+            applied_.fetch_add(1, std::memory_order_relaxed);
+            complete(pending, SetpointResult::APPLIED);
+        } else {
+            due->confirmed.reset(); // Register state unknown after a failed write
+            failed_.fetch_add(1, std::memory_order_relaxed);
+            complete(pending, SetpointResult::FAILED);
+        }
+    }
+}
+
+void SetpointWriter::complete(Pending& pending, SetpointResult result) {
+    pending.promise->set_value(result);
+}
+
+} // namespace ecoWatt
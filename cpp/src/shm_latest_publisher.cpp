@@ -0,0 +1,140 @@
+/**
+ * @file shm_latest_publisher.cpp
+ * @brief Implementation of the shared-memory latest-value publisher
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "shm_latest_publisher.hpp"
+#include "exceptions.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+
+namespace ecoWatt {
+
+namespace {
+
+void copyTruncated(char* dest, size_t size, const std::string& text) {
+    const size_t length = std::min(size - 1, text.size());
+    std::memcpy(dest, text.data(), length);
+    dest[length] = '\0';
+}
+
+} // namespace
+
+ShmLatestPublisher::ShmLatestPublisher(const SharedMemoryConfig& config,
+                                       const std::map<RegisterAddress, RegisterConfig>& registers)
+    : config_(config), slot_count_(registers.size()) {
+
+    if (config_.name.size() < 2 || config_.name[0] != '/' ||
+        config_.name.find('/', 1) != std::string::npos) {
+        throw ValidationException("Shared-memory name must be '/' followed by a name without slashes: " + config_.name);
+    }
+
+    // A fresh segment per run: readers still mapping a previous one see it
+    // invalidated instead of having its layout change under them
+    ::shm_unlink(config_.name.c_str());
+    const int fd = ::shm_open(config_.name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        throw StorageException("shm_open " + config_.name + ": " + std::strerror(errno));
+    }
+    struct stat st {};
+    ::fstat(fd, &st);
+    device_ = st.st_dev;
+    inode_ = st.st_ino;
+    size_ = shmTableSize(static_cast<uint32_t>(slot_count_));
+    if (::ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+        const int error = errno;
+        ::close(fd);
+        ::shm_unlink(config_.name.c_str());
+        throw StorageException("ftruncate " + config_.name + ": " + std::strerror(error));
+    }
+    void* base = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        ::shm_unlink(config_.name.c_str());
+        throw StorageException("mmap " + config_.name + ": " + std::strerror(error));
+    }
+    base_ = base;
+
+    // ftruncate zero-fills; construct the atomics in place
+    header_ = new (base_) ShmTableHeader{};
+    slots_ = reinterpret_cast<ShmSlot*>(static_cast<char*>(base_) + sizeof(ShmTableHeader));
+    size_t index = 0;
+    for (const auto& [address, reg] : registers) {
+        ShmSlot* slot = new (&slots_[index++]) ShmSlot{};
+        slot->address = address;
+        copyTruncated(slot->name, sizeof(slot->name), reg.name);
+        copyTruncated(slot->unit, sizeof(slot->unit), reg.unit);
+        slot_by_address_.emplace(address, slot);
+    }
+
+    header_->version = kShmTableVersion;
+    header_->slot_count = static_cast<uint32_t>(slot_count_);
+    header_->slot_size = sizeof(ShmSlot);
+    header_->created_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    header_->publisher_pid = static_cast<int32_t>(::getpid());
+    header_->magic.store(kShmTableMagic, std::memory_order_release);
+
+    LOG_INFO("Latest values published in shared memory {} ({} slots, {} bytes)", config_.name, slot_count_, size_);
+}
+
+ShmLatestPublisher::~ShmLatestPublisher() {
+    if (!base_) {
+        return;
+    }
+    header_->magic.store(0, std::memory_order_release);
+    ::munmap(base_, size_);
+    if (!config_.unlink_on_exit) {
+        return;
+    }
+    const int fd = ::shm_open(config_.name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return;
+    }
+    struct stat st {};
+    const bool ours = ::fstat(fd, &st) == 0 && st.st_dev == device_ && st.st_ino == inode_;
+    ::close(fd);
+    if (ours) {
+        ::shm_unlink(config_.name.c_str());
+    }
+}
+
+void ShmLatestPublisher::publish(const AcquisitionSample& sample) {
+    auto it = slot_by_address_.find(sample.register_address);
+    if (it == slot_by_address_.end()) {
+        unknown_register_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ShmSlot& slot = *it->second;
+
+    // Claim the slot by making its sequence odd
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    do {
+        sequence &= ~1u;
+    } while (!slot.sequence.compare_exchange_weak(sequence, sequence + 1,
+                                                  std::memory_order_acquire, std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.raw_value.store(sample.raw_value, std::memory_order_relaxed);
+    slot.value.store(sample.scaled_value, std::memory_order_relaxed);
+    slot.timestamp_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        sample.timestamp.time_since_epoch()).count(), std::memory_order_relaxed);
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+    header_->publish_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+ShmLatestPublisher::Statistics ShmLatestPublisher::getStatistics() const {
+    Statistics stats;
+    stats.published = header_->publish_count.load(std::memory_order_relaxed);
+    stats.unknown_register = unknown_register_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace ecoWatt
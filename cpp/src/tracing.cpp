@@ -0,0 +1,236 @@
+/**
+ * @file tracing.cpp
+ * @brief Implementation of the span tracer and its Chrome trace export
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "tracing.hpp"
+#include "logger.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ecoWatt {
+
+std::atomic<bool> Tracer::enabled_{false};
+
+namespace {
+
+struct Event {
+    const char* name = nullptr;
+    const char* category = nullptr;
+    uint64_t start = 0;
+    uint64_t end = 0;
+};
+
+struct ThreadRing {
+    std::mutex mutex;
+    std::vector<Event> events;  // Grows to capacity, then wraps
+    uint32_t capacity = 0;
+    uint64_t next = 0;          // Total recorded; slot is next % events.size()
+    uint32_t tid = 0;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    std::atomic<uint32_t> capacity{TracingConfig{}.buffer_events};
+    uint32_t next_tid = 1;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+uint64_t steadyNanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+const uint64_t kEpoch = steadyNanoseconds() - 1;  // Keeps Tracer::now() non-zero
+
+ThreadRing& localRing() {
+    thread_local std::shared_ptr<ThreadRing> ring = [] {
+        auto created = std::make_shared<ThreadRing>();
+        auto& shared = registry();
+        created->capacity = shared.capacity.load();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        created->tid = shared.next_tid++;
+        shared.rings.push_back(created);
+        return created;
+    }();
+    return *ring;
+}
+
+struct PeriodicDump {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread thread;
+    bool stop = false;
+};
+
+PeriodicDump& periodicDump() {
+    static PeriodicDump instance;
+    return instance;
+}
+
+} // namespace
+
+void Tracer::setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::configure(const TracingConfig& config) {
+    registry().capacity.store(std::max<uint32_t>(1, config.buffer_events));
+    stopPeriodicDump();
+    clear();
+    setEnabled(config.enabled);
+
+    if (config.enabled && config.dump_interval.count() > 0) {
+        startPeriodicDump(config.output, config.dump_interval, config.dump_files);
+    }
+    if (config.enabled) {
+        LOG_INFO("Tracing enabled ({} spans per thread, output {})", config.buffer_events, config.output);
+    }
+}
+
+uint64_t Tracer::now() {
+    return steadyNanoseconds() - kEpoch;
+}
+
+void Tracer::record(const char* name, const char* category, uint64_t start_ns, uint64_t end_ns) {
+    ThreadRing& ring = localRing();
+    std::lock_guard<std::mutex> lock(ring.mutex);  // Only contended while exporting
+    const Event event{name, category, start_ns, end_ns};
+    if (ring.events.size() < ring.capacity) {
+        // Grown on demand: a thread recording a few spans never pays for a full ring
+        ring.events.push_back(event);
+    } else {
+        ring.events[ring.next % ring.events.size()] = event;
+    }
+    ++ring.next;
+}
+
+std::string Tracer::toChromeJson() {
+    nlohmann::json events = nlohmann::json::array();
+    events.push_back({{"name", "process_name"}, {"ph", "M"}, {"pid", 1}, {"tid", 0},
+                      {"args", {{"name", "ecoWatt"}}}});
+
+    auto& shared = registry();
+    std::lock_guard<std::mutex> registry_lock(shared.mutex);
+    for (const auto& ring : shared.rings) {
+        std::lock_guard<std::mutex> lock(ring->mutex);
+        const uint64_t size = ring->events.size();
+        const uint64_t count = std::min(ring->next, size);
+        if (count == 0) {
+            continue;
+        }
+
+        events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", ring->tid},
+                          {"args", {{"name", "thread " + std::to_string(ring->tid)}}}});
+        for (uint64_t i = ring->next - count; i < ring->next; ++i) {
+            const Event& event = ring->events[i % size];
+            events.push_back({{"name", event.name},
+                              {"cat", event.category},
+                              {"ph", "X"},
+                              {"ts", static_cast<double>(event.start) / 1000.0},
+                              {"dur", static_cast<double>(event.end - event.start) / 1000.0},
+                              {"pid", 1},
+                              {"tid", ring->tid}});
+        }
+    }
+
+    nlohmann::json trace;
+    trace["traceEvents"] = std::move(events);
+    trace["displayTimeUnit"] = "ns";
+    return trace.dump();
+}
+
+bool Tracer::writeChromeTrace(const std::string& path) {
+    std::string json = toChromeJson();
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("Cannot write trace file: {}", path);
+        return false;
+    }
+    file << json;
+    LOG_DEBUG("Trace written to '{}' ({} bytes)", path, json.size());
+    return true;
+}
+
+void Tracer::clear() {
+    auto& shared = registry();
+    const uint32_t capacity = shared.capacity.load();
+    std::lock_guard<std::mutex> registry_lock(shared.mutex);
+
+    // Rings whose thread has exited are only referenced by the registry
+    shared.rings.erase(std::remove_if(shared.rings.begin(), shared.rings.end(),
+                                      [](const std::shared_ptr<ThreadRing>& ring) { return ring.use_count() == 1; }),
+                       shared.rings.end());
+    for (const auto& ring : shared.rings) {
+        std::lock_guard<std::mutex> lock(ring->mutex);
+        ring->events.clear();
+        ring->events.shrink_to_fit();
+        ring->capacity = capacity;
+        ring->next = 0;
+    }
+}
+
+size_t Tracer::eventCount() {
+    auto& shared = registry();
+    std::lock_guard<std::mutex> registry_lock(shared.mutex);
+    size_t total = 0;
+    for (const auto& ring : shared.rings) {
+        std::lock_guard<std::mutex> lock(ring->mutex);
+        total += static_cast<size_t>(std::min<uint64_t>(ring->next, ring->events.size()));
+    }
+    return total;
+}
+
+void Tracer::startPeriodicDump(const std::string& output, Duration interval, uint32_t files) {
+    stopPeriodicDump();
+
+    std::string stem = output;
+    if (stem.size() > 5 && stem.compare(stem.size() - 5, 5, ".json") == 0) {
+        stem.resize(stem.size() - 5);
+    }
+
+    auto& dump = periodicDump();
+    std::lock_guard<std::mutex> lock(dump.mutex);
+    dump.stop = false;
+    dump.thread = std::thread([stem, interval, files]() {
+        auto& state = periodicDump();
+        uint32_t index = 0;
+        std::unique_lock<std::mutex> lock(state.mutex);
+        while (!state.cv.wait_for(lock, interval, [&state] { return state.stop; })) {
+            lock.unlock();
+            writeChromeTrace(stem + "." + std::to_string(index) + ".json");
+            index = (index + 1) % std::max<uint32_t>(1, files);
+            lock.lock();
+        }
+    });
+}
+
+void Tracer::stopPeriodicDump() {
+    auto& dump = periodicDump();
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(dump.mutex);
+        dump.stop = true;
+        thread = std::move(dump.thread);
+    }
+    dump.cv.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+} // namespace ecoWatt
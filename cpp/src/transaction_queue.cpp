@@ -0,0 +1,101 @@
+/**
+ * @file transaction_queue.cpp
+ * @brief Implementation of prioritized transaction admission
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "transaction_queue.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace ecoWatt {
+
+TransactionQueue::Slot TransactionQueue::acquire(TransactionLane lane) {
+    const size_t index = static_cast<size_t>(lane);
+    auto enqueued = std::chrono::steady_clock::now();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        uint64_t ticket = next_ticket_++;
+        waiting_[index].push_back(ticket);
+
+        cv_.wait(lock, [&] {
+            if (in_flight_ >= capacity_) {
+                return false;
+            }
+            for (size_t higher = 0; higher < index; ++higher) {
+                if (!waiting_[higher].empty()) {
+                    return false;
+                }
+            }
+            return waiting_[index].front() == ticket;
+        });
+
+        waiting_[index].pop_front();
+        ++in_flight_;
+    }
+
+    admitted_[index].fetch_add(1, std::memory_order_relaxed);
+    queue_latency_[index].record(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - enqueued));
+
+    return Slot(this);
+}
+
+void TransactionQueue::release() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --in_flight_;
+    }
+    cv_.notify_all();
+}
+
+void TransactionQueue::setCapacity(size_t capacity) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_ = std::max<size_t>(capacity, 1);
+    }
+    cv_.notify_all();
+}
+
+size_t TransactionQueue::getCapacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+size_t TransactionQueue::inFlight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+}
+
+TransactionQueue::LaneStatistics TransactionQueue::getLaneStatistics(TransactionLane lane) const {
+    const size_t index = static_cast<size_t>(lane);
+
+    LaneStatistics stats;
+    stats.admitted = admitted_[index].load(std::memory_order_relaxed);
+    stats.queue_latency = queue_latency_[index].snapshot();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats.waiting = waiting_[index].size();
+    }
+    return stats;
+}
+
+void TransactionQueue::resetStatistics() {
+    for (size_t i = 0; i < kLaneCount; ++i) {
+        admitted_[i].store(0, std::memory_order_relaxed);
+        queue_latency_[i].reset();
+    }
+}
+
+const char* TransactionQueue::laneName(TransactionLane lane) {
+    switch (lane) {
+        case TransactionLane::CONTROL: return "control";
+        case TransactionLane::INTERACTIVE: return "interactive";
+        case TransactionLane::BACKGROUND: return "background";
+        default: return "unknown";
+    }
+}
+
+} // namespace ecoWatt
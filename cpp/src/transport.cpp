@@ -0,0 +1,36 @@
+/**
+ * @file transport.cpp
+ * @brief Transport selection from configuration
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "transport.hpp"
+#include "http_transport.hpp"
+#include "modbus_tcp_transport.hpp"
+#include "modbus_rtu_transport.hpp"
+#include "config_manager.hpp"
+
+namespace ecoWatt {
+
+UniquePtr<Transport> createTransport(const ConfigManager& config) {
+    const ModbusConfig& modbus_config = config.getModbusConfig();
+    
+    switch (modbus_config.transport) {
+        case TransportType::HTTP:
+            return std::make_unique<HttpTransport>(config.getApiConfig(), modbus_config.timeout);
+        case TransportType::MODBUS_TCP:
+            return std::make_unique<ModbusTcpTransport>(modbus_config.tcp_host, modbus_config.tcp_port,
+                                                        modbus_config.timeout,
+                                                        modbus_config.tcp_max_in_flight);
+        case TransportType::MODBUS_RTU:
+            return std::make_unique<ModbusRtuTransport>(modbus_config.serial_device,
+                                                        modbus_config.serial_baud_rate,
+                                                        modbus_config.serial_parity,
+                                                        modbus_config.timeout);
+        default:
+            throw ConfigException("Unsupported transport: " + to_string(modbus_config.transport));
+    }
+}
+
+} // namespace ecoWatt
@@ -0,0 +1,247 @@
+/**
+ * @file uplink.cpp
+ * @brief Implementation of the store-and-forward uplink
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "uplink.hpp"
+#include "uplink_codec.hpp"
+#include "logger.hpp"
+#include "tracing.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+
+namespace ecoWatt {
+
+UplinkForwarder::UplinkForwarder(const UplinkConfig& config, std::shared_ptr<HybridDataStorage> storage, Sender sender)
+    : config_(config), storage_(std::move(storage)), sender_(std::move(sender)) {
+
+    if (!storage_) {
+        throw ValidationException("UplinkForwarder requires storage");
+    }
+    if (config_.batch_max_samples == 0 || config_.batch_max_bytes == 0 ||
+        config_.retry_initial.count() <= 0 || config_.retry_max < config_.retry_initial) {
+        throw ValidationException("UplinkForwarder needs positive batch limits and retry_max >= retry_initial");
+    }
+    if (!sender_) {
+        http_client_ = std::make_unique<HttpClient>(config_.collector_url,
+                                                    static_cast<uint32_t>(config_.request_timeout.count()));
+        sender_ = [this](const Delivery& delivery) { return httpSend(delivery); };
+    }
+
+    cursor_ = storage_->loadCursor(kCursorName);
+    LOG_INFO("Uplink to {}{} resuming after row {}", config_.collector_url, config_.path, cursor_.load());
+}
+
+UplinkForwarder::~UplinkForwarder() {
+    stop();
+}
+
+void UplinkForwarder::start() {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    if (running_) {
+        return;
+    }
+    stop_requested_ = false;
+    running_ = true;
+    worker_ = std::thread([this]() { workerLoop(); });
+}
+
+void UplinkForwarder::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        if (!running_) {
+            return;
+        }
+        stop_requested_ = true;
+    }
+    wake_cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    running_ = false;
+    LOG_INFO("Uplink stopped at row {}", cursor_.load());
+}
+
+void UplinkForwarder::workerLoop() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (!stop_requested_) {
+        lock.unlock();
+        CycleResult result;
+        try {
+            result = runOnce();
+        } catch (const std::exception& e) {
+            // Storage errors: treated like a failed delivery
+            LOG_ERROR("Uplink cycle failed: {}", e.what());
+            std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+            ++stats_.failures;
+            ++stats_.consecutive_failures;
+            stats_.last_error = e.what();
+            result = CycleResult::FAILED;
+        }
+        const Duration delay = nextDelay(result);
+        lock.lock();
+        if (delay.count() > 0) {
+            wake_cv_.wait_for(lock, delay, [this]() { return stop_requested_; });
+        }
+    }
+}
+
+Duration UplinkForwarder::nextDelay(CycleResult result) {
+    switch (result) {
+        case CycleResult::SENT: {
+            // More backlog: pace the catch-up; caught up: back to polling
+            if (newest_id_.load() <= cursor_.load()) {
+                return config_.poll_interval;
+            }
+            if (config_.max_batches_per_second <= 0.0) {
+                return Duration(0);
+            }
+            return Duration(static_cast<int64_t>(1000.0 / config_.max_batches_per_second));
+        }
+        case CycleResult::FAILED: {
+            uint32_t failures;
+            {
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                failures = stats_.consecutive_failures;
+            }
+            // retry_initial * 2^(failures-1), capped, then "equal jitter"
+            const uint32_t doublings = std::min<uint32_t>(failures > 0 ? failures - 1 : 0, 30);
+            const int64_t backoff = std::min<int64_t>(config_.retry_initial.count() << doublings,
+                                                      config_.retry_max.count());
+            std::uniform_int_distribution<int64_t> jitter(0, backoff / 2);
+            return Duration(backoff - backoff / 2 + jitter(jitter_));
+        }
+        case CycleResult::WAITING:
+        case CycleResult::IDLE:
+        default:
+            return config_.poll_interval;
+    }
+}
+
+UplinkForwarder::CycleResult UplinkForwarder::runOnce() {
+    TRACE_SPAN("UplinkForwarder::runOnce", "uplink");
+    const uint64_t cursor = cursor_.load();
+    const uint64_t newest = storage_->getLastSampleId();
+    newest_id_ = newest;
+    if (newest <= cursor) {
+        return CycleResult::IDLE;
+    }
+
+    // Hold a partial batch until its oldest row reaches batch_max_age
+    if (!oldest_pending_) {
+        auto first = storage_->getSamplesAfter(cursor, 1);
+        if (first.empty()) {
+            return CycleResult::IDLE;
+        }
+        // A row stamped ahead of the clock (skew, clock step) ages from now
+        oldest_pending_ = std::min(first.front().timestamp, std::chrono::system_clock::now());
+    }
+    const bool full = newest - cursor >= config_.batch_max_samples;
+    if (!full && std::chrono::system_clock::now() - *oldest_pending_ < config_.batch_max_age) {
+        return CycleResult::WAITING;
+    }
+
+    auto rows = storage_->getSamplesAfter(cursor, config_.batch_max_samples);
+    if (rows.empty()) {
+        oldest_pending_.reset();
+        return CycleResult::IDLE;
+    }
+
+    UplinkBatchEncoder encoder;
+    for (const auto& row : rows) {
+        encoder.add(row);
+        if (encoder.size() >= config_.batch_max_bytes) {
+            break;
+        }
+    }
+
+    Delivery delivery;
+    delivery.first_id = encoder.firstId();
+    delivery.last_id = encoder.lastId();
+    delivery.samples = encoder.count();
+    auto encoded = encoder.finish();
+    const size_t encoded_size = encoded.size();
+    if (config_.compress) {
+        delivery.body = UplinkCodec::gzip(encoded);
+        delivery.content_encoding = "gzip";
+    } else {
+        delivery.body = std::move(encoded);
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    uint64_t ack;
+    try {
+        ack = sender_(delivery);
+        // An ack at or behind the cursor moved nothing: retry with backoff, not at once
+        if (ack > delivery.last_id || ack <= cursor) {
+            throw HttpException("Collector acknowledged row " + std::to_string(ack) + " for rows " +
+                                std::to_string(delivery.first_id) + ".." + std::to_string(delivery.last_id));
+        }
+    } catch (const std::exception& e) {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        ++stats_.failures;
+        ++stats_.consecutive_failures;
+        stats_.last_error = e.what();
+        if (stats_.consecutive_failures == 1) {
+            LOG_WARN("Uplink delivery of rows {}..{} failed, will retry: {}",
+                     delivery.first_id, delivery.last_id, e.what());
+        }
+        return CycleResult::FAILED;
+    }
+    send_latency_.record(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - started));
+
+    storage_->saveCursor(kCursorName, ack);
+    cursor_ = ack;
+    oldest_pending_.reset();
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    if (stats_.consecutive_failures > 0) {
+        LOG_INFO("Uplink delivering again after {} failed attempts", stats_.consecutive_failures);
+    }
+    stats_.consecutive_failures = 0;
+    ++stats_.batches_sent;
+    stats_.samples_sent += delivery.samples;
+    stats_.bytes_encoded += encoded_size;
+    stats_.bytes_sent += delivery.body.size();
+    return CycleResult::SENT;
+}
+
+uint64_t UplinkForwarder::httpSend(const Delivery& delivery) {
+    std::map<std::string, std::string> headers = {
+        {"X-Batch-First-Id", std::to_string(delivery.first_id)},
+        {"X-Batch-Last-Id", std::to_string(delivery.last_id)}};
+    if (!delivery.content_encoding.empty()) {
+        headers["Content-Encoding"] = delivery.content_encoding;
+    }
+    if (!config_.api_key.empty()) {
+        headers["Authorization"] = config_.api_key;
+    }
+
+    HttpResponse response = http_client_->postBytes(config_.path, delivery.body, UplinkCodec::kContentType, headers);
+    if (!response.isSuccess()) {
+        throw HttpException("Collector answered " + std::to_string(response.status_code));
+    }
+    auto body = nlohmann::json::parse(response.body, nullptr, false);
+    if (body.is_discarded() || !body.contains("ack") || !body["ack"].is_number_unsigned()) {
+        throw HttpException("Collector reply has no ack");
+    }
+    return body["ack"].get<uint64_t>();
+}
+
+UplinkForwarder::Statistics UplinkForwarder::getStatistics() const {
+    Statistics stats;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats = stats_;
+    }
+    stats.cursor = cursor_.load();
+    stats.newest_id = std::max(newest_id_.load(), stats.cursor);
+    stats.backlog = stats.newest_id - stats.cursor;
+    stats.send_latency = send_latency_.snapshot();
+    return stats;
+}
+
+} // namespace ecoWatt
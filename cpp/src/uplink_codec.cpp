@@ -0,0 +1,235 @@
+/**
+ * @file uplink_codec.cpp
+ * @brief Implementation of the uplink batch format
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "uplink_codec.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <zlib.h>
+
+namespace ecoWatt {
+
+namespace {
+
+constexpr uint8_t kMagic[3] = {'E', 'W', 'B'};
+constexpr uint8_t kVersion = 1;
+constexpr double kMaxExactInteger = 4503599627370496.0;  // 2^52: zigzag << 1 still fits
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+class Reader {
+public:
+    Reader(const std::vector<uint8_t>& data, size_t pos) : data_(data), pos_(pos) {}
+
+    bool atEnd() const { return pos_ == data_.size(); }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const uint8_t byte = next();
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        throw ValidationException("Malformed uplink batch: varint too long");
+    }
+
+    double ieee754() {
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; ++i) {
+            bits |= static_cast<uint64_t>(next()) << (8 * i);
+        }
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    uint8_t next() {
+        if (pos_ >= data_.size()) {
+            throw ValidationException("Malformed uplink batch: truncated");
+        }
+        return data_[pos_++];
+    }
+
+private:
+    const std::vector<uint8_t>& data_;
+    size_t pos_;
+};
+
+} // namespace
+
+// UplinkBatchEncoder
+
+UplinkBatchEncoder::UplinkBatchEncoder() {
+    reset();
+}
+
+void UplinkBatchEncoder::reset() {
+    buffer_.clear();
+    buffer_.insert(buffer_.end(), std::begin(kMagic), std::end(kMagic));
+    buffer_.push_back(kVersion);
+    count_ = 0;
+    first_id_ = 0;
+    previous_id_ = 0;
+    previous_timestamp_ = 0;
+    previous_values_.clear();
+}
+
+void UplinkBatchEncoder::add(const StoredSample& row) {
+    if (count_ == 0) {
+        first_id_ = row.id;
+    } else if (row.id <= previous_id_) {
+        throw ValidationException("Uplink batch rows must be in increasing id order");
+    }
+    putVarint(buffer_, row.id - previous_id_);
+    putVarint(buffer_, row.register_address);
+
+    const int64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        row.timestamp.time_since_epoch()).count();
+    putVarint(buffer_, zigzag(timestamp - previous_timestamp_));
+
+    if (std::nearbyint(row.value) == row.value && std::fabs(row.value) < kMaxExactInteger) {
+        const int64_t value = static_cast<int64_t>(row.value);
+        int64_t& previous = previous_values_[row.register_address];
+        putVarint(buffer_, zigzag(value - previous) << 1);
+        previous = value;
+    } else {
+        putVarint(buffer_, 1);
+        uint64_t bits;
+        std::memcpy(&bits, &row.value, sizeof(bits));
+        for (int i = 0; i < 8; ++i) {
+            buffer_.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+        }
+    }
+
+    previous_id_ = row.id;
+    previous_timestamp_ = timestamp;
+    ++count_;
+}
+
+std::vector<uint8_t> UplinkBatchEncoder::finish() {
+    std::vector<uint8_t> batch;
+    batch.swap(buffer_);
+    reset();
+    return batch;
+}
+
+// UplinkCodec
+
+std::vector<StoredSample> UplinkCodec::decode(const std::vector<uint8_t>& data) {
+    if (data.size() < 4 || std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+        throw ValidationException("Malformed uplink batch: bad magic");
+    }
+    if (data[3] != kVersion) {
+        throw ValidationException("Unsupported uplink batch version " + std::to_string(data[3]));
+    }
+
+    Reader reader(data, 4);
+    std::vector<StoredSample> rows;
+    std::unordered_map<RegisterAddress, int64_t> previous_values;
+    uint64_t previous_id = 0;
+    int64_t previous_timestamp = 0;
+
+    while (!reader.atEnd()) {
+        StoredSample row;
+        row.id = previous_id + reader.varint();
+        const uint64_t address = reader.varint();
+        if (address > 0xFFFF) {
+            throw ValidationException("Malformed uplink batch: register address out of range");
+        }
+        row.register_address = static_cast<RegisterAddress>(address);
+        const int64_t timestamp = previous_timestamp + unzigzag(reader.varint());
+        row.timestamp = TimePoint(std::chrono::milliseconds(timestamp));
+
+        const uint64_t value = reader.varint();
+        if (value & 1) {
+            row.value = reader.ieee754();
+        } else {
+            int64_t& previous = previous_values[row.register_address];
+            previous += unzigzag(value >> 1);
+            row.value = static_cast<double>(previous);
+        }
+
+        previous_id = row.id;
+        previous_timestamp = timestamp;
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+std::vector<uint8_t> UplinkCodec::gzip(const std::vector<uint8_t>& data, int level) {
+    z_stream stream{};
+    // windowBits 15 + 16: gzip header and trailer
+    if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw ValidationException("deflateInit2 failed");
+    }
+    std::vector<uint8_t> out(deflateBound(&stream, static_cast<uLong>(data.size())));
+    stream.next_in = const_cast<Bytef*>(data.data());
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = out.data();
+    stream.avail_out = static_cast<uInt>(out.size());
+    const int rc = deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    if (rc != Z_STREAM_END) {
+        throw ValidationException("gzip compression failed");
+    }
+    return out;
+}
+
+std::vector<uint8_t> UplinkCodec::gunzip(const std::vector<uint8_t>& data, size_t max_size) {
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 16) != Z_OK) {
+        throw ValidationException("inflateInit2 failed");
+    }
+    std::vector<uint8_t> out(std::min(std::max<size_t>(data.size() * 4, 1024), std::max<size_t>(max_size, 1)));
+    stream.next_in = const_cast<Bytef*>(data.data());
+    stream.avail_in = static_cast<uInt>(data.size());
+
+    int rc = Z_OK;
+    while (rc != Z_STREAM_END) {
+        if (stream.total_out == out.size()) {
+            if (out.size() >= max_size) {
+                inflateEnd(&stream);
+                throw ValidationException("gzip body inflates beyond " + std::to_string(max_size) + " bytes");
+            }
+            out.resize(std::min(out.size() * 2, max_size));
+        }
+        stream.next_out = out.data() + stream.total_out;
+        stream.avail_out = static_cast<uInt>(out.size() - stream.total_out);
+        rc = inflate(&stream, Z_NO_FLUSH);
+        if (rc != Z_OK && rc != Z_STREAM_END) {
+            inflateEnd(&stream);
+            throw ValidationException("Corrupt gzip body");
+        }
+        if (rc == Z_OK && stream.avail_in == 0 && stream.avail_out != 0) {
+            inflateEnd(&stream);
+            throw ValidationException("Truncated gzip body");
+        }
+    }
+    out.resize(stream.total_out);
+    inflateEnd(&stream);
+    return out;
+}
+
+} // namespace ecoWatt
@@ -0,0 +1,179 @@
+/**
+ * @file uplink_collector.cpp
+ * @brief Implementation of the stand-in uplink collector
+ * @author EcoWatt Team
+ * @date 2025-09-02
+ */
+
+#include "uplink_collector.hpp"
+#include "uplink_codec.hpp"
+#include "exceptions.hpp"
+#include "logger.hpp"
+#include <nlohmann/json.hpp>
+
+using namespace web;
+using namespace web::http;
+using namespace web::http::experimental::listener;
+
+namespace ecoWatt {
+
+UplinkCollectorServer::UplinkCollectorServer(const std::string& base_url,
+                                             const std::string& path,
+                                             const std::string& api_key)
+    : base_url_(base_url), path_(path), api_key_(api_key) {
+}
+
+UplinkCollectorServer::~UplinkCollectorServer() {
+    try {
+        stop();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error stopping uplink collector: {}", e.what());
+    }
+}
+
+void UplinkCollectorServer::start() {
+    if (running_) {
+        return;
+    }
+
+    try {
+        listener_ = std::make_unique<http_listener>(utility::conversions::to_string_t(base_url_));
+        listener_->support(methods::POST, [this](http_request request) { handlePost(request); });
+        listener_->open().wait();
+        running_ = true;
+
+        LOG_INFO("Uplink collector listening on {}{}", base_url_, path_);
+    } catch (const std::exception& e) {
+        listener_.reset();
+        throw HttpException("Failed to start uplink collector on " + base_url_ + ": " + e.what());
+    }
+}
+
+void UplinkCollectorServer::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    listener_->close().wait();
+    listener_.reset();
+
+    LOG_INFO("Uplink collector stopped");
+}
+
+UplinkCollectorServer::Reply UplinkCollectorServer::ingest(const std::vector<uint8_t>& body,
+                                                           const std::string& content_encoding) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!available_) {
+            ++stats_.rejected;
+            return {503, high_water_};
+        }
+        if (fail_next_ > 0) {
+            --fail_next_;
+            ++stats_.rejected;
+            return {500, high_water_};
+        }
+    }
+
+    std::vector<StoredSample> rows;
+    size_t decoded_size = body.size();
+    try {
+        if (content_encoding == "gzip") {
+            auto decoded = UplinkCodec::gunzip(body);
+            decoded_size = decoded.size();
+            rows = UplinkCodec::decode(decoded);
+        } else if (content_encoding.empty() || content_encoding == "identity") {
+            rows = UplinkCodec::decode(body);
+        } else {
+            throw ValidationException("Unsupported Content-Encoding " + content_encoding);
+        }
+    } catch (const ValidationException& e) {
+        LOG_DEBUG("Uplink collector rejected batch: {}", e.what());
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.rejected;
+        return {400, high_water_};
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& row : rows) {
+        if (row.id <= high_water_) {
+            ++stats_.duplicates;
+            continue;
+        }
+        samples_.push_back(row);
+        high_water_ = row.id;
+        ++stats_.samples;
+    }
+    ++stats_.batches;
+    stats_.bytes_received += body.size();
+    stats_.bytes_decoded += decoded_size;
+    return {200, high_water_};
+}
+
+void UplinkCollectorServer::handlePost(http_request request) {
+    std::string path = utility::conversions::to_utf8string(request.relative_uri().path());
+    if (path != path_) {
+        request.reply(status_codes::NotFound);
+        return;
+    }
+
+    if (!api_key_.empty()) {
+        auto it = request.headers().find(U("Authorization"));
+        if (it == request.headers().end() ||
+            utility::conversions::to_utf8string(it->second) != api_key_) {
+            request.reply(static_cast<status_code>(401));
+            return;
+        }
+    }
+
+    std::string content_encoding;
+    auto it = request.headers().find(U("Content-Encoding"));
+    if (it != request.headers().end()) {
+        content_encoding = utility::conversions::to_utf8string(it->second);
+    }
+
+    Reply reply;
+    try {
+        auto body = request.extract_vector().get();
+        reply = ingest(std::vector<uint8_t>(body.begin(), body.end()), content_encoding);
+    } catch (const std::exception& e) {
+        LOG_DEBUG("Uplink collector failed to read request: {}", e.what());
+        request.reply(status_codes::BadRequest);
+        return;
+    }
+
+    if (reply.status != 200) {
+        request.reply(static_cast<status_code>(reply.status));
+        return;
+    }
+    nlohmann::json ack = {{"ack", reply.ack}};
+    request.reply(status_codes::OK, ack.dump(), "application/json");
+}
+
+void UplinkCollectorServer::setAvailable(bool available) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    available_ = available;
+}
+
+void UplinkCollectorServer::failNext(uint32_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fail_next_ = count;
+}
+
+std::vector<StoredSample> UplinkCollectorServer::samples() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return samples_;
+}
+
+uint64_t UplinkCollectorServer::highWater() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return high_water_;
+}
+
+UplinkCollectorServer::Statistics UplinkCollectorServer::getStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace ecoWatt
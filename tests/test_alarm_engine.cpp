@@ -0,0 +1,198 @@
+/**
+ * @file test_alarm_engine.cpp
+ * @brief Tests for the per-sample alarm rule engine
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/alarm_engine.hpp"
+#include "../cpp/include/config_manager.hpp"
+#include "../cpp/include/exceptions.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace ecoWatt;
+using namespace std::chrono_literals;
+
+namespace {
+
+const TimePoint kStart = TimePoint(std::chrono::seconds(1700000000));
+
+AlarmRuleConfig rule(const std::string& name, RegisterAddress address, AlarmCondition condition,
+                     double threshold, double hysteresis = 0.0, Duration duration = Duration(0)) {
+    AlarmRuleConfig config;
+    config.name = name;
+    config.address = address;
+    config.condition = condition;
+    config.threshold = threshold;
+    config.hysteresis = hysteresis;
+    config.duration = duration;
+    return config;
+}
+
+AcquisitionSample sample(RegisterAddress address, double value, std::chrono::seconds offset) {
+    return AcquisitionSample(kStart + offset, address, "", static_cast<RegisterValue>(value * 10), value, "");
+}
+
+struct Recorded {
+    AlarmTransition transition;
+    std::string rule;
+    double value;
+    TimePoint timestamp;
+};
+
+class AlarmEngineTest : public ::testing::Test {
+protected:
+    void build(const std::vector<AlarmRuleConfig>& rules) {
+        engine_ = std::make_unique<AlarmEngine>(rules);
+        engine_->addCallback([this](const AlarmEvent& event) {
+            events_.push_back({event.transition, std::string(event.rule), event.value, event.timestamp});
+        });
+    }
+
+    std::unique_ptr<AlarmEngine> engine_;
+    std::vector<Recorded> events_;
+};
+
+} // namespace
+
+TEST_F(AlarmEngineTest, Threshold_RaisesAndClearsOnce) {
+    build({rule("Hot", 7, AlarmCondition::ABOVE, 70.0)});
+
+    engine_->evaluate(sample(7, 65.0, 0s));
+    engine_->evaluate(sample(7, 71.0, 1s));
+    engine_->evaluate(sample(7, 75.0, 2s));
+    ASSERT_EQ(events_.size(), 1u);
+    EXPECT_EQ(events_[0].transition, AlarmTransition::RAISED);
+    EXPECT_EQ(events_[0].rule, "Hot");
+    EXPECT_DOUBLE_EQ(events_[0].value, 71.0);
+    EXPECT_EQ(events_[0].timestamp, kStart + 1s);
+
+    auto active = engine_->getActiveAlarms();
+    ASSERT_EQ(active.size(), 1u);
+    EXPECT_EQ(active[0].address, 7);
+    EXPECT_EQ(active[0].since, kStart + 1s);
+
+    engine_->evaluate(sample(7, 70.0, 3s));
+    ASSERT_EQ(events_.size(), 2u);
+    EXPECT_EQ(events_[1].transition, AlarmTransition::CLEARED);
+    EXPECT_TRUE(engine_->getActiveAlarms().empty());
+}
+
+TEST_F(AlarmEngineTest, Hysteresis_PreventsChatter) {
+    build({rule("Undervoltage", 0, AlarmCondition::BELOW, 207.0, 3.0)});
+
+    for (int i = 0; i < 10; ++i) {
+        engine_->evaluate(sample(0, i % 2 == 0 ? 206.0 : 209.0, std::chrono::seconds(i)));
+    }
+    ASSERT_EQ(events_.size(), 1u);
+
+    engine_->evaluate(sample(0, 210.0, 10s));
+    ASSERT_EQ(events_.size(), 2u);
+    EXPECT_EQ(events_[1].transition, AlarmTransition::CLEARED);
+}
+
+TEST_F(AlarmEngineTest, Duration_RequiresSustainedViolation) {
+    build({rule("Hot", 7, AlarmCondition::ABOVE, 70.0, 0.0, Duration(30000))});
+
+    engine_->evaluate(sample(7, 72.0, 0s));
+    engine_->evaluate(sample(7, 72.0, 20s));
+    engine_->evaluate(sample(7, 69.0, 25s));  // Resets the pending violation
+    engine_->evaluate(sample(7, 72.0, 30s));
+    engine_->evaluate(sample(7, 72.0, 50s));
+    EXPECT_TRUE(events_.empty());
+
+    engine_->evaluate(sample(7, 72.0, 60s));
+    ASSERT_EQ(events_.size(), 1u);
+    EXPECT_EQ(events_[0].timestamp, kStart + 60s);
+}
+
+TEST_F(AlarmEngineTest, RateOfChange_PerSecond) {
+    build({rule("Collapse", 1000, AlarmCondition::RATE_BELOW, -500.0),
+           rule("Surge", 1000, AlarmCondition::RATE_ABOVE, 500.0)});
+
+    engine_->evaluate(sample(1000, 3000.0, 0s));   // No previous sample yet
+    engine_->evaluate(sample(1000, 2000.0, 5s));   // -200 W/s
+    EXPECT_TRUE(events_.empty());
+
+    engine_->evaluate(sample(1000, 500.0, 7s));    // -750 W/s
+    ASSERT_EQ(events_.size(), 1u);
+    EXPECT_EQ(events_[0].rule, "Collapse");
+    EXPECT_DOUBLE_EQ(events_[0].value, -750.0);
+
+    engine_->evaluate(sample(1000, 500.0, 8s));    // Flat: clears
+    engine_->evaluate(sample(1000, 2000.0, 9s));   // +1500 W/s
+    ASSERT_EQ(events_.size(), 3u);
+    EXPECT_EQ(events_[1].transition, AlarmTransition::CLEARED);
+    EXPECT_EQ(events_[2].rule, "Surge");
+}
+
+TEST_F(AlarmEngineTest, Dispatch_OnlyRulesOfSampleRegister) {
+    build({rule("A", 5, AlarmCondition::ABOVE, 1.0), rule("B", 2, AlarmCondition::ABOVE, 1.0),
+           rule("C", 5, AlarmCondition::BELOW, 0.0)});
+    EXPECT_EQ(engine_->ruleCount(), 3u);
+
+    engine_->evaluate(sample(2, 10.0, 0s));
+    engine_->evaluate(sample(3, 10.0, 0s));        // No rules
+    engine_->evaluate(sample(60000, 10.0, 0s));    // Beyond the dispatch table
+    ASSERT_EQ(events_.size(), 1u);
+    EXPECT_EQ(events_[0].rule, "B");
+
+    engine_->evaluate(sample(5, 10.0, 1s));
+    ASSERT_EQ(events_.size(), 2u);
+    EXPECT_EQ(events_[1].rule, "A");
+
+    auto stats = engine_->getStatistics();
+    EXPECT_EQ(stats.evaluated_samples, 2u);
+    EXPECT_EQ(stats.raised, 2u);
+    EXPECT_EQ(stats.cleared, 0u);
+}
+
+TEST_F(AlarmEngineTest, InvalidRules_Throw) {
+    EXPECT_THROW(AlarmEngine({rule("X", 0, AlarmCondition::ABOVE, 1.0, -1.0)}), ConfigException);
+    EXPECT_THROW(AlarmEngine({rule("X", 0, AlarmCondition::ABOVE, 1.0, 0.0, Duration(-1))}), ConfigException);
+
+    AlarmEngine empty({});
+    empty.evaluate(sample(0, 1.0, 0s));
+    EXPECT_EQ(empty.getStatistics().evaluated_samples, 0u);
+}
+
+TEST(AlarmConfigTest, ParsesAndValidatesAlarmSection) {
+    nlohmann::json base;
+    std::ifstream("config.json") >> base;
+
+    const std::string path = "test_alarm_config.json";
+    auto write = [&](const std::string& alarms) {
+        nlohmann::json json = base;
+        json["alarms"] = nlohmann::json::parse(alarms);
+        std::ofstream(path) << json.dump();
+    };
+
+    write(R"([{"name": "Low", "register": 0, "condition": "below", "threshold": 207,
+               "hysteresis": 3, "duration_ms": 10000, "severity": "critical"},
+              {"name": "Efficiency", "register": 1002, "threshold": 99}])");
+    ConfigManager config(path);
+    ASSERT_EQ(config.getAlarmRuleConfigs().size(), 2u);
+    const auto& parsed = config.getAlarmRuleConfigs()[0];
+    EXPECT_EQ(parsed.condition, AlarmCondition::BELOW);
+    EXPECT_EQ(parsed.severity, AlarmSeverity::CRITICAL);
+    EXPECT_DOUBLE_EQ(parsed.hysteresis, 3.0);
+    EXPECT_EQ(parsed.duration, Duration(10000));
+    EXPECT_EQ(config.getAlarmRuleConfigs()[1].condition, AlarmCondition::ABOVE);
+    EXPECT_EQ(config.getAlarmRuleConfigs()[1].severity, AlarmSeverity::WARNING);
+
+    write(R"([{"name": "X", "register": 0, "condition": "sideways", "threshold": 1}])");
+    EXPECT_THROW(ConfigManager{path}, ConfigException);
+    write(R"([{"name": "X", "register": 0, "threshold": 1, "severity": "fatal"}])");
+    EXPECT_THROW(ConfigManager{path}, ConfigException);
+    write(R"([{"name": "X", "register": 4242, "threshold": 1}])");
+    EXPECT_THROW(ConfigManager{path}, ConfigException);
+    write(R"([{"name": "X", "register": 0, "threshold": 1, "hysteresis": -2}])");
+    EXPECT_THROW(ConfigManager{path}, ConfigException);
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,196 @@
+/**
+ * @file test_bench_compare.cpp
+ * @brief Tests for benchmark result loading and the regression gate
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../benchmarks/bench_stats.hpp"
+#include <nlohmann/json.hpp>
+#include <vector>
+
+using namespace ecoWatt;
+using namespace ecoWatt::bench;
+
+namespace {
+
+nlohmann::json makeRun(const std::string& name, const std::vector<double>& times_us,
+                       double items_per_second, double allocs_per_op) {
+    nlohmann::json json;
+    json["context"] = {{"library_build_type", "release"}};
+    json["benchmarks"] = nlohmann::json::array();
+
+    for (size_t i = 0; i < times_us.size(); ++i) {
+        json["benchmarks"].push_back({
+            {"name", name},
+            {"run_name", name},
+            {"run_type", "iteration"},
+            {"repetition_index", i},
+            {"real_time", times_us[i]},
+            {"cpu_time", times_us[i]},
+            {"time_unit", "us"},
+            {"items_per_second", items_per_second * (1.0 + 0.001 * static_cast<double>(i))},
+            {"allocs_per_op", allocs_per_op}
+        });
+    }
+
+    json["benchmarks"].push_back({
+        {"name", name + "_mean"},
+        {"run_name", name},
+        {"run_type", "aggregate"},
+        {"aggregate_name", "mean"},
+        {"real_time", 0.0},
+        {"cpu_time", 0.0},
+        {"time_unit", "us"}
+    });
+
+    return json;
+}
+
+const MetricComparison& metric(const BenchmarkComparison& comparison, const std::string& name) {
+    for (const auto& m : comparison.metrics) {
+        if (m.metric == name) {
+            return m;
+        }
+    }
+    throw std::runtime_error("metric not found: " + name);
+}
+
+} // namespace
+
+// ============================================================================
+// STATISTICS TESTS
+// ============================================================================
+
+TEST(BenchCompareTest, MannWhitney_SeparatedSamples_Significant) {
+    std::vector<double> a = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    std::vector<double> b = {11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+
+    MannWhitneyResult result = mannWhitneyU(a, b);
+    ASSERT_TRUE(result.valid);
+    EXPECT_DOUBLE_EQ(result.u, 0.0);
+    EXPECT_LT(result.p_value, 0.001);
+}
+
+TEST(BenchCompareTest, MannWhitney_InterleavedSamples_NotSignificant) {
+    std::vector<double> a = {1, 3, 5, 7, 9, 11, 13, 15};
+    std::vector<double> b = {2, 4, 6, 8, 10, 12, 14, 16};
+
+    MannWhitneyResult result = mannWhitneyU(a, b);
+    ASSERT_TRUE(result.valid);
+    EXPECT_GT(result.p_value, 0.5);
+}
+
+TEST(BenchCompareTest, MannWhitney_AllTied_PValueOne) {
+    MannWhitneyResult result = mannWhitneyU({5, 5, 5}, {5, 5, 5});
+    ASSERT_TRUE(result.valid);
+    EXPECT_DOUBLE_EQ(result.p_value, 1.0);
+
+    EXPECT_FALSE(mannWhitneyU({}, {1.0}).valid);
+}
+
+TEST(BenchCompareTest, Percentile_Interpolates) {
+    std::vector<double> values = {40, 10, 30, 20};
+    EXPECT_DOUBLE_EQ(percentile(values, 0), 10.0);
+    EXPECT_DOUBLE_EQ(percentile(values, 50), 25.0);
+    EXPECT_DOUBLE_EQ(percentile(values, 100), 40.0);
+    EXPECT_DOUBLE_EQ(percentile({}, 50), 0.0);
+}
+
+// ============================================================================
+// LOADING TESTS
+// ============================================================================
+
+TEST(BenchCompareTest, Parse_SkipsAggregatesAndNormalisesUnits) {
+    BenchmarkRun run = parseBenchmarkJson(makeRun("BM_A", {1.0, 2.0, 3.0}, 1000.0, 2.0));
+
+    ASSERT_EQ(run.size(), 1u);
+    const auto& samples = run.at("BM_A");
+    ASSERT_EQ(samples.real_time_ns.size(), 3u);
+    EXPECT_DOUBLE_EQ(samples.real_time_ns[1], 2000.0);
+    EXPECT_EQ(samples.allocs_per_op.size(), 3u);
+}
+
+TEST(BenchCompareTest, Parse_InvalidDocument_Throws) {
+    EXPECT_THROW(parseBenchmarkJson(nlohmann::json::array()), ConfigException);
+    EXPECT_THROW(parseBenchmarkJson({{"benchmarks", {{{"name", "x"}, {"real_time", 1}}}}}),
+                 ConfigException);
+    EXPECT_THROW(loadBenchmarkFile("does_not_exist.json"), ConfigException);
+}
+
+// ============================================================================
+// REGRESSION GATE TESTS
+// ============================================================================
+
+TEST(BenchCompareTest, Compare_NoiseWithinThreshold_NoRegression) {
+    std::vector<double> base = {100, 101, 99, 100, 102, 98, 100, 101};
+    std::vector<double> cand = {101, 100, 100, 102, 99, 101, 100, 100};
+
+    CompareReport report = compareRuns(parseBenchmarkJson(makeRun("BM_A", base, 1e6, 3.0)),
+                                       parseBenchmarkJson(makeRun("BM_A", cand, 1e6, 3.0)),
+                                       CompareThresholds{});
+    ASSERT_EQ(report.benchmarks.size(), 1u);
+    EXPECT_FALSE(report.regressed());
+}
+
+TEST(BenchCompareTest, Compare_SignificantSlowdown_Regresses) {
+    std::vector<double> base = {100, 101, 99, 100, 102, 98, 100, 101};
+    std::vector<double> cand = {120, 121, 119, 122, 118, 120, 121, 119};
+
+    CompareReport report = compareRuns(parseBenchmarkJson(makeRun("BM_A", base, 1e6, 3.0)),
+                                       parseBenchmarkJson(makeRun("BM_A", cand, 0.8e6, 3.0)),
+                                       CompareThresholds{});
+    ASSERT_EQ(report.benchmarks.size(), 1u);
+    EXPECT_TRUE(report.regressed());
+
+    const auto& time = metric(report.benchmarks[0], "real_time");
+    EXPECT_EQ(time.verdict, Verdict::REGRESSED);
+    EXPECT_TRUE(time.utest);
+    EXPECT_NEAR(time.change, 0.20, 0.01);
+
+    EXPECT_EQ(metric(report.benchmarks[0], "items_per_second").verdict, Verdict::REGRESSED);
+    EXPECT_NEAR(report.benchmarks[0].candidate_latency.p50, 120000.0, 500.0);
+}
+
+TEST(BenchCompareTest, Compare_Speedup_Improves) {
+    std::vector<double> base = {100, 101, 99, 100, 102, 98};
+    std::vector<double> cand = {50, 51, 49, 50, 52, 48};
+
+    CompareReport report = compareRuns(parseBenchmarkJson(makeRun("BM_A", base, 1e6, 3.0)),
+                                       parseBenchmarkJson(makeRun("BM_A", cand, 2e6, 1.0)),
+                                       CompareThresholds{});
+    EXPECT_FALSE(report.regressed());
+    EXPECT_EQ(metric(report.benchmarks[0], "real_time").verdict, Verdict::IMPROVED);
+    EXPECT_EQ(metric(report.benchmarks[0], "allocs_per_op").verdict, Verdict::IMPROVED);
+}
+
+TEST(BenchCompareTest, Compare_ExtraAllocations_Regress) {
+    std::vector<double> times = {100, 100, 100, 100, 100};
+
+    CompareReport report = compareRuns(parseBenchmarkJson(makeRun("BM_A", times, 1e6, 3.0)),
+                                       parseBenchmarkJson(makeRun("BM_A", times, 1e6, 4.0)),
+                                       CompareThresholds{});
+    EXPECT_TRUE(report.regressed());
+    EXPECT_EQ(metric(report.benchmarks[0], "allocs_per_op").verdict, Verdict::REGRESSED);
+    EXPECT_EQ(metric(report.benchmarks[0], "real_time").verdict, Verdict::SAME);
+}
+
+TEST(BenchCompareTest, Compare_FewRepetitions_UsesThresholdOnly) {
+    CompareReport report = compareRuns(parseBenchmarkJson(makeRun("BM_A", {100}, 1e6, 0.0)),
+                                       parseBenchmarkJson(makeRun("BM_A", {110}, 1e6, 0.0)),
+                                       CompareThresholds{});
+    const auto& time = metric(report.benchmarks[0], "real_time");
+    EXPECT_FALSE(time.utest);
+    EXPECT_EQ(time.verdict, Verdict::REGRESSED);
+}
+
+TEST(BenchCompareTest, Compare_AddedAndRemovedBenchmarks_Reported) {
+    CompareReport report = compareRuns(parseBenchmarkJson(makeRun("BM_Old", {1}, 1, 0)),
+                                       parseBenchmarkJson(makeRun("BM_New", {1}, 1, 0)),
+                                       CompareThresholds{});
+    EXPECT_TRUE(report.benchmarks.empty());
+    EXPECT_EQ(report.only_in_baseline, std::vector<std::string>{"BM_Old"});
+    EXPECT_EQ(report.only_in_candidate, std::vector<std::string>{"BM_New"});
+    EXPECT_FALSE(report.regressed());
+}
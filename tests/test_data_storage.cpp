@@ -391,6 +391,29 @@ TEST_F(DataStorageTest, HybridStorage_StoreSample_BothStorages) {
     EXPECT_GE(historical_samples.size(), 1) << "Should have sample in persistent storage";
 }
 
+TEST_F(DataStorageTest, HybridStorage_Deadband_FiltersOnlyPersistentRows) {
+    HybridDataStorage storage(hybrid_config_);
+    
+    RegisterConfig temperature(7, "Temperature", "C", 10.0, AccessType::READ_ONLY, "");
+    temperature.deadband = 1.0;
+    storage.configureFilters({{7, temperature}});
+    
+    auto now = std::chrono::system_clock::now();
+    for (int i = 0; i < 10; ++i) {
+        double value = 40.0 + 0.1 * i;
+        storage.storeSample(AcquisitionSample(now + std::chrono::seconds(i), 7, "Temperature",
+                                              static_cast<RegisterValue>(value * 10), value, "C"));
+    }
+    
+    EXPECT_EQ(storage.getRecentSamples(7, 100).size(), 10u);
+    auto historical = storage.getHistoricalSamples(7, now - std::chrono::hours(1), now + std::chrono::hours(1));
+    EXPECT_EQ(historical.size(), 1u);
+    
+    auto stats = storage.getCombinedStatistics();
+    EXPECT_EQ(stats.filter_stats.received, 10u);
+    EXPECT_EQ(stats.filter_stats.stored, 1u);
+}
+
 TEST_F(DataStorageTest, HybridStorage_GetLatestSample_FromMemory) {
     HybridDataStorage storage(hybrid_config_);
     
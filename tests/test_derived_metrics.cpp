@@ -0,0 +1,293 @@
+/**
+ * @file test_derived_metrics.cpp
+ * @brief Tests for the derived metrics engine and its poll-cycle integration
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/derived_metrics.hpp"
+#include "../cpp/include/data_storage.hpp"
+#include "../cpp/include/acquisition_scheduler.hpp"
+#include "../cpp/include/inverter_sim_server.hpp"
+#include "../cpp/include/config_manager.hpp"
+#include "../cpp/include/exceptions.hpp"
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace ecoWatt;
+using namespace std::chrono_literals;
+
+namespace {
+
+const TimePoint kStart = TimePoint(std::chrono::seconds(1700000000));
+
+std::map<RegisterAddress, RegisterConfig> physicalRegisters() {
+    std::map<RegisterAddress, RegisterConfig> registers;
+    registers[0] = RegisterConfig(0, "Vac", "V", 10.0, AccessType::READ_ONLY, "");
+    registers[1] = RegisterConfig(1, "Iac", "A", 10.0, AccessType::READ_ONLY, "");
+    registers[3] = RegisterConfig(3, "Vpv1", "V", 10.0, AccessType::READ_ONLY, "");
+    registers[5] = RegisterConfig(5, "Ipv1", "A", 10.0, AccessType::READ_ONLY, "");
+    return registers;
+}
+
+DerivedMetricConfig metric(RegisterAddress address, const std::string& name, const std::string& expression,
+                           bool integrate = false) {
+    DerivedMetricConfig config;
+    config.address = address;
+    config.name = name;
+    config.expression = expression;
+    config.integrate = integrate;
+    return config;
+}
+
+AcquisitionSample sample(RegisterAddress address, double value, std::chrono::seconds offset = 0s) {
+    return AcquisitionSample(kStart + offset, address, "", static_cast<SampleRawValue>(value * 10), value, "");
+}
+
+const AcquisitionSample* find(const std::vector<AcquisitionSample>& samples, RegisterAddress address) {
+    for (const auto& s : samples) {
+        if (s.register_address == address) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+// ============================================================================
+// ENGINE TESTS
+// ============================================================================
+
+TEST(DerivedMetricsTest, Expression_ByNameAndAddress) {
+    DerivedMetricsEngine engine({metric(1000, "Ppv1", "Vpv1 * Ipv1"),
+                                 metric(1001, "Mixed", "abs(-(r0 - 200) / 2 + max(r1, 3) * abs(-2) + sqrt(16))")},
+                                physicalRegisters());
+
+    auto out = engine.evaluate({sample(0, 230.0), sample(1, 5.0), sample(3, 300.0), sample(5, 8.5)});
+
+    ASSERT_EQ(out.size(), 2u);
+    ASSERT_NE(find(out, 1000), nullptr);
+    EXPECT_DOUBLE_EQ(find(out, 1000)->scaled_value, 2550.0);
+    EXPECT_EQ(find(out, 1000)->raw_value, 2550);
+    EXPECT_EQ(find(out, 1000)->register_name, "Ppv1");
+    EXPECT_EQ(find(out, 1000)->timestamp, kStart);
+    EXPECT_DOUBLE_EQ(find(out, 1001)->scaled_value, 15.0 - 10.0 - 4.0);
+    EXPECT_EQ(find(out, 1001)->raw_value, 1);
+}
+
+TEST(DerivedMetricsTest, NegativeNetPower_StoredAndReadBack) {
+    auto net = metric(1000, "Pnet", "Vpv1 * Ipv1 - Vac * Iac");
+    net.gain = 10.0;
+    DerivedMetricsEngine engine({net}, physicalRegisters());
+
+    // Importing: 1500 W from PV against a 4600 W load
+    auto out = engine.evaluate({sample(0, 230.0), sample(1, 20.0), sample(3, 300.0), sample(5, 5.0)});
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_DOUBLE_EQ(out[0].scaled_value, -3100.0);
+    EXPECT_EQ(out[0].raw_value, -31000);
+
+    MemoryDataStorage memory;
+    memory.storeSample(out[0]);
+    ASSERT_NE(memory.getLatestSample(1000), nullptr);
+    EXPECT_EQ(memory.getLatestSample(1000)->raw_value, -31000);
+
+    SQLiteDataStorage sqlite(":memory:");
+    sqlite.storeSample(out[0]);
+    auto stored = sqlite.getSamples(1000);
+    ASSERT_EQ(stored.size(), 1u);
+    EXPECT_EQ(stored[0].raw_value, -31000);
+    EXPECT_EQ(stored[0].timestamp, out[0].timestamp);
+}
+
+TEST(DerivedMetricsTest, RawValue_WiderThanRegisterAndSaturates) {
+    auto power = metric(1000, "Ppv1", "Vpv1 * Ipv1");
+    power.gain = 10.0;
+    DerivedMetricsEngine engine({power}, physicalRegisters());
+
+    // Beyond 16 bits, as an energy counter soon is
+    auto out = engine.evaluate({sample(3, 300.0), sample(5, 30.0)});
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0].raw_value, 90000);
+    EXPECT_EQ(engine.getClampedCount(), 0u);
+
+    power.gain = 1e18;
+    DerivedMetricsEngine saturating({power}, physicalRegisters());
+    out = saturating.evaluate({sample(3, 300.0), sample(5, 30.0)});
+    EXPECT_EQ(out[0].raw_value, std::numeric_limits<SampleRawValue>::max());
+    EXPECT_DOUBLE_EQ(out[0].scaled_value, 9000.0);
+    out = saturating.evaluate({sample(3, -300.0), sample(5, 31.0)});
+    EXPECT_EQ(out[0].raw_value, std::numeric_limits<SampleRawValue>::min());
+    EXPECT_EQ(saturating.getClampedCount(), 2u);
+}
+
+TEST(DerivedMetricsTest, DependentMetrics_EvaluatedInDependencyOrder) {
+    // Declared before the metric it reads
+    DerivedMetricsEngine engine({metric(1001, "Half", "Ppv1 / 2"), metric(1000, "Ppv1", "Vpv1 * Ipv1")},
+                                physicalRegisters());
+
+    auto out = engine.evaluate({sample(3, 100.0), sample(5, 2.0)});
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0].register_address, 1000);
+    EXPECT_DOUBLE_EQ(out[1].scaled_value, 100.0);
+}
+
+TEST(DerivedMetricsTest, MissingInputs_SkippedForTheCycle) {
+    DerivedMetricsEngine engine({metric(1000, "Ppv1", "Vpv1 * Ipv1")}, physicalRegisters());
+
+    EXPECT_TRUE(engine.evaluate({sample(3, 300.0)}).empty());
+
+    // The previous cycle's voltage is stale, not reused
+    EXPECT_TRUE(engine.evaluate({sample(5, 2.0, 5s)}).empty());
+
+    auto out = engine.evaluate({sample(3, 300.0, 10s), sample(5, 2.0, 10s)});
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_DOUBLE_EQ(out[0].scaled_value, 600.0);
+    EXPECT_EQ(out[0].timestamp, kStart + 10s);
+}
+
+TEST(DerivedMetricsTest, NonFiniteResult_Skipped) {
+    DerivedMetricsEngine engine({metric(1000, "Ratio", "Vac / Iac")}, physicalRegisters());
+
+    EXPECT_TRUE(engine.evaluate({sample(0, 230.0), sample(1, 0.0)}).empty());
+    EXPECT_EQ(engine.evaluate({sample(0, 230.0), sample(1, 2.0)}).size(), 1u);
+}
+
+TEST(DerivedMetricsTest, Integral_TrapezoidalRule) {
+    auto energy = metric(1001, "Energy", "Ppv1", true);
+    energy.scale = 0.001; // Wh -> kWh
+    energy.max_gap = Duration(2 * 3600 * 1000);
+    DerivedMetricsEngine engine({metric(1000, "Ppv1", "Vpv1 * Ipv1"), energy}, physicalRegisters());
+
+    // 1000 W -> 3000 W linearly over one hour, then flat for half an hour
+    auto first = engine.evaluate({sample(3, 100.0, 0s), sample(5, 10.0, 0s)});
+    auto second = engine.evaluate({sample(3, 100.0, 3600s), sample(5, 30.0, 3600s)});
+    auto third = engine.evaluate({sample(3, 100.0, 5400s), sample(5, 30.0, 5400s)});
+
+    EXPECT_DOUBLE_EQ(find(first, 1001)->scaled_value, 0.0);
+    EXPECT_DOUBLE_EQ(find(second, 1001)->scaled_value, 2.0);
+    EXPECT_DOUBLE_EQ(find(third, 1001)->scaled_value, 3.5);
+    EXPECT_DOUBLE_EQ(engine.getIntegral(1001).value(), 3.5);
+    EXPECT_FALSE(engine.getIntegral(1000).has_value());
+}
+
+TEST(DerivedMetricsTest, Integral_GapNotIntegratedAndRestore) {
+    auto energy = metric(1000, "Energy", "Vac", true);
+    energy.max_gap = Duration(60000);
+    DerivedMetricsEngine engine({energy}, physicalRegisters());
+
+    engine.evaluate({sample(0, 100.0, 0s)});
+    engine.evaluate({sample(0, 100.0, 36s)});
+    EXPECT_DOUBLE_EQ(engine.getIntegral(1000).value(), 1.0);
+
+    // Ten-minute outage: no energy credited for it
+    engine.evaluate({sample(0, 100.0, 636s)});
+    EXPECT_DOUBLE_EQ(engine.getIntegral(1000).value(), 1.0);
+
+    engine.restoreIntegral(1000, 50.0);
+    engine.evaluate({sample(0, 100.0, 700s)});
+    EXPECT_DOUBLE_EQ(engine.getIntegral(1000).value(), 50.0); // Restore restarts the baseline
+}
+
+TEST(DerivedMetricsTest, Integral_FailedReadsNotIntegratedOnStaleInput) {
+    auto energy = metric(1000, "Energy", "Vac", true);
+    energy.max_gap = Duration(60000);
+    DerivedMetricsEngine engine({energy}, physicalRegisters());
+
+    engine.evaluate({sample(0, 100.0, 0s)});
+
+    // Vac fails for two and a half minutes while other registers still read
+    for (auto offset : {30s, 60s, 90s, 120s}) {
+        EXPECT_TRUE(engine.evaluate({sample(1, 5.0, offset)}).empty());
+    }
+    EXPECT_DOUBLE_EQ(engine.getIntegral(1000).value(), 0.0);
+
+    engine.evaluate({sample(0, 100.0, 150s)});
+    EXPECT_DOUBLE_EQ(engine.getIntegral(1000).value(), 0.0);  // Longer than max_gap
+    engine.evaluate({sample(0, 100.0, 186s)});
+    EXPECT_DOUBLE_EQ(engine.getIntegral(1000).value(), 1.0);
+}
+
+TEST(DerivedMetricsTest, InvalidConfigurations_Throw) {
+    auto registers = physicalRegisters();
+    EXPECT_THROW(DerivedMetricsEngine({metric(1000, "X", "Vac *")}, registers), ConfigException);
+    EXPECT_THROW(DerivedMetricsEngine({metric(1000, "X", "Unknown + 1")}, registers), ConfigException);
+    EXPECT_THROW(DerivedMetricsEngine({metric(1000, "X", "r42")}, registers), ConfigException);
+    EXPECT_THROW(DerivedMetricsEngine({metric(1000, "X", "pow(Vac, 2)")}, registers), ConfigException);
+    EXPECT_THROW(DerivedMetricsEngine({metric(1000, "X", "(Vac")}, registers), ConfigException);
+    EXPECT_THROW(DerivedMetricsEngine({metric(0, "X", "Iac")}, registers), ConfigException);
+    EXPECT_THROW(DerivedMetricsEngine({metric(1000, "A", "B"), metric(1001, "B", "A")}, registers),
+                 ConfigException);
+
+    auto zero_gain = metric(1000, "X", "Vac");
+    zero_gain.gain = 0.0;
+    EXPECT_THROW(DerivedMetricsEngine({zero_gain}, registers), ConfigException);
+
+    DerivedMetricsEngine engine({metric(1000, "X", "r1")}, registers);
+    EXPECT_TRUE(engine.isDerived(1000));
+    EXPECT_FALSE(engine.isDerived(1));
+}
+
+// ============================================================================
+// SCHEDULER INTEGRATION (in-process Inverter SIM)
+// ============================================================================
+
+class DerivedMetricsSchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        simulator_ = std::make_shared<InverterSimulator>();
+        server_ = std::make_unique<InverterSimServer>(simulator_, kBaseUrl);
+        server_->start();
+
+        ModbusConfig modbus_config;
+        modbus_config.slave_address = 17;
+        modbus_config.max_retries = 1;
+        config_.updateModbusConfig(modbus_config);
+
+        ApiConfig api_config;
+        api_config.base_url = kBaseUrl;
+        config_.updateApiConfig(api_config);
+
+        config_.setDerivedMetricConfigs({metric(1000, "Sac", "Vac1_L1_Phase_voltage * Iac1_L1_Phase_current")});
+
+        scheduler_ = std::make_unique<AcquisitionScheduler>(
+            std::make_shared<ProtocolAdapter>(config_), config_);
+        scheduler_->configureRegisters(config_.getRegisterConfigs());
+    }
+
+    void TearDown() override {
+        scheduler_.reset();
+        server_->stop();
+    }
+
+    static constexpr const char* kBaseUrl = "http://127.0.0.1:18093";
+
+    ConfigManager config_;
+    std::shared_ptr<InverterSimulator> simulator_;
+    std::unique_ptr<InverterSimServer> server_;
+    std::unique_ptr<AcquisitionScheduler> scheduler_;
+};
+
+TEST_F(DerivedMetricsSchedulerTest, PollCycle_PublishesVirtualRegister) {
+    std::vector<AcquisitionSample> published;
+    scheduler_->addSampleCallback([&](const AcquisitionSample& s) { published.push_back(s); });
+
+    scheduler_->pollOnce();
+
+    const AcquisitionSample* voltage = find(published, 0);
+    const AcquisitionSample* current = find(published, 1);
+    const AcquisitionSample* apparent = find(published, 1000);
+    ASSERT_NE(voltage, nullptr);
+    ASSERT_NE(current, nullptr);
+    ASSERT_NE(apparent, nullptr);
+    EXPECT_DOUBLE_EQ(apparent->scaled_value, voltage->scaled_value * current->scaled_value);
+    EXPECT_EQ(published.back().register_address, 1000);
+
+    // Served from the cache, never read from the inverter
+    uint64_t requests = simulator_->getStatistics().requests;
+    auto latest = scheduler_->getLatestSamples({1000});
+    ASSERT_EQ(latest.size(), 1u);
+    EXPECT_EQ(simulator_->getStatistics().requests, requests);
+}
@@ -0,0 +1,134 @@
+/**
+ * @file test_frame_envelope.cpp
+ * @brief Tests for the JSON frame envelope codec
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/frame_envelope.hpp"
+#include "../cpp/include/exceptions.hpp"
+#include <nlohmann/json.hpp>
+#include <string>
+
+using namespace ecoWatt;
+
+// ============================================================================
+// REQUEST ENCODING TESTS
+// ============================================================================
+
+TEST(FrameEnvelopeTest, EncodeRequest_HexFrame_MatchesDomOutput) {
+    std::string frame = "110300000002C69B";
+
+    nlohmann::json payload;
+    payload["frame"] = frame;
+
+    EXPECT_EQ(FrameEnvelope::encodeRequest(frame), payload.dump());
+}
+
+TEST(FrameEnvelopeTest, EncodeRequest_ReusesBuffer_Overwrites) {
+    std::string buffer = "previous content that is longer than the envelope";
+    FrameEnvelope::encodeRequest("0103", buffer);
+    EXPECT_EQ(buffer, "{\"frame\":\"0103\"}");
+}
+
+TEST(FrameEnvelopeTest, EncodeRequest_SpecialCharacters_Escaped) {
+    std::string encoded = FrameEnvelope::encodeRequest("a\"b");
+    EXPECT_EQ(nlohmann::json::parse(encoded)["frame"], "a\"b");
+}
+
+// ============================================================================
+// RESPONSE SCANNING TESTS
+// ============================================================================
+
+TEST(FrameEnvelopeTest, ExtractFrame_SimpleBody_ReturnsView) {
+    std::string body = "{\"frame\":\"110304090400199C33\"}";
+    std::string_view frame = FrameEnvelope::extractFrame(body);
+
+    EXPECT_EQ(frame, "110304090400199C33");
+    EXPECT_GE(frame.data(), body.data());
+    EXPECT_LE(frame.data() + frame.size(), body.data() + body.size());
+}
+
+TEST(FrameEnvelopeTest, ScanFrame_WhitespaceAndExtraFields_Found) {
+    std::string body = " {\n  \"status\" : \"ok\",\n  \"meta\": {\"id\": [1, 2, {\"x\": \"}\"}]},"
+                       "\n  \"frame\" : \"1106000800327FA5\" ,\n  \"n\": -1.5e3, \"b\": true }\n";
+    std::string_view frame;
+
+    ASSERT_TRUE(FrameEnvelope::scanFrame(body, frame));
+    EXPECT_EQ(frame, "1106000800327FA5");
+}
+
+TEST(FrameEnvelopeTest, ScanFrame_DuplicateKey_LastWins) {
+    std::string body = "{\"frame\":\"AA\",\"frame\":\"BB\"}";
+    std::string_view frame;
+
+    ASSERT_TRUE(FrameEnvelope::scanFrame(body, frame));
+    EXPECT_EQ(frame, "BB");
+    EXPECT_EQ(nlohmann::json::parse(body)["frame"], "BB");
+}
+
+TEST(FrameEnvelopeTest, ScanFrame_UnexpectedShapes_DefersToParser) {
+    std::string_view frame;
+
+    EXPECT_FALSE(FrameEnvelope::scanFrame("", frame));
+    EXPECT_FALSE(FrameEnvelope::scanFrame("[]", frame));
+    EXPECT_FALSE(FrameEnvelope::scanFrame("{}", frame));
+    EXPECT_FALSE(FrameEnvelope::scanFrame("{\"frame\":123}", frame));
+    EXPECT_FALSE(FrameEnvelope::scanFrame("{\"frame\":\"AB\\u0043\"}", frame));
+    EXPECT_FALSE(FrameEnvelope::scanFrame("{\"frame\":\"AB\"", frame));
+    EXPECT_FALSE(FrameEnvelope::scanFrame("{\"frame\":\"AB\"} trailing", frame));
+}
+
+TEST(FrameEnvelopeTest, ExtractFrame_EscapedValue_FallbackDecodes) {
+    std::string body = "{\"frame\":\"AB\\u0043D\"}";
+    std::string_view frame = FrameEnvelope::extractFrame(body);
+    EXPECT_EQ(frame, "ABCD");
+}
+
+TEST(FrameEnvelopeTest, ExtractFrame_InvalidJson_ThrowsHttpException) {
+    std::string body = "invalid json response";
+    EXPECT_THROW(FrameEnvelope::extractFrame(body), HttpException);
+}
+
+TEST(FrameEnvelopeTest, ExtractFrame_MissingOrEmptyFrame_ThrowsHttpException) {
+    std::string missing = "{\"status\":\"ok\"}";
+    EXPECT_THROW(FrameEnvelope::extractFrame(missing), HttpException);
+
+    std::string empty = "{\"frame\":\"\"}";
+    EXPECT_THROW(FrameEnvelope::extractFrame(empty), HttpException);
+}
+
+TEST(FrameEnvelopeTest, ExtractFrame_NonStringFrame_ThrowsHttpException) {
+    std::string body = "{\"frame\":42}";
+    EXPECT_THROW(FrameEnvelope::extractFrame(body), HttpException);
+}
+
+// ============================================================================
+// BATCH ENVELOPE TESTS
+// ============================================================================
+
+TEST(FrameEnvelopeTest, EncodeBatchRequest_MatchesDomOutput) {
+    std::vector<std::string> frames = {"110300000002C69B", "110300080001070A"};
+    std::string out;
+    FrameEnvelope::encodeBatchRequest(frames, out);
+
+    nlohmann::json expected;
+    expected["frames"] = frames;
+    EXPECT_EQ(out, expected.dump());
+
+    FrameEnvelope::encodeBatchRequest({}, out);
+    EXPECT_EQ(out, "{\"frames\":[]}");
+}
+
+TEST(FrameEnvelopeTest, ExtractFrames_PreservesOrderAndEmptyEntries) {
+    auto frames = FrameEnvelope::extractFrames("{ \"frames\": [\"1103020064\", \"\", \"118302\"] }");
+    EXPECT_EQ(frames, (std::vector<std::string>{"1103020064", "", "118302"}));
+}
+
+TEST(FrameEnvelopeTest, ExtractFrames_WrongShape_ThrowsHttpException) {
+    EXPECT_THROW(FrameEnvelope::extractFrames("{\"frame\":\"11\"}"), HttpException);
+    EXPECT_THROW(FrameEnvelope::extractFrames("{\"frames\":\"11\"}"), HttpException);
+    EXPECT_THROW(FrameEnvelope::extractFrames("{\"frames\":[1, 2]}"), HttpException);
+    EXPECT_THROW(FrameEnvelope::extractFrames("not json"), HttpException);
+}
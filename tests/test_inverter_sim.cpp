@@ -0,0 +1,397 @@
+/**
+ * @file test_inverter_sim.cpp
+ * @brief Tests for the local Inverter SIM and its HTTP front end
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/inverter_simulator.hpp"
+#include "../cpp/include/inverter_sim_server.hpp"
+#include "../cpp/include/protocol_adapter.hpp"
+#include "../cpp/include/config_manager.hpp"
+#include "../cpp/include/modbus_frame.hpp"
+#include "../cpp/include/exceptions.hpp"
+#include <nlohmann/json.hpp>
+#include <memory>
+#include <vector>
+
+using namespace ecoWatt;
+
+namespace {
+
+std::vector<uint8_t> frameBytes(const std::string& hex) {
+    return ModbusFrame::hexToBytes(hex);
+}
+
+std::vector<uint8_t> readRequest(RegisterAddress start, uint16_t count, SlaveAddress slave = 17) {
+    return frameBytes(ModbusFrame::createReadFrame(slave, start, count));
+}
+
+std::vector<uint8_t> writeRequest(RegisterAddress address, RegisterValue value, SlaveAddress slave = 17) {
+    return frameBytes(ModbusFrame::createWriteFrame(slave, address, value));
+}
+
+} // namespace
+
+// ============================================================================
+// REGISTER MODEL TESTS
+// ============================================================================
+
+TEST(InverterSimulatorTest, Read_DefaultMap_ReturnsValidFrame) {
+    InverterSimulator sim;
+
+    auto response = sim.processFrame(readRequest(0, 10));
+    ASSERT_TRUE(response.has_value());
+    ASSERT_TRUE(ModbusFrame::validateFrame(*response));
+
+    ModbusResponse parsed = ModbusFrame::parseResponse(ModbusFrame::bytesToHex(*response));
+    EXPECT_FALSE(parsed.is_error);
+    EXPECT_EQ(parsed.slave_address, 17);
+    EXPECT_EQ(parsed.data.size(), 20u); // 10 registers
+
+    // Export power register is constant at 100 %
+    EXPECT_EQ(sim.readRegister(8), 100);
+}
+
+TEST(InverterSimulatorTest, Read_RandomWalk_StaysWithinBounds) {
+    InverterSimConfig config = InverterSimConfig::defaults();
+    config.registers[2].step = 500; // Larger than the [4950, 5050] window
+
+    InverterSimulator sim(config);
+    for (int i = 0; i < 200; ++i) {
+        RegisterValue value = sim.readRegister(2);
+        EXPECT_GE(value, 4950);
+        EXPECT_LE(value, 5050);
+    }
+}
+
+TEST(InverterSimulatorTest, Read_UnmappedAddress_ReturnsIllegalAddress) {
+    InverterSimulator sim;
+
+    auto response = sim.processFrame(readRequest(8, 5));
+    ASSERT_TRUE(response.has_value());
+
+    ModbusResponse parsed = ModbusFrame::parseResponse(ModbusFrame::bytesToHex(*response));
+    EXPECT_TRUE(parsed.is_error);
+    EXPECT_EQ(parsed.error_code, 0x02);
+}
+
+TEST(InverterSimulatorTest, Write_WritableRegister_EchoesAndUpdates) {
+    InverterSimulator sim;
+
+    auto request = writeRequest(8, 50);
+    auto response = sim.processFrame(request);
+    ASSERT_TRUE(response.has_value());
+    EXPECT_EQ(*response, request);
+    EXPECT_EQ(sim.readRegister(8), 50);
+}
+
+TEST(InverterSimulatorTest, Write_ReadOnlyOrOutOfRange_ReturnsException) {
+    InverterSimulator sim;
+
+    auto read_only = sim.processFrame(writeRequest(0, 1234));
+    ASSERT_TRUE(read_only.has_value());
+    EXPECT_EQ((*read_only)[1], 0x86);
+    EXPECT_EQ((*read_only)[2], 0x02);
+
+    auto out_of_range = sim.processFrame(writeRequest(8, 150));
+    ASSERT_TRUE(out_of_range.has_value());
+    EXPECT_EQ((*out_of_range)[2], 0x03);
+    EXPECT_EQ(sim.readRegister(8), 100);
+}
+
+TEST(InverterSimulatorTest, InvalidFrames_AreIgnoredAndCounted) {
+    InverterSimulator sim;
+
+    auto bad_crc = readRequest(0, 2);
+    bad_crc.back() ^= 0xFF;
+
+    EXPECT_FALSE(sim.processFrame(bad_crc).has_value());
+    EXPECT_FALSE(sim.processFrame(readRequest(0, 2, 5)).has_value()); // Wrong slave
+    EXPECT_FALSE(sim.processFrame({0x11, 0x03}).has_value());
+
+    auto stats = sim.getStatistics();
+    EXPECT_EQ(stats.requests, 3u);
+    EXPECT_EQ(stats.invalid_frames, 3u);
+    EXPECT_EQ(stats.replies, 0u);
+}
+
+TEST(InverterSimulatorTest, UnknownFunction_ReturnsIllegalFunction) {
+    InverterSimulator sim;
+
+    std::vector<uint8_t> request = {0x11, 0x04, 0x00, 0x00, 0x00, 0x01};
+    uint16_t crc = ModbusFrame::calculateCRC(request);
+    request.push_back(crc & 0xFF);
+    request.push_back((crc >> 8) & 0xFF);
+
+    auto response = sim.processFrame(request);
+    ASSERT_TRUE(response.has_value());
+    EXPECT_EQ((*response)[1], 0x84);
+    EXPECT_EQ((*response)[2], 0x01);
+}
+
+TEST(InverterSimulatorTest, WriteMultiple_UpdatesAllOrNothing) {
+    InverterSimConfig config = InverterSimConfig::defaults();
+    config.registers[9].writable = true;
+    config.registers[9].min_value = 0;
+    config.registers[9].max_value = 100;
+    InverterSimulator sim(config);
+
+    auto response = sim.processFrame(frameBytes(ModbusFrame::createWriteMultipleFrame(17, 8, {40, 60})));
+    ASSERT_TRUE(response.has_value());
+    ModbusResponse parsed = ModbusFrame::parseResponse(ModbusFrame::bytesToHex(*response));
+    EXPECT_FALSE(parsed.is_error);
+    EXPECT_EQ(parsed.data, (std::vector<uint8_t>{0x00, 0x08, 0x00, 0x02}));
+    EXPECT_EQ(sim.readRegister(8), 40);
+    EXPECT_EQ(sim.readRegister(9), 60);
+
+    // One value out of range rejects the whole request
+    auto rejected = sim.processFrame(frameBytes(ModbusFrame::createWriteMultipleFrame(17, 8, {10, 200})));
+    ASSERT_TRUE(rejected.has_value());
+    EXPECT_EQ((*rejected)[1], 0x90);
+    EXPECT_EQ((*rejected)[2], 0x03);
+    EXPECT_EQ(sim.readRegister(8), 40);
+}
+
+TEST(InverterSimulatorTest, ReadWriteMultiple_WritesBeforeReading) {
+    InverterSimulator sim;
+
+    auto response = sim.processFrame(
+        frameBytes(ModbusFrame::createReadWriteMultipleFrame(17, 0, 10, 8, {25})));
+    ASSERT_TRUE(response.has_value());
+
+    ModbusResponse parsed = ModbusFrame::parseResponse(ModbusFrame::bytesToHex(*response));
+    EXPECT_FALSE(parsed.is_error);
+    ASSERT_EQ(parsed.data.size(), 20u);
+    EXPECT_EQ((parsed.data[16] << 8) | parsed.data[17], 25); // Register 8 already updated
+
+    auto read_only = sim.processFrame(
+        frameBytes(ModbusFrame::createReadWriteMultipleFrame(17, 0, 2, 0, {1})));
+    ASSERT_TRUE(read_only.has_value());
+    EXPECT_EQ((*read_only)[1], 0x97);
+    EXPECT_EQ((*read_only)[2], 0x02);
+}
+
+// ============================================================================
+// FAULT AND LATENCY INJECTION TESTS
+// ============================================================================
+
+TEST(InverterSimulatorTest, Faults_CertainRates_AlwaysApply) {
+    InverterSimulator sim;
+
+    SimFaultProfile faults;
+    faults.exception_rate = 1.0;
+    faults.exception_code = 0x06;
+    sim.setFaultProfile(faults);
+
+    auto response = sim.processFrame(readRequest(0, 1));
+    ASSERT_TRUE(response.has_value());
+    EXPECT_EQ((*response)[1], 0x83);
+    EXPECT_EQ((*response)[2], 0x06);
+
+    faults = SimFaultProfile{};
+    faults.crc_error_rate = 1.0;
+    sim.setFaultProfile(faults);
+    response = sim.processFrame(readRequest(0, 1));
+    ASSERT_TRUE(response.has_value());
+    EXPECT_FALSE(ModbusFrame::validateFrame(*response));
+
+    faults = SimFaultProfile{};
+    faults.drop_rate = 1.0;
+    sim.setFaultProfile(faults);
+    EXPECT_FALSE(sim.processFrame(readRequest(0, 1)).has_value());
+
+    auto stats = sim.getStatistics();
+    EXPECT_EQ(stats.exceptions_injected, 1u);
+    EXPECT_EQ(stats.crc_errors_injected, 1u);
+    EXPECT_EQ(stats.drops, 1u);
+}
+
+TEST(InverterSimulatorTest, Faults_DropRate_IsApproximatelyHonoured) {
+    InverterSimConfig config = InverterSimConfig::defaults();
+    config.faults.drop_rate = 0.25;
+    InverterSimulator sim(config);
+
+    const int requests = 4000;
+    for (int i = 0; i < requests; ++i) {
+        sim.processFrame(readRequest(0, 1));
+    }
+
+    double observed = static_cast<double>(sim.getStatistics().drops) / requests;
+    EXPECT_NEAR(observed, 0.25, 0.03);
+}
+
+TEST(InverterSimulatorTest, Latency_Distributions_RespectBounds) {
+    InverterSimulator sim;
+
+    SimLatencyProfile profile;
+    profile.distribution = LatencyDistribution::FIXED;
+    profile.mean = std::chrono::microseconds(1500);
+    sim.setLatencyProfile(profile);
+    EXPECT_EQ(sim.sampleLatency().count(), 1500);
+
+    profile.distribution = LatencyDistribution::LOG_NORMAL;
+    profile.mean = std::chrono::microseconds(2000);
+    profile.stddev = std::chrono::microseconds(1000);
+    profile.min = std::chrono::microseconds(500);
+    profile.max = std::chrono::microseconds(5000);
+    sim.setLatencyProfile(profile);
+
+    double sum = 0.0;
+    const int samples = 2000;
+    for (int i = 0; i < samples; ++i) {
+        auto latency = sim.sampleLatency();
+        EXPECT_GE(latency.count(), 500);
+        EXPECT_LE(latency.count(), 5000);
+        sum += static_cast<double>(latency.count());
+    }
+    EXPECT_NEAR(sum / samples, 2000.0, 200.0);
+}
+
+// ============================================================================
+// CONFIGURATION TESTS
+// ============================================================================
+
+TEST(InverterSimulatorTest, FromJson_OverridesDefaults) {
+    nlohmann::json json = {
+        {"slave_address", 3},
+        {"latency", {{"distribution", "uniform"}, {"min_ms", 1}, {"max_ms", 2}}},
+        {"faults", {{"drop_rate", 0.1}, {"drop_hold_ms", 250}}},
+        {"registers", {{"20", {{"base", 777}, {"dynamics", "constant"}, {"writable", true}}}}}
+    };
+
+    InverterSimConfig config = InverterSimConfig::fromJson(json);
+    EXPECT_EQ(config.slave_address, 3);
+    EXPECT_EQ(config.latency.distribution, LatencyDistribution::UNIFORM);
+    EXPECT_EQ(config.latency.max.count(), 2000);
+    EXPECT_DOUBLE_EQ(config.faults.drop_rate, 0.1);
+    EXPECT_EQ(config.faults.drop_hold.count(), 250);
+    EXPECT_EQ(config.registers.size(), 11u);
+
+    InverterSimulator sim(config);
+    EXPECT_EQ(sim.readRegister(20), 777);
+}
+
+TEST(InverterSimulatorTest, FromJson_InvalidValues_Throw) {
+    EXPECT_THROW(InverterSimConfig::fromJson({{"faults", {{"drop_rate", 1.5}}}}), ConfigException);
+    EXPECT_THROW(InverterSimConfig::fromJson({{"latency", {{"distribution", "bimodal"}}}}), ConfigException);
+    EXPECT_THROW(InverterSimConfig::fromJson({{"registers", {{"1", {{"min", 10}, {"max", 5}}}}}}),
+                 ConfigException);
+}
+
+// ============================================================================
+// IN-PROCESS HTTP ROUND TRIP
+// ============================================================================
+
+class InverterSimServerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        simulator_ = std::make_shared<InverterSimulator>();
+        server_ = std::make_unique<InverterSimServer>(simulator_, kBaseUrl, "test-key");
+        server_->start();
+
+        ModbusConfig modbus_config;
+        modbus_config.slave_address = 17;
+        modbus_config.timeout = Duration(2000);
+        modbus_config.max_retries = 2;
+        modbus_config.retry_delay = Duration(10);
+
+        ApiConfig api_config;
+        api_config.base_url = kBaseUrl;
+        api_config.api_key = "test-key";
+
+        config_.updateModbusConfig(modbus_config);
+        config_.updateApiConfig(api_config);
+        adapter_ = std::make_unique<ProtocolAdapter>(config_);
+    }
+
+    void TearDown() override {
+        adapter_.reset();
+        server_->stop();
+    }
+
+    static constexpr const char* kBaseUrl = "http://127.0.0.1:18089";
+
+    ConfigManager config_;
+    std::shared_ptr<InverterSimulator> simulator_;
+    std::unique_ptr<InverterSimServer> server_;
+    std::unique_ptr<ProtocolAdapter> adapter_;
+};
+
+TEST_F(InverterSimServerTest, ReadAndWrite_ThroughProtocolAdapter) {
+    auto values = adapter_->readRegisters(0, 10);
+    ASSERT_EQ(values.size(), 10u);
+    EXPECT_EQ(values[8], 100);
+
+    EXPECT_TRUE(adapter_->writeRegister(8, 42));
+    EXPECT_EQ(simulator_->readRegister(8), 42);
+
+    auto stats = adapter_->getStatistics();
+    EXPECT_EQ(stats.successful_requests, 2u);
+}
+
+TEST_F(InverterSimServerTest, WriteMultipleAndReadWrite_ThroughProtocolAdapter) {
+    EXPECT_TRUE(adapter_->writeRegisters(8, {30}));
+    EXPECT_EQ(simulator_->readRegister(8), 30);
+
+    auto values = adapter_->readWriteRegisters(0, 10, 8, {70});
+    ASSERT_EQ(values.size(), 10u);
+    EXPECT_EQ(values[8], 70);
+
+    EXPECT_THROW(adapter_->writeRegisters(0, {1}), ModbusException); // Read-only register
+    EXPECT_THROW(adapter_->writeRegisters(8, {}), ModbusException);
+}
+
+TEST_F(InverterSimServerTest, InjectedException_SurfacesAsModbusException) {
+    SimFaultProfile faults;
+    faults.exception_rate = 1.0;
+    simulator_->setFaultProfile(faults);
+
+    EXPECT_THROW(adapter_->readRegisters(0, 2), ModbusException);
+}
+
+TEST_F(InverterSimServerTest, DroppedRequests_AreRetried) {
+    SimFaultProfile faults;
+    faults.drop_rate = 1.0;
+    simulator_->setFaultProfile(faults);
+
+    EXPECT_THROW(adapter_->readRegisters(0, 2), ModbusException);
+    EXPECT_EQ(simulator_->getStatistics().drops, 2u); // max_retries counts attempts
+}
+
+TEST_F(InverterSimServerTest, BatchEnvelope_ManyBlocksOneRoundTrip) {
+    ApiConfig api_config = config_.getApiConfig();
+    api_config.enable_batch = true;
+    config_.updateApiConfig(api_config);
+    adapter_ = std::make_unique<ProtocolAdapter>(config_);
+
+    // Register 200 is outside the register map
+    auto results = adapter_->readRegisterBlocks({{0, 2}, {8, 1}, {200, 1}});
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_TRUE(results[0].ok());
+    EXPECT_EQ(results[1].values, std::vector<RegisterValue>{100});
+    EXPECT_FALSE(results[2].ok());
+
+    auto stats = adapter_->getStatistics();
+    EXPECT_EQ(stats.batch_round_trips, 1u);
+    EXPECT_EQ(stats.batched_frames, 3u);
+}
+
+TEST_F(InverterSimServerTest, BatchEnvelope_UnsupportedServer_FallsBack) {
+    ApiConfig server_api;
+    server_api.batch_endpoint.clear();
+    server_->stop();
+    server_ = std::make_unique<InverterSimServer>(simulator_, kBaseUrl, "test-key", server_api);
+    server_->start();
+
+    ApiConfig api_config = config_.getApiConfig();
+    api_config.enable_batch = true;
+    config_.updateApiConfig(api_config);
+    adapter_ = std::make_unique<ProtocolAdapter>(config_);
+
+    auto results = adapter_->readRegisterBlocks({{0, 2}, {8, 1}});
+    EXPECT_TRUE(results[0].ok());
+    EXPECT_TRUE(results[1].ok());
+    EXPECT_EQ(adapter_->getStatistics().batch_round_trips, 0u);
+}
@@ -0,0 +1,143 @@
+/**
+ * @file test_latency_histogram.cpp
+ * @brief Tests for lock-free latency histogram and EWMA gauge
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/latency_histogram.hpp"
+#include <thread>
+#include <vector>
+
+using namespace ecoWatt;
+
+// ============================================================================
+// BUCKET LAYOUT TESTS
+// ============================================================================
+
+TEST(LatencyHistogramTest, BucketLayout_SmallValues_ExactBuckets) {
+    for (uint64_t value = 0; value < LatencyHistogram::kSubBucketCount; ++value) {
+        size_t index = LatencyHistogram::bucketIndex(value);
+        EXPECT_EQ(index, value);
+        EXPECT_EQ(LatencyHistogram::bucketLowerBound(index), value);
+        EXPECT_EQ(LatencyHistogram::bucketUpperBound(index), value + 1);
+    }
+}
+
+TEST(LatencyHistogramTest, BucketLayout_LargeValues_WithinBounds) {
+    for (uint64_t value : {32ULL, 33ULL, 100ULL, 999ULL, 1000ULL, 123456ULL, 5000000ULL}) {
+        size_t index = LatencyHistogram::bucketIndex(value);
+        EXPECT_LE(LatencyHistogram::bucketLowerBound(index), value) << "value " << value;
+        EXPECT_GT(LatencyHistogram::bucketUpperBound(index), value) << "value " << value;
+
+        // Relative bucket width bounded by 1/32
+        double width = static_cast<double>(LatencyHistogram::bucketUpperBound(index) -
+                                           LatencyHistogram::bucketLowerBound(index));
+        EXPECT_LE(width / value, 1.0 / 32 + 1e-9) << "value " << value;
+    }
+}
+
+TEST(LatencyHistogramTest, BucketLayout_HugeValue_ClampsToLastBucket) {
+    EXPECT_EQ(LatencyHistogram::bucketIndex(UINT64_MAX), LatencyHistogram::kBucketCount - 1);
+}
+
+// ============================================================================
+// RECORDING AND PERCENTILE TESTS
+// ============================================================================
+
+TEST(LatencyHistogramTest, Snapshot_Empty_ReturnsZeros) {
+    LatencyHistogram histogram;
+    auto snapshot = histogram.snapshot();
+
+    EXPECT_EQ(snapshot.count, 0u);
+    EXPECT_EQ(snapshot.min_us, 0u);
+    EXPECT_EQ(snapshot.max_us, 0u);
+    EXPECT_EQ(snapshot.percentile(99), 0u);
+    EXPECT_DOUBLE_EQ(snapshot.mean_us(), 0.0);
+}
+
+TEST(LatencyHistogramTest, Record_SubMillisecond_Captured) {
+    LatencyHistogram histogram;
+    histogram.record(std::chrono::microseconds(250));
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 1u);
+    EXPECT_EQ(snapshot.min_us, 250u);
+    EXPECT_EQ(snapshot.max_us, 250u);
+    EXPECT_DOUBLE_EQ(snapshot.mean_us(), 250.0);
+}
+
+TEST(LatencyHistogramTest, Percentiles_UniformDistribution_Accurate) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 10000; ++value) {
+        histogram.record(value);
+    }
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 10000u);
+    EXPECT_NEAR(snapshot.mean_us(), 5000.5, 0.01);
+    EXPECT_NEAR(static_cast<double>(snapshot.percentile(50)), 5000.0, 5000.0 * 0.04);
+    EXPECT_NEAR(static_cast<double>(snapshot.percentile(99)), 9900.0, 9900.0 * 0.04);
+    EXPECT_LE(snapshot.percentile(100), 10000u);
+}
+
+TEST(LatencyHistogramTest, Reset_ClearsAllCounts) {
+    LatencyHistogram histogram;
+    histogram.record(10);
+    histogram.record(10000);
+    histogram.reset();
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 0u);
+    EXPECT_EQ(snapshot.percentile(50), 0u);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecording_NoLostUpdates) {
+    LatencyHistogram histogram;
+    const int threads = 4;
+    const int per_thread = 10000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&histogram, t]() {
+            for (int i = 0; i < per_thread; ++i) {
+                histogram.record(static_cast<uint64_t>(t * 100 + i % 100));
+            }
+        });
+    }
+
+    // Snapshots while recording must not crash or block
+    for (int i = 0; i < 10; ++i) {
+        auto snapshot = histogram.snapshot();
+        EXPECT_LE(snapshot.count, static_cast<uint64_t>(threads * per_thread));
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(histogram.snapshot().count, static_cast<uint64_t>(threads * per_thread));
+}
+
+// ============================================================================
+// EWMA TESTS
+// ============================================================================
+
+TEST(EwmaGaugeTest, FirstSample_InitializesValue) {
+    EwmaGauge gauge(0.5);
+    EXPECT_DOUBLE_EQ(gauge.value(), 0.0);
+
+    gauge.update(100.0);
+    EXPECT_DOUBLE_EQ(gauge.value(), 100.0);
+}
+
+TEST(EwmaGaugeTest, Update_WeightsNewestSample) {
+    EwmaGauge gauge(0.5);
+    gauge.update(100.0);
+    gauge.update(200.0);
+    EXPECT_DOUBLE_EQ(gauge.value(), 150.0);
+
+    gauge.reset();
+    EXPECT_DOUBLE_EQ(gauge.value(), 0.0);
+}
@@ -0,0 +1,315 @@
+/**
+ * @file test_latest_value_cache.cpp
+ * @brief Tests for the latest-value cache and cache-backed current readings
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/latest_value_cache.hpp"
+#include "../cpp/include/acquisition_scheduler.hpp"
+#include "../cpp/include/inverter_sim_server.hpp"
+#include "../cpp/include/config_manager.hpp"
+#include "../cpp/include/modbus_frame.hpp"
+#include "../cpp/include/transport.hpp"
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace ecoWatt;
+using namespace std::chrono_literals;
+
+namespace {
+
+AcquisitionSample makeSample(RegisterAddress address, RegisterValue raw,
+                             TimePoint timestamp = std::chrono::system_clock::now()) {
+    return AcquisitionSample(timestamp, address, "Register " + std::to_string(address),
+                             raw, raw / 10.0, "V");
+}
+
+/**
+ * @brief Register bank whose first read of @p held_register waits for release()
+ *
+ * The read answers with the values as they were when it arrived, like a
+ * device that sampled its registers before a concurrent write landed.
+ */
+class GatedTransport : public Transport {
+public:
+    explicit GatedTransport(uint16_t held_register) : held_register_(held_register) {}
+
+    std::vector<uint8_t> transact(const std::vector<uint8_t>& request, TransportOperation) override {
+        uint16_t address = (request[2] << 8) | request[3];
+        uint16_t field = (request[4] << 8) | request[5];
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (request[1] == 0x06) {
+            values_[address] = field;
+            return request; // Echo
+        }
+
+        std::vector<uint8_t> response = {request[0], 0x03, static_cast<uint8_t>(field * 2)};
+        for (uint16_t i = 0; i < field; ++i) {
+            RegisterValue value = values_[address + i];
+            response.push_back(static_cast<uint8_t>(value >> 8));
+            response.push_back(static_cast<uint8_t>(value & 0xFF));
+        }
+
+        if (!read_held_ && address <= held_register_ && held_register_ < address + field) {
+            read_held_ = true;
+            changed_.notify_all();
+            changed_.wait(lock, [this] { return released_; });
+        }
+
+        uint16_t crc = ModbusFrame::calculateCRC(response);
+        response.push_back(crc & 0xFF);
+        response.push_back(crc >> 8);
+        return response;
+    }
+
+    size_t maxInFlight() const override { return 2; }
+    std::string describe() const override { return "gated"; }
+
+    void waitForHeldRead() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [this] { return read_held_; });
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        released_ = true;
+        changed_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::map<uint16_t, RegisterValue> values_;
+    uint16_t held_register_;
+    bool read_held_ = false;
+    bool released_ = false;
+};
+
+} // namespace
+
+// ============================================================================
+// CACHE TESTS
+// ============================================================================
+
+TEST(LatestValueCacheTest, Lookup_EmptyCache_AllStale) {
+    LatestValueCache cache(Duration(1000));
+
+    auto lookup = cache.lookup({0, 1, 2});
+    EXPECT_TRUE(lookup.fresh.empty());
+    EXPECT_EQ(lookup.stale, (std::vector<RegisterAddress>{0, 1, 2}));
+    EXPECT_EQ(cache.getStatistics().misses, 3u);
+}
+
+TEST(LatestValueCacheTest, Lookup_FreshValues_ServedInRequestOrder) {
+    LatestValueCache cache(Duration(1000));
+    cache.update(std::vector<AcquisitionSample>{makeSample(0, 2300), makeSample(1, 45)});
+
+    auto lookup = cache.lookup({1, 0, 2});
+    ASSERT_EQ(lookup.fresh.size(), 2u);
+    EXPECT_EQ(lookup.fresh[0].register_address, 1);
+    EXPECT_EQ(lookup.fresh[1].raw_value, 2300);
+    EXPECT_EQ(lookup.stale, std::vector<RegisterAddress>{2});
+
+    auto stats = cache.getStatistics();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.updates, 2u);
+}
+
+TEST(LatestValueCacheTest, Lookup_PerRegisterMaxAge_Applied) {
+    LatestValueCache cache(Duration(1000));
+    cache.setMaxAge(1, Duration(50));
+    cache.update(std::vector<AcquisitionSample>{makeSample(0, 1), makeSample(1, 2)});
+
+    auto later = LatestValueCache::Clock::now() + 200ms;
+    auto lookup = cache.lookup({0, 1}, later);
+    ASSERT_EQ(lookup.fresh.size(), 1u);
+    EXPECT_EQ(lookup.fresh[0].register_address, 0);
+    EXPECT_EQ(lookup.stale, std::vector<RegisterAddress>{1});
+
+    // Zero reverts to the default
+    cache.setMaxAge(1, Duration(0));
+    EXPECT_EQ(cache.getMaxAge(1), Duration(1000));
+    EXPECT_EQ(cache.lookup({1}, later).fresh.size(), 1u);
+}
+
+TEST(LatestValueCacheTest, Configure_UsesRegisterMaxAge) {
+    std::map<RegisterAddress, RegisterConfig> configs;
+    configs[0] = RegisterConfig(0, "Vac", "V", 10.0, AccessType::READ_ONLY, "");
+    configs[8] = RegisterConfig(8, "Export", "%", 1.0, AccessType::READ_WRITE, "");
+    configs[8].max_age = Duration(60000);
+
+    LatestValueCache cache(Duration(5000));
+    cache.configure(configs);
+
+    EXPECT_EQ(cache.getMaxAge(0), Duration(5000));
+    EXPECT_EQ(cache.getMaxAge(8), Duration(60000));
+}
+
+TEST(LatestValueCacheTest, Update_OlderSample_Ignored) {
+    LatestValueCache cache(Duration(1000));
+    auto now = std::chrono::system_clock::now();
+
+    cache.update(makeSample(0, 200, now));
+    cache.update(makeSample(0, 100, now - 1s));
+
+    auto lookup = cache.lookup({0});
+    ASSERT_EQ(lookup.fresh.size(), 1u);
+    EXPECT_EQ(lookup.fresh[0].raw_value, 200);
+    EXPECT_EQ(cache.getStatistics().updates, 1u);
+}
+
+TEST(LatestValueCacheTest, Invalidate_ForcesMiss) {
+    LatestValueCache cache(Duration(1000));
+    cache.update(makeSample(0, 1));
+    cache.update(makeSample(1, 1));
+
+    cache.invalidate(0);
+    EXPECT_EQ(cache.lookup({0, 1}).stale, std::vector<RegisterAddress>{0});
+
+    cache.clear();
+    EXPECT_EQ(cache.lookup({0, 1}).stale.size(), 2u);
+}
+
+TEST(LatestValueCacheTest, Update_ReadStartedBeforeInvalidate_Rejected) {
+    LatestValueCache cache(Duration(1000));
+    uint64_t before = cache.epoch();
+
+    cache.invalidate(8);
+    cache.update(makeSample(8, 10), before);   // In flight across the write
+    cache.update(makeSample(9, 10), before);   // Other registers unaffected
+    EXPECT_EQ(cache.lookup({8, 9}).stale, std::vector<RegisterAddress>{8});
+
+    cache.update(makeSample(8, 55), cache.epoch());
+    auto lookup = cache.lookup({8});
+    ASSERT_EQ(lookup.fresh.size(), 1u);
+    EXPECT_EQ(lookup.fresh[0].raw_value, 55);
+
+    before = cache.epoch();
+    cache.clear();
+    cache.update(makeSample(9, 11), before);
+    EXPECT_EQ(cache.lookup({9}).stale.size(), 1u);
+    EXPECT_EQ(cache.getStatistics().rejected, 2u);
+}
+
+TEST(LatestValueCacheTest, PollInFlightAcrossWrite_DoesNotRecacheOldValue) {
+    ConfigManager config;
+    ModbusConfig modbus_config;
+    modbus_config.slave_address = 17;
+    modbus_config.max_retries = 1;
+    config.updateModbusConfig(modbus_config);
+
+    auto transport = std::make_unique<GatedTransport>(8);
+    GatedTransport* gate = transport.get();
+    AcquisitionScheduler scheduler(std::make_shared<ProtocolAdapter>(config, std::move(transport)), config);
+    scheduler.configureRegisters(config.getRegisterConfigs());
+
+    std::thread poller([&scheduler] { scheduler.pollOnce(); });
+    gate->waitForHeldRead();   // Poll has sampled register 8 as 0
+
+    EXPECT_TRUE(scheduler.performWriteOperation(8, 55));
+    gate->release();
+    poller.join();
+
+    auto samples = scheduler.getLatestSamples({8});
+    ASSERT_EQ(samples.size(), 1u);
+    EXPECT_EQ(samples[0].raw_value, 55);
+    EXPECT_GE(scheduler.getCacheStatistics().rejected, 1u);
+}
+
+// ============================================================================
+// SCHEDULER INTEGRATION (in-process Inverter SIM)
+// ============================================================================
+
+class LatestSamplesTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        simulator_ = std::make_shared<InverterSimulator>();
+        server_ = std::make_unique<InverterSimServer>(simulator_, kBaseUrl);
+        server_->start();
+
+        ModbusConfig modbus_config;
+        modbus_config.slave_address = 17;
+        modbus_config.max_retries = 1;
+        config_.updateModbusConfig(modbus_config);
+
+        ApiConfig api_config;
+        api_config.base_url = kBaseUrl;
+        config_.updateApiConfig(api_config);
+
+        AcquisitionConfig acquisition_config = config_.getAcquisitionConfig();
+        acquisition_config.cache_max_age = Duration(60000);
+        config_.updateAcquisitionConfig(acquisition_config);
+
+        scheduler_ = std::make_unique<AcquisitionScheduler>(
+            std::make_shared<ProtocolAdapter>(config_), config_);
+        scheduler_->configureRegisters(config_.getRegisterConfigs());
+
+        for (const auto& [address, register_config] : config_.getRegisterConfigs()) {
+            addresses_.push_back(address);
+        }
+    }
+
+    void TearDown() override {
+        scheduler_.reset();
+        server_->stop();
+    }
+
+    static constexpr const char* kBaseUrl = "http://127.0.0.1:18092";
+
+    ConfigManager config_;
+    std::shared_ptr<InverterSimulator> simulator_;
+    std::unique_ptr<InverterSimServer> server_;
+    std::unique_ptr<AcquisitionScheduler> scheduler_;
+    std::vector<RegisterAddress> addresses_;
+};
+
+TEST_F(LatestSamplesTest, ColdCache_SingleBlockRead) {
+    auto samples = scheduler_->getLatestSamples(addresses_);
+
+    EXPECT_EQ(samples.size(), addresses_.size());
+    EXPECT_EQ(simulator_->getStatistics().requests, 1u);
+}
+
+TEST_F(LatestSamplesTest, WarmCache_NoInverterTraffic) {
+    scheduler_->pollOnce(); // Poll cycle feeds the cache
+    uint64_t after_poll = simulator_->getStatistics().requests;
+
+    auto samples = scheduler_->getLatestSamples(addresses_);
+    EXPECT_EQ(samples.size(), addresses_.size());
+    EXPECT_EQ(simulator_->getStatistics().requests, after_poll);
+    EXPECT_EQ(scheduler_->getCacheStatistics().hits, addresses_.size());
+}
+
+TEST_F(LatestSamplesTest, StaleRegisters_OnlyThoseReadLive) {
+    scheduler_->getLatestSamples(addresses_);
+    simulator_->resetStatistics();
+
+    scheduler_->setCacheMaxAge(Duration(1));
+    std::this_thread::sleep_for(5ms);
+
+    auto samples = scheduler_->getLatestSamples({3, 4, 5});
+    EXPECT_EQ(samples.size(), 3u);
+    EXPECT_EQ(simulator_->getStatistics().requests, 1u);
+}
+
+TEST_F(LatestSamplesTest, NonContiguousStaleSet_SpanReadWhenConfigured) {
+    auto samples = scheduler_->getLatestSamples({1, 7});
+
+    ASSERT_EQ(samples.size(), 2u);
+    EXPECT_EQ(samples[0].register_address, 1);
+    EXPECT_EQ(samples[1].register_address, 7);
+    EXPECT_EQ(simulator_->getStatistics().requests, 1u);
+
+    // The covering block refreshed the registers in between as well
+    simulator_->resetStatistics();
+    scheduler_->getLatestSamples({2, 3, 4, 5, 6});
+    EXPECT_EQ(simulator_->getStatistics().requests, 0u);
+}
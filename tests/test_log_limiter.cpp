@@ -0,0 +1,131 @@
+/**
+ * @file test_log_limiter.cpp
+ * @brief Tests for per-call-site log rate limiting and duplicate folding
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/log_limiter.hpp"
+#include <spdlog/sinks/ostream_sink.h>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ecoWatt;
+
+class LogLimiterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto sink = std::make_shared<spdlog::sinks::ostream_sink_mt>(output_);
+        logger_ = std::make_shared<spdlog::logger>("log_limiter_test", sink);
+        logger_->set_pattern("%v");
+        configure(3, 0.0, std::chrono::milliseconds(60000));
+    }
+
+    void TearDown() override {
+        LoggingConfig defaults;
+        LogSite::configure(defaults);
+    }
+
+    void configure(uint32_t burst, double per_minute, std::chrono::milliseconds interval) {
+        LoggingConfig config;
+        config.suppress_burst = burst;
+        config.suppress_per_minute = per_minute;
+        config.suppress_summary_interval = Duration(interval.count());
+        LogSite::configure(config);
+    }
+
+    std::vector<std::string> lines() const {
+        std::vector<std::string> result;
+        std::istringstream stream(output_.str());
+        for (std::string line; std::getline(stream, line);) {
+            result.push_back(line);
+        }
+        return result;
+    }
+
+    std::ostringstream output_;
+    std::shared_ptr<spdlog::logger> logger_;
+};
+
+TEST_F(LogLimiterTest, Duplicates_FoldedUntilDifferentMessage) {
+    LogSite site("src/protocol_adapter.cpp", 42);
+    auto before = LogSite::getStatistics();
+
+    for (int i = 0; i < 50; ++i) {
+        site.log(*logger_, spdlog::level::err, "Request failed: {}", "timeout");
+    }
+    ASSERT_EQ(lines().size(), 1u);
+    EXPECT_EQ(lines()[0], "Request failed: timeout");
+
+    site.log(*logger_, spdlog::level::err, "Request failed: {}", "refused");
+    auto out = lines();
+    ASSERT_EQ(out.size(), 3u);
+    EXPECT_EQ(out[1], "[protocol_adapter.cpp:42] last message repeated 49 times");
+    EXPECT_EQ(out[2], "Request failed: refused");
+    EXPECT_EQ(LogSite::getStatistics().folded - before.folded, 49u);
+}
+
+TEST_F(LogLimiterTest, DistinctMessages_RateLimitedAfterBurst) {
+    LogSite site("a.cpp", 1);
+    auto before = LogSite::getStatistics();
+
+    for (int i = 0; i < 20; ++i) {
+        site.log(*logger_, spdlog::level::warn, "Register {} unreachable", i);
+    }
+    auto out = lines();
+    ASSERT_EQ(out.size(), 3u);
+    EXPECT_EQ(out[2], "Register 2 unreachable");
+    EXPECT_EQ(LogSite::getStatistics().suppressed - before.suppressed, 17u);
+
+    // Pending counts are written at shutdown
+    LogSite::flushAll(*logger_);
+    out = lines();
+    ASSERT_EQ(out.size(), 4u);
+    EXPECT_EQ(out[3].rfind("[a.cpp:1] 17 messages suppressed in the last", 0), 0u);
+}
+
+TEST_F(LogLimiterTest, Summary_WrittenAfterInterval) {
+    configure(1, 0.0, std::chrono::milliseconds(50));
+    LogSite site("b.cpp", 7);
+
+    site.log(*logger_, spdlog::level::err, "down");
+    site.log(*logger_, spdlog::level::err, "down");
+    site.log(*logger_, spdlog::level::err, "down");
+    EXPECT_EQ(lines().size(), 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    site.log(*logger_, spdlog::level::err, "down");
+    auto out = lines();
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[1], "[b.cpp:7] last message repeated 3 times");
+}
+
+TEST_F(LogLimiterTest, TokensRefillOverTime) {
+    configure(1, 60000.0, std::chrono::milliseconds(60000)); // 1000 per second
+    LogSite site("c.cpp", 3);
+
+    site.log(*logger_, spdlog::level::warn, "first");
+    site.log(*logger_, spdlog::level::warn, "second");
+    EXPECT_EQ(lines().size(), 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    site.log(*logger_, spdlog::level::warn, "third");
+    EXPECT_EQ(lines().size(), 2u);
+}
+
+TEST_F(LogLimiterTest, Disabled_PassesEverything) {
+    LoggingConfig config;
+    config.suppress_enabled = false;
+    LogSite::configure(config);
+    LogSite site("d.cpp", 9);
+
+    for (int i = 0; i < 20; ++i) {
+        site.log(*logger_, spdlog::level::err, "same");
+    }
+    EXPECT_EQ(lines().size(), 20u);
+}
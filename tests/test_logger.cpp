@@ -0,0 +1,90 @@
+/**
+ * @file test_logger.cpp
+ * @brief Tests for logger initialization, level filtering and async overflow
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/logger.hpp"
+#include <spdlog/details/console_globals.h>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+using namespace ecoWatt;
+
+class LoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::shutdown(); // Every test starts without a logger
+    }
+
+    void TearDown() override {
+        Logger::shutdown();
+        std::remove(kLogFile);
+    }
+
+    static LoggingConfig makeConfig(LogLevel console_level, LogLevel file_level) {
+        LoggingConfig config;
+        config.console_level = console_level;
+        config.file_level = file_level;
+        config.log_file = kLogFile;
+        return config;
+    }
+
+    static constexpr const char* kLogFile = "test_logger.log";
+};
+
+TEST_F(LoggerTest, DisabledLevel_ArgumentsNotEvaluated) {
+    Logger::initialize(makeConfig(LogLevel::INFO, LogLevel::INFO));
+
+    int evaluated = 0;
+    auto argument = [&evaluated] { return ++evaluated; };
+
+    LOG_DEBUG("Debug value {}", argument());
+    EXPECT_EQ(evaluated, 0);
+
+    LOG_INFO("Info value {}", argument());
+    EXPECT_EQ(evaluated, 1);
+}
+
+TEST_F(LoggerTest, Initialize_ReplacesDefaultedLoggerAndAppliesLevels) {
+    LOG_INFO("Logged before initialize"); // Creates the default logger
+    spdlog::logger* defaulted = &Logger::instance();
+
+    Logger::initialize(makeConfig(LogLevel::WARN, LogLevel::DEBUG));
+    spdlog::logger* configured = &Logger::instance();
+
+    EXPECT_NE(configured, defaulted);
+    EXPECT_EQ(configured->level(), spdlog::level::debug); // Most verbose sink
+    ASSERT_EQ(configured->sinks().size(), 2u);
+    EXPECT_EQ(configured->sinks()[0]->level(), spdlog::level::warn);
+    EXPECT_EQ(configured->sinks()[1]->level(), spdlog::level::debug);
+
+    // A caller still holding the replaced logger can finish its call
+    defaulted->info("Logged through the replaced logger");
+
+    // An explicit configuration is not replaced by a later one
+    Logger::initialize(makeConfig(LogLevel::TRACE, LogLevel::TRACE));
+    EXPECT_EQ(&Logger::instance(), configured);
+}
+
+TEST_F(LoggerTest, AsyncOverrunOldest_FullQueueDoesNotBlock) {
+    LoggingConfig config = makeConfig(LogLevel::INFO, LogLevel::INFO);
+    config.async = true;
+    config.async_queue_size = 4;
+    config.async_overflow = LogOverflowPolicy::OVERRUN_OLDEST;
+    Logger::initialize(config);
+
+    {
+        // Stall the writer thread inside the console sink
+        std::lock_guard<std::mutex> console(spdlog::details::console_mutex::mutex());
+
+        // With the block policy this loop would wait for the writer forever
+        for (int i = 0; i < 100; ++i) {
+            LOG_INFO("Queued message {}", i);
+        }
+        EXPECT_GT(spdlog::thread_pool()->overrun_counter(), 0u);
+    }
+}
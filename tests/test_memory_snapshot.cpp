@@ -0,0 +1,278 @@
+/**
+ * @file test_memory_snapshot.cpp
+ * @brief Tests for the memory-mapped warm-start snapshot of the memory rings
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/memory_snapshot.hpp"
+#include "../cpp/include/data_storage.hpp"
+#include "../cpp/include/exceptions.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace ecoWatt;
+
+class MemorySnapshotTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::remove(path_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path_);
+    }
+
+    AcquisitionSample sample(RegisterAddress address, int64_t timestamp_ms, RegisterValue raw) {
+        return AcquisitionSample(start_ + Duration(timestamp_ms), address,
+                                 address == 0 ? "Voltage" : "Current", raw, raw / 10.0,
+                                 address == 0 ? "V" : "A");
+    }
+
+    std::vector<uint8_t> readFile() {
+        std::ifstream file(path_, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), {});
+    }
+
+    void writeFile(const std::vector<uint8_t>& bytes) {
+        std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    // Byte offset of record @p index in ring @p slot
+    static size_t recordOffset(uint32_t max_registers, uint32_t capacity, uint32_t slot, uint32_t index) {
+        return sizeof(SnapshotHeader) + max_registers * sizeof(SnapshotRegister) +
+               (static_cast<size_t>(slot) * capacity + index) * sizeof(SnapshotRecord);
+    }
+
+    const std::string path_ = "test_memory.snap";
+    const TimePoint start_ = TimePoint(std::chrono::milliseconds(1757116800000));
+};
+
+TEST_F(MemorySnapshotTest, NewFile_HasFixedSizeAndNothingRestored) {
+    MemorySnapshotFile snapshot(path_, 4, 10);
+    EXPECT_TRUE(snapshot.takeRestored().empty());
+    EXPECT_EQ(std::filesystem::file_size(path_), MemorySnapshotFile::fileSize(4, 10));
+    EXPECT_EQ(MemorySnapshotFile::fileSize(4, 10), 64u + 4 * 64u + 4 * 10 * 40u);
+    EXPECT_TRUE(snapshot.getStatistics().reset_reason.empty());
+}
+
+TEST_F(MemorySnapshotTest, Reopen_RestoresLastSamplesInOrder) {
+    {
+        MemorySnapshotFile snapshot(path_, 4, 5);
+        for (int i = 0; i < 12; ++i) {
+            snapshot.append(sample(0, i * 1000, static_cast<RegisterValue>(2300 + i)));
+            if (i % 2 == 0) {
+                snapshot.append(sample(1, i * 1000 + 5, static_cast<RegisterValue>(i)));
+            }
+        }
+        EXPECT_EQ(snapshot.getStatistics().written, 18u);
+    }
+
+    MemorySnapshotFile snapshot(path_, 4, 5);
+    auto restored = snapshot.takeRestored();
+    ASSERT_EQ(restored.size(), 2u);
+
+    // The ring wrapped: the newest five, oldest first
+    const auto& voltage = restored[0];
+    ASSERT_EQ(voltage.size(), 5u);
+    for (size_t i = 0; i < voltage.size(); ++i) {
+        EXPECT_EQ(voltage[i].raw_value, 2307 + i);
+        EXPECT_EQ(voltage[i].timestamp, start_ + Duration((7 + i) * 1000));
+        EXPECT_DOUBLE_EQ(voltage[i].scaled_value, (2307 + i) / 10.0);
+        EXPECT_EQ(voltage[i].register_name, "Voltage");
+        EXPECT_EQ(voltage[i].unit, "V");
+    }
+    const auto& current = restored[1];
+    ASSERT_EQ(current.size(), 5u);
+    EXPECT_EQ(current.front().raw_value, 2);
+    EXPECT_EQ(current.back().raw_value, 10);
+    EXPECT_EQ(snapshot.getStatistics().restored, 10u);
+    EXPECT_EQ(snapshot.getStatistics().discarded, 0u);
+
+    // Writing continues after the newest record
+    snapshot.append(sample(0, 20000, 9999));
+    snapshot.takeRestored();
+}
+
+TEST_F(MemorySnapshotTest, ContinuesAcrossSeveralRestarts) {
+    for (int run = 0; run < 3; ++run) {
+        MemorySnapshotFile snapshot(path_, 2, 4);
+        snapshot.takeRestored();
+        snapshot.append(sample(0, run * 1000, static_cast<RegisterValue>(run)));
+        snapshot.append(sample(0, run * 1000 + 1, static_cast<RegisterValue>(run + 100)));
+    }
+
+    MemorySnapshotFile snapshot(path_, 2, 4);
+    auto ring = snapshot.takeRestored()[0];
+    ASSERT_EQ(ring.size(), 4u);
+    EXPECT_EQ(ring[0].raw_value, 1);
+    EXPECT_EQ(ring[1].raw_value, 101);
+    EXPECT_EQ(ring[2].raw_value, 2);
+    EXPECT_EQ(ring[3].raw_value, 102);
+}
+
+TEST_F(MemorySnapshotTest, CorruptRecord_IsDiscarded) {
+    {
+        MemorySnapshotFile snapshot(path_, 2, 4);
+        for (int i = 0; i < 3; ++i) {
+            snapshot.append(sample(0, i, static_cast<RegisterValue>(i)));
+        }
+    }
+    // A torn write: the value changed but the checksum did not
+    auto bytes = readFile();
+    bytes[recordOffset(2, 4, 0, 1) + offsetof(SnapshotRecord, scaled_value)] ^= 0x40;
+    writeFile(bytes);
+
+    MemorySnapshotFile snapshot(path_, 2, 4);
+    auto ring = snapshot.takeRestored()[0];
+    ASSERT_EQ(ring.size(), 2u);
+    EXPECT_EQ(ring[0].raw_value, 0);
+    EXPECT_EQ(ring[1].raw_value, 2);
+    EXPECT_EQ(snapshot.getStatistics().discarded, 1u);
+    EXPECT_TRUE(snapshot.getStatistics().reset_reason.empty());
+}
+
+TEST_F(MemorySnapshotTest, CorruptHeaderOrOtherVersion_StartsEmpty) {
+    {
+        MemorySnapshotFile snapshot(path_, 2, 4);
+        snapshot.append(sample(0, 0, 1));
+    }
+    auto bytes = readFile();
+    bytes[offsetof(SnapshotHeader, max_registers)] ^= 0x01;
+    writeFile(bytes);
+    {
+        MemorySnapshotFile snapshot(path_, 2, 4);
+        EXPECT_TRUE(snapshot.takeRestored().empty());
+        EXPECT_EQ(snapshot.getStatistics().reset_reason, "header checksum mismatch");
+        snapshot.append(sample(0, 0, 1));
+    }
+
+    bytes = readFile();
+    SnapshotHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    header.version = kSnapshotVersion + 1;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    writeFile(bytes);
+    {
+        MemorySnapshotFile snapshot(path_, 2, 4);
+        EXPECT_TRUE(snapshot.takeRestored().empty());
+        EXPECT_NE(snapshot.getStatistics().reset_reason.find("version"), std::string::npos);
+    }
+
+    writeFile({'n', 'o', 't', ' ', 'a', ' ', 's', 'n', 'a', 'p'});
+    MemorySnapshotFile snapshot(path_, 2, 4);
+    EXPECT_TRUE(snapshot.takeRestored().empty());
+    EXPECT_EQ(std::filesystem::file_size(path_), MemorySnapshotFile::fileSize(2, 4));
+}
+
+TEST_F(MemorySnapshotTest, GeometryChange_KeepsNewestSamplesThatFit) {
+    {
+        MemorySnapshotFile snapshot(path_, 4, 10);
+        for (int i = 0; i < 10; ++i) {
+            snapshot.append(sample(0, i, static_cast<RegisterValue>(i)));
+            snapshot.append(sample(1, i, static_cast<RegisterValue>(100 + i)));
+        }
+    }
+
+    {
+        MemorySnapshotFile snapshot(path_, 4, 3);
+        auto restored = snapshot.takeRestored();
+        ASSERT_EQ(restored[0].size(), 3u);
+        EXPECT_EQ(restored[0].front().raw_value, 7);
+        EXPECT_EQ(restored[1].back().raw_value, 109);
+        EXPECT_NE(snapshot.getStatistics().reset_reason.find("geometry"), std::string::npos);
+        EXPECT_EQ(std::filesystem::file_size(path_), MemorySnapshotFile::fileSize(4, 3));
+    }
+
+    // The rebuilt file is reused as is
+    MemorySnapshotFile snapshot(path_, 4, 3);
+    EXPECT_EQ(snapshot.takeRestored()[0].back().raw_value, 9);
+    EXPECT_TRUE(snapshot.getStatistics().reset_reason.empty());
+}
+
+TEST_F(MemorySnapshotTest, RegisterLimit_CountsOverflow) {
+    MemorySnapshotFile snapshot(path_, 1, 4);
+    snapshot.append(sample(0, 0, 1));
+    snapshot.append(sample(1, 0, 2));
+    EXPECT_EQ(snapshot.getStatistics().register_overflow, 1u);
+    EXPECT_EQ(snapshot.getStatistics().written, 1u);
+}
+
+TEST_F(MemorySnapshotTest, Clear_IsPersisted) {
+    {
+        MemorySnapshotFile snapshot(path_, 2, 4);
+        snapshot.append(sample(0, 0, 1));
+        snapshot.append(sample(1, 0, 2));
+        snapshot.clear(0);
+    }
+    {
+        MemorySnapshotFile snapshot(path_, 2, 4);
+        auto restored = snapshot.takeRestored();
+        EXPECT_EQ(restored.count(0), 0u);
+        EXPECT_EQ(restored.count(1), 1u);
+        snapshot.clearAll();
+    }
+    MemorySnapshotFile snapshot(path_, 2, 4);
+    EXPECT_TRUE(snapshot.takeRestored().empty());
+}
+
+TEST_F(MemorySnapshotTest, InvalidLimits_Throw) {
+    EXPECT_THROW(MemorySnapshotFile(path_, 0, 4), ValidationException);
+    EXPECT_THROW(MemorySnapshotFile(path_, 4, 0), ValidationException);
+    EXPECT_THROW(MemorySnapshotFile("/nonexistent-dir/x.snap", 4, 4), StorageException);
+}
+
+TEST_F(MemorySnapshotTest, MemoryStorage_WarmStartWithoutSQLite) {
+    {
+        MemoryDataStorage storage(100, path_);
+        for (int i = 0; i < 150; ++i) {
+            storage.storeSample(sample(0, i * 1000, static_cast<RegisterValue>(i)));
+        }
+        storage.storeSample(sample(1, 0, 42));
+    }
+
+    MemoryDataStorage storage(100, path_);
+    auto latest = storage.getLatestSample(0);
+    ASSERT_NE(latest, nullptr);
+    EXPECT_EQ(latest->raw_value, 149);
+    EXPECT_EQ(storage.getSamples(0).size(), 100u);
+    EXPECT_EQ(storage.getSamples(0).back().raw_value, 50);
+    EXPECT_EQ(storage.getAllLatestSamples().size(), 2u);
+    ASSERT_TRUE(storage.getSnapshotStatistics().has_value());
+    EXPECT_EQ(storage.getSnapshotStatistics()->restored, 101u);
+
+    // Without a path there is no snapshot
+    MemoryDataStorage plain(100);
+    EXPECT_FALSE(plain.getSnapshotStatistics().has_value());
+    EXPECT_EQ(plain.getLatestSample(0), nullptr);
+}
+
+TEST_F(MemorySnapshotTest, HybridStorage_LatestFromSnapshotAfterRestart) {
+    StorageConfig config;
+    config.database_path = "test_memory_snapshot.db";
+    config.snapshot_path = path_;
+    config.memory_retention_samples = 50;
+    std::filesystem::remove(config.database_path);
+    {
+        HybridDataStorage storage(config);
+        storage.storeSample(sample(0, 0, 2301));
+        storage.storeSample(sample(0, 1000, 2302));
+    }
+
+    {
+        HybridDataStorage storage(config);
+        auto latest = storage.getAllLatestSamples();
+        ASSERT_EQ(latest.count(0), 1u);
+        EXPECT_EQ(latest[0].raw_value, 2302);
+        EXPECT_DOUBLE_EQ(latest[0].scaled_value, 230.2);
+        EXPECT_EQ(storage.getRecentSamples(0, 10).size(), 2u);
+    }
+    std::filesystem::remove(config.database_path);
+    std::filesystem::remove(config.database_path + "-wal");
+    std::filesystem::remove(config.database_path + "-shm");
+}
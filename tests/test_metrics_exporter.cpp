@@ -0,0 +1,145 @@
+/**
+ * @file test_metrics_exporter.cpp
+ * @brief Tests for the OpenMetrics writer and the /metrics endpoint
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/metrics_exporter.hpp"
+#include <cpprest/http_client.h>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+using namespace ecoWatt;
+
+namespace {
+
+MetricsConfig metricsConfig() {
+    MetricsConfig config;
+    config.enabled = true;
+    config.listen_url = "http://127.0.0.1:18094";
+    config.refresh_interval = Duration(50);
+    return config;
+}
+
+bool contains(const std::string& text, const std::string& line) {
+    return text.find(line) != std::string::npos;
+}
+
+} // namespace
+
+TEST(MetricsWriterTest, CounterAndGauge_FollowFamilyLines) {
+    std::string out;
+    MetricsWriter writer(out);
+    writer.family("ecowatt_polls", "counter", "Poll cycles");
+    writer.counter("ecowatt_polls", 7, "result=\"success\"");
+    writer.counter("ecowatt_polls", 2, "result=\"failure\"");
+    writer.family("ecowatt_running", "gauge", "Running");
+    writer.gauge("ecowatt_running", 1.0);
+    writer.gauge("ecowatt_running", 0.25, "lane=\"control\"");
+
+    EXPECT_EQ(out,
+              "# TYPE ecowatt_polls counter\n"
+              "# HELP ecowatt_polls Poll cycles\n"
+              "ecowatt_polls_total{result=\"success\"} 7\n"
+              "ecowatt_polls_total{result=\"failure\"} 2\n"
+              "# TYPE ecowatt_running gauge\n"
+              "# HELP ecowatt_running Running\n"
+              "ecowatt_running 1\n"
+              "ecowatt_running{lane=\"control\"} 0.25\n");
+}
+
+TEST(MetricsWriterTest, Histogram_CumulativeBucketsInSeconds) {
+    LatencyHistogram histogram;
+    histogram.record(500);         // 0.5 ms
+    histogram.record(3000);        // 3 ms
+    histogram.record(20000);       // 20 ms
+    histogram.record(20000000);    // 20 s, above the last bound
+
+    std::string out;
+    MetricsWriter writer(out);
+    writer.histogram("ecowatt_latency_seconds", histogram.snapshot(), "operation=\"read\"");
+
+    EXPECT_TRUE(contains(out, "ecowatt_latency_seconds_bucket{operation=\"read\",le=\"0.001\"} 1\n"));
+    EXPECT_TRUE(contains(out, "ecowatt_latency_seconds_bucket{operation=\"read\",le=\"0.0025\"} 1\n"));
+    EXPECT_TRUE(contains(out, "ecowatt_latency_seconds_bucket{operation=\"read\",le=\"0.005\"} 2\n"));
+    EXPECT_TRUE(contains(out, "ecowatt_latency_seconds_bucket{operation=\"read\",le=\"0.025\"} 3\n"));
+    EXPECT_TRUE(contains(out, "ecowatt_latency_seconds_bucket{operation=\"read\",le=\"1.0\"} 3\n"));
+    EXPECT_TRUE(contains(out, "ecowatt_latency_seconds_bucket{operation=\"read\",le=\"10.0\"} 3\n"));
+    EXPECT_TRUE(contains(out, "ecowatt_latency_seconds_bucket{operation=\"read\",le=\"+Inf\"} 4\n"));
+    EXPECT_TRUE(contains(out, "ecowatt_latency_seconds_count{operation=\"read\"} 4\n"));
+    EXPECT_TRUE(contains(out, "ecowatt_latency_seconds_sum{operation=\"read\"} 20.0235\n"));
+}
+
+TEST(MetricsExporterTest, Refresh_RepublishesOnlyChangedSections) {
+    MetricsExporter exporter(metricsConfig());
+    uint64_t polls = 1;
+    exporter.addCollector([&polls](MetricsWriter& out) {
+        out.family("ecowatt_polls", "counter", "Poll cycles");
+        out.counter("ecowatt_polls", polls);
+    });
+    exporter.addCollector([](MetricsWriter& out) {
+        out.family("ecowatt_running", "gauge", "Running");
+        out.gauge("ecowatt_running", 1.0);
+    });
+
+    EXPECT_EQ(*exporter.body(), "# EOF\n");
+    EXPECT_TRUE(exporter.refresh());
+    auto first = exporter.body();
+    EXPECT_TRUE(contains(*first, "ecowatt_polls_total 1\n"));
+    EXPECT_TRUE(contains(*first, "ecowatt_running 1\n"));
+    EXPECT_EQ(first->substr(first->size() - 6), "# EOF\n");
+
+    // Nothing changed: the same buffer keeps being served
+    EXPECT_FALSE(exporter.refresh());
+    EXPECT_EQ(exporter.body(), first);
+
+    polls = 2;
+    EXPECT_TRUE(exporter.refresh());
+    EXPECT_TRUE(contains(*exporter.body(), "ecowatt_polls_total 2\n"));
+    EXPECT_TRUE(contains(*first, "ecowatt_polls_total 1\n"));  // Earlier readers keep their copy
+}
+
+TEST(MetricsExporterTest, Refresh_FailingCollectorKeepsLastSection) {
+    MetricsExporter exporter(metricsConfig());
+    bool fail = false;
+    exporter.addCollector([&fail](MetricsWriter& out) {
+        if (fail) {
+            throw std::runtime_error("storage unavailable");
+        }
+        out.family("ecowatt_samples", "gauge", "Samples");
+        out.gauge("ecowatt_samples", 5.0);
+    });
+
+    EXPECT_TRUE(exporter.refresh());
+    fail = true;
+    EXPECT_FALSE(exporter.refresh());
+    EXPECT_TRUE(contains(*exporter.body(), "ecowatt_samples 5\n"));
+}
+
+TEST(MetricsExporterTest, Scrape_ServesPublishedBody) {
+    MetricsExporter exporter(metricsConfig());
+    std::atomic<uint64_t> polls{3};
+    exporter.addCollector([&polls](MetricsWriter& out) {
+        out.family("ecowatt_polls", "counter", "Poll cycles");
+        out.counter("ecowatt_polls", polls.load());
+    });
+    exporter.start();
+
+    web::http::client::http_client client(U("http://127.0.0.1:18094"));
+    auto response = client.request(web::http::methods::GET, U("/metrics")).get();
+    EXPECT_EQ(response.status_code(), web::http::status_codes::OK);
+    EXPECT_EQ(utility::conversions::to_utf8string(response.headers().content_type()),
+              MetricsExporter::kContentType);
+    std::string body = utility::conversions::to_utf8string(response.extract_string().get());
+    EXPECT_TRUE(contains(body, "ecowatt_polls_total 3\n"));
+    EXPECT_EQ(exporter.scrapeCount(), 1u);
+
+    auto missing = client.request(web::http::methods::GET, U("/other")).get();
+    EXPECT_EQ(missing.status_code(), web::http::status_codes::NotFound);
+
+    exporter.stop();
+    EXPECT_FALSE(exporter.isRunning());
+}
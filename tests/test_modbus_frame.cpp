@@ -176,6 +176,65 @@ TEST_F(ModbusFrameTest, CreateWriteFrame_CRCValidation_Success) {
     EXPECT_TRUE(ModbusFrame::validateFrame(bytes)) << "CRC validation should pass";
 }
 
+// ============================================================================
+// MULTIPLE REGISTER FRAME TESTS (FC16 / FC23)
+// ============================================================================
+
+TEST_F(ModbusFrameTest, CreateWriteMultipleFrame_ValidParameters_Success) {
+    std::string frame = ModbusFrame::createWriteMultipleFrame(0x11, 0x0008, {0x0064, 0x000A});
+    
+    EXPECT_TRUE(isValidHexString(frame)) << "Frame should be valid hex string";
+    EXPECT_EQ(frame.length(), 26) << "Frame should be 13 bytes (9 + 2 * 2 values)";
+    EXPECT_EQ(frame.substr(0, 2), "11") << "Slave address should be 0x11";
+    EXPECT_EQ(frame.substr(2, 2), "10") << "Function code should be 0x10";
+    EXPECT_EQ(frame.substr(4, 4), "0008") << "Start address should be 0x0008";
+    EXPECT_EQ(frame.substr(8, 4), "0002") << "Quantity should be 2";
+    EXPECT_EQ(frame.substr(12, 2), "04") << "Byte count should be 4";
+    EXPECT_EQ(frame.substr(14, 8), "0064000A") << "Values should be big-endian";
+    EXPECT_TRUE(ModbusFrame::validateFrame(ModbusFrame::hexToBytes(frame))) << "CRC validation should pass";
+}
+
+TEST_F(ModbusFrameTest, CreateReadWriteMultipleFrame_ValidParameters_Success) {
+    std::string frame = ModbusFrame::createReadWriteMultipleFrame(0x11, 0x0000, 10, 0x0008, {0x0032});
+    
+    EXPECT_TRUE(isValidHexString(frame)) << "Frame should be valid hex string";
+    EXPECT_EQ(frame.length(), 30) << "Frame should be 15 bytes (13 + 2 * 1 value)";
+    EXPECT_EQ(frame.substr(2, 2), "17") << "Function code should be 0x17";
+    EXPECT_EQ(frame.substr(4, 8), "0000000A") << "Read start 0, quantity 10";
+    EXPECT_EQ(frame.substr(12, 8), "00080001") << "Write start 8, quantity 1";
+    EXPECT_EQ(frame.substr(20, 6), "020032") << "Byte count and value";
+    EXPECT_TRUE(ModbusFrame::validateFrame(ModbusFrame::hexToBytes(frame))) << "CRC validation should pass";
+}
+
+TEST_F(ModbusFrameTest, ParseResponse_WriteMultipleResponse_Success) {
+    std::vector<uint8_t> bytes = {0x11, 0x10, 0x00, 0x08, 0x00, 0x02};
+    uint16_t crc = ModbusFrame::calculateCRC(bytes);
+    bytes.push_back(crc & 0xFF);
+    bytes.push_back((crc >> 8) & 0xFF);
+    
+    ModbusResponse response = ModbusFrame::parseResponse(ModbusFrame::bytesToHex(bytes));
+    
+    EXPECT_EQ(response.function_code, 0x10) << "Function code should be 0x10";
+    EXPECT_FALSE(response.is_error) << "Should not be an error response";
+    ASSERT_EQ(response.data.size(), 4) << "Data should contain start address + quantity";
+    EXPECT_EQ((response.data[0] << 8) | response.data[1], 0x0008) << "Echoed start should be 0x0008";
+    EXPECT_EQ((response.data[2] << 8) | response.data[3], 2) << "Echoed quantity should be 2";
+}
+
+TEST_F(ModbusFrameTest, ParseResponse_ReadWriteMultipleResponse_Success) {
+    std::vector<uint8_t> bytes = {0x11, 0x17, 0x04, 0x09, 0xC4, 0x00, 0x32};
+    uint16_t crc = ModbusFrame::calculateCRC(bytes);
+    bytes.push_back(crc & 0xFF);
+    bytes.push_back((crc >> 8) & 0xFF);
+    
+    ModbusResponse response = ModbusFrame::parseResponse(ModbusFrame::bytesToHex(bytes));
+    
+    EXPECT_EQ(response.function_code, 0x17) << "Function code should be 0x17";
+    ASSERT_EQ(response.data.size(), 4) << "Data should exclude the byte count";
+    EXPECT_EQ(response.data[0], 0x09) << "First data byte should be 0x09";
+    EXPECT_EQ(response.data[3], 0x32) << "Last data byte should be 0x32";
+}
+
 // ============================================================================
 // PARSE RESPONSE TESTS
 // ============================================================================
@@ -0,0 +1,179 @@
+/**
+ * @file test_modbus_rtu_transport.cpp
+ * @brief Tests for the Modbus RTU serial transport over a pseudo-terminal
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/modbus_rtu_transport.hpp"
+#include "../cpp/include/modbus_rtu_sim_slave.hpp"
+#include "../cpp/include/protocol_adapter.hpp"
+#include "../cpp/include/config_manager.hpp"
+#include "../cpp/include/modbus_frame.hpp"
+#include "../cpp/include/exceptions.hpp"
+#include <memory>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace ecoWatt;
+using namespace std::chrono_literals;
+
+// ============================================================================
+// TIMING AND FRAMING TESTS
+// ============================================================================
+
+TEST(ModbusRtuTimingTest, TimingForBaud_ScalesWithBaudRateUpTo19200) {
+    auto slow = ModbusRtuTransport::timingForBaud(9600);
+    EXPECT_EQ(slow.character, 1146us);   // 11 bits at 9600 baud
+    EXPECT_EQ(slow.inter_char, 1719us);
+    EXPECT_EQ(slow.inter_frame, 4011us);
+
+    auto fast = ModbusRtuTransport::timingForBaud(115200);
+    EXPECT_EQ(fast.inter_char, 750us);
+    EXPECT_EQ(fast.inter_frame, 1750us);
+}
+
+TEST(ModbusRtuTimingTest, UnsupportedBaudRate_Throws) {
+    EXPECT_THROW(ModbusRtuTransport("/dev/null", 12345), ConfigException);
+}
+
+TEST(ModbusRtuTimingTest, ExpectedLengths_FromFunctionCode) {
+    EXPECT_EQ(ModbusRtuTransport::expectedResponseLength({0x11}), 0u);
+    EXPECT_EQ(ModbusRtuTransport::expectedResponseLength({0x11, 0x03, 0x04}), 9u);
+    EXPECT_EQ(ModbusRtuTransport::expectedResponseLength({0x11, 0x06}), 8u);
+    EXPECT_EQ(ModbusRtuTransport::expectedResponseLength({0x11, 0x83}), 5u);
+
+    EXPECT_EQ(ModbusRtuTransport::expectedRequestLength(ModbusFrame::createReadFrameBytes(17, 0, 2)), 8u);
+    auto write_multiple = ModbusFrame::createWriteMultipleFrameBytes(17, 8, {1, 2});
+    EXPECT_EQ(ModbusRtuTransport::expectedRequestLength(write_multiple), write_multiple.size());
+    auto read_write = ModbusFrame::createReadWriteMultipleFrameBytes(17, 0, 2, 8, {1});
+    EXPECT_EQ(ModbusRtuTransport::expectedRequestLength(read_write), read_write.size());
+}
+
+TEST(ModbusRtuTimingTest, ReceiveFrame_SilentIntervalSeparatesFrames) {
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    // A t3.5 far longer than any real line's, so a writer descheduled on a
+    // loaded machine cannot split the first frame or merge the second
+    RtuTiming timing = ModbusRtuTransport::timingForBaud(9600);
+    timing.inter_frame = 100ms;
+
+    std::thread writer([&] {
+        const uint8_t first[] = {1, 2, 3, 4};
+        const uint8_t second[] = {5, 6, 7, 8};
+        ::write(fds[1], first, sizeof(first));
+        std::this_thread::sleep_for(1ms);    // Inside t3.5: same frame
+        ::write(fds[1], second, sizeof(second));
+        std::this_thread::sleep_for(300ms);  // Beyond t3.5: next frame
+        ::write(fds[1], first, sizeof(first));
+    });
+
+    auto frame = ModbusRtuTransport::receiveFrame(fds[0], timing, 1000000us, nullptr);
+    EXPECT_EQ(frame, (std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8}));
+    frame = ModbusRtuTransport::receiveFrame(fds[0], timing, 1000000us, nullptr);
+    EXPECT_EQ(frame, (std::vector<uint8_t>{1, 2, 3, 4}));
+    EXPECT_TRUE(ModbusRtuTransport::receiveFrame(fds[0], timing, 10000us, nullptr).empty());
+
+    writer.join();
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+// ============================================================================
+// TRANSPORT TESTS (pty pair with the in-process RTU slave emulator)
+// ============================================================================
+
+class ModbusRtuTransportTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        simulator_ = std::make_shared<InverterSimulator>();
+        slave_ = std::make_unique<ModbusRtuSimSlave>(simulator_, kBaudRate);
+        slave_->start();
+    }
+
+    void TearDown() override {
+        slave_->stop();
+    }
+
+    std::unique_ptr<ModbusRtuTransport> makeTransport(Duration timeout = Duration(500)) {
+        return std::make_unique<ModbusRtuTransport>(slave_->devicePath(), kBaudRate,
+                                                    SerialParity::NONE, timeout);
+    }
+
+    static constexpr uint32_t kBaudRate = 115200;
+
+    ConfigManager config_;
+    std::shared_ptr<InverterSimulator> simulator_;
+    std::unique_ptr<ModbusRtuSimSlave> slave_;
+};
+
+TEST_F(ModbusRtuTransportTest, Transact_ReturnsBinaryResponseFrame) {
+    auto transport = makeTransport();
+
+    auto response = transport->transact(ModbusFrame::createReadFrameBytes(17, 8, 1),
+                                        TransportOperation::READ);
+    ModbusResponse parsed = ModbusFrame::parseResponse(response);
+
+    ASSERT_FALSE(parsed.is_error);
+    EXPECT_EQ(parsed.data, (std::vector<uint8_t>{0x00, 100}));
+}
+
+TEST_F(ModbusRtuTransportTest, ReadAndWrite_ThroughProtocolAdapter) {
+    ModbusConfig modbus_config;
+    modbus_config.slave_address = 17;
+    modbus_config.max_retries = 2;
+    modbus_config.retry_delay = Duration(10);
+    config_.updateModbusConfig(modbus_config);
+    ProtocolAdapter adapter(config_, makeTransport());
+
+    auto values = adapter.readRegisters(0, 10);
+    ASSERT_EQ(values.size(), 10u);
+    EXPECT_EQ(values[8], 100);
+
+    EXPECT_TRUE(adapter.writeRegister(8, 42));
+    EXPECT_EQ(simulator_->readRegister(8), 42);
+    EXPECT_TRUE(adapter.writeRegisters(8, {55}));
+    EXPECT_EQ(adapter.readWriteRegisters(8, 1, 8, {60}), std::vector<RegisterValue>{60});
+
+    EXPECT_THROW(adapter.writeRegister(0, 1), ModbusException); // Exception response, not retried
+    EXPECT_EQ(adapter.getStatistics().retry_attempts, 0u);
+}
+
+TEST_F(ModbusRtuTransportTest, BackToBackTransactions_KeepInterFrameGap) {
+    auto transport = makeTransport();
+    auto request = ModbusFrame::createReadFrameBytes(17, 0, 10);
+
+    constexpr int kTransactions = 50;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kTransactions; ++i) {
+        ASSERT_FALSE(ModbusFrame::parseResponse(transport->transact(request, TransportOperation::READ)).is_error);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // Each request is written at least t3.5 after the previous response was
+    // received, so the requests are spread over at least that many gaps.
+    // A lower bound only: scheduling delays on a loaded runner cannot fail it
+    EXPECT_GE(elapsed, (kTransactions - 1) * transport->timing().inter_frame);
+}
+
+TEST_F(ModbusRtuTransportTest, DroppedRequest_TimesOutThenRecovers) {
+    auto transport = makeTransport(Duration(100));
+
+    SimFaultProfile faults;
+    faults.drop_rate = 1.0;
+    simulator_->setFaultProfile(faults);
+    EXPECT_THROW(transport->transact(ModbusFrame::createReadFrameBytes(17, 0, 1), TransportOperation::READ),
+                 TimeoutException);
+
+    simulator_->setFaultProfile(SimFaultProfile{});
+    auto response = transport->transact(ModbusFrame::createReadFrameBytes(17, 0, 1), TransportOperation::READ);
+    EXPECT_FALSE(ModbusFrame::parseResponse(response).is_error);
+}
+
+TEST_F(ModbusRtuTransportTest, MissingDevice_ThrowsTransportException) {
+    ModbusRtuTransport transport("/dev/does-not-exist", kBaudRate);
+    EXPECT_THROW(transport.transact(ModbusFrame::createReadFrameBytes(17, 0, 1), TransportOperation::READ),
+                 TransportException);
+}
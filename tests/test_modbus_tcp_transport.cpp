@@ -0,0 +1,206 @@
+/**
+ * @file test_modbus_tcp_transport.cpp
+ * @brief Tests for the native Modbus TCP transport
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/modbus_tcp_transport.hpp"
+#include "../cpp/include/modbus_tcp_sim_server.hpp"
+#include "../cpp/include/protocol_adapter.hpp"
+#include "../cpp/include/config_manager.hpp"
+#include "../cpp/include/modbus_frame.hpp"
+#include "../cpp/include/exceptions.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace ecoWatt;
+using namespace std::chrono_literals;
+
+namespace {
+
+SimLatencyProfile fixedLatency(std::chrono::microseconds latency) {
+    SimLatencyProfile profile;
+    profile.distribution = LatencyDistribution::FIXED;
+    profile.mean = latency;
+    return profile;
+}
+
+} // namespace
+
+// ============================================================================
+// MBAP FRAMING TESTS
+// ============================================================================
+
+TEST(ModbusTcpFramingTest, EncodeAdu_ReplacesCrcWithMbapHeader) {
+    auto request = ModbusFrame::createReadFrameBytes(17, 0, 2);
+    auto adu = ModbusTcpTransport::encodeAdu(0x1234, request);
+
+    EXPECT_EQ(adu, (std::vector<uint8_t>{0x12, 0x34, 0x00, 0x00, 0x00, 0x06,
+                                         0x11, 0x03, 0x00, 0x00, 0x00, 0x02}));
+}
+
+TEST(ModbusTcpFramingTest, ToRtuFrame_RoundTripsThroughAdu) {
+    auto request = ModbusFrame::createWriteFrameBytes(17, 8, 75);
+    auto adu = ModbusTcpTransport::encodeAdu(1, request);
+
+    auto rebuilt = ModbusTcpTransport::toRtuFrame(adu[6], adu.data() + 7, adu.size() - 7);
+    EXPECT_EQ(rebuilt, request);
+    EXPECT_TRUE(ModbusFrame::validateFrame(rebuilt));
+}
+
+// ============================================================================
+// TRANSPORT TESTS (in-process Modbus TCP Inverter SIM)
+// ============================================================================
+
+class ModbusTcpTransportTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        simulator_ = std::make_shared<InverterSimulator>();
+        server_ = std::make_unique<ModbusTcpSimServer>(simulator_);
+        server_->start();
+    }
+
+    void TearDown() override {
+        server_->stop();
+    }
+
+    std::unique_ptr<ModbusTcpTransport> makeTransport(Duration timeout = Duration(2000),
+                                                      size_t max_in_flight = 8) {
+        return std::make_unique<ModbusTcpTransport>("127.0.0.1", server_->port(), timeout, max_in_flight);
+    }
+
+    std::unique_ptr<ProtocolAdapter> makeAdapter(size_t max_in_flight = 8) {
+        ModbusConfig modbus_config;
+        modbus_config.slave_address = 17;
+        modbus_config.timeout = Duration(2000);
+        modbus_config.max_retries = 2;
+        modbus_config.retry_delay = Duration(10);
+        config_.updateModbusConfig(modbus_config);
+
+        return std::make_unique<ProtocolAdapter>(config_, makeTransport(modbus_config.timeout, max_in_flight));
+    }
+
+    ConfigManager config_;
+    std::shared_ptr<InverterSimulator> simulator_;
+    std::unique_ptr<ModbusTcpSimServer> server_;
+};
+
+TEST_F(ModbusTcpTransportTest, Transact_ReturnsValidRtuFrame) {
+    auto transport = makeTransport();
+
+    auto response = transport->transact(ModbusFrame::createReadFrameBytes(17, 8, 1),
+                                        TransportOperation::READ);
+    ModbusResponse parsed = ModbusFrame::parseResponse(response);
+
+    ASSERT_FALSE(parsed.is_error);
+    EXPECT_EQ(parsed.slave_address, 17);
+    EXPECT_EQ(parsed.data, (std::vector<uint8_t>{0x00, 100}));
+    EXPECT_TRUE(transport->isConnected());
+    EXPECT_EQ(transport->getConnectCount(), 1u);
+}
+
+TEST_F(ModbusTcpTransportTest, ReadAndWrite_ThroughProtocolAdapter) {
+    auto adapter = makeAdapter();
+
+    auto values = adapter->readRegisters(0, 10);
+    ASSERT_EQ(values.size(), 10u);
+    EXPECT_EQ(values[8], 100);
+
+    EXPECT_TRUE(adapter->writeRegister(8, 42));
+    EXPECT_EQ(simulator_->readRegister(8), 42);
+
+    EXPECT_TRUE(adapter->writeRegisters(8, {55}));
+    EXPECT_EQ(adapter->readWriteRegisters(8, 1, 8, {60}), std::vector<RegisterValue>{60});
+
+    EXPECT_THROW(adapter->writeRegister(0, 1), ModbusException); // Read-only register
+    EXPECT_EQ(adapter->getStatistics().retry_attempts, 0u);
+}
+
+TEST_F(ModbusTcpTransportTest, ConcurrentRequests_ArePipelined) {
+    simulator_->setLatencyProfile(fixedLatency(100ms));
+    auto adapter = makeAdapter(8);
+
+    constexpr int kRequests = 8;
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRequests; ++i) {
+        // Distinct ranges so the read coalescer does not merge them
+        threads.emplace_back([&, i] { adapter->readRegisters(static_cast<RegisterAddress>(i), 1); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // Serial transactions would take kRequests x 100ms
+    EXPECT_LT(elapsed, 400ms);
+    EXPECT_EQ(simulator_->getStatistics().requests, static_cast<uint64_t>(kRequests));
+    EXPECT_EQ(adapter->getStatistics().successful_requests, static_cast<uint64_t>(kRequests));
+}
+
+TEST_F(ModbusTcpTransportTest, InFlightLimit_BoundsPipelineDepth) {
+    simulator_->setLatencyProfile(fixedLatency(100ms));
+    auto adapter = makeAdapter(1);
+
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 3; ++i) {
+        threads.emplace_back([&, i] { adapter->readRegisters(static_cast<RegisterAddress>(i), 1); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 290ms);
+}
+
+TEST_F(ModbusTcpTransportTest, DroppedRequest_TimesOutWithoutBreakingConnection) {
+    auto transport = makeTransport(Duration(150));
+
+    SimFaultProfile faults;
+    faults.drop_rate = 1.0;
+    simulator_->setFaultProfile(faults);
+    EXPECT_THROW(transport->transact(ModbusFrame::createReadFrameBytes(17, 0, 1), TransportOperation::READ),
+                 TimeoutException);
+
+    simulator_->setFaultProfile(SimFaultProfile{});
+    auto response = transport->transact(ModbusFrame::createReadFrameBytes(17, 0, 1), TransportOperation::READ);
+    EXPECT_FALSE(ModbusFrame::parseResponse(response).is_error);
+    EXPECT_EQ(transport->getConnectCount(), 1u);
+}
+
+TEST_F(ModbusTcpTransportTest, ServerRestart_FailsOutstandingThenReconnects) {
+    auto transport = makeTransport();
+    transport->transact(ModbusFrame::createReadFrameBytes(17, 0, 1), TransportOperation::READ);
+
+    uint16_t port = server_->port();
+    server_->stop();
+    for (int i = 0; i < 500 && transport->isConnected(); ++i) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_FALSE(transport->isConnected());
+    EXPECT_THROW(transport->transact(ModbusFrame::createReadFrameBytes(17, 0, 1), TransportOperation::READ),
+                 TransportException);
+
+    server_ = std::make_unique<ModbusTcpSimServer>(simulator_, port);
+    server_->start();
+
+    auto response = transport->transact(ModbusFrame::createReadFrameBytes(17, 0, 1), TransportOperation::READ);
+    EXPECT_FALSE(ModbusFrame::parseResponse(response).is_error);
+    EXPECT_EQ(transport->getConnectCount(), 2u);
+}
+
+TEST_F(ModbusTcpTransportTest, CreateTransport_HonoursConfiguredBackend) {
+    ModbusConfig modbus_config;
+    modbus_config.transport = TransportType::MODBUS_TCP;
+    modbus_config.tcp_port = server_->port();
+    modbus_config.tcp_max_in_flight = 3;
+    config_.updateModbusConfig(modbus_config);
+
+    auto transport = createTransport(config_);
+    EXPECT_EQ(transport->maxInFlight(), 3u);
+    EXPECT_EQ(transport->describe(), "modbus-tcp://127.0.0.1:" + std::to_string(server_->port()));
+}
@@ -10,6 +10,8 @@
 #include "../cpp/include/protocol_adapter.hpp"
 #include "../cpp/include/config_manager.hpp"
 #include "../cpp/include/exceptions.hpp"
+#include "../cpp/include/modbus_frame.hpp"
+#include <fmt/format.h>
 #include <vector>
 #include <string>
 #include <chrono>
@@ -30,7 +32,7 @@ public:
     };
     
     MOCK_METHOD(HttpResponse, post, (const std::string& endpoint, const std::string& data), ());
-    MOCK_METHOD(void, setDefaultHeaders, (const std::map<std::string, std::string>& headers), ());
+    MOCK_METHOD(void, setDefaultHeaders, ((const std::map<std::string, std::string>&) headers), ());
     MOCK_METHOD(void, setTimeout, (uint32_t timeout_ms), ());
 };
 
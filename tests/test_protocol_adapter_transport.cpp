@@ -0,0 +1,350 @@
+/**
+ * @file test_protocol_adapter_transport.cpp
+ * @brief ProtocolAdapter tests over scripted in-process transports (no network)
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "../cpp/include/protocol_adapter.hpp"
+#include "../cpp/include/config_manager.hpp"
+#include "../cpp/include/exceptions.hpp"
+#include "../cpp/include/modbus_frame.hpp"
+#include "../cpp/include/transport.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace ecoWatt;
+using namespace testing;
+
+// ============================================================================
+// BATCH READ TESTS (scripted transport)
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief Transport that answers FC03 frames from a fixed register image
+ *
+ * Register 5 answers with an Illegal Data Address exception and register 6
+ * never answers, so per-frame error mapping can be checked.
+ */
+class ScriptedBatchTransport : public Transport {
+public:
+    explicit ScriptedBatchTransport(bool batch) : batch_(batch) {}
+
+    std::vector<uint8_t> transact(const std::vector<uint8_t>& request, TransportOperation) override {
+        ++single_calls;
+        return answer(request);
+    }
+
+    std::vector<std::vector<uint8_t>> transactBatch(const std::vector<std::vector<uint8_t>>& requests,
+                                                    TransportOperation) override {
+        ++batch_calls;
+        std::vector<std::vector<uint8_t>> responses;
+        for (const auto& request : requests) {
+            responses.push_back(answer(request));
+        }
+        return responses;
+    }
+
+    bool supportsBatch() const override { return batch_; }
+    size_t maxBatchSize() const override { return 4; }
+    std::string describe() const override { return "scripted"; }
+
+    int single_calls = 0;
+    int batch_calls = 0;
+
+private:
+    std::vector<uint8_t> answer(const std::vector<uint8_t>& request) {
+        uint16_t start = (request[2] << 8) | request[3];
+        uint16_t count = (request[4] << 8) | request[5];
+        if (start == 6) {
+            return {};
+        }
+
+        std::vector<uint8_t> response = {request[0], 0x03, static_cast<uint8_t>(count * 2)};
+        if (start == 5) {
+            response = {request[0], 0x83, 0x02};
+        } else {
+            for (uint16_t i = 0; i < count; ++i) {
+                response.push_back(0x00);
+                response.push_back(static_cast<uint8_t>(100 + start + i));
+            }
+        }
+
+        uint16_t crc = ModbusFrame::calculateCRC(response);
+        response.push_back(crc & 0xFF);
+        response.push_back(crc >> 8);
+        return response;
+    }
+
+    bool batch_;
+};
+
+std::unique_ptr<ProtocolAdapter> makeScriptedAdapter(ScriptedBatchTransport*& transport, bool batch) {
+    ConfigManager config;
+    ModbusConfig modbus_config;
+    modbus_config.slave_address = 0x11;
+    modbus_config.max_retries = 1;
+    config.updateModbusConfig(modbus_config);
+
+    auto owned = std::make_unique<ScriptedBatchTransport>(batch);
+    transport = owned.get();
+    return std::make_unique<ProtocolAdapter>(config, std::move(owned));
+}
+
+} // namespace
+
+TEST(ProtocolAdapterBatchTest, BatchTransport_OneRoundTripPerChunk) {
+    ScriptedBatchTransport* transport = nullptr;
+    auto adapter = makeScriptedAdapter(transport, true);
+
+    std::vector<std::pair<RegisterAddress, uint16_t>> blocks = {{0, 2}, {2, 1}, {3, 1}, {4, 1}, {7, 2}};
+    auto results = adapter->readRegisterBlocks(blocks);
+
+    ASSERT_EQ(results.size(), blocks.size());
+    for (const auto& result : results) {
+        EXPECT_TRUE(result.ok()) << result.error;
+    }
+    EXPECT_EQ(results[0].values, (std::vector<RegisterValue>{100, 101}));
+    EXPECT_EQ(results[4].values, (std::vector<RegisterValue>{107, 108}));
+
+    // Five frames with at most four per batch
+    EXPECT_EQ(transport->batch_calls, 2);
+    EXPECT_EQ(transport->single_calls, 0);
+
+    auto stats = adapter->getStatistics();
+    EXPECT_EQ(stats.batch_round_trips, 2u);
+    EXPECT_EQ(stats.batched_frames, 5u);
+    EXPECT_EQ(stats.successful_requests, 5u);
+}
+
+TEST(ProtocolAdapterBatchTest, BatchTransport_ErrorsMapToTheirOwnBlock) {
+    ScriptedBatchTransport* transport = nullptr;
+    auto adapter = makeScriptedAdapter(transport, true);
+
+    auto results = adapter->readRegisterBlocks({{4, 1}, {5, 1}, {6, 1}, {0, 0}});
+
+    EXPECT_TRUE(results[0].ok());
+    EXPECT_THAT(results[1].error, HasSubstr("Illegal Data Address"));
+    EXPECT_THAT(results[2].error, HasSubstr("Empty"));
+    EXPECT_THAT(results[3].error, HasSubstr("Invalid number of registers"));
+    EXPECT_EQ(transport->batch_calls, 1);
+    EXPECT_EQ(adapter->getStatistics().failed_requests, 2u);
+}
+
+TEST(ProtocolAdapterBatchTest, NonBatchTransport_FallsBackToSingleReads) {
+    ScriptedBatchTransport* transport = nullptr;
+    auto adapter = makeScriptedAdapter(transport, false);
+
+    auto results = adapter->readRegisterBlocks({{0, 1}, {1, 1}, {5, 1}});
+
+    EXPECT_TRUE(results[0].ok());
+    EXPECT_TRUE(results[1].ok());
+    EXPECT_FALSE(results[2].ok());
+    EXPECT_EQ(transport->single_calls, 3);
+    EXPECT_EQ(transport->batch_calls, 0);
+}
+
+// ============================================================================
+// BATCH READ COALESCING (gated transport)
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief Batch transport whose batches block until released
+ *
+ * Single transactions (writes) are echoed straight away, so a write can
+ * complete while a batched read is still in flight.
+ */
+class GatedBatchTransport : public Transport {
+public:
+    std::vector<uint8_t> transact(const std::vector<uint8_t>& request, TransportOperation) override {
+        std::vector<uint8_t> response(request.begin(), request.end() - 2);
+        uint16_t crc = ModbusFrame::calculateCRC(response);
+        response.push_back(crc & 0xFF);
+        response.push_back(crc >> 8);
+        return response;
+    }
+
+    std::vector<std::vector<uint8_t>> transactBatch(const std::vector<std::vector<uint8_t>>& requests,
+                                                    TransportOperation) override {
+        batch_calls.fetch_add(1);
+        frames_sent.fetch_add(static_cast<int>(requests.size()));
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return open_; });
+
+        std::vector<std::vector<uint8_t>> responses;
+        for (const auto& request : requests) {
+            uint16_t start = (request[2] << 8) | request[3];
+            uint16_t count = (request[4] << 8) | request[5];
+            std::vector<uint8_t> response = {request[0], 0x03, static_cast<uint8_t>(count * 2)};
+            for (uint16_t i = 0; i < count; ++i) {
+                response.push_back(0x00);
+                response.push_back(static_cast<uint8_t>(100 + start + i));
+            }
+            uint16_t crc = ModbusFrame::calculateCRC(response);
+            response.push_back(crc & 0xFF);
+            response.push_back(crc >> 8);
+            responses.push_back(response);
+        }
+        return responses;
+    }
+
+    bool supportsBatch() const override { return true; }
+    size_t maxBatchSize() const override { return 4; }
+    size_t maxInFlight() const override { return 4; }
+    std::string describe() const override { return "gated"; }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            open_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    std::atomic<int> batch_calls{0};
+    std::atomic<int> frames_sent{0};
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool open_ = false;
+};
+
+std::unique_ptr<ProtocolAdapter> makeGatedAdapter(GatedBatchTransport*& transport) {
+    ConfigManager config;
+    ModbusConfig modbus_config;
+    modbus_config.slave_address = 0x11;
+    modbus_config.max_retries = 1;
+    config.updateModbusConfig(modbus_config);
+
+    auto owned = std::make_unique<GatedBatchTransport>();
+    transport = owned.get();
+    return std::make_unique<ProtocolAdapter>(config, std::move(owned));
+}
+
+template <typename Predicate>
+void waitFor(Predicate done) {
+    for (int i = 0; i < 500 && !done(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+} // namespace
+
+TEST(ProtocolAdapterBatchTest, ConcurrentBatches_ShareInFlightBlocks) {
+    GatedBatchTransport* transport = nullptr;
+    auto adapter = makeGatedAdapter(transport);
+
+    std::vector<ProtocolAdapter::BlockRead> first, second;
+    std::thread poll([&] { first = adapter->readRegisterBlocks({{0, 2}, {2, 1}}); });
+    waitFor([&] { return transport->batch_calls.load() == 1; });
+
+    // Two blocks ride on the poll's batch; only {3, 1} goes out again
+    std::thread dashboard([&] { second = adapter->readRegisterBlocks({{0, 2}, {2, 1}, {3, 1}}); });
+    waitFor([&] { return transport->batch_calls.load() == 2; });
+
+    transport->release();
+    poll.join();
+    dashboard.join();
+
+    EXPECT_EQ(transport->frames_sent.load(), 3);
+    ASSERT_EQ(second.size(), 3u);
+    for (const auto& result : second) {
+        EXPECT_TRUE(result.ok()) << result.error;
+    }
+    EXPECT_EQ(second[0].values, first[0].values);
+    EXPECT_EQ(second[0].values, (std::vector<RegisterValue>{100, 101}));
+    EXPECT_EQ(second[2].values, (std::vector<RegisterValue>{103}));
+    EXPECT_EQ(adapter->getStatistics().coalesced_reads, 2u);
+}
+
+TEST(ProtocolAdapterBatchTest, WriteDuringBatch_RetiresOverlappingBlocks) {
+    GatedBatchTransport* transport = nullptr;
+    auto adapter = makeGatedAdapter(transport);
+
+    std::vector<ProtocolAdapter::BlockRead> first, second;
+    std::thread poll([&] { first = adapter->readRegisterBlocks({{0, 2}, {2, 1}}); });
+    waitFor([&] { return transport->batch_calls.load() == 1; });
+
+    // Register 1 changes after the poll's batch was sent
+    EXPECT_TRUE(adapter->writeRegister(1, 55));
+
+    std::thread dashboard([&] { second = adapter->readRegisterBlocks({{0, 2}, {2, 1}}); });
+    waitFor([&] { return transport->batch_calls.load() == 2; });
+
+    transport->release();
+    poll.join();
+    dashboard.join();
+
+    // {0, 2} is read again; {2, 1} does not overlap the write and is shared
+    EXPECT_EQ(transport->frames_sent.load(), 3);
+    EXPECT_TRUE(second[0].ok()) << second[0].error;
+    EXPECT_TRUE(second[1].ok()) << second[1].error;
+    EXPECT_EQ(adapter->getStatistics().coalesced_reads, 1u);
+}
+
+// ============================================================================
+// WRITE RESPONSE VALIDATION (FC16 / FC23)
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief Answers every request with a CRC-valid FC03 reply carrying @p registers zero registers
+ */
+class WrongFunctionTransport : public Transport {
+public:
+    explicit WrongFunctionTransport(uint8_t registers = 0) : registers_(registers) {}
+
+    std::vector<uint8_t> transact(const std::vector<uint8_t>& request, TransportOperation) override {
+        std::vector<uint8_t> response = {request[0], 0x03, static_cast<uint8_t>(registers_ * 2)};
+        response.insert(response.end(), registers_ * 2u, 0x00);
+        uint16_t crc = ModbusFrame::calculateCRC(response);
+        response.push_back(crc & 0xFF);
+        response.push_back(crc >> 8);
+        return response;
+    }
+
+    std::string describe() const override { return "wrong-function"; }
+
+private:
+    uint8_t registers_;
+};
+
+} // namespace
+
+TEST(ProtocolAdapterWriteTest, WriteRegisters_WrongFunctionReply_ThrowsModbusException) {
+    ConfigManager config;
+    ModbusConfig modbus_config;
+    modbus_config.slave_address = 0x11;
+    modbus_config.max_retries = 1;
+    config.updateModbusConfig(modbus_config);
+    ProtocolAdapter adapter(config, std::make_unique<WrongFunctionTransport>());
+
+    EXPECT_THROW(adapter.writeRegisters(8, {30, 31}), ModbusException);
+    EXPECT_EQ(adapter.getStatistics().failed_requests, 1u);
+}
+
+TEST(ProtocolAdapterWriteTest, ReadWriteRegisters_WrongFunctionReply_ThrowsModbusException) {
+    ConfigManager config;
+    ModbusConfig modbus_config;
+    modbus_config.slave_address = 0x11;
+    modbus_config.max_retries = 1;
+    config.updateModbusConfig(modbus_config);
+    // FC03 reply with exactly the byte count the FC23 read expects
+    ProtocolAdapter adapter(config, std::make_unique<WrongFunctionTransport>(2));
+
+    EXPECT_THROW(adapter.readWriteRegisters(0, 2, 8, {30}), ModbusException);
+    EXPECT_EQ(adapter.getStatistics().failed_requests, 1u);
+}
@@ -0,0 +1,232 @@
+/**
+ * @file test_query_api_server.cpp
+ * @brief Tests for the read-only REST query API
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/query_api_server.hpp"
+#include "../cpp/include/data_storage.hpp"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+using namespace ecoWatt;
+
+namespace {
+
+constexpr const char* kDbPath = "test_query_api.db";
+
+void removeDatabase() {
+    for (const char* suffix : {"", "-wal", "-shm"}) {
+        std::filesystem::remove(std::string(kDbPath) + suffix);
+    }
+}
+
+RegisterConfig registerConfig(RegisterAddress address, const std::string& name, const std::string& unit, double gain) {
+    RegisterConfig config;
+    config.address = address;
+    config.name = name;
+    config.unit = unit;
+    config.gain = gain;
+    config.access = AccessType::READ_ONLY;
+    return config;
+}
+
+AcquisitionSample sample(RegisterAddress address, RegisterValue raw, int64_t timestamp_ms) {
+    const std::string name = address == 0 ? "Voltage" : "Current";
+    return AcquisitionSample(TimePoint(Duration(timestamp_ms)), address, name, raw, raw / 10.0,
+                             address == 0 ? "V" : "A");
+}
+
+nlohmann::json parse(const QueryApiServer::Response& response) {
+    return nlohmann::json::parse(*response.body);
+}
+
+} // namespace
+
+class QueryApiServerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        removeDatabase();
+        StorageConfig storage_config;
+        storage_config.database_path = kDbPath;
+        storage_ = std::make_shared<HybridDataStorage>(storage_config);
+
+        config_.max_history_points = 100;
+        // Storage filters are not configured, so rows land as given (already "filtered")
+        RegisterConfig compressed = registerConfig(2, "Frequency", "Hz", 10.0);
+        compressed.deadband = 1.0;
+        compressed.compression = CompressionMode::SWINGING_DOOR;
+        RegisterConfig deadband = registerConfig(7, "Temperature", "C", 10.0);
+        deadband.deadband = 0.5;
+        deadband.max_interval = Duration(2000);
+
+        server_ = std::make_unique<QueryApiServer>(config_, storage_, std::map<RegisterAddress, RegisterConfig>{
+            {0, registerConfig(0, "Voltage", "V", 10.0)},
+            {1, registerConfig(1, "Current", "A", 10.0)},
+            {2, compressed},
+            {7, deadband}});
+    }
+
+    void TearDown() override {
+        server_.reset();
+        storage_.reset();
+        removeDatabase();
+    }
+
+    QueryApiConfig config_;
+    std::shared_ptr<HybridDataStorage> storage_;
+    std::unique_ptr<QueryApiServer> server_;
+};
+
+TEST_F(QueryApiServerTest, Latest_ServesSamplesFromCallback) {
+    auto empty = server_->handle("/api/v1/latest", {});
+    EXPECT_EQ(empty.status, 200);
+    EXPECT_TRUE(parse(empty)["readings"].empty());
+
+    server_->onSample(sample(0, 2301, 1000));
+    server_->onSample(sample(1, 45, 1000));
+
+    auto response = server_->handle("/api/v1/latest", {});
+    auto body = parse(response);
+    EXPECT_EQ(body["generation"], 2);
+    ASSERT_EQ(body["readings"].size(), 2u);
+    EXPECT_EQ(body["readings"][0]["name"], "Voltage");
+    EXPECT_DOUBLE_EQ(body["readings"][0]["value"].get<double>(), 230.1);
+    EXPECT_EQ(body["readings"][0]["timestamp_ms"], 1000);
+}
+
+TEST_F(QueryApiServerTest, Latest_ETagAndSharedBody) {
+    server_->onSample(sample(0, 2301, 1000));
+
+    auto first = server_->handle("/api/v1/latest", {});
+    ASSERT_FALSE(first.etag.empty());
+
+    // Same generation: same serialized buffer, 304 for a matching If-None-Match
+    auto second = server_->handle("/api/v1/latest", {});
+    EXPECT_EQ(second.body, first.body);
+    EXPECT_EQ(server_->getStatistics().latest_cache_hits, 1u);
+
+    auto not_modified = server_->handle("/api/v1/latest", {}, "W/\"other\", " + first.etag);
+    EXPECT_EQ(not_modified.status, 304);
+    EXPECT_FALSE(not_modified.body);
+
+    server_->onSample(sample(0, 2302, 2000));
+    auto changed = server_->handle("/api/v1/latest", {}, first.etag);
+    EXPECT_EQ(changed.status, 200);
+    EXPECT_NE(changed.etag, first.etag);
+    EXPECT_EQ(server_->getStatistics().not_modified, 1u);
+}
+
+TEST_F(QueryApiServerTest, LatestOne_VersionIsPerRegister) {
+    server_->onSample(sample(0, 2301, 1000));
+    auto voltage = server_->handle("/api/v1/latest/0", {});
+    EXPECT_EQ(voltage.status, 200);
+    EXPECT_EQ(parse(voltage)["version"], 1);
+
+    // Another register's sample leaves register 0's ETag valid
+    server_->onSample(sample(1, 45, 2000));
+    EXPECT_EQ(server_->handle("/api/v1/latest/0", {}, voltage.etag).status, 304);
+
+    server_->onSample(sample(0, 2302, 3000));
+    EXPECT_EQ(server_->handle("/api/v1/latest/0", {}, voltage.etag).status, 200);
+
+    EXPECT_EQ(server_->handle("/api/v1/latest/7", {}).status, 404);
+    EXPECT_EQ(server_->handle("/api/v1/latest/x1", {}).status, 400);
+    EXPECT_EQ(server_->handle("/api/v1/unknown", {}).status, 404);
+}
+
+TEST_F(QueryApiServerTest, History_AveragesPerResolutionBucket) {
+    storage_->storeSample(sample(0, 2300, 10000));
+    storage_->storeSample(sample(0, 2310, 10500));
+    storage_->storeSample(sample(0, 2400, 11200));
+    storage_->storeSample(sample(1, 45, 10000));
+
+    auto response = server_->handle("/api/v1/history",
+                                    {{"register", "0"}, {"from", "10000"}, {"to", "11999"}, {"resolution", "1000"}});
+    ASSERT_EQ(response.status, 200);
+    auto body = parse(response);
+    EXPECT_EQ(body["unit"], "V");
+    EXPECT_EQ(body["resolution_ms"], 1000);
+    EXPECT_EQ(body["filtered"], false);
+    ASSERT_EQ(body["points"].size(), 2u);
+    EXPECT_EQ(body["points"][0]["t"], 10000);
+    EXPECT_EQ(body["points"][0]["count"], 2);
+    EXPECT_DOUBLE_EQ(body["points"][0]["mean"].get<double>(), 230.5);
+    EXPECT_DOUBLE_EQ(body["points"][0]["min"].get<double>(), 230.0);
+    EXPECT_DOUBLE_EQ(body["points"][0]["max"].get<double>(), 231.0);
+    EXPECT_DOUBLE_EQ(body["points"][1]["mean"].get<double>(), 240.0);
+}
+
+TEST_F(QueryApiServerTest, History_DeadbandRegister_HeldAndTimeWeighted) {
+    storage_->storeSample(sample(7, 100, 5000));   // Before the range: seeds it
+    storage_->storeSample(sample(7, 200, 12500));
+
+    auto response = server_->handle("/api/v1/history",
+                                    {{"register", "7"}, {"from", "10000"}, {"to", "15999"}, {"resolution", "1000"}});
+    ASSERT_EQ(response.status, 200);
+    auto body = parse(response);
+    EXPECT_EQ(body["filtered"], true);
+    EXPECT_EQ(body["fill"], "hold");
+
+    // Held until the next row, the newest one for max_interval (2 s)
+    const auto& points = body["points"];
+    ASSERT_EQ(points.size(), 5u);
+    EXPECT_EQ(points[0]["t"], 10000);
+    EXPECT_EQ(points[0]["count"], 0);
+    EXPECT_DOUBLE_EQ(points[0]["mean"].get<double>(), 10.0);
+    EXPECT_DOUBLE_EQ(points[1]["mean"].get<double>(), 10.0);
+    EXPECT_EQ(points[2]["count"], 1);
+    EXPECT_DOUBLE_EQ(points[2]["mean"].get<double>(), 15.0);
+    EXPECT_DOUBLE_EQ(points[2]["min"].get<double>(), 10.0);
+    EXPECT_DOUBLE_EQ(points[2]["max"].get<double>(), 20.0);
+    EXPECT_EQ(points[4]["t"], 14000);
+    EXPECT_EQ(points[4]["count"], 0);
+    EXPECT_DOUBLE_EQ(points[4]["mean"].get<double>(), 20.0);
+}
+
+TEST_F(QueryApiServerTest, History_SwingingDoorRegister_Interpolated) {
+    storage_->storeSample(sample(2, 100, 9000));
+    storage_->storeSample(sample(2, 300, 11000));
+    storage_->storeSample(sample(2, 300, 13000));  // After the range: closes the last segment
+
+    auto response = server_->handle("/api/v1/history",
+                                    {{"register", "2"}, {"from", "10000"}, {"to", "12999"}, {"resolution", "1000"}});
+    ASSERT_EQ(response.status, 200);
+    auto body = parse(response);
+    EXPECT_EQ(body["fill"], "linear");
+
+    const auto& points = body["points"];
+    ASSERT_EQ(points.size(), 3u);
+    EXPECT_EQ(points[0]["count"], 0);
+    EXPECT_DOUBLE_EQ(points[0]["mean"].get<double>(), 25.0);
+    EXPECT_DOUBLE_EQ(points[0]["min"].get<double>(), 20.0);
+    EXPECT_DOUBLE_EQ(points[0]["max"].get<double>(), 30.0);
+    EXPECT_EQ(points[1]["count"], 1);
+    EXPECT_DOUBLE_EQ(points[1]["mean"].get<double>(), 30.0);
+    EXPECT_DOUBLE_EQ(points[2]["mean"].get<double>(), 30.0);
+}
+
+TEST_F(QueryApiServerTest, History_ResolutionCoarsenedToMaxPoints) {
+    auto response = server_->handle("/api/v1/history",
+                                    {{"register", "0"}, {"from", "0"}, {"to", "99999"}, {"resolution", "1"}});
+    ASSERT_EQ(response.status, 200);
+    EXPECT_EQ(parse(response)["resolution_ms"], 1000);
+
+    EXPECT_EQ(server_->handle("/api/v1/history", {}).status, 400);
+    EXPECT_EQ(server_->handle("/api/v1/history", {{"register", "abc"}}).status, 400);
+    EXPECT_EQ(server_->handle("/api/v1/history", {{"register", "0"}, {"from", "5"}, {"to", "1"}}).status, 400);
+    EXPECT_EQ(server_->handle("/api/v1/history", {{"register", "9"}}).status, 404);
+}
+
+TEST_F(QueryApiServerTest, Statistics_IncludesProviderAndServerCounters) {
+    server_->setStatisticsProvider([] { return nlohmann::json{{"running", true}}; });
+    server_->handle("/api/v1/latest", {});
+
+    auto body = parse(server_->handle("/api/v1/statistics", {}));
+    EXPECT_EQ(body["running"], true);
+    EXPECT_EQ(body["query_api"]["requests"], 2);
+}
@@ -0,0 +1,286 @@
+/**
+ * @file test_read_coalescer.cpp
+ * @brief Tests for single-flight coalescing of concurrent register reads
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/read_coalescer.hpp"
+#include "../cpp/include/exceptions.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+using namespace ecoWatt;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr TransactionLane kLane = TransactionLane::BACKGROUND;
+
+/**
+ * @brief Reader that blocks until released, so tests control the overlap
+ */
+class GatedReader {
+public:
+    std::vector<RegisterValue> operator()(RegisterAddress start, uint16_t count) {
+        calls_.fetch_add(1);
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return open_; });
+        if (fail_) {
+            throw ModbusException("simulated timeout");
+        }
+
+        std::vector<RegisterValue> values;
+        for (uint16_t i = 0; i < count; ++i) {
+            values.push_back(static_cast<RegisterValue>(1000 + start + i));
+        }
+        return values;
+    }
+
+    void release(bool fail = false) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            open_ = true;
+            fail_ = fail;
+        }
+        cv_.notify_all();
+    }
+
+    int calls() const { return calls_.load(); }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool open_ = false;
+    bool fail_ = false;
+    std::atomic<int> calls_{0};
+};
+
+void waitForFlights(const ReadCoalescer& coalescer, size_t count) {
+    for (int i = 0; i < 500 && coalescer.inFlight() < count; ++i) {
+        std::this_thread::sleep_for(1ms);
+    }
+}
+
+} // namespace
+
+TEST(ReadCoalescerTest, SequentialReads_NotCoalesced) {
+    ReadCoalescer coalescer;
+    int calls = 0;
+    auto reader = [&](RegisterAddress start, uint16_t count) {
+        ++calls;
+        return std::vector<RegisterValue>(count, start);
+    };
+
+    coalescer.read(17, 0, 2, kLane, reader);
+    coalescer.read(17, 0, 2, kLane, reader);
+
+    EXPECT_EQ(calls, 2);
+    EXPECT_EQ(coalescer.getStatistics().coalesced_reads, 0u);
+    EXPECT_EQ(coalescer.inFlight(), 0u);
+}
+
+TEST(ReadCoalescerTest, ConcurrentIdenticalReads_ShareOneTransaction) {
+    ReadCoalescer coalescer;
+    GatedReader gate;
+    auto reader = [&](RegisterAddress start, uint16_t count) { return gate(start, count); };
+
+    constexpr int kCallers = 8;
+    std::vector<std::vector<RegisterValue>> results(kCallers);
+    std::vector<std::thread> threads;
+
+    threads.emplace_back([&] { results[0] = coalescer.read(17, 0, 2, kLane, reader); });
+    waitForFlights(coalescer, 1);
+    for (int i = 1; i < kCallers; ++i) {
+        threads.emplace_back([&, i] { results[i] = coalescer.read(17, 0, 2, kLane, reader); });
+    }
+
+    // Let the followers attach before the leader returns
+    for (int i = 0; i < 500 && coalescer.getStatistics().coalesced_reads < kCallers - 1; ++i) {
+        std::this_thread::sleep_for(1ms);
+    }
+    gate.release();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(gate.calls(), 1);
+    for (const auto& values : results) {
+        EXPECT_EQ(values, (std::vector<RegisterValue>{1000, 1001}));
+    }
+
+    auto stats = coalescer.getStatistics();
+    EXPECT_EQ(stats.leader_reads, 1u);
+    EXPECT_EQ(stats.coalesced_reads, static_cast<uint64_t>(kCallers - 1));
+    EXPECT_EQ(stats.coalesced_registers, static_cast<uint64_t>(2 * (kCallers - 1)));
+    EXPECT_NEAR(stats.suppression_ratio(), 7.0 / 8.0, 1e-9);
+}
+
+TEST(ReadCoalescerTest, CoveredSubrange_ServedFromLeaderSlice) {
+    ReadCoalescer coalescer;
+    GatedReader gate;
+    auto reader = [&](RegisterAddress start, uint16_t count) { return gate(start, count); };
+
+    std::vector<RegisterValue> block;
+    std::vector<RegisterValue> single;
+    std::thread leader([&] { block = coalescer.read(17, 0, 10, kLane, reader); });
+    waitForFlights(coalescer, 1);
+
+    std::thread follower([&] { single = coalescer.read(17, 8, 1, kLane, reader); });
+    for (int i = 0; i < 500 && coalescer.getStatistics().coalesced_reads < 1; ++i) {
+        std::this_thread::sleep_for(1ms);
+    }
+    gate.release();
+    leader.join();
+    follower.join();
+
+    EXPECT_EQ(gate.calls(), 1);
+    EXPECT_EQ(block.size(), 10u);
+    EXPECT_EQ(single, std::vector<RegisterValue>{1008});
+}
+
+TEST(ReadCoalescerTest, Retire_ReadAfterWriteStartsFresh) {
+    ReadCoalescer coalescer;
+    GatedReader gate;
+    auto reader = [&](RegisterAddress start, uint16_t count) { return gate(start, count); };
+
+    // A block read issued before the write is still on the wire
+    std::vector<RegisterValue> block;
+    std::thread leader([&] { block = coalescer.read(17, 0, 10, kLane, reader); });
+    waitForFlights(coalescer, 1);
+
+    // A write elsewhere leaves it joinable; a write inside it does not
+    coalescer.retire(17, 20, 1);
+    coalescer.retire(18, 8, 1);
+    EXPECT_EQ(coalescer.inFlight(), 1u);
+    coalescer.retire(17, 9, 2);
+    EXPECT_EQ(coalescer.inFlight(), 0u);
+
+    int fresh_calls = 0;
+    auto after_write = coalescer.read(17, 8, 1, kLane, [&](RegisterAddress, uint16_t count) {
+        ++fresh_calls;
+        return std::vector<RegisterValue>(count, 42);
+    });
+    EXPECT_EQ(after_write, std::vector<RegisterValue>{42});
+    EXPECT_EQ(fresh_calls, 1);
+    EXPECT_EQ(coalescer.getStatistics().coalesced_reads, 0u);
+
+    gate.release();
+    leader.join();
+    EXPECT_EQ(block.size(), 10u);
+    EXPECT_EQ(coalescer.inFlight(), 0u);
+}
+
+TEST(ReadCoalescerTest, PartialOverlapOrOtherSlave_IssuedSeparately) {
+    ReadCoalescer coalescer;
+    GatedReader gate;
+    auto reader = [&](RegisterAddress start, uint16_t count) { return gate(start, count); };
+
+    std::vector<std::thread> threads;
+    threads.emplace_back([&] { coalescer.read(17, 0, 4, kLane, reader); });
+    waitForFlights(coalescer, 1);
+    threads.emplace_back([&] { coalescer.read(17, 2, 4, kLane, reader); });  // Extends past the leader
+    threads.emplace_back([&] { coalescer.read(18, 0, 4, kLane, reader); });  // Different slave
+    waitForFlights(coalescer, 3);
+
+    gate.release();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(gate.calls(), 3);
+    EXPECT_EQ(coalescer.getStatistics().coalesced_reads, 0u);
+}
+
+TEST(ReadCoalescerTest, HigherLaneRead_NotQueuedBehindBackgroundLeader) {
+    ReadCoalescer coalescer;
+    GatedReader background;
+    std::vector<RegisterValue> polled;
+
+    std::thread poll([&] {
+        polled = coalescer.read(17, 0, 2, TransactionLane::BACKGROUND,
+                                [&](RegisterAddress start, uint16_t count) { return background(start, count); });
+    });
+    waitForFlights(coalescer, 1);
+
+    // Returns while the background read is still blocked
+    int control_calls = 0;
+    auto urgent = coalescer.read(17, 0, 2, TransactionLane::CONTROL, [&](RegisterAddress, uint16_t count) {
+        ++control_calls;
+        return std::vector<RegisterValue>(count, 7);
+    });
+    EXPECT_EQ(urgent, (std::vector<RegisterValue>{7, 7}));
+    EXPECT_EQ(control_calls, 1);
+    EXPECT_EQ(coalescer.getStatistics().coalesced_reads, 0u);
+
+    background.release();
+    poll.join();
+    EXPECT_EQ(polled, (std::vector<RegisterValue>{1000, 1001}));
+    EXPECT_EQ(background.calls(), 1);
+}
+
+TEST(ReadCoalescerTest, BackgroundRead_JoinsHigherLaneLeader) {
+    ReadCoalescer coalescer;
+    GatedReader gate;
+    auto reader = [&](RegisterAddress start, uint16_t count) { return gate(start, count); };
+
+    std::vector<RegisterValue> interactive;
+    std::vector<RegisterValue> polled;
+    std::thread leader([&] { interactive = coalescer.read(17, 0, 2, TransactionLane::INTERACTIVE, reader); });
+    waitForFlights(coalescer, 1);
+    std::thread follower([&] { polled = coalescer.read(17, 0, 2, TransactionLane::BACKGROUND, reader); });
+
+    for (int i = 0; i < 500 && coalescer.getStatistics().coalesced_reads < 1; ++i) {
+        std::this_thread::sleep_for(1ms);
+    }
+    gate.release();
+    leader.join();
+    follower.join();
+
+    EXPECT_EQ(gate.calls(), 1);
+    EXPECT_EQ(polled, interactive);
+}
+
+TEST(ReadCoalescerTest, LeaderFailure_PropagatesToFollowers) {
+    ReadCoalescer coalescer;
+    GatedReader gate;
+    auto reader = [&](RegisterAddress start, uint16_t count) { return gate(start, count); };
+
+    std::atomic<int> failures{0};
+    auto call = [&] {
+        try {
+            coalescer.read(17, 0, 2, kLane, reader);
+        } catch (const ModbusException&) {
+            failures.fetch_add(1);
+        }
+    };
+
+    std::thread leader(call);
+    waitForFlights(coalescer, 1);
+    std::thread follower(call);
+    for (int i = 0; i < 500 && coalescer.getStatistics().coalesced_reads < 1; ++i) {
+        std::this_thread::sleep_for(1ms);
+    }
+    gate.release(true);
+    leader.join();
+    follower.join();
+
+    EXPECT_EQ(gate.calls(), 1);
+    EXPECT_EQ(failures.load(), 2);
+    EXPECT_EQ(coalescer.inFlight(), 0u);
+}
+
+TEST(ReadCoalescerTest, ResetStatistics_ClearsCounters) {
+    ReadCoalescer coalescer;
+    coalescer.read(17, 0, 1, kLane, [](RegisterAddress, uint16_t count) {
+        return std::vector<RegisterValue>(count, 0);
+    });
+    ASSERT_EQ(coalescer.getStatistics().leader_reads, 1u);
+
+    coalescer.resetStatistics();
+    EXPECT_EQ(coalescer.getStatistics().leader_reads, 0u);
+    EXPECT_DOUBLE_EQ(coalescer.getStatistics().suppression_ratio(), 0.0);
+}
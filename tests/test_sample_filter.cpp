@@ -0,0 +1,220 @@
+/**
+ * @file test_sample_filter.cpp
+ * @brief Tests for deadband, swinging-door and heartbeat sample filtering
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/sample_filter.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace ecoWatt;
+using namespace std::chrono_literals;
+
+namespace {
+
+const TimePoint kStart = TimePoint(std::chrono::seconds(1700000000));
+
+AcquisitionSample makeSample(RegisterAddress address, double value, std::chrono::seconds offset) {
+    return AcquisitionSample(kStart + offset, address, "Register " + std::to_string(address),
+                             static_cast<RegisterValue>(value * 100), value, "");
+}
+
+RegisterConfig makeConfig(RegisterAddress address, double deadband, CompressionMode compression,
+                          Duration max_interval = Duration(0)) {
+    RegisterConfig config(address, "Register " + std::to_string(address), "", 100.0,
+                          AccessType::READ_ONLY, "");
+    config.deadband = deadband;
+    config.compression = compression;
+    config.max_interval = max_interval;
+    return config;
+}
+
+std::vector<AcquisitionSample> feed(SampleFilter& filter, const std::vector<AcquisitionSample>& samples) {
+    std::vector<AcquisitionSample> stored;
+    for (const auto& sample : samples) {
+        for (auto& persisted : filter.offer(sample)) {
+            stored.push_back(std::move(persisted));
+        }
+    }
+    for (auto& persisted : filter.flush()) {
+        stored.push_back(std::move(persisted));
+    }
+    return stored;
+}
+
+double secondsSinceStart(const TimePoint& time_point) {
+    return std::chrono::duration<double>(time_point - kStart).count();
+}
+
+/**
+ * @brief Value of the piecewise-linear curve through @p stored at @p time_point
+ */
+double interpolate(const std::vector<AcquisitionSample>& stored, const TimePoint& time_point) {
+    for (size_t i = 1; i < stored.size(); ++i) {
+        if (stored[i].timestamp >= time_point) {
+            double t0 = secondsSinceStart(stored[i - 1].timestamp);
+            double t1 = secondsSinceStart(stored[i].timestamp);
+            double t = secondsSinceStart(time_point);
+            return stored[i - 1].scaled_value +
+                   (stored[i].scaled_value - stored[i - 1].scaled_value) * (t - t0) / (t1 - t0);
+        }
+    }
+    return stored.back().scaled_value;
+}
+
+/**
+ * @brief Grid frequency: slow drift plus quantized jitter, one sample every 5 s
+ */
+std::vector<AcquisitionSample> frequencyDay(RegisterAddress address) {
+    std::vector<AcquisitionSample> samples;
+    for (int i = 0; i < 17280; ++i) {
+        double drift = 0.05 * std::sin(i * 2.0 * M_PI / 2880.0);
+        double jitter = ((i * 7919) % 3 - 1) * 0.005;
+        double value = std::round((50.0 + drift + jitter) * 100.0) / 100.0;
+        samples.push_back(makeSample(address, value, std::chrono::seconds(5 * i)));
+    }
+    return samples;
+}
+
+} // namespace
+
+TEST(SampleFilterTest, UnconfiguredRegister_PassesThrough) {
+    SampleFilter filter;
+    filter.configure({{2, makeConfig(2, 0.5, CompressionMode::NONE)}});
+
+    std::vector<AcquisitionSample> samples = {makeSample(0, 1.0, 0s), makeSample(0, 1.0, 5s)};
+    EXPECT_EQ(feed(filter, samples).size(), 2u);
+}
+
+TEST(SampleFilterTest, Deadband_StoresOnlyExceptions) {
+    SampleFilter filter;
+    filter.configure({{7, makeConfig(7, 0.5, CompressionMode::NONE)}});
+
+    auto stored = feed(filter, {makeSample(7, 40.0, 0s), makeSample(7, 40.3, 5s), makeSample(7, 39.6, 10s),
+                                makeSample(7, 40.6, 15s), makeSample(7, 40.9, 20s)});
+
+    ASSERT_EQ(stored.size(), 2u);
+    EXPECT_DOUBLE_EQ(stored[0].scaled_value, 40.0);
+    EXPECT_DOUBLE_EQ(stored[1].scaled_value, 40.6);
+    EXPECT_EQ(filter.getStatistics().received, 5u);
+    EXPECT_EQ(filter.getStatistics().stored, 2u);
+}
+
+TEST(SampleFilterTest, DeadbandPercent_RelativeToLastStored) {
+    RegisterConfig config = makeConfig(3, 0.0, CompressionMode::NONE);
+    config.deadband_percent = 1.0;
+    SampleFilter filter;
+    filter.configure({{3, config}});
+
+    auto stored = feed(filter, {makeSample(3, 300.0, 0s), makeSample(3, 302.9, 5s), makeSample(3, 303.5, 10s)});
+
+    ASSERT_EQ(stored.size(), 2u);
+    EXPECT_DOUBLE_EQ(stored[1].scaled_value, 303.5);
+}
+
+TEST(SampleFilterTest, Heartbeat_BoundsGapBetweenStoredSamples) {
+    SampleFilter filter;
+    filter.configure({{7, makeConfig(7, 1.0, CompressionMode::NONE, Duration(60000))}});
+
+    std::vector<AcquisitionSample> samples;
+    for (int i = 0; i <= 60; ++i) {
+        samples.push_back(makeSample(7, 40.0, std::chrono::seconds(5 * i)));
+    }
+    auto stored = feed(filter, samples);
+
+    // t = 0, 60, 120, ..., 300
+    ASSERT_EQ(stored.size(), 6u);
+    for (size_t i = 1; i < stored.size(); ++i) {
+        EXPECT_EQ(stored[i].timestamp - stored[i - 1].timestamp, 60s);
+    }
+}
+
+TEST(SampleFilterTest, SwingingDoor_LinearRampStoresEndpointsOnly) {
+    SampleFilter filter;
+    filter.configure({{2, makeConfig(2, 0.01, CompressionMode::SWINGING_DOOR)}});
+
+    std::vector<AcquisitionSample> samples;
+    for (int i = 0; i <= 100; ++i) {
+        samples.push_back(makeSample(2, 49.0 + 0.01 * i, std::chrono::seconds(i)));
+    }
+    auto stored = feed(filter, samples);
+
+    ASSERT_EQ(stored.size(), 2u);
+    EXPECT_EQ(stored.front().timestamp, kStart);
+    EXPECT_EQ(stored.back().timestamp, kStart + 100s);
+}
+
+TEST(SampleFilterTest, SwingingDoor_StepClosesSegmentAtLastSampleBeforeIt) {
+    SampleFilter filter;
+    filter.configure({{2, makeConfig(2, 0.1, CompressionMode::SWINGING_DOOR)}});
+
+    auto first = filter.offer(makeSample(2, 50.0, 0s));
+    auto flat = filter.offer(makeSample(2, 50.0, 5s));
+    auto step = filter.offer(makeSample(2, 52.0, 10s));
+
+    EXPECT_EQ(first.size(), 1u);
+    EXPECT_TRUE(flat.empty());
+    ASSERT_EQ(step.size(), 1u);
+    EXPECT_EQ(step[0].timestamp, kStart + 5s);
+
+    auto flushed = filter.flush();
+    ASSERT_EQ(flushed.size(), 1u);
+    EXPECT_DOUBLE_EQ(flushed[0].scaled_value, 52.0);
+    EXPECT_TRUE(filter.flush().empty());
+}
+
+TEST(SampleFilterTest, SwingingDoor_InterpolationWithinDeadband) {
+    const double deadband = 0.02;
+    SampleFilter filter;
+    filter.configure({{2, makeConfig(2, deadband, CompressionMode::SWINGING_DOOR)}});
+
+    auto samples = frequencyDay(2);
+    auto stored = feed(filter, samples);
+
+    for (const auto& sample : samples) {
+        EXPECT_LE(std::abs(interpolate(stored, sample.timestamp) - sample.scaled_value), deadband + 1e-9)
+            << "at t=" << secondsSinceStart(sample.timestamp);
+    }
+    EXPECT_GE(filter.getStatistics().reduction(), 5.0);
+}
+
+TEST(SampleFilterTest, Deadband_SlowRegisterReduction) {
+    SampleFilter filter;
+    filter.configure({{2, makeConfig(2, 0.02, CompressionMode::NONE, Duration(300000))}});
+
+    auto samples = frequencyDay(2);
+    auto stored = feed(filter, samples);
+
+    EXPECT_GE(static_cast<double>(samples.size()) / stored.size(), 5.0);
+}
+
+TEST(SampleFilterTest, OutOfOrderSample_PersistedWithoutDisturbingState) {
+    SampleFilter filter;
+    filter.configure({{7, makeConfig(7, 1.0, CompressionMode::NONE)}});
+
+    filter.offer(makeSample(7, 40.0, 10s));
+    EXPECT_EQ(filter.offer(makeSample(7, 40.0, 5s)).size(), 1u);
+    EXPECT_TRUE(filter.offer(makeSample(7, 40.5, 15s)).empty());
+}
+
+TEST(SampleFilterTest, Reconfigure_KeepsStateForUnchangedSettings) {
+    std::map<RegisterAddress, RegisterConfig> configs = {
+        {2, makeConfig(2, 0.1, CompressionMode::SWINGING_DOOR)},
+        {7, makeConfig(7, 1.0, CompressionMode::NONE)}};
+    SampleFilter filter;
+    filter.configure(configs);
+
+    filter.offer(makeSample(2, 50.0, 0s));
+    filter.offer(makeSample(2, 50.0, 5s));
+
+    configs[7].deadband = 2.0;
+    filter.configure(configs);
+    EXPECT_EQ(filter.flush().size(), 1u); // Held sample for register 2 survived
+
+    filter.resetStatistics();
+    EXPECT_EQ(filter.getStatistics().received, 0u);
+    EXPECT_DOUBLE_EQ(filter.getStatistics().reduction(), 1.0);
+}
@@ -0,0 +1,232 @@
+/**
+ * @file test_sample_stream.cpp
+ * @brief Tests for the live sample broadcaster
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/sample_stream.hpp"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ecoWatt;
+
+namespace {
+
+AcquisitionSample sample(RegisterValue raw) {
+    return AcquisitionSample(TimePoint(Duration(1000)), 0, "Voltage", raw, raw / 10.0, "V");
+}
+
+/**
+ * @brief Fake client connection recording what it was sent
+ */
+struct FakeClient {
+    std::vector<const std::string*> events;  // Addresses, to check sharing
+    std::vector<std::string> text;
+    bool accepting = true;
+    bool closed = false;
+
+    SampleBroadcaster::Writer writer() {
+        return [this](const std::string& event) {
+            if (!accepting) {
+                return false;
+            }
+            events.push_back(&event);
+            text.push_back(event);
+            return true;
+        };
+    }
+
+    SampleBroadcaster::Closer closer() {
+        return [this]() { closed = true; };
+    }
+};
+
+} // namespace
+
+TEST(SampleBroadcasterTest, FormatEvent_IsSseSampleEvent) {
+    auto event = SampleBroadcaster::formatEvent(7, sample(2301));
+    EXPECT_EQ(event.rfind("id: 7\nevent: sample\ndata: {", 0), 0u);
+    EXPECT_NE(event.find("\"value\":230.1"), std::string::npos);
+    EXPECT_NE(event.find("\"timestamp_ms\":1000"), std::string::npos);
+    EXPECT_EQ(event.substr(event.size() - 2), "\n\n");
+}
+
+TEST(SampleBroadcasterTest, Pump_SerializesOnceForAllSubscribers) {
+    SampleBroadcaster broadcaster(16);
+    FakeClient a, b;
+    broadcaster.subscribe(a.writer(), a.closer());
+    broadcaster.subscribe(b.writer(), b.closer());
+
+    broadcaster.publish(sample(2301));
+    broadcaster.publish(sample(2302));
+    EXPECT_FALSE(broadcaster.pump());
+
+    ASSERT_EQ(a.events.size(), 2u);
+    ASSERT_EQ(b.events.size(), 2u);
+    EXPECT_EQ(a.events[0], b.events[0]);
+    EXPECT_EQ(a.events[1], b.events[1]);
+    EXPECT_EQ(a.text[1].rfind("id: 2\n", 0), 0u);
+
+    auto stats = broadcaster.getStatistics();
+    EXPECT_EQ(stats.subscribers, 2u);
+    EXPECT_EQ(stats.published, 2u);
+    EXPECT_EQ(stats.delivered, 4u);
+    EXPECT_EQ(stats.delivery_lag.count, 4u);
+}
+
+TEST(SampleBroadcasterTest, Pump_BackpressureKeepsEventsQueued) {
+    SampleBroadcaster broadcaster(16);
+    FakeClient fast, slow;
+    broadcaster.subscribe(fast.writer(), fast.closer());
+    auto slow_id = broadcaster.subscribe(slow.writer(), slow.closer());
+
+    slow.accepting = false;
+    for (int i = 0; i < 3; ++i) {
+        broadcaster.publish(sample(2300 + i));
+    }
+    EXPECT_TRUE(broadcaster.pump());
+    EXPECT_EQ(fast.events.size(), 3u);
+    EXPECT_TRUE(slow.events.empty());
+
+    auto per_client = broadcaster.getSubscriberStatistics();
+    ASSERT_EQ(per_client.size(), 2u);
+    EXPECT_EQ(per_client[1].id, slow_id);
+    EXPECT_EQ(per_client[1].backlog, 3u);
+
+    slow.accepting = true;
+    EXPECT_FALSE(broadcaster.pump());
+    ASSERT_EQ(slow.events.size(), 3u);
+    EXPECT_EQ(slow.text[0].rfind("id: 1\n", 0), 0u);
+    EXPECT_EQ(broadcaster.getStatistics().dropped, 0u);
+}
+
+TEST(SampleBroadcasterTest, Pump_DropsOldestThenEvictsSubscriberThatNeverCatchesUp) {
+    SampleBroadcaster broadcaster(4);
+    FakeClient fast, slow;
+    broadcaster.subscribe(fast.writer(), fast.closer());
+    broadcaster.subscribe(slow.writer(), slow.closer());
+    slow.accepting = false;
+
+    for (int i = 0; i < 6; ++i) {
+        broadcaster.publish(sample(2300 + i));
+        broadcaster.pump();
+    }
+    // Ring holds 3..6; the slow client lost events 1 and 2
+    EXPECT_EQ(broadcaster.getSubscriberStatistics()[1].dropped, 2u);
+    EXPECT_FALSE(slow.closed);
+
+    // Catching up to the head ends the episode
+    slow.accepting = true;
+    broadcaster.pump();
+    slow.accepting = false;
+
+    // Behind again: two more drops make four in its lifetime, but only two in this episode
+    for (int i = 0; i < 6; ++i) {
+        broadcaster.publish(sample(2400 + i));
+        broadcaster.pump();
+    }
+    EXPECT_EQ(broadcaster.getSubscriberStatistics()[1].dropped, 4u);
+    EXPECT_FALSE(slow.closed);
+
+    // Losing a full ring without catching up closes it
+    for (int i = 0; i < 2; ++i) {
+        broadcaster.publish(sample(2500 + i));
+        broadcaster.pump();
+    }
+    EXPECT_TRUE(slow.closed);
+    EXPECT_FALSE(fast.closed);
+    EXPECT_EQ(fast.events.size(), 14u);
+    EXPECT_EQ(slow.events.size(), 4u);
+
+    auto stats = broadcaster.getStatistics();
+    EXPECT_EQ(stats.subscribers, 1u);
+    EXPECT_EQ(stats.evicted, 1u);
+    EXPECT_EQ(stats.dropped, 6u);
+}
+
+TEST(SampleBroadcasterTest, Publish_QueueOverflowCountsAsDropped) {
+    SampleBroadcaster broadcaster(4);
+    FakeClient client;
+    broadcaster.subscribe(client.writer(), client.closer());
+
+    // No pump in between: the queue keeps the newest four
+    for (int i = 0; i < 6; ++i) {
+        broadcaster.publish(sample(2300 + i));
+    }
+    broadcaster.pump();
+
+    ASSERT_EQ(client.text.size(), 4u);
+    EXPECT_NE(client.text[0].find("\"raw\":2302"), std::string::npos);
+    auto stats = broadcaster.getStatistics();
+    EXPECT_EQ(stats.published, 6u);
+    EXPECT_EQ(stats.dropped, 2u);
+}
+
+TEST(SampleBroadcasterTest, Subscribe_ResumesFromLastEventId) {
+    SampleBroadcaster broadcaster(8);
+    for (int i = 0; i < 5; ++i) {
+        broadcaster.publish(sample(2300 + i));
+    }
+    broadcaster.pump();
+
+    FakeClient resumed, fresh, stale;
+    broadcaster.subscribe(resumed.writer(), resumed.closer(), 3);
+    broadcaster.subscribe(fresh.writer(), fresh.closer());
+    broadcaster.subscribe(stale.writer(), stale.closer(), 99);
+    broadcaster.pump();
+
+    ASSERT_EQ(resumed.text.size(), 2u);
+    EXPECT_EQ(resumed.text[0].rfind("id: 4\n", 0), 0u);
+    EXPECT_TRUE(fresh.text.empty());
+    EXPECT_TRUE(stale.text.empty());
+}
+
+TEST(SampleBroadcasterTest, Heartbeat_OnlyToCaughtUpSubscribers) {
+    SampleBroadcaster broadcaster(8);
+    FakeClient idle, behind;
+    broadcaster.subscribe(idle.writer(), idle.closer());
+    broadcaster.subscribe(behind.writer(), behind.closer());
+
+    behind.accepting = false;
+    broadcaster.publish(sample(2301));
+    broadcaster.pump();
+    behind.accepting = true;
+
+    broadcaster.heartbeat();
+    ASSERT_EQ(idle.text.size(), 2u);
+    EXPECT_EQ(idle.text[1], ": keepalive\n\n");
+    EXPECT_TRUE(behind.text.empty());
+}
+
+TEST(SampleBroadcasterTest, WriterFailure_RemovesSubscriber) {
+    SampleBroadcaster broadcaster(8);
+    bool closed = false;
+    broadcaster.subscribe([](const std::string&) -> bool { throw std::runtime_error("peer gone"); },
+                          [&closed]() { closed = true; });
+    broadcaster.publish(sample(2301));
+    broadcaster.pump();
+
+    EXPECT_TRUE(closed);
+    EXPECT_EQ(broadcaster.getStatistics().subscribers, 0u);
+    EXPECT_EQ(broadcaster.getStatistics().evicted, 0u);
+}
+
+TEST(SampleBroadcasterTest, Unsubscribe_ClosesAndNotifierFires) {
+    SampleBroadcaster broadcaster(8);
+    int notified = 0;
+    broadcaster.setNotifier([&notified]() { ++notified; });
+
+    FakeClient client;
+    auto id = broadcaster.subscribe(client.writer(), client.closer());
+    broadcaster.publish(sample(2301));
+    EXPECT_EQ(notified, 2);
+
+    broadcaster.unsubscribe(id);
+    EXPECT_TRUE(client.closed);
+    broadcaster.pump();
+    EXPECT_TRUE(client.events.empty());
+}
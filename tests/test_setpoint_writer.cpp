@@ -0,0 +1,197 @@
+/**
+ * @file test_setpoint_writer.cpp
+ * @brief Tests for the coalescing, rate-limited setpoint writer
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/setpoint_writer.hpp"
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace ecoWatt;
+using namespace std::chrono_literals;
+
+namespace {
+
+/**
+ * @brief Records every write that reaches the "inverter"
+ */
+class RecordingWriter {
+public:
+    bool operator()(RegisterAddress address, RegisterValue value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        writes_.emplace_back(address, value, SetpointWriter::Clock::now());
+        return !fail_;
+    }
+
+    void setFail(bool fail) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fail_ = fail;
+    }
+
+    std::vector<RegisterValue> values() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<RegisterValue> result;
+        for (const auto& write : writes_) {
+            result.push_back(std::get<1>(write));
+        }
+        return result;
+    }
+
+    std::vector<SetpointWriter::Clock::time_point> times() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<SetpointWriter::Clock::time_point> result;
+        for (const auto& write : writes_) {
+            result.push_back(std::get<2>(write));
+        }
+        return result;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::tuple<RegisterAddress, RegisterValue, SetpointWriter::Clock::time_point>> writes_;
+    bool fail_ = false;
+};
+
+SetpointWriter::Writer bind(RecordingWriter& recorder) {
+    return [&recorder](RegisterAddress address, RegisterValue value) { return recorder(address, value); };
+}
+
+} // namespace
+
+TEST(SetpointWriterTest, Write_AppliedAndConfirmed) {
+    RecordingWriter recorder;
+    SetpointWriter writer(bind(recorder), Duration(0));
+
+    EXPECT_EQ(writer.write(8, 75), SetpointResult::APPLIED);
+    EXPECT_EQ(recorder.values(), std::vector<RegisterValue>{75});
+    EXPECT_EQ(writer.getConfirmedValue(8), RegisterValue(75));
+    EXPECT_EQ(writer.getStatistics().applied, 1u);
+}
+
+TEST(SetpointWriterTest, EqualToConfirmed_Skipped) {
+    RecordingWriter recorder;
+    SetpointWriter writer(bind(recorder), Duration(0));
+
+    writer.write(8, 60);
+    EXPECT_EQ(writer.write(8, 60), SetpointResult::SKIPPED);
+    EXPECT_EQ(recorder.values().size(), 1u);
+
+    // After invalidation the same value is sent again
+    writer.invalidate(8);
+    EXPECT_EQ(writer.write(8, 60), SetpointResult::APPLIED);
+    EXPECT_EQ(writer.getStatistics().skipped, 1u);
+}
+
+TEST(SetpointWriterTest, Burst_LastWriterWins) {
+    RecordingWriter recorder;
+    SetpointWriter writer(bind(recorder), Duration(100));
+
+    writer.write(8, 10); // Starts the min-interval window
+
+    std::vector<std::shared_future<SetpointResult>> results;
+    for (RegisterValue value = 11; value <= 20; ++value) {
+        results.push_back(writer.submit(8, value));
+    }
+
+    for (size_t i = 0; i + 1 < results.size(); ++i) {
+        EXPECT_EQ(results[i].get(), SetpointResult::COALESCED);
+    }
+    EXPECT_EQ(results.back().get(), SetpointResult::APPLIED);
+
+    EXPECT_EQ(recorder.values(), (std::vector<RegisterValue>{10, 20}));
+    auto stats = writer.getStatistics();
+    EXPECT_EQ(stats.submitted, 11u);
+    EXPECT_EQ(stats.applied, 2u);
+    EXPECT_EQ(stats.coalesced, 9u);
+}
+
+TEST(SetpointWriterTest, MinInterval_SpacesWrites) {
+    RecordingWriter recorder;
+    SetpointWriter writer(bind(recorder), Duration(50));
+
+    writer.write(8, 1);
+    writer.write(8, 2);
+    writer.write(8, 3);
+
+    auto times = recorder.times();
+    ASSERT_EQ(times.size(), 3u);
+    EXPECT_GE(times[1] - times[0], 45ms);
+    EXPECT_GE(times[2] - times[1], 45ms);
+}
+
+TEST(SetpointWriterTest, MinInterval_IsPerRegister) {
+    RecordingWriter recorder;
+    SetpointWriter writer(bind(recorder), Duration(10000));
+
+    writer.write(8, 1);
+    auto start = SetpointWriter::Clock::now();
+    EXPECT_EQ(writer.write(9, 1), SetpointResult::APPLIED);
+    EXPECT_LT(SetpointWriter::Clock::now() - start, 1s);
+}
+
+TEST(SetpointWriterTest, RevertToConfirmedWhilePending_Skipped) {
+    RecordingWriter recorder;
+    SetpointWriter writer(bind(recorder), Duration(100));
+
+    writer.write(8, 40);
+    auto superseded = writer.submit(8, 70);
+    auto reverted = writer.submit(8, 40);
+
+    EXPECT_EQ(superseded.get(), SetpointResult::COALESCED);
+    EXPECT_EQ(reverted.get(), SetpointResult::SKIPPED);
+    EXPECT_EQ(recorder.values(), std::vector<RegisterValue>{40});
+}
+
+TEST(SetpointWriterTest, FailedWrite_ForgetsConfirmedValue) {
+    RecordingWriter recorder;
+    SetpointWriter writer(bind(recorder), Duration(0));
+
+    writer.write(8, 30);
+    recorder.setFail(true);
+    EXPECT_EQ(writer.write(8, 50), SetpointResult::FAILED);
+    EXPECT_FALSE(writer.getConfirmedValue(8).has_value());
+
+    // 30 is no longer known to be in the register, so it is sent
+    recorder.setFail(false);
+    EXPECT_EQ(writer.write(8, 30), SetpointResult::APPLIED);
+    EXPECT_EQ(writer.getStatistics().failed, 1u);
+}
+
+TEST(SetpointWriterTest, ReadBackDiffers_ResendsSameValue) {
+    RecordingWriter recorder;
+    SetpointWriter writer(bind(recorder), Duration(0));
+    const TimePoint before_write = std::chrono::system_clock::now() - 1s;
+
+    writer.write(8, 40);
+    writer.observe(8, 40, std::chrono::system_clock::now());
+    writer.observe(8, 100, before_write);  // Polled before the write landed
+    EXPECT_EQ(writer.write(8, 40), SetpointResult::SKIPPED);
+
+    // Inverter reset to its default: the same setpoint must be restored
+    writer.observe(8, 100, std::chrono::system_clock::now());
+    EXPECT_FALSE(writer.getConfirmedValue(8).has_value());
+    EXPECT_EQ(writer.write(8, 40), SetpointResult::APPLIED);
+    EXPECT_EQ(recorder.values(), (std::vector<RegisterValue>{40, 40}));
+    EXPECT_EQ(writer.getStatistics().invalidated, 1u);
+
+    // Registers never written are not tracked
+    writer.observe(9, 5, std::chrono::system_clock::now());
+    EXPECT_FALSE(writer.getConfirmedValue(9).has_value());
+}
+
+TEST(SetpointWriterTest, Destructor_FlushesPendingWrites) {
+    RecordingWriter recorder;
+    std::shared_future<SetpointResult> pending;
+    {
+        SetpointWriter writer(bind(recorder), Duration(60000));
+        writer.write(8, 1);
+        pending = writer.submit(8, 2);
+    }
+
+    EXPECT_EQ(pending.get(), SetpointResult::APPLIED);
+    EXPECT_EQ(recorder.values(), (std::vector<RegisterValue>{1, 2}));
+}
@@ -0,0 +1,165 @@
+/**
+ * @file test_shm_latest_table.cpp
+ * @brief Tests for the shared-memory latest-value publisher and reader
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/shm_latest_publisher.hpp"
+#include "../cpp/include/exceptions.hpp"
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+
+using namespace ecoWatt;
+
+namespace {
+
+RegisterConfig registerConfig(RegisterAddress address, const std::string& name, const std::string& unit) {
+    RegisterConfig config;
+    config.address = address;
+    config.name = name;
+    config.unit = unit;
+    config.access = AccessType::READ_ONLY;
+    return config;
+}
+
+AcquisitionSample sample(RegisterAddress address, RegisterValue raw, int64_t timestamp_ms) {
+    return AcquisitionSample(TimePoint(Duration(timestamp_ms)), address, "Voltage", raw, raw / 10.0, "V");
+}
+
+} // namespace
+
+class ShmLatestTableTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config_.enabled = true;
+        config_.name = "/ecowatt_test_" + std::to_string(::getpid());
+        registers_ = {{0, registerConfig(0, "Voltage", "V")},
+                      {1, registerConfig(1, "Current", "A")},
+                      {10, registerConfig(10, "A very long register name indeed", "kWh")}};
+    }
+
+    SharedMemoryConfig config_;
+    std::map<RegisterAddress, RegisterConfig> registers_;
+};
+
+TEST_F(ShmLatestTableTest, Layout_OneCacheLinePerSlot) {
+    EXPECT_EQ(sizeof(ShmSlot), 64u);
+    EXPECT_EQ(alignof(ShmSlot), 64u);
+    EXPECT_EQ(shmTableSize(3), 4 * 64u);
+}
+
+TEST_F(ShmLatestTableTest, Reader_SeesSlotsInAddressOrder) {
+    ShmLatestPublisher publisher(config_, registers_);
+    ShmLatestReader reader(config_.name);
+
+    EXPECT_TRUE(reader.valid());
+    EXPECT_EQ(reader.slotCount(), 3u);
+    EXPECT_EQ(reader.publisherPid(), ::getpid());
+    EXPECT_EQ(reader.findSlot(0), 0);
+    EXPECT_EQ(reader.findSlot(10), 2);
+    EXPECT_EQ(reader.findSlot(7), -1);
+    EXPECT_STREQ(reader.name(1), "Current");
+    EXPECT_STREQ(reader.unit(2), "kWh");
+    EXPECT_EQ(std::strlen(reader.name(2)), kShmSlotNameSize - 1);
+
+    // Never written: consistent, but sequence 0
+    ShmReading reading;
+    ASSERT_TRUE(reader.tryRead(0, reading));
+    EXPECT_EQ(reading.sequence, 0u);
+}
+
+TEST_F(ShmLatestTableTest, Publish_ReaderGetsLatestValue) {
+    ShmLatestPublisher publisher(config_, registers_);
+    ShmLatestReader reader(config_.name);
+
+    publisher.publish(sample(0, 2301, 1000));
+    publisher.publish(sample(0, 2302, 2000));
+    publisher.publish(sample(42, 1, 2000));
+
+    ShmReading reading;
+    ASSERT_TRUE(reader.read(0, reading));
+    EXPECT_EQ(reading.address, 0);
+    EXPECT_EQ(reading.raw_value, 2302);
+    EXPECT_DOUBLE_EQ(reading.value, 230.2);
+    EXPECT_EQ(reading.timestamp_ns, 2000LL * 1000000);
+    EXPECT_EQ(reading.sequence, 4u);
+
+    EXPECT_EQ(reader.publishCount(), 2u);
+    EXPECT_EQ(publisher.getStatistics().published, 2u);
+    EXPECT_EQ(publisher.getStatistics().unknown_register, 1u);
+}
+
+TEST_F(ShmLatestTableTest, ConcurrentReads_NeverTorn) {
+    ShmLatestPublisher publisher(config_, registers_);
+    ShmLatestReader reader(config_.name);
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&]() {
+        RegisterValue raw = 0;
+        while (!stop.load()) {
+            ++raw;
+            publisher.publish(sample(1, raw, raw));
+        }
+    });
+
+    // value and timestamp are both derived from raw; a torn copy breaks that
+    uint64_t consistent = 0;
+    uint32_t last_sequence = 0;
+    while (consistent < 100000) {
+        ShmReading reading;
+        if (!reader.tryRead(1, reading) || reading.sequence == 0) {
+            continue;
+        }
+        ++consistent;
+        ASSERT_GE(reading.sequence, last_sequence);
+        last_sequence = reading.sequence;
+        ASSERT_DOUBLE_EQ(reading.value, reading.raw_value / 10.0);
+        ASSERT_EQ(reading.timestamp_ns, reading.raw_value * 1000000LL);
+    }
+    stop = true;
+    writer.join();
+    EXPECT_GT(last_sequence, 0u);
+}
+
+TEST_F(ShmLatestTableTest, Shutdown_InvalidatesAndUnlinks) {
+    auto publisher = std::make_unique<ShmLatestPublisher>(config_, registers_);
+    ShmLatestReader reader(config_.name);
+    publisher.reset();
+
+    // The existing mapping stays readable but reports the publisher gone
+    EXPECT_FALSE(reader.valid());
+    EXPECT_THROW(ShmLatestReader{config_.name}, std::system_error);
+}
+
+TEST_F(ShmLatestTableTest, Restart_ReplacesSegment) {
+    auto first = std::make_unique<ShmLatestPublisher>(config_, registers_);
+    ShmLatestReader old_reader(config_.name);
+
+    registers_.erase(10);
+    ShmLatestPublisher second(config_, registers_);
+    ShmLatestReader new_reader(config_.name);
+    EXPECT_EQ(new_reader.slotCount(), 2u);
+    EXPECT_EQ(old_reader.slotCount(), 3u);
+    EXPECT_TRUE(old_reader.valid());
+
+    // The old publisher leaves the name to its successor
+    first.reset();
+    EXPECT_FALSE(old_reader.valid());
+    EXPECT_TRUE(new_reader.valid());
+    EXPECT_NO_THROW(ShmLatestReader{config_.name});
+}
+
+TEST_F(ShmLatestTableTest, InvalidName_Throws) {
+    config_.name = "no_leading_slash";
+    EXPECT_THROW(ShmLatestPublisher(config_, registers_), ValidationException);
+    config_.name = "/nested/name";
+    EXPECT_THROW(ShmLatestPublisher(config_, registers_), ValidationException);
+}
@@ -0,0 +1,150 @@
+/**
+ * @file test_tracing.cpp
+ * @brief Tests for trace spans and the Chrome trace-event export
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/tracing.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ecoWatt;
+
+namespace {
+
+TracingConfig tracingConfig(bool enabled, uint32_t buffer_events = 1024) {
+    TracingConfig config;
+    config.enabled = enabled;
+    config.buffer_events = buffer_events;
+    return config;
+}
+
+std::vector<nlohmann::json> spans(const nlohmann::json& trace) {
+    std::vector<nlohmann::json> result;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "X") {
+            result.push_back(event);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+class TracingTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        Tracer::configure(tracingConfig(false));
+    }
+};
+
+TEST_F(TracingTest, Disabled_RecordsNothing) {
+    Tracer::configure(tracingConfig(false));
+    {
+        TRACE_SPAN("idle");
+    }
+    EXPECT_EQ(Tracer::eventCount(), 0u);
+}
+
+TEST_F(TracingTest, NestedSpans_ExportedAsCompleteEvents) {
+    Tracer::configure(tracingConfig(true));
+    {
+        TRACE_SPAN("outer", "test");
+        {
+            TRACE_SPAN("inner", "test");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+
+    auto trace = nlohmann::json::parse(Tracer::toChromeJson());
+    EXPECT_EQ(trace["displayTimeUnit"], "ns");
+    auto events = spans(trace);
+    ASSERT_EQ(events.size(), 2u);
+
+    // Inner closes first
+    const auto& inner = events[0];
+    const auto& outer = events[1];
+    EXPECT_EQ(inner["name"], "inner");
+    EXPECT_EQ(outer["name"], "outer");
+    EXPECT_EQ(outer["cat"], "test");
+    EXPECT_EQ(inner["tid"], outer["tid"]);
+    EXPECT_GE(inner["dur"].get<double>(), 2000.0);
+    EXPECT_LE(outer["ts"].get<double>(), inner["ts"].get<double>());
+    EXPECT_GE(outer["ts"].get<double>() + outer["dur"].get<double>(),
+              inner["ts"].get<double>() + inner["dur"].get<double>());
+}
+
+TEST_F(TracingTest, Ring_KeepsNewestSpans) {
+    Tracer::configure(tracingConfig(true, 4));
+    const char* names[] = {"s0", "s1", "s2", "s3", "s4", "s5"};
+    for (const char* name : names) {
+        TraceSpan span(name);
+    }
+
+    EXPECT_EQ(Tracer::eventCount(), 4u);
+    auto events = spans(nlohmann::json::parse(Tracer::toChromeJson()));
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_EQ(events.front()["name"], "s2");
+    EXPECT_EQ(events.back()["name"], "s5");
+}
+
+TEST_F(TracingTest, Configure_ResizesExistingRings) {
+    Tracer::configure(tracingConfig(true, 8));
+    for (int i = 0; i < 3; ++i) {
+        TraceSpan span("before");
+    }
+    EXPECT_EQ(Tracer::eventCount(), 3u);
+
+    // This thread's ring already exists; it takes the new size
+    Tracer::configure(tracingConfig(true, 2));
+    EXPECT_EQ(Tracer::eventCount(), 0u);
+    const char* names[] = {"a0", "a1", "a2"};
+    for (const char* name : names) {
+        TraceSpan span(name);
+    }
+    auto events = spans(nlohmann::json::parse(Tracer::toChromeJson()));
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events.front()["name"], "a1");
+    EXPECT_EQ(events.back()["name"], "a2");
+}
+
+TEST_F(TracingTest, Threads_RecordToSeparateRings) {
+    Tracer::configure(tracingConfig(true));
+    auto work = [] {
+        for (int i = 0; i < 10; ++i) {
+            TRACE_SPAN("worker");
+        }
+    };
+    std::thread a(work);
+    std::thread b(work);
+    a.join();
+    b.join();
+
+    auto events = spans(nlohmann::json::parse(Tracer::toChromeJson()));
+    ASSERT_EQ(events.size(), 20u);
+    EXPECT_NE(events.front()["tid"], events.back()["tid"]);
+
+    // Rings of exited threads go away on clear
+    Tracer::clear();
+    EXPECT_EQ(Tracer::eventCount(), 0u);
+}
+
+TEST_F(TracingTest, WriteChromeTrace_ProducesLoadableFile) {
+    Tracer::configure(tracingConfig(true));
+    {
+        TRACE_SPAN("file");
+    }
+
+    const std::string path = "test_trace.json";
+    ASSERT_TRUE(Tracer::writeChromeTrace(path));
+    std::ifstream file(path);
+    auto trace = nlohmann::json::parse(file);
+    EXPECT_EQ(spans(trace).size(), 1u);
+    std::remove(path.c_str());
+}
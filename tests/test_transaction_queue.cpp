@@ -0,0 +1,132 @@
+/**
+ * @file test_transaction_queue.cpp
+ * @brief Tests for prioritized transaction admission
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/transaction_queue.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace ecoWatt;
+using namespace std::chrono_literals;
+
+namespace {
+
+void waitForWaiting(const TransactionQueue& queue, TransactionLane lane, size_t count) {
+    for (int i = 0; i < 500 && queue.getLaneStatistics(lane).waiting < count; ++i) {
+        std::this_thread::sleep_for(1ms);
+    }
+}
+
+} // namespace
+
+TEST(TransactionQueueTest, Uncontended_AdmitsImmediately) {
+    TransactionQueue queue;
+    {
+        auto slot = queue.acquire(TransactionLane::BACKGROUND);
+    }
+    {
+        auto slot = queue.acquire(TransactionLane::CONTROL);
+    }
+
+    EXPECT_EQ(queue.getLaneStatistics(TransactionLane::BACKGROUND).admitted, 1u);
+    EXPECT_EQ(queue.getLaneStatistics(TransactionLane::CONTROL).admitted, 1u);
+    EXPECT_EQ(queue.getLaneStatistics(TransactionLane::INTERACTIVE).admitted, 0u);
+}
+
+TEST(TransactionQueueTest, ControlWrite_PreemptsQueuedPolls) {
+    TransactionQueue queue;
+    std::mutex order_mutex;
+    std::vector<std::string> order;
+
+    auto worker = [&](TransactionLane lane, const std::string& name) {
+        auto slot = queue.acquire(lane);
+        std::lock_guard<std::mutex> lock(order_mutex);
+        order.push_back(name);
+    };
+
+    auto holder = std::make_unique<TransactionQueue::Slot>(queue.acquire(TransactionLane::BACKGROUND));
+
+    std::vector<std::thread> threads;
+    threads.emplace_back(worker, TransactionLane::BACKGROUND, "poll-1");
+    waitForWaiting(queue, TransactionLane::BACKGROUND, 1);
+    threads.emplace_back(worker, TransactionLane::BACKGROUND, "poll-2");
+    waitForWaiting(queue, TransactionLane::BACKGROUND, 2);
+    threads.emplace_back(worker, TransactionLane::INTERACTIVE, "status");
+    waitForWaiting(queue, TransactionLane::INTERACTIVE, 1);
+    threads.emplace_back(worker, TransactionLane::CONTROL, "export-limit");
+    waitForWaiting(queue, TransactionLane::CONTROL, 1);
+
+    holder.reset();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(order, (std::vector<std::string>{"export-limit", "status", "poll-1", "poll-2"}));
+}
+
+TEST(TransactionQueueTest, QueueLatency_RecordedPerLane) {
+    TransactionQueue queue;
+
+    auto holder = std::make_unique<TransactionQueue::Slot>(queue.acquire(TransactionLane::BACKGROUND));
+    std::thread waiter([&] { auto slot = queue.acquire(TransactionLane::CONTROL); });
+    waitForWaiting(queue, TransactionLane::CONTROL, 1);
+    std::this_thread::sleep_for(20ms);
+    holder.reset();
+    waiter.join();
+
+    auto control = queue.getLaneStatistics(TransactionLane::CONTROL);
+    EXPECT_EQ(control.admitted, 1u);
+    EXPECT_EQ(control.waiting, 0u);
+    EXPECT_EQ(control.queue_latency.count, 1u);
+    EXPECT_GE(control.queue_latency.max_us, 15000u);
+
+    auto background = queue.getLaneStatistics(TransactionLane::BACKGROUND);
+    EXPECT_LT(background.queue_latency.max_us, control.queue_latency.max_us);
+}
+
+TEST(TransactionQueueTest, ResetStatistics_ClearsCounters) {
+    TransactionQueue queue;
+    {
+        auto slot = queue.acquire(TransactionLane::INTERACTIVE);
+    }
+    queue.resetStatistics();
+
+    auto stats = queue.getLaneStatistics(TransactionLane::INTERACTIVE);
+    EXPECT_EQ(stats.admitted, 0u);
+    EXPECT_EQ(stats.queue_latency.count, 0u);
+    EXPECT_STREQ(TransactionQueue::laneName(TransactionLane::CONTROL), "control");
+}
+
+TEST(TransactionQueueTest, Capacity_AdmitsUpToLimitConcurrently) {
+    TransactionQueue queue;
+    queue.setCapacity(2);
+
+    auto first = std::make_unique<TransactionQueue::Slot>(queue.acquire(TransactionLane::BACKGROUND));
+    auto second = std::make_unique<TransactionQueue::Slot>(queue.acquire(TransactionLane::BACKGROUND));
+    EXPECT_EQ(queue.inFlight(), 2u);
+
+    std::atomic<bool> admitted{false};
+    std::thread third([&] {
+        auto slot = queue.acquire(TransactionLane::CONTROL);
+        admitted = true;
+    });
+    waitForWaiting(queue, TransactionLane::CONTROL, 1);
+    EXPECT_FALSE(admitted.load());
+
+    first.reset();
+    third.join();
+    EXPECT_TRUE(admitted.load());
+
+    second.reset();
+    EXPECT_EQ(queue.inFlight(), 0u);
+    queue.setCapacity(0);
+    EXPECT_EQ(queue.getCapacity(), 1u);
+}
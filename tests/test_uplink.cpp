@@ -0,0 +1,299 @@
+/**
+ * @file test_uplink.cpp
+ * @brief Tests for the store-and-forward uplink
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/uplink.hpp"
+#include "../cpp/include/uplink_collector.hpp"
+#include "../cpp/include/data_storage.hpp"
+#include "../cpp/include/exceptions.hpp"
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace ecoWatt;
+
+class UplinkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::remove(db_path_);
+        storage_config_.database_path = db_path_;
+        storage_config_.memory_retention_samples = 100;
+        storage_ = std::make_shared<HybridDataStorage>(storage_config_);
+
+        config_.enabled = true;
+        config_.batch_max_samples = 100;
+        config_.batch_max_age = Duration(0);
+        config_.retry_initial = Duration(10);
+        config_.retry_max = Duration(80);
+    }
+
+    void TearDown() override {
+        storage_.reset();
+        std::filesystem::remove(db_path_);
+        std::filesystem::remove(db_path_ + "-wal");
+        std::filesystem::remove(db_path_ + "-shm");
+    }
+
+    // Delivers straight into the collector, as its HTTP handler would
+    UplinkForwarder::Sender collectorSender() {
+        return [this](const UplinkForwarder::Delivery& delivery) {
+            ++deliveries_;
+            auto reply = collector_.ingest(delivery.body, delivery.content_encoding);
+            if (reply.status != 200) {
+                throw HttpException("Collector answered " + std::to_string(reply.status));
+            }
+            return reply.ack;
+        };
+    }
+
+    void storeSamples(size_t count, TimePoint timestamp = std::chrono::system_clock::now() - std::chrono::seconds(1)) {
+        for (size_t i = 0; i < count; ++i) {
+            RegisterAddress address = static_cast<RegisterAddress>(i % 2);
+            RegisterValue raw = static_cast<RegisterValue>(2300 + stored_ % 50);
+            storage_->storeSample(AcquisitionSample(timestamp + Duration(i), address,
+                                                    address == 0 ? "Voltage" : "Current",
+                                                    raw, raw / 10.0, address == 0 ? "V" : "A"));
+            ++stored_;
+        }
+    }
+
+    const std::string db_path_ = "test_uplink.db";
+    StorageConfig storage_config_;
+    std::shared_ptr<HybridDataStorage> storage_;
+    UplinkConfig config_;
+    UplinkCollectorServer collector_;
+    size_t deliveries_ = 0;
+    size_t stored_ = 0;
+};
+
+TEST_F(UplinkTest, Constructor_RejectsInvalidConfiguration) {
+    config_.batch_max_samples = 0;
+    EXPECT_THROW(UplinkForwarder(config_, storage_, collectorSender()), ValidationException);
+    config_.batch_max_samples = 100;
+    config_.retry_max = Duration(1);
+    EXPECT_THROW(UplinkForwarder(config_, storage_, collectorSender()), ValidationException);
+    config_.retry_max = Duration(80);
+    EXPECT_THROW(UplinkForwarder(config_, nullptr, collectorSender()), ValidationException);
+}
+
+TEST_F(UplinkTest, RunOnce_IdleWithoutRows) {
+    UplinkForwarder uplink(config_, storage_, collectorSender());
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::IDLE);
+    EXPECT_EQ(deliveries_, 0u);
+}
+
+TEST_F(UplinkTest, CatchUp_SendsFullBatchesInOrder) {
+    storeSamples(250);
+    UplinkForwarder uplink(config_, storage_, collectorSender());
+
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::SENT);
+    EXPECT_EQ(uplink.getStatistics().backlog, 150u);
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::SENT);
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::SENT);
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::IDLE);
+
+    auto received = collector_.samples();
+    ASSERT_EQ(received.size(), 250u);
+    for (size_t i = 1; i < received.size(); ++i) {
+        EXPECT_EQ(received[i].id, received[i - 1].id + 1);
+    }
+    EXPECT_EQ(received[1].register_address, 1);
+
+    auto stats = uplink.getStatistics();
+    EXPECT_EQ(stats.batches_sent, 3u);
+    EXPECT_EQ(stats.samples_sent, 250u);
+    EXPECT_EQ(stats.backlog, 0u);
+    EXPECT_EQ(stats.cursor, received.back().id);
+    EXPECT_GT(stats.compression_ratio(), 1.0);
+    EXPECT_EQ(stats.send_latency.count, 3u);
+}
+
+TEST_F(UplinkTest, Cursor_SurvivesRestart) {
+    storeSamples(150);
+    {
+        UplinkForwarder uplink(config_, storage_, collectorSender());
+        EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::SENT);
+    }
+
+    // Reopen the database as after a reboot
+    storage_.reset();
+    storage_ = std::make_shared<HybridDataStorage>(storage_config_);
+    storeSamples(10);
+
+    UplinkForwarder uplink(config_, storage_, collectorSender());
+    EXPECT_EQ(uplink.getStatistics().cursor, collector_.highWater());
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::SENT);
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::IDLE);
+
+    EXPECT_EQ(collector_.samples().size(), 160u);
+    EXPECT_EQ(collector_.getStatistics().duplicates, 0u);
+}
+
+TEST_F(UplinkTest, Outage_KeepsCursorAndResumes) {
+    storeSamples(50);
+    UplinkForwarder uplink(config_, storage_, collectorSender());
+
+    collector_.setAvailable(false);
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::FAILED);
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::FAILED);
+    auto stats = uplink.getStatistics();
+    EXPECT_EQ(stats.cursor, 0u);
+    EXPECT_EQ(stats.failures, 2u);
+    EXPECT_EQ(stats.consecutive_failures, 2u);
+    EXPECT_NE(stats.last_error.find("503"), std::string::npos);
+
+    // Rows keep arriving during the outage
+    storeSamples(20);
+    collector_.setAvailable(true);
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::SENT);
+    EXPECT_EQ(uplink.getStatistics().consecutive_failures, 0u);
+    EXPECT_EQ(collector_.samples().size(), 70u);
+}
+
+TEST_F(UplinkTest, LostAck_ResendIsDeduplicated) {
+    storeSamples(30);
+    bool drop_ack = true;
+    UplinkForwarder uplink(config_, storage_, [&](const UplinkForwarder::Delivery& delivery) {
+        auto reply = collector_.ingest(delivery.body, delivery.content_encoding);
+        if (drop_ack) {
+            drop_ack = false;
+            throw HttpException("Timed out waiting for the reply");
+        }
+        return reply.ack;
+    });
+
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::FAILED);
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::SENT);
+
+    EXPECT_EQ(collector_.samples().size(), 30u);
+    EXPECT_EQ(collector_.getStatistics().duplicates, 30u);
+    EXPECT_EQ(uplink.getStatistics().cursor, collector_.highWater());
+}
+
+TEST_F(UplinkTest, Ack_OutsideBatchIsAFailure) {
+    storeSamples(10);
+    UplinkForwarder uplink(config_, storage_, [](const UplinkForwarder::Delivery& delivery) {
+        return delivery.last_id + 5;
+    });
+
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::FAILED);
+    EXPECT_EQ(uplink.getStatistics().cursor, 0u);
+}
+
+TEST_F(UplinkTest, Ack_AtCursorIsAFailure) {
+    storeSamples(10);
+    UplinkForwarder uplink(config_, storage_, [](const UplinkForwarder::Delivery& delivery) {
+        return delivery.first_id - 1;
+    });
+
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::FAILED);
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::FAILED);
+    auto stats = uplink.getStatistics();
+    EXPECT_EQ(stats.cursor, 0u);
+    EXPECT_EQ(stats.batches_sent, 0u);
+    EXPECT_EQ(stats.consecutive_failures, 2u);
+    EXPECT_GT(uplink.nextDelay(UplinkForwarder::CycleResult::FAILED), Duration(0));
+}
+
+TEST_F(UplinkTest, PartialBatch_WaitsForMaxAge) {
+    config_.batch_max_age = Duration(60000);
+    storeSamples(10);
+    UplinkForwarder uplink(config_, storage_, collectorSender());
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::WAITING);
+    EXPECT_EQ(deliveries_, 0u);
+
+    // Filling the batch sends it regardless of age
+    storeSamples(100);
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::SENT);
+    EXPECT_EQ(collector_.samples().size(), 100u);
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::WAITING);
+}
+
+TEST_F(UplinkTest, PartialBatch_SentOnceOldEnough) {
+    config_.batch_max_age = Duration(60000);
+    storeSamples(10, std::chrono::system_clock::now() - std::chrono::minutes(5));
+    UplinkForwarder uplink(config_, storage_, collectorSender());
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::SENT);
+    EXPECT_EQ(collector_.samples().size(), 10u);
+}
+
+TEST_F(UplinkTest, ByteCap_SplitsBatches) {
+    config_.batch_max_bytes = 64;
+    storeSamples(60);
+    UplinkForwarder uplink(config_, storage_, collectorSender());
+
+    while (uplink.runOnce() == UplinkForwarder::CycleResult::SENT) {
+    }
+    EXPECT_GT(deliveries_, 2u);
+    EXPECT_EQ(collector_.samples().size(), 60u);
+}
+
+TEST_F(UplinkTest, NextDelay_BacksOffAndPaces) {
+    config_.max_batches_per_second = 4.0;
+    storeSamples(300);
+    UplinkForwarder uplink(config_, storage_, [](const UplinkForwarder::Delivery&) -> uint64_t {
+        throw HttpException("down");
+    });
+
+    Duration previous(0);
+    for (int attempt = 1; attempt <= 6; ++attempt) {
+        EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::FAILED);
+        Duration delay = uplink.nextDelay(UplinkForwarder::CycleResult::FAILED);
+        int64_t backoff = std::min<int64_t>(10LL << (attempt - 1), 80);
+        EXPECT_GE(delay.count(), backoff / 2) << "attempt " << attempt;
+        EXPECT_LE(delay.count(), backoff) << "attempt " << attempt;
+        previous = delay;
+    }
+    EXPECT_GE(previous.count(), 40);
+
+    UplinkForwarder pacing(config_, storage_, collectorSender());
+    EXPECT_EQ(pacing.runOnce(), UplinkForwarder::CycleResult::SENT);
+    EXPECT_EQ(pacing.nextDelay(UplinkForwarder::CycleResult::SENT), Duration(250));
+    while (pacing.runOnce() == UplinkForwarder::CycleResult::SENT) {
+    }
+    EXPECT_EQ(pacing.nextDelay(UplinkForwarder::CycleResult::SENT), config_.poll_interval);
+}
+
+TEST_F(UplinkTest, Worker_DrainsBacklogInBackground) {
+    config_.poll_interval = Duration(10);
+    config_.max_batches_per_second = 0.0;
+    storeSamples(500);
+    UplinkForwarder uplink(config_, storage_, collectorSender());
+    uplink.start();
+    EXPECT_TRUE(uplink.isRunning());
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (collector_.samples().size() < 500 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    uplink.stop();
+    EXPECT_FALSE(uplink.isRunning());
+    EXPECT_EQ(collector_.samples().size(), 500u);
+}
+
+TEST_F(UplinkTest, Http_EndToEndWithAuthorization) {
+    UplinkCollectorServer collector("http://127.0.0.1:18095", "/api/v1/ingest", "uplink-secret");
+    collector.start();
+
+    config_.collector_url = "http://127.0.0.1:18095";
+    config_.api_key = "uplink-secret";
+    storeSamples(40);
+    UplinkForwarder uplink(config_, storage_);
+    EXPECT_EQ(uplink.runOnce(), UplinkForwarder::CycleResult::SENT);
+    EXPECT_EQ(collector.samples().size(), 40u);
+
+    // Wrong key: rejected, cursor unchanged
+    storeSamples(5);
+    config_.api_key = "wrong";
+    UplinkForwarder unauthorized(config_, storage_);
+    EXPECT_EQ(unauthorized.runOnce(), UplinkForwarder::CycleResult::FAILED);
+    EXPECT_EQ(collector.samples().size(), 40u);
+
+    collector.stop();
+}
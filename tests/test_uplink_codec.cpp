@@ -0,0 +1,156 @@
+/**
+ * @file test_uplink_codec.cpp
+ * @brief Tests for the uplink batch encoding and gzip helpers
+ * @author EcoWatt Test Team
+ * @date 2025-09-06
+ */
+
+#include <gtest/gtest.h>
+#include "../cpp/include/uplink_codec.hpp"
+#include "../cpp/include/exceptions.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace ecoWatt;
+
+namespace {
+
+StoredSample row(uint64_t id, RegisterAddress address, double value, int64_t timestamp_ms) {
+    StoredSample sample;
+    sample.id = id;
+    sample.register_address = address;
+    sample.value = value;
+    sample.timestamp = TimePoint(Duration(timestamp_ms));
+    return sample;
+}
+
+// A day-like run of polls: two registers every 5 s with slowly moving values
+std::vector<StoredSample> pollRun(size_t polls) {
+    std::vector<StoredSample> rows;
+    uint64_t id = 1000;
+    int64_t timestamp = 1757116800000;
+    for (size_t i = 0; i < polls; ++i) {
+        rows.push_back(row(id++, 0, 2300.0 + static_cast<double>(i % 7), timestamp));
+        rows.push_back(row(id++, 1, 120.0 - static_cast<double>(i % 3), timestamp + 12));
+        timestamp += 5000;
+    }
+    return rows;
+}
+
+std::vector<StoredSample> encodeDecode(const std::vector<StoredSample>& rows) {
+    UplinkBatchEncoder encoder;
+    for (const auto& sample : rows) {
+        encoder.add(sample);
+    }
+    return UplinkCodec::decode(encoder.finish());
+}
+
+void expectSameRows(const std::vector<StoredSample>& expected, const std::vector<StoredSample>& actual) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i].id, expected[i].id) << "row " << i;
+        EXPECT_EQ(actual[i].register_address, expected[i].register_address) << "row " << i;
+        EXPECT_EQ(actual[i].timestamp, expected[i].timestamp) << "row " << i;
+        EXPECT_EQ(actual[i].value, expected[i].value) << "row " << i;
+    }
+}
+
+} // namespace
+
+TEST(UplinkCodecTest, RoundTrip_IntegerValues) {
+    auto rows = pollRun(100);
+    expectSameRows(rows, encodeDecode(rows));
+}
+
+TEST(UplinkCodecTest, RoundTrip_NonIntegerAndNegativeValues) {
+    std::vector<StoredSample> rows = {
+        row(1, 0, 230.25, 1000),
+        row(2, 0, -17.0, 900),               // Timestamps may step backwards
+        row(5, 3, std::nan(""), 2000),       // Gaps in ids are allowed
+        row(6, 3, 1e300, 2000),
+        row(7, 3, -4.0e15, 2001),
+        row(8, 65535, 0.0, 2002),
+    };
+    auto decoded = encodeDecode(rows);
+    ASSERT_EQ(decoded.size(), rows.size());
+    EXPECT_EQ(decoded[0].value, 230.25);
+    EXPECT_EQ(decoded[1].value, -17.0);
+    EXPECT_EQ(decoded[1].timestamp, TimePoint(Duration(900)));
+    EXPECT_EQ(decoded[2].id, 5u);
+    EXPECT_TRUE(std::isnan(decoded[2].value));
+    EXPECT_EQ(decoded[3].value, 1e300);
+    EXPECT_EQ(decoded[4].value, -4.0e15);
+    EXPECT_EQ(decoded[5].register_address, 65535);
+}
+
+TEST(UplinkCodecTest, Encoder_TracksIdsAndResetsOnFinish) {
+    UplinkBatchEncoder encoder;
+    EXPECT_TRUE(encoder.empty());
+    encoder.add(row(10, 0, 1.0, 1000));
+    encoder.add(row(11, 0, 2.0, 1000));
+    EXPECT_EQ(encoder.count(), 2u);
+    EXPECT_EQ(encoder.firstId(), 10u);
+    EXPECT_EQ(encoder.lastId(), 11u);
+    EXPECT_THROW(encoder.add(row(11, 0, 3.0, 1000)), ValidationException);
+
+    auto batch = encoder.finish();
+    EXPECT_GT(batch.size(), 4u);
+    EXPECT_TRUE(encoder.empty());
+
+    // Deltas restart with the next batch
+    encoder.add(row(5, 0, 9.0, 500));
+    expectSameRows({row(5, 0, 9.0, 500)}, UplinkCodec::decode(encoder.finish()));
+}
+
+TEST(UplinkCodecTest, Encoding_SmallPerRowAndCompresses) {
+    auto rows = pollRun(5000);
+    UplinkBatchEncoder encoder;
+    for (const auto& sample : rows) {
+        encoder.add(sample);
+    }
+    auto encoded = encoder.finish();
+
+    // A row is 4-6 bytes instead of ~40 as JSON
+    EXPECT_LT(encoded.size(), rows.size() * 6);
+
+    auto compressed = UplinkCodec::gzip(encoded);
+    EXPECT_LT(compressed.size(), encoded.size() / 2);
+    EXPECT_EQ(compressed[0], 0x1f);
+    EXPECT_EQ(compressed[1], 0x8b);
+    expectSameRows(rows, UplinkCodec::decode(UplinkCodec::gunzip(compressed)));
+}
+
+TEST(UplinkCodecTest, Decode_RejectsMalformedBatches) {
+    UplinkBatchEncoder encoder;
+    encoder.add(row(1, 0, 230.25, 1000));
+    auto batch = encoder.finish();
+
+    EXPECT_THROW(UplinkCodec::decode({}), ValidationException);
+    EXPECT_THROW(UplinkCodec::decode({'J', 'S', 'O', 'N', 1}), ValidationException);
+
+    auto wrong_version = batch;
+    wrong_version[3] = 99;
+    EXPECT_THROW(UplinkCodec::decode(wrong_version), ValidationException);
+
+    auto truncated = batch;
+    truncated.resize(batch.size() - 3);
+    EXPECT_THROW(UplinkCodec::decode(truncated), ValidationException);
+
+    // Header only is an empty batch
+    batch.resize(4);
+    EXPECT_TRUE(UplinkCodec::decode(batch).empty());
+}
+
+TEST(UplinkCodecTest, Gunzip_RejectsCorruptAndOversizedData) {
+    std::vector<uint8_t> data(100000, 'x');
+    auto compressed = UplinkCodec::gzip(data);
+
+    EXPECT_EQ(UplinkCodec::gunzip(compressed), data);
+    EXPECT_THROW(UplinkCodec::gunzip(compressed, 1000), ValidationException);
+
+    auto corrupt = compressed;
+    corrupt[corrupt.size() / 2] ^= 0xff;
+    corrupt.resize(corrupt.size() - 4);
+    EXPECT_THROW(UplinkCodec::gunzip(corrupt), ValidationException);
+    EXPECT_THROW(UplinkCodec::gunzip({1, 2, 3}), ValidationException);
+}